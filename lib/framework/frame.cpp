@@ -34,6 +34,7 @@
 #include "frameresource.h"
 #include "input.h"
 #include "file_ext.h"
+#include "memory_pool.h"
 
 #include <limits>
 
@@ -129,6 +130,8 @@ void frameShutDown()
 	// Shutdown the resource stuff
 	debug(LOG_NEVER, "No more resources!");
 	resShutDown();
+
+	memoryPoolLogStats(LOG_MEMORY);
 }
 
 void setMouseWarp(bool value)
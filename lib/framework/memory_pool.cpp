@@ -21,9 +21,60 @@
 #include "lib/framework/memory_pool.h"
 #include "lib/framework/frame.h" // FOR ASSERT, ASSERT_OR_RETURN
 
+#include <algorithm>
+#include <map>
+#include <mutex>
+
 namespace
 {
 
+// All live pools, for memoryPoolStats(), and the default pools of the threads.
+struct MemoryPoolRegistry
+{
+	std::mutex mutex;
+	std::vector<const MemoryPool*> pools;
+	// Default pools are never destroyed, blocks allocated from them may outlive their thread.
+	std::vector<std::unique_ptr<MemoryPool>> threadPools;
+	std::vector<MemoryPool*> idleThreadPools;
+};
+
+MemoryPoolRegistry& registry()
+{
+	// Never destroyed, so that pools in objects with static storage duration can unregister in any order.
+	static MemoryPoolRegistry* instance = new MemoryPoolRegistry();
+	return *instance;
+}
+
+// Hands the default pool of a thread back to the registry when the thread finishes.
+struct ThreadMemoryPool
+{
+	MemoryPool* pool = nullptr;
+
+	~ThreadMemoryPool()
+	{
+		if (pool)
+		{
+			pool->disown();
+			auto& reg = registry();
+			std::lock_guard<std::mutex> guard(reg.mutex);
+			reg.idleThreadPools.push_back(pool);
+		}
+	}
+};
+
+thread_local ThreadMemoryPool threadMemoryPool;
+
+// Single writer counters (see MemoryPool::SubPool), so no read-modify-write is needed.
+void stat_add(std::atomic<size_t>& stat, size_t n)
+{
+	stat.store(stat.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+void stat_sub(std::atomic<size_t>& stat, size_t n)
+{
+	stat.store(stat.load(std::memory_order_relaxed) - n, std::memory_order_relaxed);
+}
+
 size_t num_size_classes(const MemoryPoolOptions& opts)
 {
 	size_t n = 1;
@@ -82,7 +133,8 @@ MemoryPoolOptions fixup_options(const MemoryPoolOptions& opts)
 		opts.required_capacity_for_smallest_sub_pool :
 		opts.minimal_required_capacity * 2;
 	// Round up block size limits to the nearest powers-of-2
-	res.minimal_supported_block_size = bit_ceil(opts.minimal_supported_block_size);
+	// Blocks freed by other threads are linked through their first bytes, so they must fit a pointer.
+	res.minimal_supported_block_size = bit_ceil(std::max(opts.minimal_supported_block_size, sizeof(void*)));
 	res.largest_required_block_size = bit_ceil(opts.largest_required_block_size);
 
 	return res;
@@ -92,10 +144,35 @@ MemoryPoolOptions fixup_options(const MemoryPoolOptions& opts)
 
 MemoryPool::MemoryPool(const MemoryPoolOptions& opts)
 	: opts_(fixup_options(opts))
+	, owner_(std::this_thread::get_id())
 {
 	allocate_sub_pools(num_size_classes(opts_));
+
+	auto& reg = registry();
+	std::lock_guard<std::mutex> guard(reg.mutex);
+	reg.pools.push_back(this);
 }
 
+MemoryPool::~MemoryPool()
+{
+	auto& reg = registry();
+	std::lock_guard<std::mutex> guard(reg.mutex);
+	reg.pools.erase(std::remove(reg.pools.begin(), reg.pools.end(), this), reg.pools.end());
+}
+
+MemoryPool::SubPool::SubPool(SubPool&& other) noexcept
+	: blockSize(other.blockSize)
+	, totalFreeBlocks(other.totalFreeBlocks)
+	, chunks(std::move(other.chunks))
+	, remoteFreeHead(other.remoteFreeHead.exchange(nullptr))
+	, statChunks(other.statChunks.load())
+	, statCapacity(other.statCapacity.load())
+	, statUsed(other.statUsed.load())
+	, statPeakUsed(other.statPeakUsed.load())
+	, statAllocations(other.statAllocations.load())
+	, statRemoteFrees(other.statRemoteFrees.load())
+{}
+
 void* MemoryPool::allocate(size_t size, size_t alignment)
 {
 	if (size == 0 || size > largest_supported_block_size())
@@ -103,23 +180,42 @@ void* MemoryPool::allocate(size_t size, size_t alignment)
 		ASSERT(false, "Invalid allocation size (doesn't fit into any available size class): %zu", size);
 		return nullptr;
 	}
+	// The freelists are only ever touched by the owner, so refuse rather than corrupt them
+	ASSERT_OR_RETURN(nullptr, std::this_thread::get_id() == owner_.load(std::memory_order_relaxed), "Allocating from a memory pool owned by another thread");
 	SubPool* pool = find_pool(size, alignment);
 	ASSERT_OR_RETURN(nullptr, pool != nullptr, "No available blocks in any pool for size %zu and alignment %zu", size, alignment);
 
+	drain_remote_frees(*pool);
+	void* block = allocate_block(*pool, alignment);
+	if (block)
+	{
+		stat_add(pool->statAllocations, 1);
+		stat_add(pool->statUsed, 1);
+		const size_t used = pool->statUsed.load(std::memory_order_relaxed);
+		if (used > pool->statPeakUsed.load(std::memory_order_relaxed))
+		{
+			pool->statPeakUsed.store(used, std::memory_order_relaxed);
+		}
+	}
+	return block;
+}
+
+void* MemoryPool::allocate_block(SubPool& pool, size_t alignment)
+{
 	// If there are free blocks, serve from freelist or from chunk's nextFreeIndex
-	if (pool->totalFreeBlocks != 0)
+	if (pool.totalFreeBlocks != 0)
 	{
-		for (auto& chunk : pool->chunks)
+		for (auto& chunk : pool.chunks)
 		{
 			// Serve from the chunk's freelist if it's not empty
 			if (chunk.has_freelist_blocks())
 			{
-				return pool->allocate_from_freelist(chunk, alignment);
+				return pool.allocate_from_freelist(chunk, alignment);
 			}
 			// Otherwise, find the first chunk with nextFreeIndex < capacity
 			if (chunk.nextFreeIndex < chunk.capacity)
 			{
-				return pool->allocate_new_block(chunk, alignment);
+				return pool.allocate_new_block(chunk, alignment);
 			}
 		}
 		// Should not reach here if totalFreeBlocks is correct
@@ -129,10 +225,12 @@ void* MemoryPool::allocate(size_t size, size_t alignment)
 
 	// If no free blocks, allocate a new chunk (capacities increasing in a geometric progression)
 	// and serve the allocation from it
-	size_t newChunkCapacity = pool->chunks.back().capacity * 2;
-	auto& newChunk = pool->chunks.emplace_back(pool->blockSize, newChunkCapacity);
-	pool->totalFreeBlocks += newChunkCapacity;
-	return pool->allocate_new_block(newChunk, alignment);
+	size_t newChunkCapacity = pool.chunks.back().capacity * 2;
+	auto& newChunk = pool.chunks.emplace_back(pool.blockSize, newChunkCapacity);
+	pool.totalFreeBlocks += newChunkCapacity;
+	stat_add(pool.statChunks, 1);
+	stat_add(pool.statCapacity, newChunkCapacity);
+	return pool.allocate_new_block(newChunk, alignment);
 }
 
 void MemoryPool::deallocate(void* ptr, size_t bytes, size_t alignment)
@@ -144,21 +242,41 @@ void MemoryPool::deallocate(void* ptr, size_t bytes, size_t alignment)
 	SubPool* pool = find_pool(bytes, alignment);
 	ASSERT_OR_RETURN(, pool != nullptr, "No sub-pool found for deallocation (bytes=%zu, alignment=%zu)", bytes, alignment);
 
+	if (std::this_thread::get_id() != owner_.load(std::memory_order_relaxed))
+	{
+		// Leave the block to the owning thread (sub-pools are never added or removed, so finding one is safe here)
+		void* head = pool->remoteFreeHead.load(std::memory_order_relaxed);
+		do
+		{
+			*static_cast<void**>(ptr) = head;
+		} while (!pool->remoteFreeHead.compare_exchange_weak(head, ptr, std::memory_order_release, std::memory_order_relaxed));
+		return;
+	}
+
+	drain_remote_frees(*pool);
+	deallocate_block(*pool, ptr);
+	stat_sub(pool->statUsed, 1);
+}
+
+void MemoryPool::deallocate_block(SubPool& pool, void* ptr)
+{
 	// Find the chunk that owns this pointer
-	auto chunkIt = pool->get_owning_chunk(ptr);
-	ASSERT_OR_RETURN(, chunkIt != pool->chunks.end(), "Pointer %p not from this pool", ptr);
+	auto chunkIt = pool.get_owning_chunk(ptr);
+	ASSERT_OR_RETURN(, chunkIt != pool.chunks.end(), "Pointer %p not from this pool", ptr);
 
-	++pool->totalFreeBlocks;
+	++pool.totalFreeBlocks;
 
 	// Each subsequent chunk in the list is larger than the previous one
 	// Always prefer larger chunks over smaller ones (with the smaller one being automatically reclaimed)
-	if ((chunkIt->freeBlocksCount + 1) == chunkIt->capacity && std::next(chunkIt) != pool->chunks.end())
+	if ((chunkIt->freeBlocksCount + 1) == chunkIt->capacity && std::next(chunkIt) != pool.chunks.end())
 	{
 		// Reclaim the now-empty chunk
 		const auto reclaimedCapacity = chunkIt->capacity;
-		pool->chunks.erase(chunkIt);
+		pool.chunks.erase(chunkIt);
 		// Fixup the total sub-pool capacity to account for the just reclaimed chunk
-		pool->totalFreeBlocks -= reclaimedCapacity;
+		pool.totalFreeBlocks -= reclaimedCapacity;
+		stat_sub(pool.statChunks, 1);
+		stat_sub(pool.statCapacity, reclaimedCapacity);
 	}
 	else
 	{
@@ -168,6 +286,25 @@ void MemoryPool::deallocate(void* ptr, size_t bytes, size_t alignment)
 	}
 }
 
+void MemoryPool::drain_remote_frees(SubPool& pool)
+{
+	if (pool.remoteFreeHead.load(std::memory_order_relaxed) == nullptr)
+	{
+		return;
+	}
+	void* block = pool.remoteFreeHead.exchange(nullptr, std::memory_order_acquire);
+	size_t count = 0;
+	while (block)
+	{
+		void* next = *static_cast<void**>(block);
+		deallocate_block(pool, block);
+		block = next;
+		++count;
+	}
+	stat_sub(pool.statUsed, count);
+	stat_add(pool.statRemoteFrees, count);
+}
+
 size_t MemoryPool::largest_supported_block_size() const
 {
 	return opts_.largest_required_block_size;
@@ -187,6 +324,8 @@ void MemoryPool::allocate_sub_pools(size_t numSizeClasses)
 
 		sp.chunks.emplace_back(block_size, initial_capacity);
 		sp.totalFreeBlocks = initial_capacity;
+		sp.statChunks = 1;
+		sp.statCapacity = initial_capacity;
 
 		subPools_.emplace_back(std::move(sp));
 
@@ -260,8 +399,97 @@ void* MemoryPool::SubPool::allocate_from_freelist(Chunk& chunk, size_t alignment
 	return block;
 }
 
+void MemoryPool::adopt()
+{
+	owner_.store(std::this_thread::get_id(), std::memory_order_relaxed);
+}
+
+void MemoryPool::disown()
+{
+	owner_.store(std::thread::id(), std::memory_order_relaxed);
+}
+
+std::vector<MemoryPoolSizeClassStats> MemoryPool::stats() const
+{
+	std::vector<MemoryPoolSizeClassStats> result;
+	result.reserve(subPools_.size());
+	for (const auto& p : subPools_)
+	{
+		MemoryPoolSizeClassStats s;
+		s.blockSize = p.blockSize;
+		s.chunks = p.statChunks.load(std::memory_order_relaxed);
+		s.capacity = p.statCapacity.load(std::memory_order_relaxed);
+		s.used = p.statUsed.load(std::memory_order_relaxed);
+		s.peakUsed = p.statPeakUsed.load(std::memory_order_relaxed);
+		s.allocations = p.statAllocations.load(std::memory_order_relaxed);
+		s.remoteFrees = p.statRemoteFrees.load(std::memory_order_relaxed);
+		result.push_back(s);
+	}
+	return result;
+}
+
 MemoryPool& defaultMemoryPool()
 {
-	static MemoryPool instance({});
-	return instance;
+	if (!threadMemoryPool.pool)
+	{
+		auto& reg = registry();
+		std::unique_lock<std::mutex> guard(reg.mutex);
+		if (!reg.idleThreadPools.empty())
+		{
+			threadMemoryPool.pool = reg.idleThreadPools.back();
+			reg.idleThreadPools.pop_back();
+			guard.unlock();
+			threadMemoryPool.pool->adopt();
+		}
+		else
+		{
+			guard.unlock();  // The pool registers itself.
+			auto pool = std::make_unique<MemoryPool>(MemoryPoolOptions{});
+			threadMemoryPool.pool = pool.get();
+			guard.lock();
+			reg.threadPools.push_back(std::move(pool));
+		}
+	}
+	return *threadMemoryPool.pool;
+}
+
+std::vector<MemoryPoolSizeClassStats> memoryPoolStats()
+{
+	std::map<size_t, MemoryPoolSizeClassStats> byBlockSize;
+	auto& reg = registry();
+	std::lock_guard<std::mutex> guard(reg.mutex);
+	for (const MemoryPool* pool : reg.pools)
+	{
+		for (const auto& s : pool->stats())
+		{
+			auto& total = byBlockSize[s.blockSize];
+			total.blockSize = s.blockSize;
+			total.chunks += s.chunks;
+			total.capacity += s.capacity;
+			total.used += s.used;
+			total.peakUsed += s.peakUsed;  // Sum of the peaks of each pool, which may not have been reached at the same time.
+			total.allocations += s.allocations;
+			total.remoteFrees += s.remoteFrees;
+		}
+	}
+	std::vector<MemoryPoolSizeClassStats> result;
+	result.reserve(byBlockSize.size());
+	for (const auto& entry : byBlockSize)
+	{
+		result.push_back(entry.second);
+	}
+	return result;
+}
+
+void memoryPoolLogStats(code_part part)
+{
+	for (const auto& s : memoryPoolStats())
+	{
+		if (s.allocations == 0)
+		{
+			continue;
+		}
+		debug(part, "Memory pool %6zu B blocks: %zu/%zu used (peak %zu) in %zu chunks, %.0f%% unused, %zu allocations, %zu freed by other threads",
+		      s.blockSize, s.used, s.capacity, s.peakUsed, s.chunks, s.fragmentation() * 100.0, s.allocations, s.remoteFrees);
+	}
 }
@@ -28,12 +28,14 @@
 
 #include "lib/framework/frame.h" // for ASSERT
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <cassert>
 #include <queue>
 #include <list>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -57,6 +59,27 @@ struct MemoryPoolOptions
 	size_t minimal_required_capacity = 8;
 };
 
+/// <summary>
+/// Usage of one size class of a MemoryPool, or of all pools together (see `memoryPoolStats()`).
+/// Meant for tuning the chunk capacities in MemoryPoolOptions.
+/// </summary>
+struct MemoryPoolSizeClassStats
+{
+	size_t blockSize = 0;
+	size_t chunks = 0;       // Chunks currently allocated.
+	size_t capacity = 0;     // Blocks in those chunks.
+	size_t used = 0;         // Blocks handed out and not freed yet.
+	size_t peakUsed = 0;     // High-water mark of `used`.
+	size_t allocations = 0;  // Blocks handed out since the pool was created.
+	size_t remoteFrees = 0;  // Blocks freed by a thread other than the one owning the pool.
+
+	/// Share of the allocated blocks which are not in use, from 0 (none) to 1 (all of them).
+	double fragmentation() const
+	{
+		return capacity > 0 ? static_cast<double>(capacity - std::min(used, capacity)) / static_cast<double>(capacity) : 0.0;
+	}
+};
+
 /// <summary>
 /// MemoryPool provides efficient allocation and deallocation of fixed-size memory blocks using
 /// multiple power-of-2 size classes.
@@ -75,6 +98,11 @@ struct MemoryPoolOptions
 /// This helps to keep memory consumption better overall.
 ///
 /// Each subsequent sub-pool will have block size twice as large than the previous one.
+///
+/// A pool belongs to the thread which created it, and only that thread may allocate from it.
+/// Any thread may deallocate: blocks freed by another thread are pushed onto a lock-free list
+/// of their sub-pool, which the owning thread drains on its next allocation or deallocation
+/// in that sub-pool.
 /// </summary>
 class MemoryPool
 {
@@ -82,12 +110,13 @@ public:
 
 	explicit MemoryPool(const MemoryPoolOptions& opts);
 
-	~MemoryPool() = default;
+	~MemoryPool();
 	MemoryPool(const MemoryPool&) = delete;
 	MemoryPool& operator=(const MemoryPool&) = delete;
 
 	/// <summary>
 	/// Allocate a block of at least the requested size and alignment.
+	/// Returns nullptr when called from a thread other than the owner.
 	/// </summary>
 	void* allocate(size_t size, size_t alignment);
 
@@ -101,6 +130,21 @@ public:
 
 	size_t largest_supported_block_size() const;
 
+	/// <summary>
+	/// Usage of each size class. May be called from any thread.
+	/// </summary>
+	std::vector<MemoryPoolSizeClassStats> stats() const;
+
+	/// <summary>
+	/// Makes the calling thread the owner of this pool (used to hand the pools of finished threads to new ones).
+	/// </summary>
+	void adopt();
+
+	/// <summary>
+	/// Leaves the pool without an owner until `adopt()` is called: all deallocations go through the lock-free lists.
+	/// </summary>
+	void disown();
+
 private:
 
 	struct Chunk
@@ -141,7 +185,7 @@ private:
 	struct SubPool
 	{
 		explicit SubPool() = default;
-		SubPool(SubPool&& other) = default;
+		SubPool(SubPool&& other) noexcept;
 
 		using ChunkStorage = std::list<Chunk>;
 
@@ -149,6 +193,17 @@ private:
 		size_t totalFreeBlocks = 0;
 		ChunkStorage chunks;
 
+		// Blocks freed by other threads, linked through their first bytes.
+		std::atomic<void*> remoteFreeHead{nullptr};
+
+		// Statistics: only written by the owning thread, but read by any.
+		std::atomic<size_t> statChunks{0};
+		std::atomic<size_t> statCapacity{0};
+		std::atomic<size_t> statUsed{0};
+		std::atomic<size_t> statPeakUsed{0};
+		std::atomic<size_t> statAllocations{0};
+		std::atomic<size_t> statRemoteFrees{0};
+
 		// Returns the owning chunk for a pointer
 		ChunkStorage::iterator get_owning_chunk(void* ptr);
 
@@ -174,6 +229,21 @@ private:
 	/// </summary>
 	void allocate_sub_pools(size_t numSizeClasses);
 
+	/// <summary>
+	/// Serves an allocation from the given sub-pool, replenishing it with a new chunk if it's full.
+	/// </summary>
+	void* allocate_block(SubPool& pool, size_t alignment);
+
+	/// <summary>
+	/// Returns a block to its chunk (on the owning thread).
+	/// </summary>
+	void deallocate_block(SubPool& pool, void* ptr);
+
+	/// <summary>
+	/// Returns the blocks other threads freed in the given sub-pool to their chunks (on the owning thread).
+	/// </summary>
+	void drain_remote_frees(SubPool& pool);
+
 	/// <summary>
 	/// Finds a suitable sub-pool for the specified size and alignment.
 	/// </summary>
@@ -184,10 +254,23 @@ private:
 
 	MemoryPoolOptions opts_;
 	std::vector<SubPool> subPools_;
+	std::atomic<std::thread::id> owner_;
 };
 
 /// <summary>
-/// Provides a default singleton memory pool instance for use throughout the application.
+/// Provides the default memory pool of the calling thread, for use throughout the application.
+/// Each thread gets its own pool; the pool of a finished thread is kept for the next thread that
+/// asks for one, since blocks allocated from it may still be in use (and freed from anywhere).
 /// </summary>
-/// <returns>Reference to the default memory pool instance.</returns>
+/// <returns>Reference to the memory pool instance of the calling thread.</returns>
 MemoryPool& defaultMemoryPool();
+
+/// <summary>
+/// Usage of each size class, summed over all live memory pools. May be called from any thread.
+/// </summary>
+std::vector<MemoryPoolSizeClassStats> memoryPoolStats();
+
+/// <summary>
+/// Logs `memoryPoolStats()`, one line per size class in use.
+/// </summary>
+void memoryPoolLogStats(code_part part);
@@ -23,7 +23,10 @@
  */
 
 #include "resource_loading_controller.h"
+#include "wzparallel.h"
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <ratio>
 #include <utility>
@@ -34,6 +37,19 @@ struct ResourceLoadingController::ResourceLoadingSubmission
 	FramePolicy policy{};
 };
 
+/// Jobs from one `runOnWorkers()` call. The last job to finish posts `finished`.
+struct ResourceLoadingController::WorkerBatch
+{
+	explicit WorkerBatch(size_t numJobs) : remaining(numJobs), finished(wzSemaphoreCreate(0)) {}
+	~WorkerBatch() { wzSemaphoreDestroy(finished); }
+
+	WorkerBatch(const WorkerBatch&) = delete;
+	WorkerBatch& operator=(const WorkerBatch&) = delete;
+
+	std::atomic<size_t> remaining;
+	WZ_SEMAPHORE *finished;
+};
+
 ResourceLoadingController::~ResourceLoadingController()
 {
 	resetTaskState();
@@ -59,6 +75,70 @@ void ResourceLoadingController::FrameYield::await_suspend(std::coroutine_handle<
 	top.state = ExecutionFrameState::Paused;
 }
 
+ResourceLoadingController::WorkerWait ResourceLoadingController::runOnWorkers(std::vector<WorkerJob> jobs)
+{
+	return WorkerWait{this, std::move(jobs)};
+}
+
+bool ResourceLoadingController::WorkerWait::await_ready()
+{
+	ASSERT(controller != nullptr, "runOnWorkers without controller");
+	if (!jobs.empty() && controller->workerCount() > 0)
+	{
+		return false;
+	}
+	// Nothing to hand off: run on the calling thread and continue without suspending.
+	for (auto& job : jobs)
+	{
+		job();
+	}
+	jobs.clear();
+	return true;
+}
+
+void ResourceLoadingController::WorkerWait::await_suspend(std::coroutine_handle<> h)
+{
+	auto& top = controller->topFrame();
+	ASSERT(top.handle.address() == h.address(),
+	       "runOnWorkers must suspend the execution stack top");
+	ASSERT(!controller->awaitedWorkerBatch, "runOnWorkers while another worker batch is awaited");
+	auto batch = std::make_shared<WorkerBatch>(jobs.size());
+	controller->awaitedWorkerBatch = batch;
+	top.state = ExecutionFrameState::WaitingForWorkers;
+	std::vector<std::function<void ()>> poolJobs;
+	poolJobs.reserve(jobs.size());
+	for (auto& job : jobs)
+	{
+		poolJobs.emplace_back([job = std::move(job), batch]() {
+			job();
+			if (batch->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			{
+				wzSemaphorePost(batch->finished);
+			}
+		});
+	}
+	jobs.clear();
+	wzWorkerPoolSubmit(std::move(poolJobs));
+}
+
+size_t ResourceLoadingController::workerCount()
+{
+	return wzWorkerThreadCount();
+}
+
+bool ResourceLoadingController::waitingForWorkers() const noexcept
+{
+	return awaitedWorkerBatch && awaitedWorkerBatch->remaining.load(std::memory_order_acquire) > 0;
+}
+
+void ResourceLoadingController::waitForWorkers(int32_t timeoutMS) noexcept
+{
+	if (waitingForWorkers())
+	{
+		wzSemaphoreWaitTimeout(awaitedWorkerBatch->finished, timeoutMS);
+	}
+}
+
 ResourceLoadingController::ExecutionFrame& ResourceLoadingController::topFrame()
 {
 	ASSERT(hasActiveExecution(), "topFrame without active execution");
@@ -137,6 +217,15 @@ LoadStepStatus ResourceLoadingController::stepOneQuantum()
 	ASSERT(hasActiveExecution(), "ResourceLoadingController.stepOneQuantum without active execution");
 
 	ExecutionFrame& top = topFrame();
+	if (top.state == ExecutionFrameState::WaitingForWorkers)
+	{
+		if (waitingForWorkers())
+		{
+			return LoadStepStatus::InProgress;
+		}
+		awaitedWorkerBatch.reset();
+		top.state = ExecutionFrameState::Paused;
+	}
 	ASSERT(top.state == ExecutionFrameState::Paused,
 	       "stepOneQuantum must resume a paused execution frame");
 	top.state = ExecutionFrameState::Running;
@@ -167,6 +256,12 @@ void ResourceLoadingController::completeActiveSubmission(LoadStepStatus result)
 
 void ResourceLoadingController::resetTaskState() noexcept
 {
+	// Jobs still in flight may write into the coroutine frames destroyed below.
+	while (waitingForWorkers())
+	{
+		waitForWorkers(100);
+	}
+	awaitedWorkerBatch.reset();
 	while (!executionStack.empty())
 	{
 		popAndDestroyTop();
@@ -231,6 +326,16 @@ void ResourceLoadingController::step()
 	const auto minDeadline = std::chrono::steady_clock::now() + MinimumStepDuration(1);
 	do
 	{
+		if (waitingForWorkers())
+		{
+			// Sleep until the batch finishes or this frame's quantum is used up.
+			const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(minDeadline - std::chrono::steady_clock::now());
+			waitForWorkers(std::max<int32_t>(static_cast<int32_t>(remaining.count()), 0));
+			if (waitingForWorkers())
+			{
+				break;
+			}
+		}
 		completeActiveSubmission(stepOneQuantum());
 	} while (std::chrono::steady_clock::now() < minDeadline && hasActiveExecution());
 }
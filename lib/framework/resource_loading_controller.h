@@ -33,6 +33,7 @@
 #include "lib/framework/wzapp.h"
 
 #include <coroutine>
+#include <functional>
 #include <memory>
 #include <queue>
 #include <stack>
@@ -56,6 +57,9 @@
 /// * `FramePolicy` selects `ConsumeFrame` vs `ContinueMainLoop` and whether the loading
 ///   screen is shown (`presentResourceLoadingScreenIfNeeded()`).
 /// * Nested work uses `co_await child_task` (see `loading_task_controller_ops`).
+/// * CPU-bound decoding can be moved off the main thread with `co_await runOnWorkers(jobs)`:
+///   the jobs run on a small worker pool while `step()` keeps returning to `mainLoop`, and the
+///   coroutine resumes on the main thread once every job has finished.
 ///
 /// Usage constraints:
 /// * Call `yieldFrame()` only from inside a `LoadingTask` that the controller is driving
@@ -65,6 +69,8 @@
 ///   while a cooperative session is already active.
 /// * Call `runTaskToCompletion()` only when `!active()` and not from inside a loading coroutine;
 ///   otherwise use `co_await` / `yieldFrame()`.
+/// * Worker jobs must not touch the graphics context, PhysFS write paths, or game state; decode
+///   into job-owned storage and upload / publish the results after `runOnWorkers()` resumes.
 /// * `isExecutingLoadingCoroutine()` is true only during an in-flight `resume()`, not when the
 ///   task is merely paused after `yieldFrame`. Use `active()` for “a submission is in progress”.
 /// * Query `currentFrameProcessingMode()` and `loadingScreenHandledByController()` only while
@@ -81,6 +87,9 @@ public:
 	using BetweenQuantumCallback = void (*)(const FramePolicy& policy);
 
 	struct FrameYield;
+	struct WorkerWait;
+
+	using WorkerJob = std::function<void ()>;
 
 	static ResourceLoadingController& instance();
 
@@ -120,9 +129,17 @@ public:
 	// Returns an awaitable that suspends the current coroutine until the next `stepOneQuantum()`.
 	FrameYield yieldFrame() noexcept;
 
+	// Returns an awaitable that runs `jobs` on the shared worker pool (see wzparallel.h) and suspends
+	// the current coroutine until all of them have finished. Jobs run inline when there are no worker threads.
+	WorkerWait runOnWorkers(std::vector<WorkerJob> jobs);
+
+	// Number of worker threads (0 on single-core systems). Useful to size decode batches.
+	size_t workerCount();
+
 private:
 
 	friend struct FrameYield;
+	friend struct WorkerWait;
 	template <typename T>
 	friend class LoadingTask;
 	template <typename T>
@@ -142,6 +159,7 @@ private:
 	};
 
 	struct ResourceLoadingSubmission;
+	struct WorkerBatch;
 
 	explicit ResourceLoadingController() = default;
 	~ResourceLoadingController();
@@ -162,6 +180,9 @@ private:
 	void onFrameFinished(bool succeeded) noexcept;
 	bool hasActiveExecution() const noexcept { return !executionStack.empty(); }
 
+	bool waitingForWorkers() const noexcept;
+	void waitForWorkers(int32_t timeoutMS) noexcept;
+
 	std::unique_ptr<ResourceLoadingSubmission> activeSubmission;
 	std::queue<std::unique_ptr<ResourceLoadingSubmission>> pendingSubmissions; // FIFO while active
 
@@ -169,6 +190,8 @@ private:
 	std::coroutine_handle<> sessionRootHandle{}; // root handle kept until submission completes
 	bool terminalSucceeded = true;
 	bool sessionFinished = false;
+
+	std::shared_ptr<WorkerBatch> awaitedWorkerBatch; // batch the execution-stack top is waiting on
 };
 
 /// <summary>
@@ -186,6 +209,22 @@ struct ResourceLoadingController::FrameYield
 	void await_resume() const noexcept {}
 };
 
+/// <summary>
+/// Awaitable from `runOnWorkers()`: hands the jobs to the worker pool and parks the
+/// execution-stack top in `WaitingForWorkers` until the whole batch has finished.
+/// </summary>
+struct ResourceLoadingController::WorkerWait
+{
+	ResourceLoadingController* controller = nullptr;
+	std::vector<WorkerJob> jobs;
+
+	bool await_ready();
+
+	void await_suspend(std::coroutine_handle<> h);
+
+	void await_resume() const noexcept {}
+};
+
 template <typename T>
 LoadResult<T> ResourceLoadingController::runTaskToCompletion(LoadingTask<T> task, FramePolicy policy,
                                                              BetweenQuantumCallback betweenQuantum)
@@ -200,6 +239,15 @@ LoadResult<T> ResourceLoadingController::runTaskToCompletion(LoadingTask<T> task
 	LoadResult<T> result = load_fail();
 	while (active())
 	{
+		if (waitingForWorkers())
+		{
+			waitForWorkers(10);
+			if (betweenQuantum)
+			{
+				betweenQuantum(policy);
+			}
+			continue;
+		}
 		const LoadStepStatus status = stepOneQuantum();
 		if (betweenQuantum)
 		{
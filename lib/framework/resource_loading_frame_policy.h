@@ -37,12 +37,14 @@ enum class LoadStepStatus
 };
 
 /// <summary>
-/// Whether an execution-stack frame is waiting for the next quantum or inside `resume()`.
+/// Whether an execution-stack frame is waiting for the next quantum, inside `resume()`,
+/// or suspended until a `runOnWorkers()` batch has finished.
 /// </summary>
 enum class ExecutionFrameState
 {
 	Paused,
 	Running,
+	WaitingForWorkers,
 };
 
 /// <summary>
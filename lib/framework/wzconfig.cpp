@@ -29,6 +29,9 @@
 #include <sstream>
 #include <limits>
 #include "physfs_ext.h"
+#include "crc.h"
+#include <cstring>
+#include <type_traits>
 
 WzConfig::~WzConfig()
 {
@@ -68,7 +71,148 @@ static nlohmann::json jsonMerge(nlohmann::json original, const nlohmann::json& o
 	return original;
 }
 
-WzConfig::WzConfig(const WzString &name, WzConfig::warning warning)
+// Merged read-only documents are cached in the write directory as CBOR, see WzConfig::UseBinaryCache
+#define BINARY_CACHE_DIR "cache/stats"
+
+// Bump whenever the layout below or the way documents are merged changes
+static constexpr uint32_t BINARY_CACHE_VERSION = 1;
+static constexpr char BINARY_CACHE_MAGIC[4] = {'W', 'Z', 'S', 'C'};
+
+namespace
+{
+
+struct BinaryCacheHeader
+{
+	char magic[4] = {};
+	uint32_t version = 0;
+	Sha256 key;
+	uint64_t size = 0;
+	uint32_t crc = 0;
+	uint32_t padding = 0;
+};
+
+static_assert(std::is_trivially_copyable<BinaryCacheHeader>::value, "BinaryCacheHeader is written as raw bytes");
+static_assert(sizeof(BinaryCacheHeader) == 8 + Sha256::Bytes + 8 + 2 * 4, "BinaryCacheHeader must not contain implicit padding");
+
+std::string binaryCachePath(const Sha256 &key)
+{
+	return std::string(BINARY_CACHE_DIR "/") + key.toString() + ".bin";
+}
+
+// Hashes the document and every diff merged into it, so editing any of them or loading another mod changes the key.
+// Returns a zero key if a diff can't be read, which disables the cache for this document.
+Sha256 binaryCacheKey(const WzString &name, const char *data, size_t size, const std::vector<std::string> &diffPaths)
+{
+	std::string key(BINARY_CACHE_MAGIC, sizeof(BINARY_CACHE_MAGIC));
+	key.append(reinterpret_cast<const char *>(&BINARY_CACHE_VERSION), sizeof(BINARY_CACHE_VERSION));
+	key += name.toUtf8();
+	key += '\0';
+	Sha256 hash = sha256Sum(data, size);
+	key.append(reinterpret_cast<const char *>(hash.bytes), Sha256::Bytes);
+	for (const std::string &path : diffPaths)
+	{
+		std::vector<char> diffData;
+		if (!loadFileToBufferVector(path.c_str(), diffData, false, false))
+		{
+			return Sha256();
+		}
+		key += path;
+		key += '\0';
+		hash = sha256Sum(diffData.data(), diffData.size());
+		key.append(reinterpret_cast<const char *>(hash.bytes), Sha256::Bytes);
+	}
+	return sha256Sum(key.data(), key.size());
+}
+
+bool readBinaryCache(const Sha256 &key, nlohmann::json &root)
+{
+	const std::string path = binaryCachePath(key);
+	if (!PHYSFS_exists(path.c_str()))
+	{
+		return false;
+	}
+	std::vector<char> fileData;
+	if (!loadFileToBufferVector(path.c_str(), fileData, false, false))
+	{
+		return false;
+	}
+	BinaryCacheHeader header;
+	if (fileData.size() < sizeof(header))
+	{
+		debug(LOG_WARNING, "Ignoring corrupt stats cache entry: %s", path.c_str());
+		return false;
+	}
+	memcpy(&header, fileData.data(), sizeof(header));
+	if (memcmp(header.magic, BINARY_CACHE_MAGIC, sizeof(header.magic)) != 0 || header.version != BINARY_CACHE_VERSION || header.key != key)
+	{
+		debug(LOG_SAVE, "Ignoring stale stats cache entry: %s", path.c_str());
+		return false;
+	}
+	const uint8_t *body = reinterpret_cast<const uint8_t *>(fileData.data()) + sizeof(header);
+	if (header.size != fileData.size() - sizeof(header)
+		|| wz::crc_update(wz::crc_init(), body, static_cast<size_t>(header.size)) != header.crc)
+	{
+		debug(LOG_WARNING, "Ignoring corrupt stats cache entry: %s", path.c_str());
+		return false;
+	}
+	try {
+		root = nlohmann::json::from_cbor(body, body + header.size);
+	}
+	catch (const std::exception &e) {
+		debug(LOG_WARNING, "Ignoring invalid stats cache entry %s: %s", path.c_str(), e.what());
+		return false;
+	}
+	if (!root.is_object())
+	{
+		root = nlohmann::json::object();
+		return false;
+	}
+	return true;
+}
+
+void writeBinaryCache(const Sha256 &key, const nlohmann::json &root)
+{
+	static bool cacheDirCreated = false;
+	if (!cacheDirCreated)
+	{
+		// Failure is handled below: the cache is an optimisation only
+		PHYSFS_mkdir(BINARY_CACHE_DIR);
+		cacheDirCreated = true;
+	}
+	std::vector<uint8_t> body;
+	try {
+		nlohmann::json::to_cbor(root, body);
+	}
+	catch (const std::exception &e) {
+		debug(LOG_WARNING, "Unable to encode stats cache entry: %s", e.what());
+		return;
+	}
+	const std::string path = binaryCachePath(key);
+	PHYSFS_file *fileHandle = PHYSFS_openWrite(path.c_str());
+	if (!fileHandle)
+	{
+		debug(LOG_SAVE, "Unable to write stats cache entry %s: %s", path.c_str(), WZ_PHYSFS_getLastError());
+		return;
+	}
+	BinaryCacheHeader header;
+	memcpy(header.magic, BINARY_CACHE_MAGIC, sizeof(header.magic));
+	header.version = BINARY_CACHE_VERSION;
+	header.key = key;
+	header.size = body.size();
+	header.crc = wz::crc_update(wz::crc_init(), body.data(), body.size());
+	bool written = WZ_PHYSFS_writeBytes(fileHandle, &header, sizeof(header)) == static_cast<PHYSFS_sint64>(sizeof(header))
+		&& WZ_PHYSFS_writeBytes(fileHandle, body.data(), static_cast<PHYSFS_uint32>(body.size())) == static_cast<PHYSFS_sint64>(body.size());
+	PHYSFS_close(fileHandle);
+	if (!written)
+	{
+		debug(LOG_WARNING, "Failed to write stats cache entry %s: %s", path.c_str(), WZ_PHYSFS_getLastError());
+		PHYSFS_delete(path.c_str());
+	}
+}
+
+} // namespace
+
+WzConfig::WzConfig(const WzString &name, WzConfig::warning warning, WzConfig::cacheMode cache)
 : mArray(nlohmann::json::array())
 {
 	UDWORD size = 0;
@@ -104,6 +248,28 @@ WzConfig::WzConfig(const WzString &name, WzConfig::warning warning)
 	}
 	ASSERT_OR_RETURN(, data != nullptr, "Null data?");
 
+	std::vector<std::string> diffPaths;
+	WZ_PHYSFS_enumerateFolders("diffs", [&](const char *i) -> bool {
+		std::string str(std::string("diffs/") + i + std::string("/") + name.toUtf8().c_str());
+		if (PHYSFS_exists(str.c_str()))
+		{
+			diffPaths.push_back(str);
+		}
+		return true; // continue
+	});
+
+	Sha256 cacheKey;
+	if (cache == UseBinaryCache && warning != ReadAndWrite)
+	{
+		cacheKey = binaryCacheKey(name, data, size, diffPaths);
+		if (!cacheKey.isZero() && readBinaryCache(cacheKey, mRoot))
+		{
+			free(data);
+			debug(LOG_SAVE, "Opening %s from the stats cache", name.toUtf8().c_str());
+			return;
+		}
+	}
+
 	try {
 		mRoot = nlohmann::json::parse(data, data + size);
 	}
@@ -124,12 +290,8 @@ WzConfig::WzConfig(const WzString &name, WzConfig::warning warning)
 		return;
 	}
 	free(data);
-	WZ_PHYSFS_enumerateFolders("diffs", [&](const char *i) -> bool {
-		std::string str(std::string("diffs/") + i + std::string("/") + name.toUtf8().c_str());
-		if (!PHYSFS_exists(str.c_str()))
-		{
-			return true; // continue;
-		}
+	for (const std::string &str : diffPaths)
+	{
 		UDWORD size = 0;
 		char *data = nullptr;
 		if (!loadFile(str.c_str(), &data, &size))
@@ -142,6 +304,7 @@ WzConfig::WzConfig(const WzString &name, WzConfig::warning warning)
 		}
 		catch (const std::exception &e) {
 			ASSERT(false, "JSON diff from %s is invalid: %s", name.toUtf8().c_str(), e.what());
+			cacheKey.setZero();
 		}
 		catch (...) {
 			debug(LOG_FATAL, "Unexpected exception parsing JSON diff from %s", name.toUtf8().c_str());
@@ -154,13 +317,17 @@ WzConfig::WzConfig(const WzString &name, WzConfig::warning warning)
 		else
 		{
 			ASSERT(tmpJson.is_object(), "JSON diff from %s is not an object. Read: \n%s", name.toUtf8().c_str(), data);
+			cacheKey.setZero();
 		}
 		free(data);
 		debug(LOG_INFO, "jsondiff \"%s\" loaded and merged", str.c_str());
-		return true; // continue
-	});
+	}
 	debug(LOG_SAVE, "Opening %s", name.toUtf8().c_str());
 	pCurrentObj = &mRoot;
+	if (!cacheKey.isZero())
+	{
+		writeBinaryCache(cacheKey, mRoot);
+	}
 }
 
 bool WzConfig::isAtDocumentRoot() const
@@ -99,6 +99,10 @@ class WzConfig
 {
 public:
 	enum warning { ReadAndWrite, ReadOnly, ReadOnlyAndRequired };
+	/// UseBinaryCache keeps a read-only document, with its diffs merged, in a binary cache in the write
+	/// directory, keyed on the contents of every file it was merged from. Later loads of the same files
+	/// skip parsing the JSON text and merging the diffs. Meant for the big stats files.
+	enum cacheMode { NoBinaryCache, UseBinaryCache };
 
 private:
 	nlohmann::json mRoot = nlohmann::json::object();
@@ -113,7 +117,7 @@ private:
 	warning mWarning;
 
 public:
-	WzConfig(const WzString &name, WzConfig::warning warning);
+	WzConfig(const WzString &name, WzConfig::warning warning, WzConfig::cacheMode cache = NoBinaryCache);
 	~WzConfig();
 
 	Vector3f vector3f(const WzString &name);
@@ -0,0 +1,222 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+	This file is part of Warzone 2100.
+	Copyright (C) 2026  Warzone 2100 Project (https://github.com/Warzone2100)
+
+	Warzone 2100 is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	Warzone 2100 is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Warzone 2100; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+/** @file wzparallel.cpp
+ * Implementation of the shared worker pool (see wzparallel.h).
+ */
+
+#include "wzparallel.h"
+
+#include "frame.h"
+#include "wzapp.h"
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <memory>
+
+#define MAX_WORKER_THREADS 8
+
+namespace
+{
+
+/// One `wzParallelFor` call. Helper jobs that start late may still hold a reference after the call
+/// returned, but by then every chunk is claimed, so they never touch `func` again.
+struct ParallelTask
+{
+	const std::function<void (size_t, size_t)> *func = nullptr;
+	size_t count = 0;
+	size_t chunkSize = 0;
+	size_t numChunks = 0;
+	std::atomic<size_t> nextChunk{0};
+	std::atomic<size_t> chunksLeft{0};
+	WZ_SEMAPHORE *finished = nullptr;
+
+	// Claim and run chunks until none are left.
+	void work()
+	{
+		for (size_t chunk = nextChunk.fetch_add(1); chunk < numChunks; chunk = nextChunk.fetch_add(1))
+		{
+			const size_t begin = chunk * chunkSize;
+			(*func)(begin, std::min(begin + chunkSize, count));
+			if (chunksLeft.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			{
+				wzSemaphorePost(finished);
+			}
+		}
+	}
+};
+
+struct WorkerPool
+{
+	WorkerPool()
+	{
+		mutex = wzMutexCreate();
+		jobsAvailable = wzSemaphoreCreate(0);
+		parallelForFinished = wzSemaphoreCreate(0);
+
+		const uint32_t logicalCPUCount = wzGetLogicalCPUCount();
+		// leave one core for the main thread
+		const size_t numThreads = (logicalCPUCount <= 1) ? 0 : std::min<size_t>(logicalCPUCount - 1, MAX_WORKER_THREADS);
+		debug(LOG_INFO, "Using worker threads: %zu", numThreads);
+		for (size_t i = 0; i < numThreads; ++i)
+		{
+			WZ_THREAD *thread = wzThreadCreate(threadFunc, this, "wzWorker");
+			wzThreadStart(thread);
+			threads.push_back(thread);
+		}
+	}
+
+	~WorkerPool()
+	{
+		wzMutexLock(mutex);
+		quit = true;
+		wzMutexUnlock(mutex);
+		for (size_t i = 0; i < threads.size(); ++i)
+		{
+			wzSemaphorePost(jobsAvailable); // Wake up a thread, so it can quit.
+		}
+		for (WZ_THREAD *thread : threads)
+		{
+			wzThreadJoin(thread);
+		}
+		wzSemaphoreDestroy(parallelForFinished);
+		wzSemaphoreDestroy(jobsAvailable);
+		wzMutexDestroy(mutex);
+	}
+
+	void submit(std::vector<std::function<void ()>> &&jobs)
+	{
+		wzMutexLock(mutex);
+		for (auto &job : jobs)
+		{
+			queue.push_back(std::move(job));
+		}
+		wzMutexUnlock(mutex);
+		for (size_t i = 0; i < jobs.size(); ++i)
+		{
+			wzSemaphorePost(jobsAvailable);
+		}
+	}
+
+	static int threadFunc(void *data)
+	{
+		WorkerPool &pool = *static_cast<WorkerPool *>(data);
+		for (;;)
+		{
+			wzSemaphoreWait(pool.jobsAvailable);
+			wzMutexLock(pool.mutex);
+			if (pool.quit)
+			{
+				wzMutexUnlock(pool.mutex);
+				return 0;
+			}
+			ASSERT(!pool.queue.empty(), "Worker woken without a queued job");
+			std::function<void ()> job = std::move(pool.queue.front());
+			pool.queue.pop_front();
+			wzMutexUnlock(pool.mutex);
+
+			job();
+		}
+	}
+
+	std::vector<WZ_THREAD *> threads;
+	WZ_MUTEX *mutex = nullptr;
+	WZ_SEMAPHORE *jobsAvailable = nullptr;
+	WZ_SEMAPHORE *parallelForFinished = nullptr; ///< `wzParallelFor` is main thread only, so one is enough
+	std::deque<std::function<void ()>> queue;
+	bool quit = false;
+};
+
+}
+
+static std::unique_ptr<WorkerPool> workerPool;
+static bool workerPoolShutDown = false;
+
+static WorkerPool *getWorkerPool()
+{
+	if (!workerPool && !workerPoolShutDown)
+	{
+		workerPool = std::make_unique<WorkerPool>();
+	}
+	return workerPool.get();
+}
+
+size_t wzWorkerThreadCount()
+{
+	WorkerPool *pool = getWorkerPool();
+	return pool ? pool->threads.size() : 0;
+}
+
+size_t wzParallelThreadCount()
+{
+	return wzWorkerThreadCount() + 1;
+}
+
+void wzWorkerPoolSubmit(std::vector<std::function<void ()>> jobs)
+{
+	if (wzWorkerThreadCount() == 0)
+	{
+		for (auto &job : jobs)
+		{
+			job();
+		}
+		return;
+	}
+	workerPool->submit(std::move(jobs));
+}
+
+void wzParallelFor(size_t count, size_t minBatchSize, const std::function<void (size_t begin, size_t end)> &func)
+{
+	if (count == 0)
+	{
+		return;
+	}
+	minBatchSize = std::max<size_t>(minBatchSize, 1);
+	const size_t numThreads = wzParallelThreadCount();
+	if (numThreads == 1 || count <= minBatchSize)
+	{
+		func(0, count);
+		return;
+	}
+
+	// A few chunks per thread, so a thread that got slow items does not hold up the others
+	const size_t chunkSize = std::max(minBatchSize, (count + numThreads * 4 - 1) / (numThreads * 4));
+	auto task = std::make_shared<ParallelTask>();
+	task->func = &func;
+	task->count = count;
+	task->chunkSize = chunkSize;
+	task->numChunks = (count + chunkSize - 1) / chunkSize;
+	task->chunksLeft = task->numChunks;
+	task->finished = workerPool->parallelForFinished;
+
+	const size_t helpers = std::min(numThreads - 1, task->numChunks - 1);
+	std::vector<std::function<void ()>> helperJobs(helpers, [task]() { task->work(); });
+	workerPool->submit(std::move(helperJobs));
+
+	task->work();
+	wzSemaphoreWait(task->finished);
+}
+
+void wzParallelShutdown()
+{
+	workerPool.reset();
+	workerPoolShutDown = true;
+}
@@ -0,0 +1,54 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+	This file is part of Warzone 2100.
+	Copyright (C) 2026  Warzone 2100 Project (https://github.com/Warzone2100)
+
+	Warzone 2100 is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	Warzone 2100 is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Warzone 2100; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+/** @file wzparallel.h
+ * The shared pool of worker threads.
+ *
+ * There is one pool for the whole game. Loading jobs (see `ResourceLoadingController::runOnWorkers`)
+ * are queued with `wzWorkerPoolSubmit` and complete asynchronously, while a `wzParallelFor` call
+ * blocks until its whole range is processed, with the calling thread working on the range too, so
+ * it can be used from the middle of a frame.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+/// Queues `jobs` on the worker threads, in order, and returns. Jobs must not block on each other.
+/// Without worker threads (single core, or after `wzParallelShutdown`) they run on the calling thread.
+void wzWorkerPoolSubmit(std::vector<std::function<void ()>> jobs);
+
+/// Calls `func(begin, end)` for disjoint sub-ranges that together cover `[0, count)`, spread over
+/// the worker threads and the calling thread, and returns once all of them are done. Each range
+/// holds at least `minBatchSize` items (except the last one), so small loops stay on one thread.
+/// Workers busy with queued jobs just leave more of the range to the calling thread.
+/// `func` must be safe to call concurrently. Not reentrant: call from the main thread only.
+void wzParallelFor(size_t count, size_t minBatchSize, const std::function<void (size_t begin, size_t end)> &func);
+
+/// Number of worker threads in the pool (not counting the calling thread).
+size_t wzWorkerThreadCount();
+
+/// Number of threads `wzParallelFor` may use, including the calling thread.
+size_t wzParallelThreadCount();
+
+/// Stops the worker threads. Both entry points still work afterwards, on the calling thread only.
+void wzParallelShutdown();
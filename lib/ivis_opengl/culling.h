@@ -24,6 +24,9 @@
 #include <glm/glm.hpp>
 #include <algorithm>
 #include <functional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 using BoundingBox = std::array<glm::vec3, 8>;
 
@@ -36,3 +39,263 @@ using HalfSpaceCheck = std::function<bool(const glm::vec3&)>;
 using IntersectionOfHalfSpace = std::array< HalfSpaceCheck, 6>;
 
 bool isBBoxInClipSpace(const IntersectionOfHalfSpace& intersectionOfHalfSpace, const BoundingBox& points);
+
+/// Result of testing a quadtree node against the view
+enum class CullResult
+{
+	Outside,      ///< nothing below the node can be visible
+	Intersecting, ///< test the children
+	Inside        ///< everything below the node is potentially visible
+};
+
+/// Axis-aligned rectangle of map tiles, [x1, x2) x [y1, y2)
+struct CullRect
+{
+	int x1 = 0;
+	int y1 = 0;
+	int x2 = 0;
+	int y2 = 0;
+
+	bool empty() const { return x1 >= x2 || y1 >= y2; }
+	bool intersects(const CullRect& other) const
+	{
+		return !empty() && !other.empty() && x1 < other.x2 && other.x1 < x2 && y1 < other.y2 && other.y1 < y2;
+	}
+	bool contains(const CullRect& other) const
+	{
+		return !other.empty() && x1 <= other.x1 && y1 <= other.y1 && other.x2 <= x2 && other.y2 <= y2;
+	}
+	void unite(const CullRect& other)
+	{
+		if (other.empty())
+		{
+			return;
+		}
+		if (empty())
+		{
+			*this = other;
+			return;
+		}
+		x1 = std::min(x1, other.x1);
+		y1 = std::min(y1, other.y1);
+		x2 = std::max(x2, other.x2);
+		y2 = std::max(y2, other.y2);
+	}
+};
+
+/// What a culling query did, for the performance counters
+struct CullStats
+{
+	size_t nodesTested = 0;   ///< nodes whose bounds were tested against the view
+	size_t nodesRejected = 0; ///< tested nodes found to be entirely outside the view
+	size_t itemsVisited = 0;  ///< items handed to the caller
+};
+
+/// Quadtree over the map, for culling things that do not move (terrain sectors, structures, features).
+///
+/// Each item lives in the leaf holding the centre of its bounds, and every node keeps the union of the
+/// bounds of all items below it, so items may overlap neighbouring cells. A query only descends into
+/// nodes that can be visible, so its cost follows what is on screen rather than the size of the map.
+template <typename Item>
+class CullQuadtree
+{
+public:
+	/// Drops all items and lays the nodes out over `width` x `height` tiles, splitting until a leaf is at most `leafSize` tiles across.
+	void reset(int width, int height, int leafSize)
+	{
+		nodes.clear();
+		itemLeaf.clear();
+		treeWidth = width;
+		treeHeight = height;
+		build(CullRect{0, 0, std::max(width, 1), std::max(height, 1)}, -1, std::max(leafSize, 1));
+	}
+
+	/// Drops all items, keeping the layout.
+	void clear()
+	{
+		for (Node& node : nodes)
+		{
+			node.bounds = CullRect();
+			node.itemCount = 0;
+			node.items.clear();
+		}
+		itemLeaf.clear();
+	}
+
+	void insert(const Item& item, const CullRect& bounds)
+	{
+		if (nodes.empty() || bounds.empty())
+		{
+			return;
+		}
+		remove(item);
+		const int centreX = std::clamp((bounds.x1 + bounds.x2) / 2, 0, nodes[0].cell.x2 - 1);
+		const int centreY = std::clamp((bounds.y1 + bounds.y2) / 2, 0, nodes[0].cell.y2 - 1);
+		int index = 0;
+		for (;;)
+		{
+			Node& node = nodes[index];
+			node.bounds.unite(bounds);
+			++node.itemCount;
+			int next = -1;
+			for (int child : node.children)
+			{
+				if (child < 0)
+				{
+					continue;
+				}
+				const CullRect& cell = nodes[child].cell;
+				if (centreX >= cell.x1 && centreX < cell.x2 && centreY >= cell.y1 && centreY < cell.y2)
+				{
+					next = child;
+					break;
+				}
+			}
+			if (next < 0)
+			{
+				break;
+			}
+			index = next;
+		}
+		nodes[index].items.emplace_back(item, bounds);
+		itemLeaf[item] = index;
+	}
+
+	/// Returns false if `item` was not in the tree.
+	bool remove(const Item& item)
+	{
+		auto it = itemLeaf.find(item);
+		if (it == itemLeaf.end())
+		{
+			return false;
+		}
+		int index = it->second;
+		itemLeaf.erase(it);
+
+		auto& items = nodes[index].items;
+		auto found = std::find_if(items.begin(), items.end(), [&item](const std::pair<Item, CullRect>& entry) { return entry.first == item; });
+		if (found != items.end())
+		{
+			*found = std::move(items.back());
+			items.pop_back();
+		}
+
+		// Shrink the bounds on the way up, so destroyed bases stop costing node tests
+		for (; index >= 0; index = nodes[index].parent)
+		{
+			Node& node = nodes[index];
+			--node.itemCount;
+			node.bounds = CullRect();
+			for (const auto& entry : node.items)
+			{
+				node.bounds.unite(entry.second);
+			}
+			for (int child : node.children)
+			{
+				if (child >= 0)
+				{
+					node.bounds.unite(nodes[child].bounds);
+				}
+			}
+		}
+		return true;
+	}
+
+	bool contains(const Item& item) const { return itemLeaf.count(item) != 0; }
+	size_t size() const { return itemLeaf.size(); }
+	int width() const { return treeWidth; }
+	int height() const { return treeHeight; }
+
+	/// Calls `visit(item, fullyInside)` for every item below a node that `test(nodeBounds)` does not reject.
+	/// `fullyInside` is true if some node above the item was entirely inside the view, so the item itself can
+	/// be assumed visible as far as `test` is concerned.
+	template <typename TestFunc, typename VisitFunc>
+	void query(const TestFunc& test, const VisitFunc& visit, CullStats& stats) const
+	{
+		if (!nodes.empty())
+		{
+			queryNode(0, false, test, visit, stats);
+		}
+	}
+
+private:
+	struct Node
+	{
+		CullRect cell;                                ///< the part of the map this node covers
+		CullRect bounds;                              ///< union of the bounds of all items below
+		size_t itemCount = 0;                         ///< number of items below
+		int parent = -1;
+		std::array<int, 4> children = {-1, -1, -1, -1};
+		std::vector<std::pair<Item, CullRect>> items; ///< only used by leaves
+	};
+
+	int build(const CullRect& cell, int parent, int leafSize)
+	{
+		const int index = static_cast<int>(nodes.size());
+		nodes.emplace_back();
+		nodes[index].cell = cell;
+		nodes[index].parent = parent;
+
+		const int w = cell.x2 - cell.x1;
+		const int h = cell.y2 - cell.y1;
+		if (w <= leafSize && h <= leafSize)
+		{
+			return index;
+		}
+		const int midX = (w > leafSize) ? cell.x1 + w / 2 : cell.x2;
+		const int midY = (h > leafSize) ? cell.y1 + h / 2 : cell.y2;
+		const CullRect quadrants[4] = {
+			{cell.x1, cell.y1, midX, midY},
+			{midX, cell.y1, cell.x2, midY},
+			{cell.x1, midY, midX, cell.y2},
+			{midX, midY, cell.x2, cell.y2},
+		};
+		for (size_t i = 0; i < 4; ++i)
+		{
+			if (!quadrants[i].empty())
+			{
+				const int child = build(quadrants[i], index, leafSize);
+				nodes[index].children[i] = child; // not a reference: build() grows `nodes`
+			}
+		}
+		return index;
+	}
+
+	template <typename TestFunc, typename VisitFunc>
+	void queryNode(int index, bool inside, const TestFunc& test, const VisitFunc& visit, CullStats& stats) const
+	{
+		const Node& node = nodes[index];
+		if (node.itemCount == 0)
+		{
+			return;
+		}
+		if (!inside)
+		{
+			++stats.nodesTested;
+			const CullResult result = test(node.bounds);
+			if (result == CullResult::Outside)
+			{
+				++stats.nodesRejected;
+				return;
+			}
+			inside = (result == CullResult::Inside);
+		}
+		for (const auto& entry : node.items)
+		{
+			++stats.itemsVisited;
+			visit(entry.first, inside);
+		}
+		for (int child : node.children)
+		{
+			if (child >= 0)
+			{
+				queryNode(child, inside, test, visit, stats);
+			}
+		}
+	}
+
+	std::vector<Node> nodes;
+	std::unordered_map<Item, int> itemLeaf;
+	int treeWidth = 0;
+	int treeHeight = 0;
+};
@@ -344,7 +344,7 @@ gfx_api::texture* gfx_api::context::loadTextureFromFile(const char *filename, gf
 	}
 }
 
-static inline bool uncompressedPNGImageConvertChannels(iV_Image& image, gfx_api::pixel_format_target target, gfx_api::texture_type textureType, const std::string& filename)
+static inline bool uncompressedPNGImageConvertChannels(iV_Image& image, gfx_api::pixel_format_target target, gfx_api::texture_type textureType, const std::string& filename, optional<gfx_api::pixel_format> uncompressedFormat)
 {
 	// 1.) Convert to expected # of channels based on textureType
 	switch (textureType)
@@ -378,7 +378,11 @@ static inline bool uncompressedPNGImageConvertChannels(iV_Image& image, gfx_api:
 		{
 			if (image.channels() > 3)
 			{
-				if (gfx_api::context::get().textureFormatIsSupported(target, gfx_api::pixel_format::FORMAT_RGB8_UNORM_PACK8, gfx_api::pixel_format_usage::flags::sampled_image))
+				if (!uncompressedFormat.has_value())
+				{
+					uncompressedFormat = gfx_api::context::get().bestUncompressedPixelFormat(target, textureType);
+				}
+				if (uncompressedFormat.value() == gfx_api::pixel_format::FORMAT_RGB8_UNORM_PACK8)
 				{
 					image.convert_channels({0,1,2}); // convert to RGB (which is supported)
 				}
@@ -411,7 +415,7 @@ static bool checkFormatVersusMaxCompressionLevel_FromUncompressed(optional<gfx_a
 gfx_api::texture* gfx_api::context::loadTextureFromUncompressedImage(iV_Image&& image, gfx_api::texture_type textureType, const std::string& filename, int maxWidth /*= -1*/, int maxHeight /*= -1*/)
 {
 	// 1.) Convert to expected # of channels based on textureType
-	if (!uncompressedPNGImageConvertChannels(image, gfx_api::pixel_format_target::texture_2d, textureType, filename))
+	if (!uncompressedPNGImageConvertChannels(image, gfx_api::pixel_format_target::texture_2d, textureType, filename, nullopt))
 	{
 		return nullptr;
 	}
@@ -499,7 +503,7 @@ gfx_api::texture* gfx_api::context::loadTextureFromUncompressedImage(iV_Image&&
 	return pTexture.release();
 }
 
-std::unique_ptr<iV_Image> gfx_api::loadUncompressedImageFromFile(const char *filename, gfx_api::pixel_format_target target, gfx_api::texture_type textureType, int maxWidth /*= -1*/, int maxHeight /*= -1*/, bool forceRGBA8 /*= false*/)
+std::unique_ptr<iV_Image> gfx_api::loadUncompressedImageFromFile(const char *filename, gfx_api::pixel_format_target target, gfx_api::texture_type textureType, int maxWidth /*= -1*/, int maxHeight /*= -1*/, bool forceRGBA8 /*= false*/, optional<gfx_api::pixel_format> uncompressedFormat /*= nullopt*/)
 {
 	auto imageLoadFilename = imageLoadFilenameFromInputFilename(filename);
 	std::unique_ptr<iV_Image> loadedUncompressedImage;
@@ -507,7 +511,7 @@ std::unique_ptr<iV_Image> gfx_api::loadUncompressedImageFromFile(const char *fil
 #if defined(BASIS_ENABLED)
 	if (imageLoadFilename.endsWith(".ktx2"))
 	{
-		loadedUncompressedImage = gfx_api::loadUncompressedImageFromFile_KTX2(imageLoadFilename.toUtf8(), textureType, target, maxWidth, maxHeight);
+		loadedUncompressedImage = gfx_api::loadUncompressedImageFromFile_KTX2(imageLoadFilename.toUtf8(), textureType, target, maxWidth, maxHeight, uncompressedFormat);
 		if (!loadedUncompressedImage)
 		{
 			// Failed to load the image
@@ -530,7 +534,7 @@ std::unique_ptr<iV_Image> gfx_api::loadUncompressedImageFromFile(const char *fil
 			return nullptr;
 		}
 		// Convert to expected # of channels based on textureType (if forceRGBA8 is not set)
-		if (!forceRGBA8 && !uncompressedPNGImageConvertChannels(*loadedUncompressedImage, target, textureType, imageLoadFilename.toUtf8()))
+		if (!forceRGBA8 && !uncompressedPNGImageConvertChannels(*loadedUncompressedImage, target, textureType, imageLoadFilename.toUtf8(), uncompressedFormat))
 		{
 			return nullptr;
 		}
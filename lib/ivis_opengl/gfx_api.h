@@ -676,7 +676,8 @@ namespace gfx_api
 	};
 
 	// High-level API for getting an uncompressed image (iV_Image) from a file
-	std::unique_ptr<iV_Image> loadUncompressedImageFromFile(const char *filename, gfx_api::pixel_format_target target, gfx_api::texture_type textureType, int maxWidth = -1, int maxHeight = -1, bool forceRGBA8 = false);
+	// If uncompressedFormat (the result of context::bestUncompressedPixelFormat for target + textureType) is passed, the context is not queried, so the call is safe off the main thread
+	std::unique_ptr<iV_Image> loadUncompressedImageFromFile(const char *filename, gfx_api::pixel_format_target target, gfx_api::texture_type textureType, int maxWidth = -1, int maxHeight = -1, bool forceRGBA8 = false, optional<gfx_api::pixel_format> uncompressedFormat = nullopt);
 
 	WzString imageLoadFilenameFromInputFilename(const WzString& filename);
 	bool checkImageFilesWouldLoadFromSameParentMountPath(const std::vector<WzString>& filenames, bool ignoreNotFound);
@@ -1569,6 +1570,28 @@ namespace gfx_api
 		>
 	>, notexture, SHADER_RECT_INSTANCED>;
 
+	template<>
+	struct constant_buffer_type<SHADER_IMAGE_INSTANCED>
+	{
+		glm::mat4 ProjectionMatrix;
+	};
+
+	// same per-instance layout as BoxFillPSO_Instanced, offset_scale holding the texture coordinates
+	using DrawImagePSO_Instanced = typename gfx_api::pipeline_state_helper<rasterizer_state<REND_ALPHA, DEPTH_CMP_ALWAYS_WRT_OFF, 255, polygon_offset::disabled, stencil_mode::stencil_disabled, cull_mode::back>, primitive_type::triangle_strip, index_type::u16,
+	std::tuple<constant_buffer_type<SHADER_IMAGE_INSTANCED>>,
+	std::tuple<
+	vertex_buffer_description<4, gfx_api::vertex_attribute_input_rate::vertex, vertex_attribute_description<position, gfx_api::vertex_attribute_type::u8x4_norm, 0>>,
+	// instance data
+	vertex_buffer_description<sizeof(MultiRectPerInstanceInterleavedData), gfx_api::vertex_attribute_input_rate::instance,
+		vertex_attribute_description<instance_modelMatrix, gfx_api::vertex_attribute_type::float4, 0>,
+		vertex_attribute_description<instance_modelMatrix + 1, gfx_api::vertex_attribute_type::float4, sizeof(glm::vec4)>,
+		vertex_attribute_description<instance_modelMatrix + 2, gfx_api::vertex_attribute_type::float4, sizeof(glm::vec4)*2>,
+		vertex_attribute_description<instance_modelMatrix + 3, gfx_api::vertex_attribute_type::float4, sizeof(glm::vec4)*3>,
+		vertex_attribute_description<instance_packedValues, gfx_api::vertex_attribute_type::float4, offsetof(MultiRectPerInstanceInterleavedData, offset_scale)>,
+		vertex_attribute_description<instance_Colour, gfx_api::vertex_attribute_type::u8x4_norm, offsetof(MultiRectPerInstanceInterleavedData, colour)>
+		>
+	>, std::tuple<texture_description<0, sampler_type::bilinear>>, SHADER_IMAGE_INSTANCED>;
+
 	template<>
 	struct constant_buffer_type<SHADER_LINE>
 	{
@@ -1031,6 +1031,8 @@ static const std::map<SHADER_MODE, program_data> shader_to_file_table =
 		{ "transformationMatrix", "color" } }),
 	std::make_pair(SHADER_RECT_INSTANCED, program_data{ "Rect program", "shaders/rect_instanced.vert", "shaders/rect_instanced.frag",
 		{ "ProjectionMatrix" } }),
+	std::make_pair(SHADER_IMAGE_INSTANCED, program_data{ "Instanced image program", "shaders/rect_instanced.vert", "shaders/image_instanced.frag",
+		{ "ProjectionMatrix" } }),
 	std::make_pair(SHADER_TEXRECT, program_data{ "Textured rect program", "shaders/rect.vert", "shaders/texturedrect.frag",
 		{ "transformationMatrix", "tuv_offset", "tuv_scale", "color" } }),
 	std::make_pair(SHADER_GFX_COLOUR, program_data{ "gfx_color program", "shaders/gfx_color.vert", "shaders/gfx.frag",
@@ -1379,6 +1381,7 @@ desc(createInfo.state_desc), vertex_buffer_desc(createInfo.attribute_description
 		uniform_binding_entry<SHADER_SKYBOX>(),
 		uniform_binding_entry<SHADER_GENERIC_COLOR>(),
 		uniform_binding_entry<SHADER_RECT_INSTANCED>(),
+		uniform_binding_entry<SHADER_IMAGE_INSTANCED>(),
 		uniform_binding_entry<SHADER_LINE>(),
 		uniform_binding_entry<SHADER_TEXT>(),
 		uniform_binding_entry<SHADER_DEBUG_TEXTURE2D_QUAD>(),
@@ -2505,6 +2508,11 @@ void gl_pipeline_state_object::set_constants(const gfx_api::constant_buffer_type
 	setUniforms(0, cbuf.ProjectionMatrix);
 }
 
+void gl_pipeline_state_object::set_constants(const gfx_api::constant_buffer_type<SHADER_IMAGE_INSTANCED>& cbuf)
+{
+	setUniforms(0, cbuf.ProjectionMatrix);
+}
+
 void gl_pipeline_state_object::set_constants(const gfx_api::constant_buffer_type<SHADER_LINE>& cbuf)
 {
 	setUniforms(0, cbuf.p0);
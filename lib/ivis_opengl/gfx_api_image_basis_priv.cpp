@@ -20,6 +20,7 @@
 #include "gfx_api_image_basis_priv.h"
 #include "gfx_api_image_compress_priv.h"
 #include "gfx_api.h"
+#include "gfx_api_texture_cache.h"
 #include "pietypes.h"
 
 #include "lib/framework/physfs_ext.h"
@@ -278,7 +279,8 @@ optional<gfx_api::pixel_format> gfx_api::getBestAvailableTranscodeFormatForBasis
 	return nullopt;
 }
 
-static bool iVImage_Basis_Convert_Channels(gfx_api::pixel_format_target target, gfx_api::texture_type textureType, std::unique_ptr<iV_Image>& uncompressedImage)
+// If uncompressedFormat (the best uncompressed format for target + textureType) is known, the gfx context is not queried (so this is safe off the main thread)
+static bool iVImage_Basis_Convert_Channels(gfx_api::pixel_format_target target, gfx_api::texture_type textureType, optional<gfx_api::pixel_format> uncompressedFormat, std::unique_ptr<iV_Image>& uncompressedImage)
 {
 	// Convert to expected # (and arrangement) of channels based on textureType
 	switch (textureType)
@@ -292,7 +294,10 @@ static bool iVImage_Basis_Convert_Channels(gfx_api::pixel_format_target target,
 			// TODO: the following must match how the build process encodes normal maps - currently, this assumes they are just encoded as RGBA (with no swizzling)
 			if (uncompressedImage->channels() > 3)
 			{
-				if (gfx_api::context::get().textureFormatIsSupported(target, gfx_api::pixel_format::FORMAT_RGB8_UNORM_PACK8, gfx_api::pixel_format_usage::flags::sampled_image))
+				const bool rgbSupported = (uncompressedFormat.has_value())
+					? uncompressedFormat.value() == gfx_api::pixel_format::FORMAT_RGB8_UNORM_PACK8
+					: gfx_api::context::get().textureFormatIsSupported(target, gfx_api::pixel_format::FORMAT_RGB8_UNORM_PACK8, gfx_api::pixel_format_usage::flags::sampled_image);
+				if (rgbSupported)
 				{
 					return uncompressedImage->convert_channels({0,1,2});
 				}
@@ -325,7 +330,7 @@ static bool checkFormatVersusMaxCompressionLevel_Basis(optional<gfx_api::max_tex
 // - normal_map: TODO
 // - specular_map: A compressed single-channel format, or R8 uncompressed
 // Pass `nullopt` to desiredFormat to use the "best available" format for the current system
-static std::vector<std::unique_ptr<iV_BaseImage>> loadiVImagesFromFile_Basis_Data(const void* pData, uint32_t dataSize, const std::string& filename, gfx_api::texture_type textureType, gfx_api::pixel_format_target target, optional<gfx_api::pixel_format> desiredFormat /*= nullopt*/, uint32_t maxWidth /*= UINT32_MAX*/, uint32_t maxHeight /*= UINT32_MAX*/, optional<size_t> maxMips = nullopt)
+static std::vector<std::unique_ptr<iV_BaseImage>> loadiVImagesFromFile_Basis_Data(const void* pData, uint32_t dataSize, const std::string& filename, gfx_api::texture_type textureType, gfx_api::pixel_format_target target, optional<gfx_api::pixel_format> desiredFormat /*= nullopt*/, uint32_t maxWidth /*= UINT32_MAX*/, uint32_t maxHeight /*= UINT32_MAX*/, optional<size_t> maxMips = nullopt, optional<gfx_api::pixel_format> uncompressedFormat = nullopt)
 {
 	basist::ktx2_transcoder transcoder;
 	if (!transcoder.init(pData, dataSize))
@@ -342,6 +347,10 @@ static std::vector<std::unique_ptr<iV_BaseImage>> loadiVImagesFromFile_Basis_Dat
 
 	auto format = basist::transcoder_texture_format::cTFRGBA32; // standard full uncompressed format
 	auto internalFormat = gfx_api::pixel_format::FORMAT_RGBA8_UNORM_PACK8;
+	if (!uncompressedFormat.has_value() && desiredFormat.has_value() && gfx_api::is_uncompressed_format(desiredFormat.value()))
+	{
+		uncompressedFormat = desiredFormat;
+	}
 	if (!desiredFormat.has_value())
 	{
 		desiredFormat = getBestAvailableTranscodeFormatForBasisFile(target, transcoder.get_dfd_channel_id0(), transcoder.get_dfd_transfer_func(), textureType);
@@ -452,7 +461,7 @@ static std::vector<std::unique_ptr<iV_BaseImage>> loadiVImagesFromFile_Basis_Dat
 		if (basist::basis_transcoder_format_is_uncompressed(format))
 		{
 			// Convert to expected # (and arrangement) of channels based on textureType
-			iVImage_Basis_Convert_Channels(target, textureType, uncompressedOutput);
+			iVImage_Basis_Convert_Channels(target, textureType, uncompressedFormat, uncompressedOutput);
 			if (desiredFormat.has_value())
 			{
 				ASSERT(uncompressedOutput->pixel_format() == desiredFormat.value(), "Input desiredFormat (%d) does not match converted output format (%d)", static_cast<int>(desiredFormat.value()), static_cast<int>(uncompressedOutput->pixel_format()));
@@ -477,7 +486,7 @@ static std::vector<std::unique_ptr<iV_BaseImage>> loadiVImagesFromFile_Basis_Dat
 }
 
 // Returns an iV_BaseImage for each mipLevel in a basis file, in the desiredFormat (if supported by the basis transcoder)
-static std::vector<std::unique_ptr<iV_BaseImage>> loadiVImagesFromFile_Basis_internal(const std::string& filename, gfx_api::texture_type textureType, gfx_api::pixel_format_target target,  optional<gfx_api::pixel_format> desiredFormat /*= nullopt*/, uint32_t maxWidth /*= UINT32_MAX*/, uint32_t maxHeight /*= UINT32_MAX*/, optional<size_t> maxMips)
+static std::vector<std::unique_ptr<iV_BaseImage>> loadiVImagesFromFile_Basis_internal(const std::string& filename, gfx_api::texture_type textureType, gfx_api::pixel_format_target target,  optional<gfx_api::pixel_format> desiredFormat /*= nullopt*/, uint32_t maxWidth /*= UINT32_MAX*/, uint32_t maxHeight /*= UINT32_MAX*/, optional<size_t> maxMips, optional<gfx_api::pixel_format> uncompressedFormat = nullopt)
 {
 	PHYSFS_file	*fp = PHYSFS_openRead(filename.c_str());
 	debug(LOG_3D, "Reading...[directory: %s] %s", PHYSFS_getRealDir(filename.c_str()), filename.c_str());
@@ -494,13 +503,19 @@ static std::vector<std::unique_ptr<iV_BaseImage>> loadiVImagesFromFile_Basis_int
 		return {};
 	}
 	PHYSFS_close(fp);
-	return loadiVImagesFromFile_Basis_Data(buffer.data(), static_cast<uint32_t>(filesize), filename, textureType, target, desiredFormat, maxWidth, maxHeight, maxMips);
+	return loadiVImagesFromFile_Basis_Data(buffer.data(), static_cast<uint32_t>(filesize), filename, textureType, target, desiredFormat, maxWidth, maxHeight, maxMips, uncompressedFormat);
 }
 
 // Returns an iV_BaseImage for each mipLevel in a basis file, in the desiredFormat (if supported by the basis transcoder)
-std::vector<std::unique_ptr<iV_BaseImage>> gfx_api::loadiVImagesFromFile_Basis(const std::string& filename, gfx_api::texture_type textureType, gfx_api::pixel_format_target target, optional<gfx_api::pixel_format> desiredFormat /*= nullopt*/, uint32_t maxWidth /*= UINT32_MAX*/, uint32_t maxHeight /*= UINT32_MAX*/)
+std::vector<std::unique_ptr<iV_BaseImage>> gfx_api::loadiVImagesFromFile_Basis(const std::string& filename, gfx_api::texture_type textureType, gfx_api::pixel_format_target target, optional<gfx_api::pixel_format> desiredFormat /*= nullopt*/, uint32_t maxWidth /*= UINT32_MAX*/, uint32_t maxHeight /*= UINT32_MAX*/, optional<gfx_api::pixel_format> uncompressedFormat /*= nullopt*/)
+{
+	return loadiVImagesFromFile_Basis_internal(filename, textureType, target, desiredFormat, maxWidth, maxHeight, nullopt, uncompressedFormat);
+}
+
+std::vector<std::unique_ptr<iV_BaseImage>> gfx_api::loadiVImagesFromMemory_Basis(const void* pData, size_t dataSize, const std::string& filename, gfx_api::texture_type textureType, gfx_api::pixel_format_target target, optional<gfx_api::pixel_format> desiredFormat /*= nullopt*/, uint32_t maxWidth /*= UINT32_MAX*/, uint32_t maxHeight /*= UINT32_MAX*/, optional<gfx_api::pixel_format> uncompressedFormat /*= nullopt*/)
 {
-	return loadiVImagesFromFile_Basis_internal(filename, textureType, target, desiredFormat, maxWidth, maxHeight, nullopt);
+	ASSERT_OR_RETURN({}, dataSize < static_cast<size_t>(std::numeric_limits<uint32_t>::max()), "\"%s\" filesize >= std::numeric_limits<uint32_t>::max()", filename.c_str());
+	return loadiVImagesFromFile_Basis_Data(pData, static_cast<uint32_t>(dataSize), filename, textureType, target, desiredFormat, maxWidth, maxHeight, nullopt, uncompressedFormat);
 }
 
 gfx_api::texture* gfx_api::loadImageTextureFromFile_KTX2(const std::string& filename, gfx_api::texture_type textureType, int maxWidth /*= -1*/, int maxHeight /*= -1*/)
@@ -508,12 +523,28 @@ gfx_api::texture* gfx_api::loadImageTextureFromFile_KTX2(const std::string& file
 	uint32_t maxWidth_u32 = (maxWidth > 0) ? static_cast<uint32_t>(maxWidth) : UINT32_MAX;
 	uint32_t maxHeight_u32 = (maxHeight > 0) ? static_cast<uint32_t>(maxHeight) : UINT32_MAX;
 
-	auto images = gfx_api::loadiVImagesFromFile_Basis(filename.c_str(), textureType, gfx_api::pixel_format_target::texture_2d, nullopt /* auto-detect best possible format */, maxWidth_u32, maxHeight_u32);
+	// Model pages are transcoded to the same levels on every start, so go through the texture cache
+	gfx_api::TextureCacheKey cacheKey;
+	std::vector<char> fileData;
+	ASSERT_OR_RETURN(nullptr, gfx_api::textureCacheHashFile(filename, cacheKey, fileData), "Could not open %s", filename.c_str());
+	cacheKey.backendFormats = gfx_api::textureCacheBackendFormats(gfx_api::pixel_format_target::texture_2d);
+	cacheKey.textureType = textureType;
+	cacheKey.target = gfx_api::pixel_format_target::texture_2d;
+	cacheKey.maxWidth = std::max(maxWidth, 0);
+	cacheKey.maxHeight = std::max(maxHeight, 0);
+	bool produced = false;
+	auto images = gfx_api::textureCacheLoadOrProduce(cacheKey, [&]() {
+		return gfx_api::loadiVImagesFromMemory_Basis(fileData.data(), fileData.size(), filename, textureType, gfx_api::pixel_format_target::texture_2d, nullopt /* auto-detect best possible format */, maxWidth_u32, maxHeight_u32);
+	}, produced);
 	if (images.empty())
 	{
 		// Failed to load
 		return nullptr;
 	}
+	if (produced)
+	{
+		gfx_api::textureCacheStore(cacheKey, images, filename);
+	}
 
 	// Create a new compatible gpu texture object
 	size_t mipmap_levels = images.size();
@@ -537,12 +568,16 @@ gfx_api::texture* gfx_api::loadImageTextureFromFile_KTX2(const std::string& file
 	return pTexture.release();
 }
 
-std::unique_ptr<iV_Image> gfx_api::loadUncompressedImageFromFile_KTX2(const std::string& filename, gfx_api::texture_type textureType, gfx_api::pixel_format_target target, int maxWidth /*= -1*/, int maxHeight /*= -1*/)
+std::unique_ptr<iV_Image> gfx_api::loadUncompressedImageFromFile_KTX2(const std::string& filename, gfx_api::texture_type textureType, gfx_api::pixel_format_target target, int maxWidth /*= -1*/, int maxHeight /*= -1*/, optional<gfx_api::pixel_format> uncompressedFormat /*= nullopt*/)
 {
 	uint32_t maxWidth_u32 = (maxWidth > 0) ? static_cast<uint32_t>(maxWidth) : UINT32_MAX;
 	uint32_t maxHeight_u32 = (maxHeight > 0) ? static_cast<uint32_t>(maxHeight) : UINT32_MAX;
 
-	auto images = loadiVImagesFromFile_Basis_internal(filename.c_str(), textureType, target, WZ_BASIS_UNCOMPRESSED_FORMAT, maxWidth_u32, maxHeight_u32, 1);
+	if (!uncompressedFormat.has_value())
+	{
+		uncompressedFormat = gfx_api::context::get().bestUncompressedPixelFormat(target, textureType);
+	}
+	auto images = loadiVImagesFromFile_Basis_internal(filename.c_str(), textureType, target, uncompressedFormat.value(), maxWidth_u32, maxHeight_u32, 1);
 	if (images.empty())
 	{
 		// Failed to load
@@ -39,8 +39,12 @@ namespace gfx_api
 
 	optional<gfx_api::pixel_format> getBestAvailableTranscodeFormatForBasis(gfx_api::pixel_format_target target, gfx_api::texture_type textureType);
 
-	std::vector<std::unique_ptr<iV_BaseImage>> loadiVImagesFromFile_Basis(const std::string& filename, gfx_api::texture_type textureType, gfx_api::pixel_format_target target,  optional<gfx_api::pixel_format> desiredFormat = nullopt, uint32_t maxWidth = UINT32_MAX, uint32_t maxHeight = UINT32_MAX);
+	// uncompressedFormat: the best uncompressed format for target + textureType, used when a file is transcoded uncompressed.
+	// If it is passed (or desiredFormat is uncompressed) the gfx context is not queried, so loading is safe off the main thread.
+	std::vector<std::unique_ptr<iV_BaseImage>> loadiVImagesFromFile_Basis(const std::string& filename, gfx_api::texture_type textureType, gfx_api::pixel_format_target target,  optional<gfx_api::pixel_format> desiredFormat = nullopt, uint32_t maxWidth = UINT32_MAX, uint32_t maxHeight = UINT32_MAX, optional<gfx_api::pixel_format> uncompressedFormat = nullopt);
+	// As loadiVImagesFromFile_Basis, for a file that has already been read into memory (`filename` is only used for messages)
+	std::vector<std::unique_ptr<iV_BaseImage>> loadiVImagesFromMemory_Basis(const void* pData, size_t dataSize, const std::string& filename, gfx_api::texture_type textureType, gfx_api::pixel_format_target target,  optional<gfx_api::pixel_format> desiredFormat = nullopt, uint32_t maxWidth = UINT32_MAX, uint32_t maxHeight = UINT32_MAX, optional<gfx_api::pixel_format> uncompressedFormat = nullopt);
 
 	gfx_api::texture* loadImageTextureFromFile_KTX2(const std::string& filename, gfx_api::texture_type textureType, int maxWidth = -1, int maxHeight = -1);
-	std::unique_ptr<iV_Image> loadUncompressedImageFromFile_KTX2(const std::string& filename, gfx_api::texture_type textureType, gfx_api::pixel_format_target target, int maxWidth = -1, int maxHeight = -1);
+	std::unique_ptr<iV_Image> loadUncompressedImageFromFile_KTX2(const std::string& filename, gfx_api::texture_type textureType, gfx_api::pixel_format_target target, int maxWidth = -1, int maxHeight = -1, optional<gfx_api::pixel_format> uncompressedFormat = nullopt);
 }
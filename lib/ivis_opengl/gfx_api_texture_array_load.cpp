@@ -26,6 +26,7 @@
 #include "gfx_api_image_basis_priv.h"
 #include "gfx_api_image_compress_priv.h"
 #include "gfx_api_mipmap_priv.h"
+#include "gfx_api_texture_cache.h"
 
 #include "lib/framework/loading_task.h"
 #include "lib/framework/resource_loading_controller.h"
@@ -43,13 +44,15 @@ void pumpBlockingResourceLoadWithoutUI(const ResourceLoadingController::FramePol
 	audio_Update();
 }
 
-std::vector<std::unique_ptr<iV_BaseImage>> loadUncompressedImageWithMips(const std::string& imageLoadFilename, gfx_api::texture_type textureType, int maxWidth, int maxHeight, bool forceRGBA8)
+// uncompressedFormat is the context's bestUncompressedPixelFormat() for textureType, resolved by the caller on the main thread
+std::vector<std::unique_ptr<iV_BaseImage>> loadUncompressedImageWithMips(const std::string& imageLoadFilename, gfx_api::texture_type textureType, gfx_api::pixel_format uncompressedFormat, int maxWidth, int maxHeight, bool forceRGBA8)
 {
 	std::vector<std::unique_ptr<iV_BaseImage>> results;
 #if defined(BASIS_ENABLED)
 	if (strEndsWith(imageLoadFilename, ".ktx2"))
 	{
-		results = gfx_api::loadiVImagesFromFile_Basis(imageLoadFilename, textureType, gfx_api::pixel_format_target::texture_2d_array, (forceRGBA8) ? WZ_BASIS_UNCOMPRESSED_FORMAT : gfx_api::context::get().bestUncompressedPixelFormat(gfx_api::pixel_format_target::texture_2d_array, textureType), std::max(0, maxWidth), std::max(0, maxHeight));
+		const gfx_api::pixel_format extractionFormat = (forceRGBA8) ? WZ_BASIS_UNCOMPRESSED_FORMAT : uncompressedFormat;
+		results = gfx_api::loadiVImagesFromFile_Basis(imageLoadFilename, textureType, gfx_api::pixel_format_target::texture_2d_array, extractionFormat, std::max(0, maxWidth), std::max(0, maxHeight), extractionFormat);
 
 		if (forceRGBA8)
 		{
@@ -71,7 +74,7 @@ std::vector<std::unique_ptr<iV_BaseImage>> loadUncompressedImageWithMips(const s
 #endif
 	if (strEndsWith(imageLoadFilename, ".png"))
 	{
-		auto pCurrentImage = gfx_api::loadUncompressedImageFromFile(imageLoadFilename.c_str(), gfx_api::pixel_format_target::texture_2d_array, textureType, maxWidth, maxHeight, forceRGBA8);
+		auto pCurrentImage = gfx_api::loadUncompressedImageFromFile(imageLoadFilename.c_str(), gfx_api::pixel_format_target::texture_2d_array, textureType, maxWidth, maxHeight, forceRGBA8, uncompressedFormat);
 		if (!pCurrentImage)
 		{
 			debug(LOG_ERROR, "Unable to load image file: %s", imageLoadFilename.c_str());
@@ -101,8 +104,11 @@ struct TextureArrayLoadContext
 	const std::string& debugName;
 
 	gfx_api::pixel_format uploadFormat = gfx_api::pixel_format::invalid;
+	gfx_api::pixel_format uncompressedFormat = gfx_api::pixel_format::invalid; ///< bestUncompressedPixelFormat(), resolved on the main thread for the decode workers
 	gfx_api::pixel_format desiredImageExtractionFormat = gfx_api::pixel_format::invalid;
 	bool uncompressedExtractionFormat = false;
+	bool cacheLevels = false;          ///< uploadFormat is compressed, so layers go through the texture cache
+	uint64_t cacheBackendFormats = 0;  ///< see `gfx_api::textureCacheBackendFormats`
 	std::vector<std::unique_ptr<iV_BaseImage>> defaultTextureMips = {};
 
 	std::unique_ptr<gfx_api::texture_array> texture_array = nullptr;
@@ -139,28 +145,98 @@ std::vector<std::unique_ptr<iV_BaseImage>>* getDefaultTextureMipsP(TextureArrayL
 	return &ctx.defaultTextureMips;
 }
 
-bool loadTextureArrayLayer(TextureArrayLoadContext& ctx, size_t layer)
+/// Result of decoding one layer's image file (see `decodeTextureArrayLayer`).
+struct DecodedTextureArrayLayer
+{
+	std::vector<std::unique_ptr<iV_BaseImage>> images;
+	bool useDefaultTexture = false; ///< no file, or an uncompressed load that failed
+	bool failed = false;            ///< unsupported file type
+	bool uploadReady = false;       ///< `images` are already in the upload format
+	bool storeInCache = false;      ///< `images` were produced rather than read from the texture cache
+	gfx_api::TextureCacheKey cacheKey;
+};
+
+// Produces a layer's levels in the upload format, looking them up in the texture cache first. Leaves
+// `decoded.images` empty on failure, so the caller can fall back to the uncompressed path. Only reads the
+// cache; levels it had to produce are stored by `uploadTextureArrayLayer`. Thread-safe.
+void loadCachedTextureArrayLayerLevels(const TextureArrayLoadContext& ctx, const std::string& imageLoadFilename, DecodedTextureArrayLayer& decoded)
+{
+	gfx_api::TextureCacheKey& cacheKey = decoded.cacheKey;
+	std::vector<char> fileData;
+	if (!gfx_api::textureCacheHashFile(imageLoadFilename, cacheKey, fileData))
+	{
+		return;
+	}
+	cacheKey.backendFormats = ctx.cacheBackendFormats;
+	cacheKey.requestedFormat = ctx.uploadFormat;
+	cacheKey.textureType = ctx.textureType;
+	cacheKey.target = gfx_api::pixel_format_target::texture_2d_array;
+	cacheKey.maxWidth = std::max(ctx.maxWidth, 0);
+	cacheKey.maxHeight = std::max(ctx.maxHeight, 0);
+
+	bool produced = false;
+	auto levels = gfx_api::textureCacheLoadOrProduce(cacheKey, [&]() -> std::vector<std::unique_ptr<iV_BaseImage>> {
+		if (!ctx.uncompressedExtractionFormat)
+		{
+#if defined(BASIS_ENABLED)
+			return gfx_api::loadiVImagesFromMemory_Basis(fileData.data(), fileData.size(), imageLoadFilename, ctx.textureType, gfx_api::pixel_format_target::texture_2d_array, ctx.desiredImageExtractionFormat, std::max(0, ctx.maxWidth), std::max(0, ctx.maxHeight), ctx.uncompressedFormat);
+#else
+			return {};
+#endif
+		}
+		auto uncompressedLevels = loadUncompressedImageWithMips(imageLoadFilename, ctx.textureType, ctx.uncompressedFormat, ctx.maxWidth, ctx.maxHeight, ctx.desiredImageExtractionFormat == gfx_api::pixel_format::FORMAT_RGBA8_UNORM_PACK8);
+		std::vector<std::unique_ptr<iV_BaseImage>> compressedLevels;
+		for (const auto& level : uncompressedLevels)
+		{
+			const iV_Image* image = dynamic_cast<iV_Image*>(level.get());
+			auto compressedImage = (image) ? gfx_api::compressImage(*image, ctx.uploadFormat) : nullptr;
+			if (!compressedImage)
+			{
+				return {};
+			}
+			compressedLevels.push_back(std::move(compressedImage));
+		}
+		return compressedLevels;
+	}, produced);
+
+	for (const auto& level : levels)
+	{
+		if (level->pixel_format() != ctx.uploadFormat)
+		{
+			return;
+		}
+	}
+	decoded.images = std::move(levels);
+	decoded.storeInCache = produced;
+}
+
+// Only reads from `ctx` and the filesystem, so it can run on a loading worker thread.
+DecodedTextureArrayLayer decodeTextureArrayLayer(const TextureArrayLoadContext& ctx, size_t layer)
 {
 	const WzString& imageLoadFilename = ctx.imageLoadFilenames[layer];
 
-	std::vector<std::unique_ptr<iV_BaseImage>> loadedImagesForLayer;
-	std::vector<std::unique_ptr<iV_BaseImage>>* pImagesForLayer = nullptr;
+	DecodedTextureArrayLayer decoded;
+	if (ctx.cacheLevels && !imageLoadFilename.isEmpty())
+	{
+		loadCachedTextureArrayLayerLevels(ctx, imageLoadFilename.toUtf8(), decoded);
+		if (!decoded.images.empty())
+		{
+			decoded.uploadReady = true;
+			return decoded;
+		}
+	}
+
 	if (imageLoadFilename.isEmpty())
 	{
-		pImagesForLayer = getDefaultTextureMipsP(ctx, layer, ctx.width, ctx.height, ctx.mipmap_levels, ctx.desiredImageExtractionFormat);
-		ASSERT_OR_RETURN(false, pImagesForLayer != nullptr, "Failed to generate matching default texture");
+		decoded.useDefaultTexture = true;
 	}
 	else if (ctx.uncompressedExtractionFormat || imageLoadFilename.endsWith(".png"))
 	{
-		loadedImagesForLayer = loadUncompressedImageWithMips(imageLoadFilename.toUtf8(), ctx.textureType, ctx.maxWidth, ctx.maxHeight, ctx.desiredImageExtractionFormat == gfx_api::pixel_format::FORMAT_RGBA8_UNORM_PACK8);
-		if (!loadedImagesForLayer.empty())
-		{
-			pImagesForLayer = &loadedImagesForLayer;
-		}
-		else
+		decoded.images = loadUncompressedImageWithMips(imageLoadFilename.toUtf8(), ctx.textureType, ctx.uncompressedFormat, ctx.maxWidth, ctx.maxHeight, ctx.desiredImageExtractionFormat == gfx_api::pixel_format::FORMAT_RGBA8_UNORM_PACK8);
+		if (decoded.images.empty())
 		{
 			debug(LOG_INFO, "Using default texture generator for failed image: %s", imageLoadFilename.toUtf8().c_str());
-			pImagesForLayer = getDefaultTextureMipsP(ctx, layer, ctx.width, ctx.height, ctx.mipmap_levels, ctx.desiredImageExtractionFormat);
+			decoded.useDefaultTexture = true;
 		}
 	}
 	else
@@ -168,16 +244,38 @@ bool loadTextureArrayLayer(TextureArrayLoadContext& ctx, size_t layer)
 #if defined(BASIS_ENABLED)
 		if (imageLoadFilename.endsWith(".ktx2"))
 		{
-			loadedImagesForLayer = gfx_api::loadiVImagesFromFile_Basis(imageLoadFilename.toUtf8(), ctx.textureType, gfx_api::pixel_format_target::texture_2d_array, ctx.desiredImageExtractionFormat, std::max(0, ctx.maxWidth), std::max(0, ctx.maxHeight));
-			pImagesForLayer = &loadedImagesForLayer;
+			decoded.images = gfx_api::loadiVImagesFromFile_Basis(imageLoadFilename.toUtf8(), ctx.textureType, gfx_api::pixel_format_target::texture_2d_array, ctx.desiredImageExtractionFormat, std::max(0, ctx.maxWidth), std::max(0, ctx.maxHeight), ctx.uncompressedFormat);
 		}
 		else
 #endif
 		{
 			debug(LOG_ERROR, "Unable to load image file: %s", imageLoadFilename.toUtf8().c_str());
-			return false;
+			decoded.failed = true;
 		}
 	}
+	return decoded;
+}
+
+// Creates the texture array on layer 0 and uploads the decoded images. Main thread only.
+bool uploadTextureArrayLayer(TextureArrayLoadContext& ctx, size_t layer, DecodedTextureArrayLayer& decoded)
+{
+	const WzString& imageLoadFilename = ctx.imageLoadFilenames[layer];
+	if (decoded.failed)
+	{
+		return false;
+	}
+	if (decoded.storeInCache)
+	{
+		// Not done by the decoding workers, which must not write files
+		gfx_api::textureCacheStore(decoded.cacheKey, decoded.images, imageLoadFilename.toUtf8());
+	}
+
+	std::vector<std::unique_ptr<iV_BaseImage>>* pImagesForLayer = &decoded.images;
+	if (decoded.useDefaultTexture)
+	{
+		pImagesForLayer = getDefaultTextureMipsP(ctx, layer, ctx.width, ctx.height, ctx.mipmap_levels, ctx.desiredImageExtractionFormat);
+		ASSERT_OR_RETURN(false, pImagesForLayer != nullptr || !imageLoadFilename.isEmpty(), "Failed to generate matching default texture");
+	}
 
 	ASSERT_OR_RETURN(false, pImagesForLayer && !pImagesForLayer->empty(), "Unable to load images: %s", imageLoadFilename.toUtf8().c_str());
 
@@ -196,7 +294,7 @@ bool loadTextureArrayLayer(TextureArrayLoadContext& ctx, size_t layer)
 		ASSERT_OR_RETURN(false, pImagesForLayer->size() == ctx.mipmap_levels, "Unexpected number of mip levels (%zu; expected: %zu): %s", pImagesForLayer->size(), ctx.mipmap_levels, imageLoadFilename.toUtf8().c_str());
 	}
 
-	if (ctx.uploadFormat == ctx.desiredImageExtractionFormat)
+	if (ctx.uploadFormat == ctx.desiredImageExtractionFormat || (decoded.uploadReady && pImagesForLayer == &decoded.images))
 	{
 		bool uploadSuccess = gfx_api::context::get().loadTextureArrayLayerFromBaseImages(*ctx.texture_array, layer, *pImagesForLayer, imageLoadFilename.toUtf8(), ctx.width, ctx.height);
 		ASSERT_OR_RETURN(false, uploadSuccess, "Failed to loadTextureArrayLayerFromBaseImages");
@@ -219,6 +317,12 @@ bool loadTextureArrayLayer(TextureArrayLoadContext& ctx, size_t layer)
 	return true;
 }
 
+bool loadTextureArrayLayer(TextureArrayLoadContext& ctx, size_t layer)
+{
+	DecodedTextureArrayLayer decoded = decodeTextureArrayLayer(ctx, layer);
+	return uploadTextureArrayLayer(ctx, layer, decoded);
+}
+
 bool prepareTextureArrayLoadContext(TextureArrayLoadContext& ctx)
 {
 	ASSERT_OR_RETURN(false, ctx.imageLoadFilenames.size() <= gfx_api::context::get().get_context_value(gfx_api::context::context_value::MAX_ARRAY_TEXTURE_LAYERS), "Too many layers");
@@ -242,7 +346,8 @@ bool prepareTextureArrayLoadContext(TextureArrayLoadContext& ctx)
 	}
 #endif
 
-	ctx.uploadFormat = gfx_api::context::get().bestUncompressedPixelFormat(gfx_api::pixel_format_target::texture_2d_array, ctx.textureType);
+	ctx.uncompressedFormat = gfx_api::context::get().bestUncompressedPixelFormat(gfx_api::pixel_format_target::texture_2d_array, ctx.textureType);
+	ctx.uploadFormat = ctx.uncompressedFormat;
 	ctx.desiredImageExtractionFormat = ctx.uploadFormat;
 #if defined(BASIS_ENABLED)
 	if (allFilesAreKTX2)
@@ -270,6 +375,11 @@ bool prepareTextureArrayLoadContext(TextureArrayLoadContext& ctx)
 	}
 
 	ctx.uncompressedExtractionFormat = gfx_api::is_uncompressed_format(ctx.desiredImageExtractionFormat);
+	ctx.cacheLevels = !gfx_api::is_uncompressed_format(ctx.uploadFormat);
+	if (ctx.cacheLevels)
+	{
+		ctx.cacheBackendFormats = gfx_api::textureCacheBackendFormats(gfx_api::pixel_format_target::texture_2d_array);
+	}
 	return true;
 }
 
@@ -354,13 +464,34 @@ LoadingTask<gfx_api::texture_array*> gfx_api::context::loadTextureArrayFromFiles
 		co_return load_fail();
 	}
 
-	for (size_t layer = 0; layer < imageLoadFilenames.size(); ++layer)
+	// Decode up to one layer per worker in parallel, then upload that batch on the main thread.
+	// Batching bounds how many decoded layers (with all their mip levels) are held at once.
+	const size_t batchSize = std::max<size_t>(controller.workerCount(), 1);
+	std::vector<DecodedTextureArrayLayer> decodedLayers;
+	for (size_t firstLayer = 0; firstLayer < imageLoadFilenames.size(); firstLayer += batchSize)
 	{
-		if (!loadTextureArrayLayer(ctx, layer))
+		const size_t endLayer = std::min(firstLayer + batchSize, imageLoadFilenames.size());
+		decodedLayers.clear();
+		decodedLayers.resize(endLayer - firstLayer);
+
+		std::vector<ResourceLoadingController::WorkerJob> jobs;
+		jobs.reserve(endLayer - firstLayer);
+		for (size_t layer = firstLayer; layer < endLayer; ++layer)
 		{
-			co_return load_fail();
+			jobs.emplace_back([&ctx, &decodedLayers, firstLayer, layer]() {
+				decodedLayers[layer - firstLayer] = decodeTextureArrayLayer(ctx, layer);
+			});
+		}
+		co_await controller.runOnWorkers(std::move(jobs));
+
+		for (size_t layer = firstLayer; layer < endLayer; ++layer)
+		{
+			if (!uploadTextureArrayLayer(ctx, layer, decodedLayers[layer - firstLayer]))
+			{
+				co_return load_fail();
+			}
+			co_await controller.yieldFrame();
 		}
-		co_await controller.yieldFrame();
 	}
 
 	co_return load_ok(finishTextureArrayLoad(ctx));
@@ -0,0 +1,344 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+	This file is part of Warzone 2100.
+	Copyright (C) 2026  Warzone 2100 Project (https://github.com/Warzone2100)
+
+	Warzone 2100 is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	Warzone 2100 is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Warzone 2100; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+/** @file gfx_api_texture_cache.cpp
+ * Binary texture level cache (see gfx_api_texture_cache.h).
+ */
+
+#include "gfx_api_texture_cache.h"
+#include "gfx_api.h"
+#include "gfx_api_image_compress_priv.h"
+
+#include "lib/framework/frame.h"
+#include "lib/framework/file.h"
+#include "lib/framework/physfs_ext.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <type_traits>
+
+#define TEXTURE_CACHE_DIR "cache/textures"
+
+// Bump whenever the transcoders (basis, etcpak) or the layout below change.
+static constexpr uint32_t TEXTURE_CACHE_VERSION = 1;
+static constexpr char TEXTURE_CACHE_MAGIC[4] = {'W', 'Z', 'T', 'C'};
+
+// Upper bounds used to reject corrupt entries before allocating.
+static constexpr uint32_t TEXTURE_CACHE_MAX_LEVELS = 16;
+static constexpr uint32_t TEXTURE_CACHE_MAX_DIMENSION = 1 << 15;
+
+static_assert(std::is_trivially_copyable<Sha256>::value, "Sha256 must be trivially copyable");
+
+namespace
+{
+
+/// The key as stored at the start of an entry, and hashed for its file name.
+struct StoredKey
+{
+	Sha256 sourceHash;
+	uint64_t backendFormats = 0;
+	uint32_t requestedFormat = 0;
+	uint32_t textureType = 0;
+	uint32_t target = 0;
+	uint32_t maxWidth = 0;
+	uint32_t maxHeight = 0;
+	uint32_t padding = 0; ///< keeps the bytes that are hashed and compared defined
+
+	explicit StoredKey(const gfx_api::TextureCacheKey &key)
+		: sourceHash(key.sourceHash)
+		, backendFormats(key.backendFormats)
+		, requestedFormat(static_cast<uint32_t>(key.requestedFormat))
+		, textureType(static_cast<uint32_t>(key.textureType))
+		, target(static_cast<uint32_t>(key.target))
+		, maxWidth(key.maxWidth)
+		, maxHeight(key.maxHeight)
+	{ }
+
+	bool operator ==(const StoredKey &b) const
+	{
+		return sourceHash == b.sourceHash && backendFormats == b.backendFormats && requestedFormat == b.requestedFormat
+			&& textureType == b.textureType && target == b.target && maxWidth == b.maxWidth && maxHeight == b.maxHeight;
+	}
+};
+
+static_assert(sizeof(StoredKey) == Sha256::Bytes + 8 + 6 * 4, "StoredKey must not contain implicit padding");
+
+struct EntryHeader
+{
+	char magic[4] = {};
+	uint32_t version = 0;
+	uint32_t format = 0;
+	uint32_t levelCount = 0;
+};
+
+struct LevelHeader
+{
+	uint32_t width = 0;
+	uint32_t height = 0;
+	uint32_t bufferRowLength = 0;
+	uint32_t bufferImageHeight = 0;
+	uint64_t dataSize = 0;
+	uint32_t crc = 0;
+	uint32_t padding = 0;
+};
+
+struct AtomicStats
+{
+	std::atomic<uint32_t> hits{0};
+	std::atomic<uint32_t> misses{0};
+	std::atomic<uint64_t> hitMicroseconds{0};
+	std::atomic<uint64_t> missMicroseconds{0};
+	std::atomic<uint64_t> bytesRead{0};
+	std::atomic<uint64_t> bytesWritten{0};
+};
+
+AtomicStats cacheStats;
+std::once_flag cacheDirCreated;
+
+std::string cachePath(const StoredKey &key)
+{
+	// Hash the whole key: one source file may have entries for several formats or size limits
+	return std::string(TEXTURE_CACHE_DIR "/") + sha256Sum(&key, sizeof(key)).toString() + ".bin";
+}
+
+uint64_t microsecondsSince(std::chrono::steady_clock::time_point start)
+{
+	return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+}
+
+template <typename T>
+bool readValue(const char *&pos, const char *end, T &v)
+{
+	static_assert(std::is_trivially_copyable<T>::value, "only raw values can be read");
+	if (static_cast<size_t>(end - pos) < sizeof(T))
+	{
+		return false;
+	}
+	memcpy(&v, pos, sizeof(T));
+	pos += sizeof(T);
+	return true;
+}
+
+template <typename T>
+bool writeValue(PHYSFS_file *fileHandle, const T &v)
+{
+	static_assert(std::is_trivially_copyable<T>::value, "only raw values can be written");
+	return WZ_PHYSFS_writeBytes(fileHandle, &v, sizeof(T)) == static_cast<PHYSFS_sint64>(sizeof(T));
+}
+
+bool readEntry(const StoredKey &key, std::vector<std::unique_ptr<iV_BaseImage>> &levels)
+{
+	const std::string path = cachePath(key);
+	if (!PHYSFS_exists(path.c_str()))
+	{
+		return false;
+	}
+	std::vector<char> fileData;
+	if (!loadFileToBufferVector(path.c_str(), fileData, false, false))
+	{
+		return false;
+	}
+
+	const char *pos = fileData.data();
+	const char *end = pos + fileData.size();
+	EntryHeader header;
+	StoredKey storedKey = key;
+	if (!readValue(pos, end, header) || memcmp(header.magic, TEXTURE_CACHE_MAGIC, sizeof(header.magic)) != 0
+		|| header.version != TEXTURE_CACHE_VERSION
+		|| !readValue(pos, end, storedKey) || !(storedKey == key))
+	{
+		debug(LOG_3D, "Ignoring stale texture cache entry: %s", path.c_str());
+		return false;
+	}
+	const gfx_api::pixel_format format = static_cast<gfx_api::pixel_format>(header.format);
+	if (header.format == 0 || header.format > static_cast<uint32_t>(gfx_api::MAX_PIXEL_FORMAT) || gfx_api::is_uncompressed_format(format)
+		|| header.levelCount == 0 || header.levelCount > TEXTURE_CACHE_MAX_LEVELS)
+	{
+		debug(LOG_WARNING, "Ignoring corrupt texture cache entry: %s", path.c_str());
+		return false;
+	}
+
+	levels.clear();
+	for (uint32_t level = 0; level < header.levelCount; ++level)
+	{
+		LevelHeader levelHeader;
+		bool ok = readValue(pos, end, levelHeader)
+			&& levelHeader.width > 0 && levelHeader.width <= TEXTURE_CACHE_MAX_DIMENSION
+			&& levelHeader.height > 0 && levelHeader.height <= TEXTURE_CACHE_MAX_DIMENSION
+			&& levelHeader.dataSize >= gfx_api::format_memory_size(format, levelHeader.width, levelHeader.height)
+			&& static_cast<uint64_t>(end - pos) >= levelHeader.dataSize;
+		if (ok && level > 0)
+		{
+			// The uploaders expect a complete chain
+			ok = levelHeader.width == std::max(1u, levels[0]->width() >> level) && levelHeader.height == std::max(1u, levels[0]->height() >> level);
+		}
+		ok = ok && wz::crc_update(wz::crc_init(), pos, static_cast<size_t>(levelHeader.dataSize)) == levelHeader.crc;
+		auto image = std::make_unique<iV_CompressedImage>();
+		if (!ok || !image->allocate(format, static_cast<size_t>(levelHeader.dataSize), levelHeader.bufferRowLength, levelHeader.bufferImageHeight, levelHeader.width, levelHeader.height))
+		{
+			debug(LOG_WARNING, "Ignoring corrupt texture cache entry: %s", path.c_str());
+			levels.clear();
+			return false;
+		}
+		memcpy(image->uint64_w(), pos, static_cast<size_t>(levelHeader.dataSize));
+		pos += levelHeader.dataSize;
+		levels.push_back(std::move(image));
+	}
+	if (pos != end)
+	{
+		debug(LOG_WARNING, "Ignoring corrupt texture cache entry: %s", path.c_str());
+		levels.clear();
+		return false;
+	}
+	cacheStats.bytesRead += fileData.size();
+	return true;
+}
+
+bool writeEntry(const StoredKey &key, const std::vector<std::unique_ptr<iV_BaseImage>> &levels)
+{
+	if (levels.empty() || levels.size() > TEXTURE_CACHE_MAX_LEVELS)
+	{
+		return false;
+	}
+	const gfx_api::pixel_format format = levels.front()->pixel_format();
+	if (gfx_api::is_uncompressed_format(format) || format == gfx_api::pixel_format::invalid)
+	{
+		return false;
+	}
+	for (const auto &image : levels)
+	{
+		if (!image || image->pixel_format() != format || image->data() == nullptr)
+		{
+			return false;
+		}
+	}
+
+	std::call_once(cacheDirCreated, []() {
+		// Failure is handled below: the cache is an optimisation only
+		PHYSFS_mkdir(TEXTURE_CACHE_DIR);
+	});
+	const std::string path = cachePath(key);
+	PHYSFS_file *fileHandle = PHYSFS_openWrite(path.c_str());
+	if (!fileHandle)
+	{
+		debug(LOG_3D, "Unable to write texture cache entry %s: %s", path.c_str(), WZ_PHYSFS_getLastError());
+		return false;
+	}
+
+	EntryHeader header;
+	memcpy(header.magic, TEXTURE_CACHE_MAGIC, sizeof(header.magic));
+	header.version = TEXTURE_CACHE_VERSION;
+	header.format = static_cast<uint32_t>(format);
+	header.levelCount = static_cast<uint32_t>(levels.size());
+	bool written = writeValue(fileHandle, header) && writeValue(fileHandle, key);
+	uint64_t bytesWritten = sizeof(header) + sizeof(key);
+	for (size_t level = 0; written && level < levels.size(); ++level)
+	{
+		const iV_BaseImage &image = *levels[level];
+		LevelHeader levelHeader;
+		levelHeader.width = image.width();
+		levelHeader.height = image.height();
+		levelHeader.bufferRowLength = image.bufferRowLength();
+		levelHeader.bufferImageHeight = image.bufferImageHeight();
+		levelHeader.dataSize = image.data_size();
+		levelHeader.crc = wz::crc_update(wz::crc_init(), image.data(), image.data_size());
+		written = writeValue(fileHandle, levelHeader)
+			&& WZ_PHYSFS_writeBytes(fileHandle, image.data(), static_cast<PHYSFS_uint32>(image.data_size())) == static_cast<PHYSFS_sint64>(image.data_size());
+		bytesWritten += sizeof(levelHeader) + image.data_size();
+	}
+	PHYSFS_close(fileHandle);
+	if (!written)
+	{
+		debug(LOG_WARNING, "Failed to write texture cache entry %s: %s", path.c_str(), WZ_PHYSFS_getLastError());
+		PHYSFS_delete(path.c_str());
+		return false;
+	}
+	cacheStats.bytesWritten += bytesWritten;
+	return true;
+}
+
+} // namespace
+
+uint64_t gfx_api::textureCacheBackendFormats(pixel_format_target target)
+{
+	static_assert(static_cast<size_t>(MAX_PIXEL_FORMAT) < 64, "pixel formats no longer fit the capability mask");
+	uint64_t mask = 0;
+	for (size_t i = 1; i <= static_cast<size_t>(MAX_PIXEL_FORMAT); ++i)
+	{
+		if (gfx_api::context::get().textureFormatIsSupported(target, static_cast<pixel_format>(i), pixel_format_usage::sampled_image))
+		{
+			mask |= uint64_t(1) << i;
+		}
+	}
+	return mask;
+}
+
+bool gfx_api::textureCacheHashFile(const std::string& filename, TextureCacheKey& key, std::vector<char>& fileData)
+{
+	if (!loadFileToBufferVector(filename.c_str(), fileData, false, false))
+	{
+		return false;
+	}
+	key.sourceHash = sha256Sum(fileData.data(), fileData.size());
+	return true;
+}
+
+std::vector<std::unique_ptr<iV_BaseImage>> gfx_api::textureCacheLoadOrProduce(const TextureCacheKey& key, const std::function<std::vector<std::unique_ptr<iV_BaseImage>> ()>& produce, bool& produced)
+{
+	const StoredKey storedKey(key);
+	auto start = std::chrono::steady_clock::now();
+	std::vector<std::unique_ptr<iV_BaseImage>> levels;
+	if (readEntry(storedKey, levels))
+	{
+		++cacheStats.hits;
+		cacheStats.hitMicroseconds += microsecondsSince(start);
+		produced = false;
+		return levels;
+	}
+
+	start = std::chrono::steady_clock::now();
+	levels = produce();
+	++cacheStats.misses;
+	cacheStats.missMicroseconds += microsecondsSince(start);
+	produced = !levels.empty();
+	return levels;
+}
+
+void gfx_api::textureCacheStore(const TextureCacheKey& key, const std::vector<std::unique_ptr<iV_BaseImage>>& levels, const std::string& debugName)
+{
+	if (!writeEntry(StoredKey(key), levels))
+	{
+		debug(LOG_3D, "Not caching texture levels of: %s", debugName.c_str());
+	}
+}
+
+gfx_api::TextureCacheStats gfx_api::textureCacheStats()
+{
+	TextureCacheStats stats;
+	stats.hits = cacheStats.hits.load();
+	stats.misses = cacheStats.misses.load();
+	stats.hitMicroseconds = cacheStats.hitMicroseconds.load();
+	stats.missMicroseconds = cacheStats.missMicroseconds.load();
+	stats.bytesRead = cacheStats.bytesRead.load();
+	stats.bytesWritten = cacheStats.bytesWritten.load();
+	return stats;
+}
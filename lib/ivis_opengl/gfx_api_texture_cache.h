@@ -0,0 +1,84 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+	This file is part of Warzone 2100.
+	Copyright (C) 2026  Warzone 2100 Project (https://github.com/Warzone2100)
+
+	Warzone 2100 is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	Warzone 2100 is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Warzone 2100; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+/** @file gfx_api_texture_cache.h
+ * Binary cache of GPU-ready texture mip chains.
+ *
+ * Transcoding a .ktx2 file (basis) or compressing a .png (etcpak) into BCn / ETC / ASTC levels
+ * is most of the time spent loading terrain texture arrays and model pages. A cache entry holds
+ * every finished level of one file in one compressed format. It is keyed by the SHA-256 of the
+ * source file, the requested format, texture type and size limit, and the set of formats the
+ * backend can sample, so a different GPU, driver or backend gets its own entries instead of
+ * levels it cannot use. Entries live in `cache/textures/` in the write directory; a missing,
+ * stale or corrupt entry just means the file is transcoded again.
+ */
+
+#pragma once
+
+#include "pietypes.h"
+#include "gfx_api_formats_def.h"
+#include "lib/framework/crc.h"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace gfx_api
+{
+	struct TextureCacheKey
+	{
+		Sha256 sourceHash;                                      ///< of the source file contents
+		uint64_t backendFormats = 0;                            ///< see `textureCacheBackendFormats`
+		pixel_format requestedFormat = pixel_format::invalid;   ///< invalid = best available for the file
+		texture_type textureType = texture_type::game_texture;
+		pixel_format_target target = pixel_format_target::texture_2d;
+		uint32_t maxWidth = 0;                                  ///< 0 = unlimited
+		uint32_t maxHeight = 0;                                 ///< 0 = unlimited
+	};
+
+	/// What the cache did since startup, for the loading screen.
+	struct TextureCacheStats
+	{
+		uint32_t hits = 0;
+		uint32_t misses = 0;
+		uint64_t hitMicroseconds = 0;  ///< reading and checking the entries that were used
+		uint64_t missMicroseconds = 0; ///< transcoding / compressing the files that were not cached
+		uint64_t bytesRead = 0;
+		uint64_t bytesWritten = 0;
+	};
+
+	/// Bitmask of the formats `target` can sample with the current backend. Main thread only.
+	uint64_t textureCacheBackendFormats(pixel_format_target target);
+
+	/// Reads `filename` into `fileData` and fills in `key.sourceHash`. Thread-safe.
+	bool textureCacheHashFile(const std::string& filename, TextureCacheKey& key, std::vector<char>& fileData);
+
+	/// Returns the cached levels for `key`, or calls `produce`. Only reads the cache: `produced` is set when the levels
+	/// came from `produce`, and they can then be passed to `textureCacheStore`. Thread-safe.
+	std::vector<std::unique_ptr<iV_BaseImage>> textureCacheLoadOrProduce(const TextureCacheKey& key, const std::function<std::vector<std::unique_ptr<iV_BaseImage>> ()>& produce, bool& produced);
+
+	/// Stores `levels` for `key` if every level is in the same compressed format (uncompressed levels are cheap to
+	/// rebuild, but large). Writes to the write directory, so main thread only.
+	void textureCacheStore(const TextureCacheKey& key, const std::vector<std::unique_ptr<iV_BaseImage>>& levels, const std::string& debugName);
+
+	TextureCacheStats textureCacheStats();
+}
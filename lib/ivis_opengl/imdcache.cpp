@@ -0,0 +1,428 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+	This file is part of Warzone 2100.
+	Copyright (C) 2026  Warzone 2100 Project (https://github.com/Warzone2100)
+
+	Warzone 2100 is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	Warzone 2100 is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Warzone 2100; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+/** @file imdcache.cpp
+ * Binary .pie model cache (see imdcache.h).
+ */
+
+#include "imdcache.h"
+
+#include "lib/framework/frame.h"
+#include "lib/framework/file.h"
+#include "lib/framework/physfs_ext.h"
+#include "src/version.h"
+
+#include <cstring>
+#include <type_traits>
+
+#define IMD_CACHE_DIR "cache/models"
+
+// Bump whenever the PIE loader changes what it derives from a file, or the layout below changes.
+static constexpr uint32_t IMD_CACHE_VERSION = 2;
+static constexpr char IMD_CACHE_MAGIC[4] = {'W', 'Z', 'M', 'C'};
+
+// Upper bounds used to reject corrupt entries before allocating.
+static constexpr uint32_t IMD_CACHE_MAX_LEVELS = 64;
+static constexpr uint32_t IMD_CACHE_MAX_ARRAY = 1 << 20;
+
+// Raw arrays of these are copied straight into the cache, so their layout is part of the format.
+static_assert(std::is_trivially_copyable<iIMDPoly>::value, "iIMDPoly must be trivially copyable");
+static_assert(std::is_trivially_copyable<ANIMFRAME>::value, "ANIMFRAME must be trivially copyable");
+static_assert(std::is_trivially_copyable<Vector3i>::value && std::is_trivially_copyable<Vector3f>::value, "vectors must be trivially copyable");
+
+namespace
+{
+
+struct LayoutCheck
+{
+	uint32_t polySize = sizeof(iIMDPoly);
+	uint32_t animFrameSize = sizeof(ANIMFRAME);
+	uint32_t floatSize = sizeof(gfx_api::gfxFloat);
+	uint32_t animEventCount = ANIM_EVENT_COUNT;
+
+	bool operator ==(const LayoutCheck &b) const
+	{
+		return polySize == b.polySize && animFrameSize == b.animFrameSize && floatSize == b.floatSize && animEventCount == b.animEventCount;
+	}
+};
+
+class CacheWriter
+{
+public:
+	template <typename T>
+	void value(const T &v)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "only raw values can be written");
+		const uint8_t *p = reinterpret_cast<const uint8_t *>(&v);
+		out.insert(out.end(), p, p + sizeof(T));
+	}
+
+	template <typename T>
+	void array(const std::vector<T> &v)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "only raw values can be written");
+		value(static_cast<uint32_t>(v.size()));
+		const uint8_t *p = reinterpret_cast<const uint8_t *>(v.data());
+		out.insert(out.end(), p, p + v.size() * sizeof(T));
+	}
+
+	void string(const std::string &s)
+	{
+		value(static_cast<uint32_t>(s.size()));
+		out.insert(out.end(), s.begin(), s.end());
+	}
+
+	std::vector<uint8_t> out;
+};
+
+class CacheReader
+{
+public:
+	CacheReader(const char *data, size_t size) : pos(reinterpret_cast<const uint8_t *>(data)), end(pos + size) {}
+
+	template <typename T>
+	bool value(T &v)
+	{
+		if (static_cast<size_t>(end - pos) < sizeof(T))
+		{
+			return false;
+		}
+		memcpy(&v, pos, sizeof(T));
+		pos += sizeof(T);
+		return true;
+	}
+
+	template <typename T>
+	bool array(std::vector<T> &v)
+	{
+		uint32_t count = 0;
+		if (!value(count) || count > IMD_CACHE_MAX_ARRAY || static_cast<size_t>(end - pos) < count * sizeof(T))
+		{
+			return false;
+		}
+		v.resize(count);
+		memcpy(v.data(), pos, count * sizeof(T));
+		pos += count * sizeof(T);
+		return true;
+	}
+
+	bool string(std::string &s)
+	{
+		uint32_t length = 0;
+		if (!value(length) || static_cast<size_t>(end - pos) < length)
+		{
+			return false;
+		}
+		s.assign(reinterpret_cast<const char *>(pos), length);
+		pos += length;
+		return true;
+	}
+
+	bool atEnd() const { return pos == end; }
+	size_t remaining() const { return static_cast<size_t>(end - pos); }
+	const uint8_t *position() const { return pos; }
+
+private:
+	const uint8_t *pos;
+	const uint8_t *end;
+};
+
+/// The entries of each build live in their own directory, so the entries of other builds can be pruned
+const std::string &buildCacheDir()
+{
+	static const std::string dir = [] {
+		const char *vcsHash = version_getVcsFullHash();
+		return std::string(IMD_CACHE_DIR "/") + sha256Sum(vcsHash, strlen(vcsHash)).toString().substr(0, 16);
+	}();
+	return dir;
+}
+
+/// A build may change the PIE loader without changing IMD_CACHE_VERSION, so the build is part of the key
+Sha256 entryKey(const Sha256 &sourceHash)
+{
+	std::string key(reinterpret_cast<const char *>(sourceHash.bytes), Sha256::Bytes);
+	key += version_getVcsFullHash();
+	return sha256Sum(key.data(), key.size());
+}
+
+std::string cachePath(const Sha256 &key)
+{
+	return buildCacheDir() + "/" + key.toString() + ".bin";
+}
+
+/// Deletes everything in the cache directory that is not the current build's, as no other build can read it
+void pruneOtherBuilds()
+{
+	std::vector<std::string> stale;
+	WZ_PHYSFS_enumerateFiles(IMD_CACHE_DIR, [&stale](const char *name) -> bool {
+		std::string path = std::string(IMD_CACHE_DIR "/") + name;
+		if (path != buildCacheDir())
+		{
+			stale.push_back(std::move(path));
+		}
+		return true;
+	});
+	for (const std::string &path : stale)
+	{
+		if (WZ_PHYSFS_isDirectory(path.c_str()))
+		{
+			std::vector<std::string> files;
+			WZ_PHYSFS_enumerateFiles(path.c_str(), [&files, &path](const char *file) -> bool {
+				files.push_back(path + "/" + file);
+				return true;
+			});
+			for (const std::string &file : files)
+			{
+				PHYSFS_delete(file.c_str());
+			}
+		}
+		if (PHYSFS_delete(path.c_str()))
+		{
+			debug(LOG_3D, "Pruned model cache entries of another build: %s", path.c_str());
+		}
+	}
+}
+
+void writeLevel(CacheWriter &w, const iIMDShape &s, const ImdLevelGPUData &gpu)
+{
+	w.value(static_cast<uint32_t>(s.flags));
+	w.value(static_cast<int32_t>(s.interpolate));
+	w.value(s.min);
+	w.value(s.max);
+	w.value(static_cast<int32_t>(s.sradius));
+	w.value(static_cast<int32_t>(s.radius));
+	w.value(s.ocen);
+	w.value(static_cast<uint16_t>(s.numFrames));
+	w.value(static_cast<uint16_t>(s.animInterval));
+	w.value(static_cast<int32_t>(s.objanimtime));
+	w.value(static_cast<int32_t>(s.objanimcycles));
+	w.value(static_cast<int32_t>(s.objanimframes));
+	w.array(s.connectors);
+	w.array(s.points);
+	w.array(s.polys);
+	w.array(s.altShadowPoints);
+	w.array(s.altShadowPolys);
+	w.array(s.objanimdata);
+	for (const TilesetTextureFiles &files : s.tilesetTextureFiles)
+	{
+		w.string(files.texfile);
+		w.string(files.tcmaskfile);
+		w.string(files.normalfile);
+		w.string(files.specfile);
+	}
+	w.value(static_cast<uint16_t>(s.vertexCount));
+	w.array(gpu.vertices);
+	w.array(gpu.normals);
+	w.array(gpu.texcoords);
+	w.array(gpu.tangents);
+	w.array(gpu.indices);
+}
+
+bool polysReferenceValidPoints(const std::vector<iIMDPoly> &polys, size_t numPoints)
+{
+	for (const iIMDPoly &poly : polys)
+	{
+		if (poly.pindex[0] >= numPoints || poly.pindex[1] >= numPoints || poly.pindex[2] >= numPoints)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool readLevel(CacheReader &r, iIMDShape &s, ImdLevelGPUData &gpu)
+{
+	uint32_t flags = 0;
+	int32_t interpolate = 0, sradius = 0, radius = 0, objanimtime = 0, objanimcycles = 0, objanimframes = 0;
+	uint16_t numFrames = 0, animInterval = 0, vertexCount = 0;
+
+	bool ok = r.value(flags) && r.value(interpolate)
+		&& r.value(s.min) && r.value(s.max) && r.value(sradius) && r.value(radius) && r.value(s.ocen)
+		&& r.value(numFrames) && r.value(animInterval)
+		&& r.value(objanimtime) && r.value(objanimcycles) && r.value(objanimframes)
+		&& r.array(s.connectors) && r.array(s.points) && r.array(s.polys)
+		&& r.array(s.altShadowPoints) && r.array(s.altShadowPolys) && r.array(s.objanimdata);
+	for (TilesetTextureFiles &files : s.tilesetTextureFiles)
+	{
+		ok = ok && r.string(files.texfile) && r.string(files.tcmaskfile) && r.string(files.normalfile) && r.string(files.specfile);
+	}
+	ok = ok && r.value(vertexCount)
+		&& r.array(gpu.vertices) && r.array(gpu.normals) && r.array(gpu.texcoords) && r.array(gpu.tangents) && r.array(gpu.indices);
+	if (!ok)
+	{
+		return false;
+	}
+
+	s.flags = flags;
+	s.interpolate = interpolate;
+	s.sradius = sradius;
+	s.radius = radius;
+	s.numFrames = numFrames;
+	s.animInterval = animInterval;
+	s.objanimtime = objanimtime;
+	s.objanimcycles = objanimcycles;
+	s.objanimframes = objanimframes;
+	s.vertexCount = vertexCount;
+
+	// Everything below is indexed without further checks by the renderer
+	if (!polysReferenceValidPoints(s.polys, s.points.size())
+		|| !polysReferenceValidPoints(s.altShadowPolys, s.altShadowPoints.size())
+		|| s.objanimdata.size() != static_cast<size_t>(std::max(objanimframes, 0)))
+	{
+		return false;
+	}
+	if (gpu.vertices.size() != vertexCount * 3u || gpu.normals.size() != vertexCount * 3u || gpu.texcoords.size() != vertexCount * 4u
+		|| (!gpu.tangents.empty() && gpu.tangents.size() != vertexCount * 4u) || gpu.indices.size() != s.polys.size() * 3)
+	{
+		return false;
+	}
+	for (uint16_t index : gpu.indices)
+	{
+		if (index >= vertexCount)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+} // namespace
+
+bool imdCacheRead(const Sha256 &sourceHash, std::vector<std::unique_ptr<iIMDShape>> &levels, ImdCacheData &data)
+{
+	const Sha256 key = entryKey(sourceHash);
+	const std::string path = cachePath(key);
+	if (!PHYSFS_exists(path.c_str()))
+	{
+		return false;
+	}
+	std::vector<char> fileData;
+	if (!loadFileToBufferVector(path.c_str(), fileData, false, false))
+	{
+		return false;
+	}
+
+	CacheReader r(fileData.data(), fileData.size());
+	char magic[4] = {};
+	uint32_t version = 0;
+	LayoutCheck layout;
+	Sha256 storedKey;
+	uint32_t nlevels = 0;
+	uint64_t payloadSize = 0;
+	uint32_t payloadCrc = 0;
+	if (!r.value(magic) || memcmp(magic, IMD_CACHE_MAGIC, sizeof(magic)) != 0
+		|| !r.value(version) || version != IMD_CACHE_VERSION
+		|| !r.value(layout) || !(layout == LayoutCheck())
+		|| !r.value(storedKey) || storedKey != key
+		|| !r.value(nlevels) || nlevels == 0 || nlevels > IMD_CACHE_MAX_LEVELS)
+	{
+		debug(LOG_3D, "Ignoring stale model cache entry: %s", path.c_str());
+		return false;
+	}
+	// A damaged entry could still pass the checks made while reading the levels
+	if (!r.value(payloadSize) || !r.value(payloadCrc) || payloadSize != r.remaining()
+		|| wz::crc_update(wz::crc_init(), r.position(), static_cast<size_t>(payloadSize)) != payloadCrc)
+	{
+		debug(LOG_WARNING, "Ignoring corrupt model cache entry: %s", path.c_str());
+		return false;
+	}
+
+	levels.clear();
+	data = ImdCacheData();
+	for (std::string &name : data.animEventModels)
+	{
+		if (!r.string(name))
+		{
+			return false;
+		}
+	}
+	data.levelGPUData.resize(nlevels);
+	for (uint32_t level = 0; level < nlevels; ++level)
+	{
+		auto shape = std::make_unique<iIMDShape>();
+		if (!readLevel(r, *shape, data.levelGPUData[level]))
+		{
+			debug(LOG_WARNING, "Ignoring corrupt model cache entry: %s", path.c_str());
+			levels.clear();
+			return false;
+		}
+		levels.push_back(std::move(shape));
+	}
+	if (!r.atEnd())
+	{
+		debug(LOG_WARNING, "Ignoring corrupt model cache entry: %s", path.c_str());
+		levels.clear();
+		return false;
+	}
+	return true;
+}
+
+bool imdCacheWrite(const Sha256 &sourceHash, const iIMDShape &firstLevel, const ImdCacheData &data)
+{
+	static bool cacheDirCreated = false;
+
+	CacheWriter payload;
+	for (const std::string &name : data.animEventModels)
+	{
+		payload.string(name);
+	}
+	size_t level = 0;
+	for (const iIMDShape *s = &firstLevel; s != nullptr; s = s->next.get(), ++level)
+	{
+		ASSERT_OR_RETURN(false, level < data.levelGPUData.size(), "Missing GPU data for model level %zu", level);
+		writeLevel(payload, *s, data.levelGPUData[level]);
+	}
+	ASSERT_OR_RETURN(false, level == data.levelGPUData.size(), "GPU data for %zu levels, but model has %zu", data.levelGPUData.size(), level);
+
+	const Sha256 key = entryKey(sourceHash);
+	CacheWriter w;
+	w.value(IMD_CACHE_MAGIC);
+	w.value(IMD_CACHE_VERSION);
+	w.value(LayoutCheck());
+	w.value(key);
+	w.value(static_cast<uint32_t>(data.levelGPUData.size()));
+	w.value(static_cast<uint64_t>(payload.out.size()));
+	w.value(wz::crc_update(wz::crc_init(), payload.out.data(), payload.out.size()));
+	w.out.insert(w.out.end(), payload.out.begin(), payload.out.end());
+
+	if (!cacheDirCreated)
+	{
+		// Once per run, before this build's first entry: failure is handled below, the cache is an optimisation only
+		pruneOtherBuilds();
+		PHYSFS_mkdir(buildCacheDir().c_str());
+		cacheDirCreated = true;
+	}
+	const std::string path = cachePath(key);
+	PHYSFS_file *fileHandle = PHYSFS_openWrite(path.c_str());
+	if (!fileHandle)
+	{
+		debug(LOG_3D, "Unable to write model cache entry %s: %s", path.c_str(), WZ_PHYSFS_getLastError());
+		return false;
+	}
+	const bool written = WZ_PHYSFS_writeBytes(fileHandle, w.out.data(), static_cast<PHYSFS_uint32>(w.out.size())) == static_cast<PHYSFS_sint64>(w.out.size());
+	PHYSFS_close(fileHandle);
+	if (!written)
+	{
+		debug(LOG_WARNING, "Failed to write model cache entry %s: %s", path.c_str(), WZ_PHYSFS_getLastError());
+		PHYSFS_delete(path.c_str());
+		return false;
+	}
+	return true;
+}
@@ -0,0 +1,65 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+	This file is part of Warzone 2100.
+	Copyright (C) 2026  Warzone 2100 Project (https://github.com/Warzone2100)
+
+	Warzone 2100 is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	Warzone 2100 is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Warzone 2100; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+/** @file imdcache.h
+ * Binary cache of processed .pie models, keyed by the SHA-256 of the source file and the build.
+ *
+ * A cache entry holds everything `iV_ProcessIMD` derives from the text file (points,
+ * polygons, bounds, connectors, animation data, texture file names) plus the
+ * ready-to-upload vertex / index buffers of each level, so a cache hit skips parsing,
+ * vertex welding and tangent generation. Entries live in a directory per build under
+ * `cache/models/` in the write directory, and the directories of other builds are deleted
+ * when the first entry is written. A missing, stale or corrupt (CRC) entry just falls back
+ * to the text parser.
+ */
+
+#pragma once
+
+#include "ivisdef.h"
+#include "lib/framework/crc.h"
+
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+/// GPU buffer contents of one model level, as uploaded by the PIE loader.
+struct ImdLevelGPUData
+{
+	std::vector<gfx_api::gfxFloat> vertices;
+	std::vector<gfx_api::gfxFloat> normals;
+	std::vector<gfx_api::gfxFloat> texcoords;
+	std::vector<gfx_api::gfxFloat> tangents; ///< empty unless the model provides NORMALS
+	std::vector<uint16_t> indices;
+};
+
+/// Data stored alongside the shape levels that cannot be rebuilt from `iIMDShape` alone.
+struct ImdCacheData
+{
+	std::array<std::string, ANIM_EVENT_COUNT> animEventModels; ///< EVENT model names (empty = none)
+	std::vector<ImdLevelGPUData> levelGPUData;                 ///< one entry per level
+};
+
+/// Load the cache entry for `sourceHash`. On success `levels` holds the unlinked shape levels
+/// (without `modelName`, `modelLevel`, shadow pointers or GPU buffers) and `data` their GPU data.
+bool imdCacheRead(const Sha256 &sourceHash, std::vector<std::unique_ptr<iIMDShape>> &levels, ImdCacheData &data);
+
+/// Store a freshly parsed model. `data.levelGPUData` must have one entry per level of `firstLevel`.
+bool imdCacheWrite(const Sha256 &sourceHash, const iIMDShape &firstLevel, const ImdCacheData &data);
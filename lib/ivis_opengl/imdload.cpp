@@ -35,6 +35,7 @@
 #include "lib/framework/string_ext.h"
 #include "lib/framework/fixedpoint.h"
 #include "lib/framework/file.h"
+#include "lib/framework/crc.h"
 #include "lib/framework/physfs_ext.h"
 #include "lib/framework/loading_task.h"
 #include "lib/framework/resource_loading_controller.h"
@@ -46,6 +47,7 @@
 
 #include "ivisdef.h" // for imd structures
 #include "imd.h" // for imd structures
+#include "imdcache.h" // binary cache of processed models
 #include "tex.h" // texture page loading
 
 #include <glm/vec4.hpp>
@@ -68,7 +70,8 @@ static size_t currentTilesetIdx = 0;
 static size_t modelLoadingErrors = 0;
 static size_t modelTextureLoadingFailures = 0;
 
-static std::unique_ptr<iIMDShape> iV_ProcessIMD(const WzString &filename, const char **ppFileData, const char *FileDataEnd, bool skipGPUData, bool skipDuplicateLoadChecks = false);
+static std::unique_ptr<iIMDShape> iV_ProcessIMD(const WzString &filename, const char **ppFileData, const char *FileDataEnd, bool skipGPUData, bool skipDuplicateLoadChecks = false, ImdCacheData *cacheDataOut = nullptr);
+static std::unique_ptr<iIMDShape> imdLoadFromCache(const WzString &filename, const Sha256 &sourceHash, bool skipGPUData, bool skipDuplicateLoadChecks);
 static bool _imd_load_level_textures(const iIMDShape& s, size_t tilesetIdx, iIMDShapeTextures& output);
 static std::unique_ptr<iIMDShape> tryLoadDisplayModelInternal(const WzString &path, const WzString &filename, bool skipGPUupload, bool skipDuplicateLoadChecks = false);
 
@@ -354,10 +357,24 @@ static std::unique_ptr<iIMDShape> tryLoadDisplayModelInternal(const WzString &pa
 			debug(LOG_ERROR, "Failed to load model file: %s", WzString(path + filename).toUtf8().c_str());
 			return nullptr;
 		}
+		const Sha256 sourceHash = sha256Sum(pFileData, size);
+		auto result = imdLoadFromCache(filename, sourceHash, skipGPUupload, skipDuplicateLoadChecks);
+		if (result)
+		{
+			free(pFileData);
+			return result;
+		}
+
 		fileEnd = pFileData + size;
 		const char *pFileDataPt = pFileData;
-		auto result = iV_ProcessIMD(filename, (const char **)&pFileDataPt, fileEnd, skipGPUupload, skipDuplicateLoadChecks);
+		// GPU data is only captured when it is built, so models loaded with skipGPUupload are not cached
+		ImdCacheData cacheData;
+		result = iV_ProcessIMD(filename, (const char **)&pFileDataPt, fileEnd, skipGPUupload, skipDuplicateLoadChecks, (skipGPUupload) ? nullptr : &cacheData);
 		free(pFileData);
+		if (result && !skipGPUupload)
+		{
+			imdCacheWrite(sourceHash, *result, cacheData);
+		}
 		return result;
 	}
 	return nullptr;
@@ -1570,6 +1587,51 @@ void finishTangentsGeneration()
    }
 }
 
+static void _imd_upload_level_buffers(iIMDShape &s, const WzString &filename, const std::string &key,
+                                      const std::vector<gfx_api::gfxFloat> &levelVertices, const std::vector<gfx_api::gfxFloat> &levelNormals,
+                                      const std::vector<gfx_api::gfxFloat> &levelTexcoords, const std::vector<gfx_api::gfxFloat> &levelTangents,
+                                      const std::vector<uint16_t> &levelIndices)
+{
+	if (!levelTangents.empty())
+	{
+		if (!s.buffers[VBO_TANGENT])
+			s.buffers[VBO_TANGENT] = gfx_api::context::get().create_buffer_object(gfx_api::buffer::usage::vertex_buffer, gfx_api::context::buffer_storage_hint::static_draw, "tangent buffer");
+		s.buffers[VBO_TANGENT]->upload(levelTangents.size() * sizeof(gfx_api::gfxFloat), levelTangents.data());
+	}
+
+	if (!s.buffers[VBO_VERTEX])
+		s.buffers[VBO_VERTEX] = gfx_api::context::get().create_buffer_object(gfx_api::buffer::usage::vertex_buffer, gfx_api::context::buffer_storage_hint::static_draw, "vertex buffer");
+	if (levelVertices.empty())
+	{
+		debug(LOG_ERROR, "_imd_load_level: file corrupt? - no vertices?: %s (key: %s)", filename.toUtf8().c_str(), key.c_str());
+	}
+	s.buffers[VBO_VERTEX]->upload(levelVertices.size() * sizeof(gfx_api::gfxFloat), levelVertices.data());
+
+	if (!s.buffers[VBO_NORMAL])
+		s.buffers[VBO_NORMAL] = gfx_api::context::get().create_buffer_object(gfx_api::buffer::usage::vertex_buffer, gfx_api::context::buffer_storage_hint::static_draw, "normals buffer");
+	if (levelNormals.empty())
+	{
+		debug(LOG_ERROR, "_imd_load_level: file corrupt? - no normals?: %s (key: %s)", filename.toUtf8().c_str(), key.c_str());
+	}
+	s.buffers[VBO_NORMAL]->upload(levelNormals.size() * sizeof(gfx_api::gfxFloat), levelNormals.data());
+
+	if (!s.buffers[VBO_INDEX])
+		s.buffers[VBO_INDEX] = gfx_api::context::get().create_buffer_object(gfx_api::buffer::usage::index_buffer, gfx_api::context::buffer_storage_hint::static_draw, "index buffer");
+	if (levelIndices.empty())
+	{
+		debug(LOG_ERROR, "_imd_load_level: file corrupt? - no indices?: %s (key: %s)", filename.toUtf8().c_str(), key.c_str());
+	}
+	s.buffers[VBO_INDEX]->upload(levelIndices.size() * sizeof(uint16_t), levelIndices.data());
+
+	if (!s.buffers[VBO_TEXCOORD])
+		s.buffers[VBO_TEXCOORD] = gfx_api::context::get().create_buffer_object(gfx_api::buffer::usage::vertex_buffer, gfx_api::context::buffer_storage_hint::static_draw, "tex coords buffer");
+	if (levelTexcoords.empty())
+	{
+		debug(LOG_ERROR, "_imd_load_level: file corrupt? - no texcoords?: %s (key: %s)", filename.toUtf8().c_str(), key.c_str());
+	}
+	s.buffers[VBO_TEXCOORD]->upload(levelTexcoords.size() * sizeof(gfx_api::gfxFloat), levelTexcoords.data());
+}
+
 /*!
  * Load shape levels recursively
  * \param ppFileData Pointer to the data (usually read from a file)
@@ -1580,7 +1642,7 @@ void finishTangentsGeneration()
  * \post s allocated
  */
 static_assert(PATH_MAX >= 255, "PATH_MAX is insufficient!");
-static std::unique_ptr<iIMDShape> _imd_load_level(const WzString &filename, const char **ppFileData, const char *FileDataEnd, int pieVersion, uint32_t level, const LevelSettings &globalLevelSettings, bool skipGPUData, bool skipDuplicateLoadChecks)
+static std::unique_ptr<iIMDShape> _imd_load_level(const WzString &filename, const char **ppFileData, const char *FileDataEnd, int pieVersion, uint32_t level, const LevelSettings &globalLevelSettings, bool skipGPUData, bool skipDuplicateLoadChecks, ImdLevelGPUData *gpuDataOut)
 {
 	const char *pFileData = *ppFileData;
 	char buffer[PATH_MAX] = {'\0'}; uint32_t value = 0;
@@ -1879,46 +1941,17 @@ static std::unique_ptr<iIMDShape> _imd_load_level(const WzString &filename, cons
 			for (size_t i = 0; i < indices.size(); i += 3)
 				calculateTangentsForTriangle(indices[i], indices[i+1], indices[i+2]);
 			finishTangentsGeneration();
-
-			if (!tangents.empty())
-			{
-				if (!s.buffers[VBO_TANGENT])
-					s.buffers[VBO_TANGENT] = gfx_api::context::get().create_buffer_object(gfx_api::buffer::usage::vertex_buffer, gfx_api::context::buffer_storage_hint::static_draw, "tangent buffer");
-				s.buffers[VBO_TANGENT]->upload(tangents.size() * sizeof(gfx_api::gfxFloat), tangents.data());
-			}
-		}
-
-		if (!s.buffers[VBO_VERTEX])
-			s.buffers[VBO_VERTEX] = gfx_api::context::get().create_buffer_object(gfx_api::buffer::usage::vertex_buffer, gfx_api::context::buffer_storage_hint::static_draw, "vertex buffer");
-		if (vertices.empty())
-		{
-			debug(LOG_ERROR, "_imd_load_level: file corrupt? - no vertices?: %s (key: %s)", filename.toUtf8().c_str(), key.c_str());
-		}
-		s.buffers[VBO_VERTEX]->upload(vertices.size() * sizeof(gfx_api::gfxFloat), vertices.data());
-
-		if (!s.buffers[VBO_NORMAL])
-			s.buffers[VBO_NORMAL] = gfx_api::context::get().create_buffer_object(gfx_api::buffer::usage::vertex_buffer, gfx_api::context::buffer_storage_hint::static_draw, "normals buffer");
-		if (normals.empty())
-		{
-			debug(LOG_ERROR, "_imd_load_level: file corrupt? - no normals?: %s (key: %s)", filename.toUtf8().c_str(), key.c_str());
-		}
-		s.buffers[VBO_NORMAL]->upload(normals.size() * sizeof(gfx_api::gfxFloat), normals.data());
-
-		if (!s.buffers[VBO_INDEX])
-			s.buffers[VBO_INDEX] = gfx_api::context::get().create_buffer_object(gfx_api::buffer::usage::index_buffer, gfx_api::context::buffer_storage_hint::static_draw, "index buffer");
-		if (indices.empty())
-		{
-			debug(LOG_ERROR, "_imd_load_level: file corrupt? - no indices?: %s (key: %s)", filename.toUtf8().c_str(), key.c_str());
 		}
-		s.buffers[VBO_INDEX]->upload(indices.size() * sizeof(uint16_t), indices.data());
 
-		if (!s.buffers[VBO_TEXCOORD])
-			s.buffers[VBO_TEXCOORD] = gfx_api::context::get().create_buffer_object(gfx_api::buffer::usage::vertex_buffer, gfx_api::context::buffer_storage_hint::static_draw, "tex coords buffer");
-		if (texcoords.empty())
+		_imd_upload_level_buffers(s, filename, key, vertices, normals, texcoords, tangents, indices);
+		if (gpuDataOut)
 		{
-			debug(LOG_ERROR, "_imd_load_level: file corrupt? - no texcoords?: %s (key: %s)", filename.toUtf8().c_str(), key.c_str());
+			gpuDataOut->vertices = vertices;
+			gpuDataOut->normals = normals;
+			gpuDataOut->texcoords = texcoords;
+			gpuDataOut->tangents = tangents;
+			gpuDataOut->indices = indices;
 		}
-		s.buffers[VBO_TEXCOORD]->upload(texcoords.size() * sizeof(gfx_api::gfxFloat), texcoords.data());
 	}
 
 	indices.resize(0);
@@ -1949,7 +1982,7 @@ static std::unique_ptr<iIMDShape> _imd_load_level(const WzString &filename, cons
  * \return The shape, constructed from the data read
  */
 // ppFileData is incremented to the end of the file on exit!
-static std::unique_ptr<iIMDShape> iV_ProcessIMD(const WzString &filename, const char **ppFileData, const char *FileDataEnd, bool skipGPUData, bool skipDuplicateLoadChecks)
+static std::unique_ptr<iIMDShape> iV_ProcessIMD(const WzString &filename, const char **ppFileData, const char *FileDataEnd, bool skipGPUData, bool skipDuplicateLoadChecks, ImdCacheData *cacheDataOut)
 {
 	const char *pFileData = *ppFileData;
 	char buffer[PATH_MAX] = {};
@@ -2037,6 +2070,10 @@ static std::unique_ptr<iIMDShape> iV_ProcessIMD(const WzString &filename, const
 		}
 
 		objanimpie[value] = modelGet(animpie);
+		if (cacheDataOut && value < ANIM_EVENT_COUNT)
+		{
+			cacheDataOut->animEventModels[value] = animpie;
+		}
 
 		/* Try -yet again- to read in LEVELS directive */
 		if (!getNextPossibleCommandLine())
@@ -2079,7 +2116,12 @@ static std::unique_ptr<iIMDShape> iV_ProcessIMD(const WzString &filename, const
 			return nullptr;
 		}
 
-		std::unique_ptr<iIMDShape> shape = _imd_load_level(filename, &lineToProcess.pNextLineBegin, FileDataEnd, imd_version, level, globalLevelSettings, skipGPUData, skipDuplicateLoadChecks);
+		ImdLevelGPUData *gpuDataOut = nullptr;
+		if (cacheDataOut)
+		{
+			gpuDataOut = &cacheDataOut->levelGPUData.emplace_back();
+		}
+		std::unique_ptr<iIMDShape> shape = _imd_load_level(filename, &lineToProcess.pNextLineBegin, FileDataEnd, imd_version, level, globalLevelSettings, skipGPUData, skipDuplicateLoadChecks, gpuDataOut);
 		if (shape == nullptr)
 		{
 			debug(LOG_ERROR, "%s: Unsuccessful loading level %" PRIu32, filename.toUtf8().c_str(), (level + 1));
@@ -2115,3 +2157,59 @@ static std::unique_ptr<iIMDShape> iV_ProcessIMD(const WzString &filename, const
 	*ppFileData = pFileData;
 	return firstLevel;
 }
+
+/*!
+ * Rebuild a model from its binary cache entry (see imdcache.h)
+ * \param sourceHash SHA-256 of the .pie file contents
+ * \return The shape, or nullptr if there is no usable cache entry
+ */
+static std::unique_ptr<iIMDShape> imdLoadFromCache(const WzString &filename, const Sha256 &sourceHash, bool skipGPUData, bool skipDuplicateLoadChecks)
+{
+	std::vector<std::unique_ptr<iIMDShape>> levels;
+	ImdCacheData cacheData;
+	if (!imdCacheRead(sourceHash, levels, cacheData))
+	{
+		return nullptr;
+	}
+
+	for (uint32_t level = 0; level < levels.size(); ++level)
+	{
+		iIMDShape &s = *levels[level];
+		std::string key = filename.toStdString();
+		if (level > 0)
+		{
+			key += "_" + std::to_string(level);
+		}
+		if (!skipDuplicateLoadChecks)
+		{
+			ASSERT(models.count(key) == 0, "Duplicate model load for %s!", key.c_str());
+		}
+		s.modelName = WzString::fromUtf8(key);
+		s.modelLevel = level;
+		s.pShadowPoints = (!s.altShadowPolys.empty()) ? &s.altShadowPoints : &s.points;
+		s.pShadowPolys = (!s.altShadowPolys.empty()) ? &s.altShadowPolys : &s.polys;
+
+		if (!skipGPUData)
+		{
+			const ImdLevelGPUData &gpu = cacheData.levelGPUData[level];
+			_imd_upload_level_buffers(s, filename, key, gpu.vertices, gpu.normals, gpu.texcoords, gpu.tangents, gpu.indices);
+		}
+	}
+
+	for (size_t level = levels.size() - 1; level > 0; --level)
+	{
+		levels[level - 1]->next = std::move(levels[level]);
+	}
+	std::unique_ptr<iIMDShape> firstLevel = std::move(levels.front());
+
+	// copy over model-wide animation information, stored only in the first level
+	for (int i = 0; i < ANIM_EVENT_COUNT; i++)
+	{
+		if (!cacheData.animEventModels[i].empty())
+		{
+			firstLevel->objanimpie[i] = modelGet(WzString::fromUtf8(cacheData.animEventModels[i]));
+		}
+	}
+
+	return firstLevel;
+}
@@ -651,6 +651,176 @@ static void pie_DrawMultipleImages(const std::list<PieDrawImageRequest>& request
 	gfx_api::DrawImagePSO::get().unbind_vertex_buffers(pie_internal::rectBuffer);
 }
 
+void BatchedMultiImageRenderer::resizeImageGroups(size_t count)
+{
+	groupsData.resize(count);
+}
+
+void BatchedMultiImageRenderer::addImage(IMAGEFILE *imageFile, UWORD id, float x, float y, PIELIGHT colour, size_t imageGroup /*= 0*/)
+{
+	if (!assertValidImage(imageFile, id))
+	{
+		return;
+	}
+	ASSERT_OR_RETURN(, imageGroup < groupsData.size(), "Invalid image group: %zu", imageGroup);
+	ASSERT_OR_RETURN(, !uploadedThisFrame, "Images were added after instance data was uploaded - make sure to call clear() before adding images after draw!");
+
+	AtlasImageDef const &image = imageFile->imageDefs[id];
+	const IMAGEFILE::Page &page = imageFile->pages[image.TPageID];
+	const gfx_api::gfxFloat invTextureSize = 1.f / (float)page.size;
+	const glm::vec4 offsetScale(image.Tu * invTextureSize, image.Tv * invTextureSize, image.Width * invTextureSize, image.Height * invTextureSize);
+	const glm::mat4 matrix = glm::translate(glm::vec3(x + image.XOffset, y + image.YOffset, 0.f)) * glm::scale(glm::vec3(image.Width, image.Height, 1.f));
+
+	ImageGroup &group = groupsData[imageGroup];
+	gfx_api::texture *texture = &pie_Texture(page.id);
+	if (group.runs.empty() || group.runs.back().texture != texture)
+	{
+		group.runs.push_back(ImageRun{texture, group.instances.size(), 0});
+	}
+	++group.runs.back().instancesCount;
+	group.instances.push_back(gfx_api::MultiRectPerInstanceInterleavedData{ matrix, offsetScale, colour.rgba() });
+	++totalAddedImages;
+}
+
+bool BatchedMultiImageRenderer::uploadAllImageInstances()
+{
+	instancesData.clear();
+	instancesData.reserve(totalAddedImages);
+	groupBufferOffsets.clear();
+	for (const auto& group : groupsData)
+	{
+		groupBufferOffsets.push_back(instancesData.size() * sizeof(gfx_api::MultiRectPerInstanceInterleavedData));
+		instancesData.insert(instancesData.end(), group.instances.begin(), group.instances.end());
+	}
+	uploadedThisFrame = true;
+
+	if (instancesData.empty())
+	{
+		return true;
+	}
+	ASSERT_OR_RETURN(false, !instanceDataBuffers.empty(), "No buffers available - unexpectedly called before init");
+
+	// A buffer is only uploaded once per frame - cycle through enough of them that the GPU is done with the one we overwrite
+	++currInstanceBufferIdx;
+	if (currInstanceBufferIdx >= instanceDataBuffers.size())
+	{
+		currInstanceBufferIdx = 0;
+	}
+	instanceDataBuffers[currInstanceBufferIdx]->upload(instancesData.size() * sizeof(gfx_api::MultiRectPerInstanceInterleavedData), instancesData.data());
+	return true;
+}
+
+static void pie_DrawMultiImage_NonInstanced(const std::vector<gfx_api::MultiRectPerInstanceInterleavedData>& instances, gfx_api::texture& texture, const glm::mat4& projectionMatrix)
+{
+	gfx_api::DrawImagePSO::get().bind();
+	gfx_api::DrawImagePSO::get().bind_textures(&texture);
+	gfx_api::DrawImagePSO::get().bind_vertex_buffers(pie_internal::rectBuffer);
+	for (const auto& instance : instances)
+	{
+		gfx_api::DrawImagePSO::get().bind_constants({ projectionMatrix * instance.TransformationMatrix,
+			glm::vec2(instance.offset_scale.x, instance.offset_scale.y),
+			glm::vec2(instance.offset_scale.z, instance.offset_scale.w),
+			glm::vec4((instance.colour & 0xff) / 255.f, ((instance.colour >> 8) & 0xff) / 255.f, ((instance.colour >> 16) & 0xff) / 255.f, ((instance.colour >> 24) & 0xff) / 255.f),
+			0 });
+		gfx_api::DrawImagePSO::get().draw(4, 0);
+	}
+	gfx_api::DrawImagePSO::get().unbind_vertex_buffers(pie_internal::rectBuffer);
+}
+
+void BatchedMultiImageRenderer::drawImages(size_t imageGroup, glm::mat4 projectionMatrix /*= defaultProjectionMatrix()*/)
+{
+	ASSERT_OR_RETURN(, imageGroup < groupsData.size(), "Invalid image group: %zu", imageGroup);
+	const ImageGroup &group = groupsData[imageGroup];
+	if (group.instances.empty())
+	{
+		return;
+	}
+
+	if (!useInstancedRendering)
+	{
+		std::vector<gfx_api::MultiRectPerInstanceInterleavedData> runInstances;
+		for (const auto& run : group.runs)
+		{
+			runInstances.assign(group.instances.begin() + run.firstInstance, group.instances.begin() + run.firstInstance + run.instancesCount);
+			pie_DrawMultiImage_NonInstanced(runInstances, *run.texture, projectionMatrix);
+		}
+		return;
+	}
+
+	// otherwise, use instanced rendering
+	if (!uploadedThisFrame && !uploadAllImageInstances())
+	{
+		return;
+	}
+	ASSERT_OR_RETURN(, instancesData.size() == totalAddedImages, "Images were added after instance data was uploaded - make sure to call clear() before adding images after draw!");
+
+	gfx_api::buffer *instanceBuffer = instanceDataBuffers[currInstanceBufferIdx];
+	gfx_api::DrawImagePSO_Instanced::get().bind();
+	gfx_api::DrawImagePSO_Instanced::get().bind_constants({ projectionMatrix });
+	for (const auto& run : group.runs)
+	{
+		gfx_api::DrawImagePSO_Instanced::get().bind_textures(run.texture);
+		gfx_api::context::get().bind_vertex_buffers(0, {
+			std::make_tuple(pie_internal::rectBuffer, 0),
+			std::make_tuple(instanceBuffer, groupBufferOffsets[imageGroup] + run.firstInstance * sizeof(gfx_api::MultiRectPerInstanceInterleavedData))});
+		gfx_api::DrawImagePSO_Instanced::get().draw_instanced(4, 0, run.instancesCount);
+	}
+	gfx_api::DrawImagePSO_Instanced::get().unbind_vertex_buffers(pie_internal::rectBuffer, instanceBuffer);
+}
+
+bool BatchedMultiImageRenderer::initialize()
+{
+	reset();
+
+	// same requirements as BatchedMultiRectRenderer, which uses the same vertex shader
+	if (!gfx_api::context::get().supportsInstancedRendering())
+	{
+		useInstancedRendering = false;
+		return true;
+	}
+	int32_t max_vertex_attribs = gfx_api::context::get().get_context_value(gfx_api::context::context_value::MAX_VERTEX_ATTRIBS);
+	size_t maxInstancedShaderVertexAttribs = std::max({gfx_api::instance_modelMatrix + 3, gfx_api::instance_packedValues, gfx_api::instance_Colour}) + 1;
+	if (max_vertex_attribs < maxInstancedShaderVertexAttribs)
+	{
+		debug(LOG_INFO, "Disabling instanced image rendering - Insufficient MAX_VERTEX_ATTRIBS (%" PRIi32 "; need: %zu)", max_vertex_attribs, maxInstancedShaderVertexAttribs);
+		useInstancedRendering = false;
+		return true;
+	}
+
+	instanceDataBuffers.resize(gfx_api::context::get().maxFramesInFlight() + 1);
+	for (size_t i = 0; i < instanceDataBuffers.size(); ++i)
+	{
+		instanceDataBuffers[i] = gfx_api::context::get().create_buffer_object(gfx_api::buffer::usage::vertex_buffer, gfx_api::context::buffer_storage_hint::stream_draw, "BatchedMultiImageRenderer::instanceDataBuffer[" + std::to_string(i) + "]");
+	}
+	useInstancedRendering = true;
+	return true;
+}
+
+void BatchedMultiImageRenderer::clear()
+{
+	for (auto& group : groupsData)
+	{
+		group.instances.clear();
+		group.runs.clear();
+	}
+	totalAddedImages = 0;
+	uploadedThisFrame = false;
+	instancesData.clear();
+}
+
+void BatchedMultiImageRenderer::reset()
+{
+	clear();
+	size_t numGroups = groupsData.size();
+	groupsData.clear();
+	groupsData.resize(numGroups);
+	for (auto buffer : instanceDataBuffers)
+	{
+		delete buffer;
+	}
+	instanceDataBuffers.clear();
+}
+
 static Vector2i makePieImage(IMAGEFILE *imageFile, unsigned id, PIERECT *dest, int x, int y)
 {
 	AtlasImageDef const &image = imageFile->imageDefs[id];
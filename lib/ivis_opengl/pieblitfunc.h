@@ -185,6 +185,44 @@ private:
 	size_t currInstanceBufferIdx = 0;
 	optional<UploadedRectsInstanceBufferInfo> currentUploadedRectInfo;
 };
+
+/// Collects images (icons, group numbers, ...) queued during a frame, in any number of groups, and draws each
+/// group with one instanced draw per run of consecutive images that share a texture page.
+/// Images within a group are drawn in the order they were added, so overlapping images stack as if drawn one by one.
+class BatchedMultiImageRenderer
+{
+public:
+	void resizeImageGroups(size_t count);
+	void addImage(IMAGEFILE *imageFile, UWORD id, float x, float y, PIELIGHT colour, size_t imageGroup = 0);
+	void drawImages(size_t imageGroup, glm::mat4 projectionMatrix = defaultProjectionMatrix());
+public:
+	bool initialize();
+	void clear();
+	void reset();
+private:
+	struct ImageRun
+	{
+		gfx_api::texture* texture = nullptr;
+		size_t firstInstance = 0;
+		size_t instancesCount = 0;
+	};
+	struct ImageGroup
+	{
+		std::vector<gfx_api::MultiRectPerInstanceInterleavedData> instances;
+		std::vector<ImageRun> runs;
+	};
+	bool uploadAllImageInstances();
+private:
+	bool useInstancedRendering = false;
+	std::vector<ImageGroup> groupsData;
+	size_t totalAddedImages = 0;
+
+	std::vector<gfx_api::MultiRectPerInstanceInterleavedData> instancesData;
+	std::vector<size_t> groupBufferOffsets;
+	std::vector<gfx_api::buffer*> instanceDataBuffers;
+	size_t currInstanceBufferIdx = 0;
+	bool uploadedThisFrame = false;
+};
 struct PIERECT  ///< Screen rectangle.
 {
 	float x, y, w, h;
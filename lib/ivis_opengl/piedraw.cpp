@@ -28,6 +28,7 @@
 #include "lib/framework/frame.h"
 #include "lib/framework/hash_combine.h"
 #include "lib/framework/pool_allocator.h"
+#include "lib/framework/wzparallel.h"
 #include "lib/ivis_opengl/ivisdef.h"
 #include "lib/ivis_opengl/imd.h"
 #include "lib/ivis_opengl/piefunc.h"
@@ -1104,6 +1105,8 @@ private:
 	ShapeVector shapes;
 
 	std::vector<gfx_api::Draw3DShapePerInstanceInterleavedData> instancesData;
+	// Source batch of each entry in finalizedDrawCalls, only valid inside FinalizeInstances()
+	std::vector<const gfx_api::Draw3DShapePerInstanceInterleavedData*> batchSources;
 	std::vector<gfx_api::buffer*> instanceDataBuffers;
 	size_t currInstanceBufferIdx = 0;
 
@@ -1563,51 +1566,56 @@ bool InstancedMeshRenderer::FinalizeInstances()
 		return true;
 	}
 
-	instancesData.reserve(instancesCount + translucentInstancesCount + additiveInstancesCount);
+	// Lay the batches out in the instance buffer first, then copy them in parallel: with many
+	// units on screen this is a few MB of instance data every frame.
+	size_t totalInstances = 0;
+	batchSources.clear();
+	auto addBatch = [this, &totalInstances](const MeshInstanceKey& key, const InstanceDataVector& meshInstances) {
+		finalizedDrawCalls.emplace_back(key, meshInstances.size(), totalInstances);
+		batchSources.push_back(meshInstances.data());
+		totalInstances += meshInstances.size();
+	};
 
 	for (const auto& mesh : instanceMeshes)
 	{
-		const auto& meshInstances = mesh.second;
-		if (meshInstances.empty())
+		if (mesh.second.empty())
 		{
 			// A batch retained from an earlier frame that nothing drew into this time
 			continue;
 		}
-		size_t startingIdxInInstancesBuffer = instancesData.size();
-		instancesData.insert(instancesData.end(), meshInstances.begin(), meshInstances.end());
-		finalizedDrawCalls.emplace_back(mesh.first, meshInstances.size(), startingIdxInInstancesBuffer);
+		addBatch(mesh.first, mesh.second);
 	}
 
 	startIdxTranslucentDrawCalls = finalizedDrawCalls.size();
 
 	for (const auto& mesh : instanceTranslucentMeshes)
 	{
-		const auto& meshInstances = mesh.second;
-		size_t startingIdxInInstancesBuffer = instancesData.size();
-		instancesData.insert(instancesData.end(), meshInstances.begin(), meshInstances.end());
-		finalizedDrawCalls.emplace_back(mesh.first, meshInstances.size(), startingIdxInInstancesBuffer);
+		addBatch(mesh.first, mesh.second);
 	}
 
 	startIdxTranslucentNoDepthWriteDrawCalls = finalizedDrawCalls.size();
 
 	for (const auto& mesh : instanceTranslucentMeshesNoDepthWrite)
 	{
-		const auto& meshInstances = mesh.second;
-		size_t startingIdxInInstancesBuffer = instancesData.size();
-		instancesData.insert(instancesData.end(), meshInstances.begin(), meshInstances.end());
-		finalizedDrawCalls.emplace_back(mesh.first, meshInstances.size(), startingIdxInInstancesBuffer);
+		addBatch(mesh.first, mesh.second);
 	}
 
 	startIdxAdditiveDrawCalls = finalizedDrawCalls.size();
 
 	for (const auto& mesh : instanceAdditiveMeshes)
 	{
-		const auto& meshInstances = mesh.second;
-		size_t startingIdxInInstancesBuffer = instancesData.size();
-		instancesData.insert(instancesData.end(), meshInstances.begin(), meshInstances.end());
-		finalizedDrawCalls.emplace_back(mesh.first, meshInstances.size(), startingIdxInInstancesBuffer);
+		addBatch(mesh.first, mesh.second);
 	}
 
+	instancesData.resize(totalInstances);
+	wzParallelFor(finalizedDrawCalls.size(), 16, [this](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i)
+		{
+			const InstancedDrawCall& call = finalizedDrawCalls[i];
+			std::copy_n(batchSources[i], call.instance_count, instancesData.begin() + call.startingIdxInInstancesBuffer);
+		}
+	});
+
 	// Upload buffer
 	++currInstanceBufferIdx;
 	if (currInstanceBufferIdx >= instanceDataBuffers.size())
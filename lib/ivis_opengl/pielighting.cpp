@@ -61,6 +61,13 @@ const PIELIGHT& LightMap::operator()(int32_t x, int32_t y) const
 	return data[x + (y * mapWidth)];
 }
 
+const PIELIGHT* LightMap::row(int32_t y) const
+{
+	ASSERT(y >= -1 && y < mapHeight + 1, "mapTile: y value is out of range (%d) in %dx%d", y, mapWidth, mapHeight);
+	y = std::min(std::max(y, 0), mapHeight - 1);
+	return &data[y * mapWidth];
+}
+
 void LightMap::reset(size_t width, size_t height)
 {
 	mapWidth = static_cast<int32_t>(width);
@@ -40,6 +40,10 @@ struct LightMap
 {
 	PIELIGHT& operator()(int32_t x, int32_t y);
 	const PIELIGHT& operator()(int32_t x, int32_t y) const;
+	/// The `width()` values of row `y` (clamped like operator()), for loops over whole rows
+	const PIELIGHT* row(int32_t y) const;
+	int32_t width() const { return mapWidth; }
+	int32_t height() const { return mapHeight; }
 
 	void reset(size_t width, size_t height);
 private:
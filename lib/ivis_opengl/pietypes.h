@@ -111,6 +111,7 @@ enum SHADER_MODE
 	SHADER_WATER,
 	SHADER_RECT,
 	SHADER_RECT_INSTANCED,
+	SHADER_IMAGE_INSTANCED,
 	SHADER_TEXRECT,
 	SHADER_GFX_COLOUR,
 	SHADER_GFX_TEXT,
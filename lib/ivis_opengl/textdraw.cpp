@@ -103,11 +103,11 @@ namespace HBFeature
 struct RasterizedGlyph
 {
 	std::unique_ptr<unsigned char[]> buffer;
-	uint32_t pitch;
-	uint32_t width;
-	uint32_t height;
-	int32_t bearing_x;
-	int32_t bearing_y;
+	uint32_t pitch = 0;
+	uint32_t width = 0;
+	uint32_t height = 0;
+	int32_t bearing_x = 0;
+	int32_t bearing_y = 0;
 };
 
 struct GlyphMetrics
@@ -375,83 +375,130 @@ namespace std {
 
 }
 
-struct FTCache
+// A rasterized glyph depends on the sub-pixel pen position it is rendered at, as well as the face and glyph
+struct FTRasterCacheKey
 {
-	FTCache()
-	: m_glyphCache(256, 16)
+	FTFace* face;
+	uint32_t codepoint;
+	int32_t subpixelX;
+	int32_t subpixelY;
+
+	FTRasterCacheKey(FTFace& face, uint32_t codepoint, Vector2i subpixeloffset64)
+	: face(&face), codepoint(codepoint), subpixelX(subpixeloffset64.x), subpixelY(subpixeloffset64.y)
 	{ }
 
-	RasterizedGlyph get(FTFace& face, uint32_t codePoint, Vector2i subpixeloffset64)
+	bool operator==(const FTRasterCacheKey& other) const
 	{
-		FT_Glyph glyph = getGlyph(face, codePoint);
-		ASSERT_OR_RETURN({}, glyph != nullptr, "Failed to get glyph: %" PRIu32, codePoint);
+		return face == other.face && codepoint == other.codepoint && subpixelX == other.subpixelX && subpixelY == other.subpixelY;
+	}
+};
 
-		FT_Vector delta;
-		delta.x = subpixeloffset64.x;
-		delta.y = subpixeloffset64.y;
+namespace std {
 
-		FT_Error error = FT_Glyph_To_Bitmap(&glyph, WZ_FT_RENDER_MODE, &delta, 0);
-		ASSERT_OR_RETURN({}, error == FT_Err_Ok, "Failed to render glyph: %" PRIu32, codePoint);
-		// After this point, glyph is actually a new FT_BitmapGlyph (which must be released when done)
+	template <>
+	struct hash<FTRasterCacheKey>
+	{
+		std::size_t operator()(const FTRasterCacheKey& k) const
+		{
+			// sub-pixel offsets are in (-64, 64)
+			return std::hash<FTFace*>()(k.face)
+				 ^ (std::hash<uint32_t>()(k.codepoint) << 1)
+				 ^ (std::hash<int32_t>()(((k.subpixelX & 0x7F) << 7) | (k.subpixelY & 0x7F)) << 2);
+		}
+	};
 
-		FT_BitmapGlyph glyph_bitmap = (FT_BitmapGlyph)glyph;
-		FT_Bitmap ftBitmap = glyph_bitmap->bitmap;
+}
 
-		RasterizedGlyph g;
-		g.buffer.reset(new unsigned char[ftBitmap.pitch * ftBitmap.rows]);
-		if (ftBitmap.buffer != nullptr)
+struct FTCache
+{
+	FTCache()
+	: m_glyphCache(256, 16)
+	, m_rasterCache(2048, 256)
+	, m_metricsCache(8192, 1024)
+	{ }
+
+	// Returns the glyph rendered at the given sub-pixel offset. Rendered glyphs are shared by every string
+	// that uses them, so laying out and drawing text only rasterizes glyphs that have not been seen recently.
+	std::shared_ptr<const RasterizedGlyph> get(FTFace& face, uint32_t codePoint, Vector2i subpixeloffset64)
+	{
+		const FTRasterCacheKey key(face, codePoint, subpixeloffset64);
+		std::shared_ptr<const RasterizedGlyph> *pCachedRaster = m_rasterCache.tryGetPt(key);
+		if (pCachedRaster)
 		{
-			memcpy(g.buffer.get(), ftBitmap.buffer, ftBitmap.pitch * ftBitmap.rows);
+			return *pCachedRaster;
 		}
-		else
+
+		std::shared_ptr<const RasterizedGlyph> result = rasterize(face, codePoint, subpixeloffset64);
+		if (!result)
 		{
-			ASSERT(ftBitmap.pitch == 0 || ftBitmap.rows == 0, "Glyph buffer missing (%d and %d)", ftBitmap.pitch, ftBitmap.rows);
+			static const std::shared_ptr<const RasterizedGlyph> emptyGlyph = std::make_shared<RasterizedGlyph>();
+			return emptyGlyph;
 		}
-		g.width = ftBitmap.width / 3;
-		g.height = ftBitmap.rows;
-		g.bearing_x = glyph_bitmap->left;
-		g.bearing_y = glyph_bitmap->top;
-		g.pitch = ftBitmap.pitch;
-
-		FT_Done_Glyph(glyph);
-		return g;
+		m_rasterCache.insert(key, result);
+		m_metricsCache.insert(key, GlyphMetrics{result->width, result->height, result->bearing_x, result->bearing_y});
+		return result;
 	}
 
 	GlyphMetrics getGlyphMetrics(FTFace& face, uint32_t codePoint, Vector2i subpixeloffset64)
+	{
+		const FTRasterCacheKey key(face, codePoint, subpixeloffset64);
+		GlyphMetrics *pCachedMetrics = m_metricsCache.tryGetPt(key);
+		if (pCachedMetrics)
+		{
+			return *pCachedMetrics;
+		}
+
+		// The bitmap size (including the LCD filter padding) is only known once rendered, so a miss renders the
+		// glyph once - into the raster cache, where drawing the same text will find it.
+		std::shared_ptr<const RasterizedGlyph> glyph = get(face, codePoint, subpixeloffset64);
+		return GlyphMetrics{glyph->width, glyph->height, glyph->bearing_x, glyph->bearing_y};
+	}
+
+public:
+	void clear()
+	{
+		m_glyphCache.clear();
+		m_rasterCache.clear();
+		m_metricsCache.clear();
+	}
+
+private:
+	std::shared_ptr<const RasterizedGlyph> rasterize(FTFace& face, uint32_t codePoint, Vector2i subpixeloffset64)
 	{
 		FT_Glyph glyph = getGlyph(face, codePoint);
-		ASSERT_OR_RETURN({}, glyph != nullptr, "Failed to get glyph: %" PRIu32, codePoint);
+		ASSERT_OR_RETURN(nullptr, glyph != nullptr, "Failed to get glyph: %" PRIu32, codePoint);
 
 		FT_Vector delta;
 		delta.x = subpixeloffset64.x;
 		delta.y = subpixeloffset64.y;
 
-		// FUTURE FIXME: Surely there is a better way of getting the metrics we need? ....
 		FT_Error error = FT_Glyph_To_Bitmap(&glyph, WZ_FT_RENDER_MODE, &delta, 0);
-		ASSERT_OR_RETURN({}, error == FT_Err_Ok, "Failed to render glyph: %" PRIu32, codePoint);
+		ASSERT_OR_RETURN(nullptr, error == FT_Err_Ok, "Failed to render glyph: %" PRIu32, codePoint);
 		// After this point, glyph is actually a new FT_BitmapGlyph (which must be released when done)
 
 		FT_BitmapGlyph glyph_bitmap = (FT_BitmapGlyph)glyph;
 		FT_Bitmap ftBitmap = glyph_bitmap->bitmap;
 
-		GlyphMetrics result {
-			ftBitmap.width / 3,
-			ftBitmap.rows,
-			glyph_bitmap->left, glyph_bitmap->top
-		};
+		auto g = std::make_shared<RasterizedGlyph>();
+		g->buffer.reset(new unsigned char[ftBitmap.pitch * ftBitmap.rows]);
+		if (ftBitmap.buffer != nullptr)
+		{
+			memcpy(g->buffer.get(), ftBitmap.buffer, ftBitmap.pitch * ftBitmap.rows);
+		}
+		else
+		{
+			ASSERT(ftBitmap.pitch == 0 || ftBitmap.rows == 0, "Glyph buffer missing (%d and %d)", ftBitmap.pitch, ftBitmap.rows);
+		}
+		g->width = ftBitmap.width / 3;
+		g->height = ftBitmap.rows;
+		g->bearing_x = glyph_bitmap->left;
+		g->bearing_y = glyph_bitmap->top;
+		g->pitch = ftBitmap.pitch;
 
 		FT_Done_Glyph(glyph);
-
-		return result;
-	}
-
-public:
-	void clear()
-	{
-		m_glyphCache.clear();
+		return g;
 	}
 
-private:
 	// The glyph is owned by the cache - if transforms are needed, the caller should use FT_Glyph_Copy to make a copy and modify the copy!
 	FT_Glyph getGlyph(FTFace& face, uint32_t codepoint)
 	{
@@ -509,6 +556,8 @@ private:
 	};
 
 	lru11::Cache<FTGlyphCacheKey, WZOwnedFTGlyph> m_glyphCache;
+	lru11::Cache<FTRasterCacheKey, std::shared_ptr<const RasterizedGlyph>> m_rasterCache;
+	lru11::Cache<FTRasterCacheKey, GlyphMetrics> m_metricsCache;
 };
 
 static FTCache* glyphCache = nullptr;
@@ -788,26 +837,28 @@ struct TextShaper
 		// build glyphes
 		struct glyphRaster
 		{
-			std::unique_ptr<unsigned char[]> buffer;
+			std::shared_ptr<const RasterizedGlyph> glyph; // shared with the glyph cache
 			Vector2i pixelPosition;
 			Vector2i size;
 			uint32_t pitch;
 
-			glyphRaster(std::unique_ptr<unsigned char[]> &&b, Vector2i &&p, Vector2i &&s, uint32_t _pitch)
-				: buffer(std::move(b)), pixelPosition(p), size(s), pitch(_pitch) {}
+			glyphRaster(std::shared_ptr<const RasterizedGlyph> &&g, Vector2i &&p, Vector2i &&s, uint32_t _pitch)
+				: glyph(std::move(g)), pixelPosition(p), size(s), pitch(_pitch) {}
 		};
 
 		std::vector<glyphRaster> glyphs;
 		std::transform(shapingResult.glyphes.begin(), shapingResult.glyphes.end(), std::back_inserter(glyphs),
 			[&] (const HarfbuzzPosition &g) {
-			RasterizedGlyph glyph = glyphCache->get(g.face, g.codepoint, g.penPosition % 64);
-			int32_t x0 = g.penPosition.x / 64 + glyph.bearing_x;
-			int32_t y0 = g.penPosition.y / 64 - glyph.bearing_y;
+			std::shared_ptr<const RasterizedGlyph> glyph = glyphCache->get(g.face, g.codepoint, g.penPosition % 64);
+			int32_t x0 = g.penPosition.x / 64 + glyph->bearing_x;
+			int32_t y0 = g.penPosition.y / 64 - glyph->bearing_y;
 			min_x = std::min(x0, min_x);
-			max_x = std::max(static_cast<int32_t>(x0 + glyph.width), max_x);
+			max_x = std::max(static_cast<int32_t>(x0 + glyph->width), max_x);
 			min_y = std::min(y0, min_y);
-			max_y = std::max(static_cast<int32_t>(y0 + glyph.height), max_y);
-			return glyphRaster(std::move(glyph.buffer), Vector2i(x0, y0), Vector2i(glyph.width, glyph.height), glyph.pitch);
+			max_y = std::max(static_cast<int32_t>(y0 + glyph->height), max_y);
+			Vector2i size(glyph->width, glyph->height);
+			const uint32_t pitch = glyph->pitch;
+			return glyphRaster(std::move(glyph), Vector2i(x0, y0), std::move(size), pitch);
 			});
 
 		const uint32_t texture_width = max_x - min_x + 1;
@@ -839,7 +890,7 @@ struct TextShaper
 						uint32_t j0 = g.pixelPosition.x - min_x;
 						const auto srcBufferPos = i * g.pitch + 3 * j;
 						ASSERT(srcBufferPos + 2 < glyphBufferSize, "Invalid source (%" PRIu32" / %" PRIu32") reading glyph %zu for string \"%s\"; (%d, %d, %d, %d, %" PRIu32 ", %d, %d, %d, %" PRIu32 ", %" PRIu32 ")", srcBufferPos, glyphBufferSize, glyphNum, text.toUtf8().c_str(), i, g.size.y, g.pixelPosition.y, min_y, i0, j, g.pixelPosition.x, min_x, j0, g.pitch);
-						uint8_t const *src = &g.buffer[srcBufferPos];
+						uint8_t const *src = &g.glyph->buffer[srcBufferPos];
 						const auto stringTexturePos = 4 * ((i0 + i) * texture_width + j + j0);
 						ASSERT(stringTexturePos + 3 < stringTextureSize, "Invalid destination (%" PRIu32" / %zu) writing glyph %zu for string \"%s\"; (%d, %d, %d, %d, %" PRIu32 ", %d, %d, %d, %" PRIu32 ", %" PRIu32 ")", stringTexturePos, stringTextureSize, glyphNum, text.toUtf8().c_str(), i, g.size.y, g.pixelPosition.y, min_y, i0, j, g.pixelPosition.x, min_x, j0, texture_width);
 						uint8_t *dst = &stringTexture[stringTexturePos];
@@ -138,6 +138,7 @@ struct NETSTATS  // data regarding the last one second or so.
 	Statistic       rawBytes;               // Number of actual bytes, in about 1 sec.
 	Statistic       uncompressedBytes;      // Number of bytes sent, before compression, in about 1 sec.
 	Statistic       packets;                // Number of calls to writeAll, in about 1 sec.
+	Statistic       copiedBytes;            // Number of received bytes copied by the net queues (not sent), in about 1 sec.
 };
 
 struct NET_PLAYER_DATA
@@ -320,11 +321,12 @@ static int32_t          NetGameFlags[4] = { 0, 0, 0, 0 };
 char iptoconnect[PATH_MAX] = "\0"; // holds IP/hostname from command line
 bool cliConnectAsSpectator = false; // for cli option
 
-static NETSTATS nStats              = {{0, 0}, {0, 0}, {0, 0}};
-static NETSTATS nStatsLastSec       = {{0, 0}, {0, 0}, {0, 0}};
-static NETSTATS nStatsSecondLastSec = {{0, 0}, {0, 0}, {0, 0}};
-static const NETSTATS nZeroStats    = {{0, 0}, {0, 0}, {0, 0}};
+static NETSTATS nStats              = {{0, 0}, {0, 0}, {0, 0}, {0, 0}};
+static NETSTATS nStatsLastSec       = {{0, 0}, {0, 0}, {0, 0}, {0, 0}};
+static NETSTATS nStatsSecondLastSec = {{0, 0}, {0, 0}, {0, 0}, {0, 0}};
+static const NETSTATS nZeroStats    = {{0, 0}, {0, 0}, {0, 0}, {0, 0}};
 static int nStatsLastUpdateTime = 0;
+static size_t copiedBytesAtReset = 0;  // Net queues count copies from startup, statistics are reset in NETshutdown.
 
 unsigned NET_PlayerConnectionStatus[CONNECTIONSTATUS_NORMAL][MAX_CONNECTED_PLAYERS];
 std::vector<optional<uint32_t>>	NET_waitingForIndexChangeAckSince = std::vector<optional<uint32_t>>(MAX_CONNECTED_PLAYERS, nullopt);	///< If waiting for the client to acknowledge a player index change, this is the realTime we started waiting
@@ -1423,6 +1425,7 @@ int NETshutdown()
 	nStats = nZeroStats;
 	nStatsLastSec = nZeroStats;
 	nStatsSecondLastSec = nZeroStats;
+	copiedBytesAtReset = NETqueueReceivedBytesCopied();
 
 	return 0;
 }
@@ -1533,9 +1536,12 @@ size_t NETgetStatistic(NetStatisticType type, bool sent, bool isTotal)
 	case NetStatisticRawBytes:          statsType = &NETSTATS::rawBytes;          break;
 	case NetStatisticUncompressedBytes: statsType = &NETSTATS::uncompressedBytes; break;
 	case NetStatisticPackets:           statsType = &NETSTATS::packets;           break;
+	case NetStatisticCopiedBytes:       statsType = &NETSTATS::copiedBytes;       break;
 	default: ASSERT(false, " "); return 0;
 	}
 
+	nStats.copiedBytes.received = NETqueueReceivedBytesCopied() - copiedBytesAtReset;
+
 	int time = wzGetTicks();
 	if ((unsigned)(time - nStatsLastUpdateTime) >= (unsigned)GAME_TICKS_PER_SEC)
 	{
@@ -2873,7 +2879,6 @@ bool NETrecvNet(NETQUEUE *queue, uint8_t *type)
 	}
 
 	uint32_t current;
-	uint8_t buffer[NET_BUFFER_SIZE];
 	for (current = 0; current < MAX_CONNECTED_PLAYERS; ++current)
 	{
 		IClientConnection** pSocket = NetPlay.isHost ? &connected_bsocket[current] : &bsocket;
@@ -2888,11 +2893,13 @@ bool NETrecvNet(NETQUEUE *queue, uint8_t *type)
 			continue;
 		}
 
-		size_t dataLen = NET_fillBuffer(pSocket, pollGroup, buffer, sizeof(buffer));
+		// Read straight into the queue's slab, which the messages parsed from the data share
+		std::span<uint8_t> buffer = NETreceiveBuffer(NETnetQueue(current), NET_BUFFER_SIZE);
+		size_t dataLen = NET_fillBuffer(pSocket, pollGroup, buffer.data(), static_cast<int>(buffer.size()));
 		if (dataLen > 0)
 		{
 			// we received some data, add to buffer
-			NETinsertRawData(NETnetQueue(current), buffer, dataLen);
+			NETcommitReceivedData(NETnetQueue(current), dataLen);
 		}
 		else if (*pSocket == nullptr)
 		{
@@ -5022,6 +5029,7 @@ const char *messageTypeToString(unsigned messageType_)
 	case GAME_DEBUG_FINISH_RESEARCH:    return "GAME_DEBUG_FINISH_RESEARCH";
 	// End of redundant messages.
 	case GAME_SYNC_OPT_CHANGE:			return "GAME_SYNC_OPT_CHANGE";
+	case GAME_DROIDINFO_BATCH:          return "GAME_DROIDINFO_BATCH";
 	case GAME_MAX_TYPE:                 return "GAME_MAX_TYPE";
 
 	// The following messages are used for playing back replays.
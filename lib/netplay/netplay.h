@@ -145,6 +145,7 @@ enum MESSAGE_TYPES
 	GAME_DEBUG_FINISH_RESEARCH,     ///< Research has been completed.
 	// End of debug messages.
 	GAME_SYNC_OPT_CHANGE,			///< Change synchronized options for a player (ex formation options)
+	GAME_DROIDINFO_BATCH,           ///< update droid orders, batched and delta-encoded (replaces GAME_DROIDINFO, which is still read from old replays).
 	GAME_MAX_TYPE,                  ///< Maximum+1 valid GAME_ type, *MUST* be last.
 
 	// The following messages are used for playing back replays.
@@ -339,7 +340,7 @@ void NETremRedirects();
 /// (NETrecvNet, in particular) when the operation is complete.
 void NETinitPortMapping();
 
-enum NetStatisticType {NetStatisticRawBytes, NetStatisticUncompressedBytes, NetStatisticPackets};
+enum NetStatisticType {NetStatisticRawBytes, NetStatisticUncompressedBytes, NetStatisticPackets, NetStatisticCopiedBytes};
 size_t NETgetStatistic(NetStatisticType type, bool sent, bool isTotal = false);     // Return some statistic. Call regularly for good results.
 
 void NETplayerKicked(UDWORD index, bool quiet = false);			// Cleanup after player has been kicked
@@ -31,6 +31,51 @@
 
 // See comments in netqueue.h.
 
+// Data from the network is read into slabs of this size, so that a read rarely has to wait for the next one.
+static constexpr size_t RECEIVE_SLAB_SIZE = MaxMsgSize * 8;
+// A new slab is started once the current one has less room than this left.
+static constexpr size_t RECEIVE_SLAB_MIN_FREE = MaxMsgSize * 2;
+// Slabs kept for reuse once no message refers to them anymore.
+static constexpr size_t MAX_FREE_RECEIVE_SLABS = 8;
+
+static std::vector<std::unique_ptr<NetReceiveSlab>> freeReceiveSlabs;
+static size_t receivedBytesCopied = 0;
+
+static NetReceiveSlabPtr allocReceiveSlab(size_t capacity)
+{
+	std::unique_ptr<NetReceiveSlab> slab;
+	for (auto i = freeReceiveSlabs.begin(); i != freeReceiveSlabs.end(); ++i)
+	{
+		if ((*i)->capacity >= capacity)
+		{
+			slab = std::move(*i);
+			freeReceiveSlabs.erase(i);
+			break;
+		}
+	}
+	if (!slab)
+	{
+		slab = std::make_unique<NetReceiveSlab>();
+		slab->bytes = std::unique_ptr<uint8_t[]>(new uint8_t[capacity]);  // Not zeroed, it is written by the network.
+		slab->capacity = capacity;
+	}
+	return NetReceiveSlabPtr(slab.release(), [](NetReceiveSlab *unused) {
+		if (freeReceiveSlabs.size() < MAX_FREE_RECEIVE_SLABS)
+		{
+			freeReceiveSlabs.emplace_back(unused);
+		}
+		else
+		{
+			delete unused;
+		}
+	});
+}
+
+size_t NETqueueReceivedBytesCopied()
+{
+	return receivedBytesCopied;
+}
+
 
 // Byte n is the final byte, iff it is less than 256-a[n].
 
@@ -108,30 +153,40 @@ bool decode_uint32_t(uint8_t b, uint32_t &v, unsigned n)
 }
 
 NetMessage::NetMessage(NetMsgDataVector&& data)
-	: data_(std::move(data))
+{
+	auto owned = std::allocate_shared<NetMsgDataVector>(PoolAllocator<NetMsgDataVector>(defaultMemoryPool()), std::move(data));
+	data_ = owned->data();
+	size_ = owned->size();
+	owner_ = std::move(owned);
+}
+
+NetMessage::NetMessage(std::shared_ptr<const void> owner, const uint8_t* data, size_t size)
+	: owner_(std::move(owner))
+	, data_(data)
+	, size_(size)
 {}
 
 uint8_t NetMessage::type() const
 {
-	ASSERT_OR_RETURN(0, !data_.empty(), "Invalid message data");
+	ASSERT_OR_RETURN(0, size_ > 0, "Invalid message data");
 	return data_[0];
 }
 
-const NetMsgDataVector& NetMessage::rawData() const
+std::span<const uint8_t> NetMessage::rawData() const
 {
-	return data_;
+	return std::span<const uint8_t>(data_, size_);
 }
 
 const uint8_t* NetMessage::payload() const
 {
-	ASSERT_OR_RETURN(nullptr, !data_.empty() && data_.size() >= HEADER_LENGTH, "Invalid message data");
-	return &data_[HEADER_LENGTH];
+	ASSERT_OR_RETURN(nullptr, size_ >= HEADER_LENGTH, "Invalid message data");
+	return data_ + HEADER_LENGTH;
 }
 
 size_t NetMessage::payloadSize() const
 {
-	ASSERT_OR_RETURN(0, data_.size() >= HEADER_LENGTH, "Invalid message data");
-	return data_.size() - HEADER_LENGTH;
+	ASSERT_OR_RETURN(0, size_ >= HEADER_LENGTH, "Invalid message data");
+	return size_ - HEADER_LENGTH;
 }
 
 optional<NetMessage> NetMessage::tryFromRawData(const uint8_t* buffer, size_t bufferLen)
@@ -156,8 +211,34 @@ optional<NetMessage> NetMessage::tryFromRawData(const uint8_t* buffer, size_t bu
 void NetMessage::rawDataAppendToVector(std::vector<uint8_t>& output) const
 {
 	const size_t oldLen = output.size();
-	output.resize(output.size() + data_.size());
-	std::memcpy(&output[oldLen], data_.data(), data_.size());
+	output.resize(output.size() + size_);
+	if (size_ > 0)
+	{
+		std::memcpy(&output[oldLen], data_, size_);
+	}
+}
+
+NetMessage NetMessage::embeddedMessage(size_t offset, size_t length) const
+{
+	offset = std::min(offset, size_);
+	length = std::min(length, size_ - offset);
+	const uint8_t *raw = data_ + offset;
+	if (length < HEADER_LENGTH)
+	{
+		return NetMessageBuilder(length > 0 ? raw[0] : 0, 0).build();  // Truncated, keep the type only.
+	}
+
+	uint16_t len = 0;
+	wz_ntohs_load_unaligned(len, &raw[1]);
+	if (len == length - HEADER_LENGTH)
+	{
+		return NetMessage(owner_, raw, length);
+	}
+
+	// The length in the header is wrong, copy the message so build() can fix it up.
+	receivedBytesCopied += length;
+	NetMsgDataVector rawData(raw, raw + length, MsgDataAllocator(defaultMemoryPool()));
+	return NetMessageBuilder(std::move(rawData)).build();
 }
 
 NetMessageBuilder::NetMessageBuilder(uint8_t type, size_t reservedCapacity /* = 16 */)
@@ -176,6 +257,8 @@ NetQueue::NetQueue()
 	: canGetMessagesForNet(true)
 	, canGetMessages(true)
 	, messages(MsgAllocator(defaultMemoryPool()))
+	, receiveSlabParsed(0)
+	, receiveSlabUsed(0)
 	, pendingGameTimeUpdateMessages(0)
 	, bCurrentMessageWasDecrypted(false)
 {
@@ -185,43 +268,72 @@ NetQueue::NetQueue()
 
 void NetQueue::writeRawData(const uint8_t *netData, size_t netLen)
 {
-	size_t used = 0;
-	std::vector<uint8_t> &buffer = incompleteReceivedMessageData;  // Short alias.
+	while (netLen > 0)
+	{
+		std::span<uint8_t> buffer = receiveBuffer(netLen);
+		const size_t len = std::min(netLen, buffer.size());
+		memcpy(buffer.data(), netData, len);
+		receivedBytesCopied += len;
+		commitReceivedData(len);
+		netData += len;
+		netLen -= len;
+	}
+}
 
-	// Insert the data.
-	buffer.insert(buffer.end(), netData, netData + netLen);
+std::span<uint8_t> NetQueue::receiveBuffer(size_t maxLen)
+{
+	const size_t minLen = std::min(maxLen, RECEIVE_SLAB_MIN_FREE);
+	if (!receiveSlab || receiveSlab->capacity - receiveSlabUsed < minLen)
+	{
+		// Start a new slab, taking along the data which has not yet formed an entire message. The old slab stays alive
+		// until the messages parsed from it are popped.
+		const size_t incompleteLen = receiveSlabUsed - receiveSlabParsed;
+		NetReceiveSlabPtr slab = allocReceiveSlab(std::max(RECEIVE_SLAB_SIZE, incompleteLen + minLen));
+		if (incompleteLen > 0)
+		{
+			memcpy(slab->bytes.get(), receiveSlab->bytes.get() + receiveSlabParsed, incompleteLen);
+			receivedBytesCopied += incompleteLen;
+		}
+		receiveSlab = std::move(slab);
+		receiveSlabParsed = 0;
+		receiveSlabUsed = incompleteLen;
+	}
+
+	return std::span<uint8_t>(receiveSlab->bytes.get() + receiveSlabUsed, std::min(maxLen, receiveSlab->capacity - receiveSlabUsed));
+}
+
+void NetQueue::commitReceivedData(size_t len)
+{
+	ASSERT_OR_RETURN(, receiveSlab != nullptr && len <= receiveSlab->capacity - receiveSlabUsed, "Data was not written to receiveBuffer");
+	receiveSlabUsed += len;
 
 	// Extract the messages.
-	while (buffer.size() - used >= NetMessage::HEADER_LENGTH)
+	const uint8_t *buffer = receiveSlab->bytes.get();
+	while (receiveSlabUsed - receiveSlabParsed >= NetMessage::HEADER_LENGTH)
 	{
-		uint8_t type = buffer[used];
-		uint16_t len = 0;
+		uint8_t type = buffer[receiveSlabParsed];
+		uint16_t msgLen = 0;
 		// Load payload length from uint16_t (network byte order) starting at the second byte of the data buffer.
-		wz_ntohs_load_unaligned(len, &buffer[used + 1]);
+		wz_ntohs_load_unaligned(msgLen, &buffer[receiveSlabParsed + 1]);
 
-		if (buffer.size() - used - NetMessage::HEADER_LENGTH < len)
+		if (receiveSlabUsed - receiveSlabParsed - NetMessage::HEADER_LENGTH < msgLen)
 		{
 			break;  // Don't have a whole message ready yet.
 		}
 
-		NetMessageBuilder msg(type, len);
-		msg.append(buffer.data() + used + NetMessage::HEADER_LENGTH, len);
-		messages.emplace_front(msg.build());
+		messages.emplace_front(NetMessage(receiveSlab, buffer + receiveSlabParsed, NetMessage::HEADER_LENGTH + msgLen));
 
 		if (type == GAME_GAME_TIME)
 		{
 			++pendingGameTimeUpdateMessages;
 		}
-		used += NetMessage::HEADER_LENGTH + len;
+		receiveSlabParsed += NetMessage::HEADER_LENGTH + msgLen;
 	}
-
-	// Recycle old data.
-	buffer.erase(buffer.begin(), buffer.begin() + used);
 }
 
 size_t NetQueue::currentIncompleteDataBuffered() const
 {
-	return incompleteReceivedMessageData.size();
+	return receiveSlabUsed - receiveSlabParsed;
 }
 
 std::vector<std::vector<uint8_t>> NetQueue::snapshotUnreadMessages() const
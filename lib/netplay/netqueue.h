@@ -29,6 +29,8 @@
 #include "lib/netplay/byteorder_funcs_wrapper.h"
 #include <vector>
 #include <list>
+#include <memory>
+#include <span>
 
 #include <nonstd/optional.hpp>
 using nonstd::optional;
@@ -37,6 +39,15 @@ using nonstd::nullopt;
 using MsgDataAllocator = PoolAllocator<uint8_t, MemoryPool>;
 using NetMsgDataVector = std::vector<uint8_t, MsgDataAllocator>;
 
+/// Block of bytes read from the network. The NetMessages parsed from it share it instead of copying their bytes out,
+/// and it is recycled once the last of them is gone. Main thread only, like the NetQueues.
+struct NetReceiveSlab
+{
+	std::unique_ptr<uint8_t[]> bytes;
+	size_t capacity = 0;
+};
+using NetReceiveSlabPtr = std::shared_ptr<NetReceiveSlab>;
+
 // At game level:
 // There should be a NetQueue representing each client.
 // Clients should serialise messages to their own queue.
@@ -53,7 +64,8 @@ using NetMsgDataVector = std::vector<uint8_t, MsgDataAllocator>;
 /// Instances of this class are immutable after creation, and should be created by using
 /// the NetMessageBuilder class.
 ///
-/// The binary layout of a NetMessage is as follows (stored internally as `std::vector<uint8_t>`):
+/// The binary layout of a NetMessage is as follows (stored either in a `NetMsgDataVector` owned by the message, or in a
+/// `NetReceiveSlab` shared with the other messages received along with it):
 ///
 /// | Type (1 byte) | Payload Length (2 bytes) | Payload (variable length) |
 ///
@@ -77,7 +89,8 @@ public:
 	NetMessage& operator=(const NetMessage&) = default;
 
 	uint8_t type() const;
-	const NetMsgDataVector& rawData() const;
+	/// The whole message, header included. Only valid as long as this message (or a copy of it) is.
+	std::span<const uint8_t> rawData() const;
 	/// Returns a pointer to the payload data (offset by `HEADER_LENGTH` from the beginning of the raw data).
 	const uint8_t* payload() const;
 	size_t payloadSize() const;
@@ -85,14 +98,24 @@ public:
 	// Append the raw data of this message to the provided output vector.
 	void rawDataAppendToVector(std::vector<uint8_t>& output) const;
 
+	/// Returns the message stored in raw form at [offset, offset + length) of this message's raw data (see `NETnetMessage`).
+	/// It shares this message's bytes, unless its header doesn't match `length`, in which case it is copied and fixed up.
+	NetMessage embeddedMessage(size_t offset, size_t length) const;
+
 private:
 
 	// Meant to be executed only by NetMessageBuilder
 	explicit NetMessage(NetMsgDataVector&& data);
 
+	// Meant to be executed only by NetQueue, for messages parsed in place from received data
+	NetMessage(std::shared_ptr<const void> owner, const uint8_t* data, size_t size);
+
 	friend class NetMessageBuilder;
+	friend class NetQueue;
 
-	NetMsgDataVector data_;
+	std::shared_ptr<const void> owner_;  ///< Keeps `data_` alive: the vector built by NetMessageBuilder, or a received slab.
+	const uint8_t* data_ = nullptr;
+	size_t size_ = 0;
 };
 
 /// <summary>
@@ -202,7 +225,7 @@ class MessageReader
 public:
 
 	explicit MessageReader(const NetMessage& m)
-		: msgData(&m.rawData()), index(NetMessage::HEADER_LENGTH), msgType(m.type())
+		: msg(&m), msgData(m.rawData()), index(NetMessage::HEADER_LENGTH), msgType(m.type())
 	{}
 
 	MessageReader(MessageReader&&) = default;
@@ -211,15 +234,15 @@ public:
 
 	void byte(uint8_t &v) const
 	{
-		v = index >= msgData->size() ? 0x00 : (*msgData)[index];
+		v = index >= msgData.size() ? 0x00 : msgData[index];
 		++index;
 	}
 	void bytes(uint8_t *pOut, size_t numBytes) const
 	{
-		size_t numCopyBytes = (index >= msgData->size()) ? 0 : std::min<size_t>(msgData->size() - index, numBytes);
+		size_t numCopyBytes = (index >= msgData.size()) ? 0 : std::min<size_t>(msgData.size() - index, numBytes);
 		if (numCopyBytes > 0)
 		{
-			memcpy(pOut, &((*msgData)[index]), numCopyBytes);
+			memcpy(pOut, &(msgData[index]), numCopyBytes);
 		}
 		if (numCopyBytes < numBytes)
 		{
@@ -232,21 +255,22 @@ public:
 	{
 		static_assert(std::is_same<typename VecT::value_type, uint8_t>::value, "Expected vector<uint8_t> as the argument");
 
-		size_t numCopyBytes = (index >= msgData->size()) ? 0 : std::min<size_t>(msgData->size() - index, desiredBytes);
+		size_t numCopyBytes = (index >= msgData.size()) ? 0 : std::min<size_t>(msgData.size() - index, desiredBytes);
 		if (numCopyBytes > 0)
 		{
 			size_t startIdx = vOut.size();
 			vOut.resize(vOut.size() + numCopyBytes);
-			memcpy(&(vOut[startIdx]), &((*msgData)[index]), numCopyBytes);
+			memcpy(&(vOut[startIdx]), &(msgData[index]), numCopyBytes);
 		}
 		index += numCopyBytes;
 	}
 	bool valid() const
 	{
-		return index <= msgData->size();
+		return index <= msgData.size();
 	}
 
-	const NetMsgDataVector* msgData;
+	const NetMessage* msg;
+	std::span<const uint8_t> msgData;
 	mutable size_t index = NetMessage::HEADER_LENGTH;
 	uint8_t msgType;
 };
@@ -263,6 +287,8 @@ public:
 
 	// Network related, receiving
 	void writeRawData(const uint8_t *netData, size_t netLen);          ///< Inserts data from the network into the NetQueue.
+	std::span<uint8_t> receiveBuffer(size_t maxLen);                   ///< Space for up to maxLen bytes from the network, in the slab the messages parsed from them will share. Never less than MaxMsgSize bytes.
+	void commitReceivedData(size_t len);                               ///< Inserts the first len bytes written to the last receiveBuffer, without copying them.
 	// Network related, sending
 	void setWillNeverGetMessagesForNet();                              ///< Marks that we will not be sending this data over the network.
 	unsigned numMessagesForNet() const;                                ///< Checks that we didn't mark that we will not be sending this data over the network (returns 0), and returns the number of messages to be sent.
@@ -328,7 +354,9 @@ private:
 	List::iterator                dataPos;                             ///< Last message which was sent over the network.
 	List::iterator                messagePos;                          ///< Last message which was popped.
 	List                          messages;                            ///< List of messages. Messages are added to the front and read from the back.
-	std::vector<uint8_t>          incompleteReceivedMessageData;       ///< Data from network which has not yet formed an entire message.
+	NetReceiveSlabPtr             receiveSlab;                         ///< Slab the latest received messages were parsed from, which the next data from the network goes into if it has room.
+	size_t                        receiveSlabParsed;                   ///< End of the messages parsed from receiveSlab. Data from network which has not yet formed an entire message follows.
+	size_t                        receiveSlabUsed;                     ///< End of the data from network in receiveSlab.
 	size_t                        pendingGameTimeUpdateMessages;       ///< Pending GAME_GAME_TIME messages added to this queue
 	bool						  bCurrentMessageWasDecrypted;
 };
@@ -348,6 +376,10 @@ public:
 	NetQueue receive;
 };
 
+/// Total number of received bytes copied by the NetQueues since startup: data that had to move to a new slab before
+/// forming an entire message, data inserted with writeRawData, and embedded messages which could not be shared.
+size_t NETqueueReceivedBytesCopied();
+
 /// Returns the number of bytes required to encode v.
 unsigned encodedlength_uint32_t(uint32_t v);
 /// Returns true iff there is another byte to be encoded.
@@ -230,6 +230,16 @@ void NETinsertRawData(NETQUEUE queue, uint8_t *data, size_t dataLen)
 	receiveQueue(queue)->writeRawData(data, dataLen);
 }
 
+std::span<uint8_t> NETreceiveBuffer(NETQUEUE queue, size_t maxLen)
+{
+	return receiveQueue(queue)->receiveBuffer(maxLen);
+}
+
+void NETcommitReceivedData(NETQUEUE queue, size_t dataLen)
+{
+	receiveQueue(queue)->commitReceivedData(dataLen);
+}
+
 void NETinsertMessageFromNet(NETQUEUE queue, NetMessage&& newMessage)
 {
 	receiveQueue(queue)->pushMessage(std::move(newMessage));
@@ -827,9 +837,14 @@ void NETVector2i(MessageReader& r, Vector2i& vec)
 
 void NETnetMessage(MessageReader& r, NetMessage** msg)
 {
-	NetMsgDataVector rawData{MsgDataAllocator(defaultMemoryPool())};
-	NETbytes(r, rawData, std::numeric_limits<uint32_t>::max());
-	*msg = new NetMessage(NetMessageBuilder(std::move(rawData)).build());
+	// Same encoding as NETbytes, but the message shares the bytes of the message it is read from.
+	uint32_t len = 0;
+	NETuint32_t(r, len);
+	const size_t offset = r.index;
+	const size_t available = offset < r.msgData.size() ? r.msgData.size() - offset : 0;
+	const size_t length = r.valid() ? std::min<size_t>(len, available) : 0;
+	r.index += length;
+	*msg = new NetMessage(r.msg->embeddedMessage(offset, length));
 }
 
 // MessageWriter overloads for encoding
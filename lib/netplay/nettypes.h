@@ -68,6 +68,8 @@ std::vector<std::vector<uint8_t>> NETgameQueueCapturePending(unsigned player);
 size_t NETgameQueueRestorePending(unsigned player, const std::vector<std::vector<uint8_t>> &rawMessages);
 
 void NETinsertRawData(NETQUEUE queue, uint8_t *data, size_t dataLen);  ///< Dump raw data from sockets and raw data sent via host here.
+std::span<uint8_t> NETreceiveBuffer(NETQUEUE queue, size_t maxLen);     ///< Space to read raw data from sockets into, so that the messages don't need to be copied out of it.
+void NETcommitReceivedData(NETQUEUE queue, size_t dataLen);             ///< Inserts the raw data read into NETreceiveBuffer.
 void NETinsertMessageFromNet(NETQUEUE queue, NetMessage&& message);     ///< Dump whole NetMessages into the queue.
 bool NETisMessageReady(NETQUEUE queue);       ///< Returns true if there is a complete message ready to deserialise in this queue.
 size_t NETincompleteMessageDataBuffered(NETQUEUE queue);
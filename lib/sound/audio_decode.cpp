@@ -0,0 +1,185 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+	This file is part of Warzone 2100.
+	Copyright (C) 2026  Warzone 2100 Project (https://github.com/Warzone2100)
+
+	Warzone 2100 is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	Warzone 2100 is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Warzone 2100; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+/** @file audio_decode.cpp
+ * Implementation of the audio decode thread (see audio_decode.h).
+ */
+
+#include "audio_decode.h"
+
+#include "lib/framework/frame.h"
+#include "lib/framework/wzapp.h"
+
+#include <algorithm>
+#include <string.h>
+#include <vector>
+
+AudioStreamDecode::AudioStreamDecode(WZDecoder *decoder_, size_t chunkCount, size_t chunkSize)
+	: ring(chunkCount, chunkSize)
+	, decoder(decoder_)
+	, numChannels(decoder_->channels())
+	, sampleRate(decoder_->frequency())
+	, duration(decoder_->totalTime())
+{ }
+
+AudioStreamDecode::~AudioStreamDecode()
+{
+	delete decoder;
+}
+
+bool AudioStreamDecode::fill()
+{
+	bool decoded = false;
+	while (!ring.isFinished() && !isCancelled())
+	{
+		uint8_t *chunk = ring.writeChunk();
+		if (!chunk)
+		{
+			break;
+		}
+		memset(chunk, 0, ring.chunkSize());
+		auto res = decoder->decode(chunk, ring.chunkSize());
+		if (!res.has_value())
+		{
+			ring.finish(true);
+			break;
+		}
+		if (res.value() == 0)
+		{
+			// End of the stream
+			ring.finish(false);
+			break;
+		}
+		ring.commitWrite(res.value());
+		decoded = true;
+	}
+	return decoded;
+}
+
+namespace
+{
+
+struct DecodeThread
+{
+	DecodeThread()
+	{
+		mutex = wzMutexCreate();
+		wake = wzSemaphoreCreate(0);
+		thread = wzThreadCreate(threadFunc, this, "wzAudioDecode");
+		if (thread)
+		{
+			wzThreadStart(thread);
+		}
+	}
+
+	~DecodeThread()
+	{
+		wzMutexLock(mutex);
+		quit = true;
+		wzMutexUnlock(mutex);
+		wzSemaphorePost(wake);
+		if (thread)
+		{
+			wzThreadJoin(thread);
+		}
+		wzSemaphoreDestroy(wake);
+		wzMutexDestroy(mutex);
+	}
+
+	static int threadFunc(void *data)
+	{
+		DecodeThread &self = *static_cast<DecodeThread *>(data);
+		std::vector<std::shared_ptr<AudioStreamDecode>> streams; // only used by this thread
+		for (;;)
+		{
+			wzSemaphoreWait(self.wake);
+
+			wzMutexLock(self.mutex);
+			if (self.quit)
+			{
+				wzMutexUnlock(self.mutex);
+				return 0;
+			}
+			streams.insert(streams.end(), self.newStreams.begin(), self.newStreams.end());
+			self.newStreams.clear();
+			wzMutexUnlock(self.mutex);
+
+			for (const auto &stream : streams)
+			{
+				stream->fill();
+			}
+			streams.erase(std::remove_if(streams.begin(), streams.end(), [](const std::shared_ptr<AudioStreamDecode> &stream) {
+				return stream->isCancelled() || stream->ring.isFinished();
+			}), streams.end());
+		}
+	}
+
+	WZ_THREAD *thread = nullptr;
+	WZ_MUTEX *mutex = nullptr;
+	WZ_SEMAPHORE *wake = nullptr;
+	std::vector<std::shared_ptr<AudioStreamDecode>> newStreams;
+	bool quit = false;
+};
+
+}
+
+static std::unique_ptr<DecodeThread> decodeThread;
+
+bool audioDecode_Start()
+{
+	if (!decodeThread)
+	{
+		decodeThread = std::make_unique<DecodeThread>();
+		if (!decodeThread->thread)
+		{
+			debug(LOG_ERROR, "Could not start the audio decode thread, decoding on the main loop");
+			decodeThread.reset();
+			return false;
+		}
+	}
+	return true;
+}
+
+void audioDecode_Stop()
+{
+	decodeThread.reset();
+}
+
+bool audioDecode_Running()
+{
+	return decodeThread != nullptr;
+}
+
+void audioDecode_AddStream(const std::shared_ptr<AudioStreamDecode>& stream)
+{
+	ASSERT_OR_RETURN(, decodeThread != nullptr, "Audio decode thread not running");
+	wzMutexLock(decodeThread->mutex);
+	decodeThread->newStreams.push_back(stream);
+	wzMutexUnlock(decodeThread->mutex);
+	wzSemaphorePost(decodeThread->wake);
+}
+
+void audioDecode_Wake()
+{
+	if (decodeThread)
+	{
+		wzSemaphorePost(decodeThread->wake);
+	}
+}
@@ -0,0 +1,81 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+	This file is part of Warzone 2100.
+	Copyright (C) 2026  Warzone 2100 Project (https://github.com/Warzone2100)
+
+	Warzone 2100 is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	Warzone 2100 is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Warzone 2100; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+/** @file audio_decode.h
+ * Background thread that decodes music streams.
+ *
+ * Only decoding happens on the thread; every OpenAL call stays on the main loop. A stream's
+ * decoded chunks come back through a lock-free `PcmChunkRing`, which the thread keeps topped up,
+ * and `sound_Update` copies them into OpenAL buffers. Sound effect tracks are small and are
+ * still decoded while loading, so a bad file fails the load.
+ */
+
+#pragma once
+
+#include "codecs.h"
+#include "pcm_ring.h"
+
+#include <atomic>
+#include <memory>
+
+/// Decoder state of one music stream, shared by the main loop and the decode thread.
+class AudioStreamDecode
+{
+public:
+	/// Takes ownership of `decoder`.
+	AudioStreamDecode(WZDecoder *decoder, size_t chunkCount, size_t chunkSize);
+	~AudioStreamDecode();
+
+	AudioStreamDecode(const AudioStreamDecode&) = delete;
+	AudioStreamDecode &operator=(const AudioStreamDecode&) = delete;
+
+	// Copies of the decoder's properties, so the main loop never touches the decoder itself
+	int channels() const { return numChannels; }
+	size_t frequency() const { return sampleRate; }
+	int64_t totalTime() const { return duration; }
+
+	/// Chunks decoded ahead of playback (producer: decode thread, consumer: main loop).
+	PcmChunkRing ring;
+
+	/// Main loop: the stream is gone, stop decoding it.
+	void cancel() { cancelled.store(true, std::memory_order_relaxed); }
+	bool isCancelled() const { return cancelled.load(std::memory_order_relaxed); }
+
+	/// Decode thread: fills free chunks until the ring is full or the stream ends. Returns true if it decoded anything.
+	bool fill();
+
+private:
+	WZDecoder *decoder = nullptr;
+	int numChannels = 0;
+	size_t sampleRate = 0;
+	int64_t duration = 0;
+	std::atomic<bool> cancelled{false};
+};
+
+/// Starts the decode thread. Returns false if it could not be started; callers then decode on the main loop.
+bool audioDecode_Start();
+/// Stops the decode thread, dropping everything it has not finished.
+void audioDecode_Stop();
+bool audioDecode_Running();
+
+/// Keeps the ring of `stream` topped up until it finishes or is cancelled.
+void audioDecode_AddStream(const std::shared_ptr<AudioStreamDecode>& stream);
+/// Tells the decode thread chunks were consumed (or a stream cancelled), so it can refill.
+void audioDecode_Wake();
@@ -50,20 +50,29 @@
 #include "openal_info.h"
 #include "oggopus.h"
 #include "oggvorbis.h"
+#include "audio_decode.h"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
 static ALuint current_queue_sample = -1;
 
 static bool openal_initialized = false;
 static const size_t bufferSize = 16 * 1024;
 static const unsigned int buffer_count = 32;
+static const size_t stream_start_chunks = 4;	// decoded chunks needed before a stream starts playing
 
 /** Source of music */
 struct AUDIO_STREAM
 {
 	ALuint                  source = -1;        // OpenAL name of the sound source
-	WZDecoder       		*decoder = nullptr;
+	std::shared_ptr<AudioStreamDecode> decode;	// decoder and decoded chunks, shared with the decode thread
+	std::vector<ALuint>     freeBuffers;        // OpenAL buffers not queued on the source
 	PHYSFS_file				*fileHandle = nullptr;
 	float                   volume = 0.f;
 	bool					queuedStop = false;	// when sound_StopStream has been called on the stream
+	bool					started = false;	// the first chunks have been queued and the source started
+	bool					startPaused = false;	// sound_PauseStream was called before the stream started
 
 	// Callbacks
 	std::function<void (const AUDIO_STREAM *, const void *)> onFinished;
@@ -239,6 +248,9 @@ bool sound_InitLibrary(HRTFMode hrtf)
 
 	openal_initialized = true;
 
+	// Decoding is done on its own thread (falls back to the main loop if the thread cannot be started)
+	audioDecode_Start();
+
 #if defined(ALC_SOFT_HRTF)
 	if(alcIsExtensionPresent(device, "ALC_SOFT_HRTF"))
 	{
@@ -377,6 +389,8 @@ void sound_ShutdownLibrary(void)
 	}
 	sound_UpdateStreams();
 
+	audioDecode_Stop();
+
 	alcGetError(device);	// clear error codes
 
 	/* On Linux since this caused some versions of OpenAL to hang on exit. - Per */
@@ -861,58 +875,85 @@ bool sound_Play3DSample(TRACK *psTrack, AUDIO_SAMPLE *psSample)
 	return true;
 }
 
-/** Fills N buffers, each of buffSize
- *  Only frees whatever was allocated by itself.
- * \returns nb of buffers copied (but not enqueued yet) to openAL
+/** Copies the chunks the decode thread has finished into free OpenAL buffers and queues them on the source.
+ *  Without a decode thread, the chunks are decoded here first.
+ * \returns nb of buffers queued, or -1 on error
 */
-static int sound_fillNBuffers(ALuint* alBuffersIds, WZDecoder* decoder, size_t n, size_t buffSize)
+static int sound_QueueDecodedChunks(AUDIO_STREAM *stream)
 {
-	ASSERT_OR_RETURN(-1, n <= static_cast<size_t>(std::numeric_limits<int>::max()), "number of buffers (%zu) exceeds int::max", n);
-	static uint8_t *pcm = (uint8_t*) malloc(buffSize);
-	if (!pcm)
+	AudioStreamDecode &decode = *stream->decode;
+	if (!audioDecode_Running())
 	{
-		debug(LOG_ERROR, "can't allocate buff of size %zu", buffSize);
-		return -1;
+		decode.fill();
 	}
+
 	// Determine PCM data format
-	ALenum format = (decoder->channels() == 1) ? AL_FORMAT_MONO16 : AL_FORMAT_STEREO16;
-	int i = 0;
-	const int i_max = static_cast<int>(n);
-	for (; i < i_max; ++i)
+	ALenum format = (decode.channels() == 1) ? AL_FORMAT_MONO16 : AL_FORMAT_STEREO16;
+	int queued = 0;
+	size_t size = 0;
+	const uint8_t *pcm = nullptr;
+	while (!stream->freeBuffers.empty() && (pcm = decode.ring.readChunk(size)) != nullptr)
+	{
+		ASSERT(size <= static_cast<size_t>(std::numeric_limits<ALint>::max()), "read size (%zu) exceeds ALint::max", size);
+		const ALuint alBuffer = stream->freeBuffers.back();
+		alBufferData(alBuffer, format, pcm, static_cast<ALint>(size), static_cast<ALsizei>(decode.frequency()));
+		decode.ring.commitRead();
+		if (sound_GetError() != AL_NO_ERROR) { return -1; }
+		alSourceQueueBuffers(stream->source, 1, &alBuffer);
+		if (sound_GetError() != AL_NO_ERROR) { return -1; }
+		stream->freeBuffers.pop_back();
+		++queued;
+	}
+	if (queued > 0)
+	{
+		// Let the decode thread refill the chunks we just consumed
+		audioDecode_Wake();
+	}
+	if (decode.ring.failed() && decode.ring.drained())
+	{
+		debug(LOG_ERROR, "Failed to decode audio data!");
+		return -1;
+	}
+	return queued;
+}
+
+/** Starts playing a stream once its first chunks have been decoded.
+ * \return true while the stream is waiting for data or playing, false if it cannot be played
+*/
+static bool sound_StartStream(AUDIO_STREAM *stream)
+{
+	if (stream->queuedStop)
+	{
+		return false;
+	}
+	const PcmChunkRing &ring = stream->decode->ring;
+	if (audioDecode_Running() && ring.available() < stream_start_chunks && !ring.isFinished())
 	{
-		memset(pcm, 0, buffSize);
-		// Decode some audio data
-		auto res = decoder->decode(pcm, buffSize);
+		// Not enough decoded to start without running dry right away
+		return true;
+	}
 
-		if (!res.has_value())
-		{
-			//free(pcm);
-			sound_GetError();
-			return -1;
-		}
+	alGetError();
+	const int res = sound_QueueDecodedChunks(stream);
+	// Bail out if we didn't fill any buffers
+	if (res <= 0)
+	{
+		debug(LOG_ERROR, "Failed to fill buffers with decoded audio data!");
+		return false;
+	}
 
-		// If we actually decoded some data
-		if (res.value() > 0)
-		{
-			ASSERT(res.value() <= static_cast<size_t>(std::numeric_limits<ALint>::max()), "read size (%zu) exceeds ALint::max", res.value());
-			alBufferData(alBuffersIds[i], format, pcm, static_cast<ALint>(res.value()), static_cast<ALsizei>(decoder->frequency()));
-			sound_GetError();
-		}
-		else // if (res.value() == 0)
-		{
-			// If no data has been decoded we're probably at the end of our
-			// stream. So cleanup the excess stuff here.
-			// First remove the data buffer itself
-			//free(pcm);
-			sound_GetError();
-			break;
-		}
+	// Start playing the source
+	alSourcePlay(stream->source);
+	if (sound_GetError() != AL_NO_ERROR) { return false; }
+	if (stream->startPaused)
+	{
+		alSourcePause(stream->source);
+		sound_GetError();
 	}
-	// all good: return how many buffers were actually (at least partially) filled
-	return i;
+	stream->started = true;
+	return true;
 }
 
-
 /** Plays the audio data from the given file
  *  \param volume the volume to play the audio at (in a range of 0.0 to 1.0)
  *  \param onFinished callback to invoke when we're finished playing
@@ -959,7 +1000,8 @@ AUDIO_STREAM *sound_PlayStream(const char* fileName, bool bufferEntireStream,
 		abort();
 		return nullptr;
 	}
-	stream->decoder = decoder;
+	ASSERT(bufferSize <= static_cast<size_t>(std::numeric_limits<ALsizei>::max()), "soundBuffer->size (%zu) exceeds ALsizei::max", bufferSize);
+	stream->decode = std::make_shared<AudioStreamDecode>(decoder, buffer_count, bufferSize);
 	// Retrieve an OpenAL sound source
 	alGenSources(1, &(stream->source));
 	if (sound_GetError() != AL_NO_ERROR)
@@ -967,7 +1009,6 @@ AUDIO_STREAM *sound_PlayStream(const char* fileName, bool bufferEntireStream,
 		// Failed to create OpenAL sound source, so bail out...
 		debug(LOG_SOUND, "alGenSources failed, most likely out of sound sources");
 		delete stream;
-		delete decoder;
 		return nullptr;
 	}
 
@@ -983,61 +1024,43 @@ AUDIO_STREAM *sound_PlayStream(const char* fileName, bool bufferEntireStream,
 #endif
 	if (sound_GetError() != AL_NO_ERROR)
 	{
-		delete decoder;
+		alDeleteSources(1, &stream->source);
 		delete stream;
 		return nullptr;
 	}
-	int res =0;
 	// Create some OpenAL buffers to store the decoded data in
-	static ALuint       *alBuffersIds = (ALuint *) malloc(buffer_count * sizeof(ALuint));
-	memset(alBuffersIds, 0, buffer_count * sizeof(ALuint));
-	alGenBuffers(buffer_count, alBuffersIds);
-	if (sound_GetError() != AL_NO_ERROR) { goto _error; }
-	// Copy the audio data into one of OpenAL's own buffers
-	ASSERT(bufferSize <= static_cast<size_t>(std::numeric_limits<ALsizei>::max()), "soundBuffer->size (%zu) exceeds ALsizei::max", bufferSize);
-
-	res = sound_fillNBuffers(alBuffersIds, decoder, buffer_count, bufferSize);
-	// Bail out if we didn't fill any buffers
-	if (res <= 0)
-	{
-		debug(LOG_ERROR, "Failed to fill buffers with decoded audio data!");
-		goto _error_with_albuffers;
-	}
-	// Attach the OpenAL buffers to our OpenAL source
-	alGetError();
-	if (res < buffer_count)
+	stream->freeBuffers.resize(buffer_count, 0);
+	alGenBuffers(buffer_count, stream->freeBuffers.data());
+	if (sound_GetError() != AL_NO_ERROR)
 	{
-		// free unused buffers
-		debug(LOG_SOUND, "freeing unused %i buffers", buffer_count - res);
-		alDeleteBuffers(buffer_count - res, alBuffersIds + res);
-		if (sound_GetError() != AL_NO_ERROR) {	goto _error_with_albuffers; }
+		alDeleteSources(1, &stream->source);
+		delete stream;
+		return nullptr;
 	}
 
-	alSourceQueueBuffers(stream->source, res, alBuffersIds);
-	if (sound_GetError() != AL_NO_ERROR) {	goto _error_with_albuffers; }
-
-	// Start playing the source
-	alGetError();
-	alSourcePlay(stream->source);
-	if (sound_GetError() != AL_NO_ERROR) {	goto _error_with_albuffers; }
-
 	// Set callback info
 	stream->onFinished = onFinished;
 	stream->user_data = user_data;
 
+	if (audioDecode_Running())
+	{
+		// Playing starts from sound_UpdateStreams, once the decode thread has caught up
+		audioDecode_AddStream(stream->decode);
+	}
+	else if (!sound_StartStream(stream))
+	{
+		alDeleteBuffers(static_cast<ALsizei>(stream->freeBuffers.size()), stream->freeBuffers.data());
+		alSourceStop(stream->source);
+		alDeleteSources(1, &stream->source);
+		sound_GetError();
+		delete stream;
+		return nullptr;
+	}
+
 	// Prepend this stream to the linked list
 	active_streams.emplace_front(stream);
 
 	return stream;
-
-	_error_with_albuffers:
-		alDeleteBuffers(buffer_count, alBuffersIds);
-
-	_error:
-		alDeleteSources(1, &stream->source);
-		delete stream;
-		delete decoder;
-		return nullptr;
 }
 
 /** Checks if the stream is playing.
@@ -1049,6 +1072,11 @@ bool sound_isStreamPlaying(AUDIO_STREAM *stream)
 {
 	ALint state;
 	alGetError();
+	if (stream && !stream->started)
+	{
+		// Still waiting for the decode thread
+		return !stream->queuedStop;
+	}
 	if (stream)
 	{
 		alGetSourcei(stream->source, AL_SOURCE_STATE, &state);
@@ -1087,6 +1115,12 @@ void sound_PauseStream(AUDIO_STREAM *stream)
 {
 	ALint state;
 
+	if (!stream->started)
+	{
+		stream->startPaused = true;
+		return;
+	}
+
 	// To be sure we won't go mutilating this OpenAL source, check whether
 	// it's playing first.
 	alGetError();
@@ -1110,6 +1144,12 @@ void sound_ResumeStream(AUDIO_STREAM *stream)
 {
 	ALint state;
 
+	if (!stream->started)
+	{
+		stream->startPaused = false;
+		return;
+	}
+
 	// To be sure we won't go mutilating this OpenAL source, check whether
 	// it's paused first.
 	alGetError();
@@ -1159,7 +1199,7 @@ void sound_SetStreamVolume(AUDIO_STREAM *stream, float volume)
 
 double sound_GetStreamTotalTime(AUDIO_STREAM *stream)
 {
-	return stream->decoder->totalTime();
+	return stream->decode->totalTime();
 }
 
 /** Update the given stream (="alSource" in openAL parlance) by making sure its buffers remain full
@@ -1168,6 +1208,11 @@ double sound_GetStreamTotalTime(AUDIO_STREAM *stream)
  */
 static bool sound_UpdateStream(AUDIO_STREAM *stream)
 {
+	if (!stream->started)
+	{
+		return sound_StartStream(stream);
+	}
+
 	ALint state, buffers_processed_count;
 	alGetError();
 	alGetSourcei(stream->source, AL_SOURCE_STATE, &state);
@@ -1181,50 +1226,29 @@ static bool sound_UpdateStream(AUDIO_STREAM *stream)
 	// Retrieve the amount of buffers which were processed and need refilling
 	alGetSourcei(stream->source, AL_BUFFERS_PROCESSED, &buffers_processed_count);
 	if (sound_GetError() != AL_NO_ERROR) { return false; }
-	if (buffers_processed_count == 0) { return true; }
-
-	// Determine PCM data format
-	ALuint *alBuffersIds = (ALuint *) malloc(buffers_processed_count * sizeof(ALuint));
-	alSourceUnqueueBuffers(stream->source, buffers_processed_count, alBuffersIds);
-	if (sound_GetError() != AL_NO_ERROR) { return false; }
-
-	auto freeUnusedALBuffers = [alBuffersIds, buffers_processed_count](ALint startingIdx) {
-		if (startingIdx < buffers_processed_count)
-		{
-			alDeleteBuffers(buffers_processed_count - startingIdx, &alBuffersIds[startingIdx]);
-		}
-	};
+	if (buffers_processed_count > 0)
+	{
+		const size_t oldFree = stream->freeBuffers.size();
+		stream->freeBuffers.resize(oldFree + static_cast<size_t>(buffers_processed_count), 0);
+		alSourceUnqueueBuffers(stream->source, buffers_processed_count, stream->freeBuffers.data() + oldFree);
+		if (sound_GetError() != AL_NO_ERROR) { return false; }
+	}
 
-	const auto res = sound_fillNBuffers(alBuffersIds, stream->decoder, buffers_processed_count, bufferSize);
+	const int res = sound_QueueDecodedChunks(stream);
+	if (res < 0)
+	{
+		debug(LOG_ERROR, "bailing out");
+		return false;
+	}
 	if (res == 0)
 	{
-		// nothing more to read and queue - will be deleted with sound_DestroyStream (later, when done playing)
-		sound_GetError();
-		freeUnusedALBuffers(0);
-		free(alBuffersIds);
 		if (state != AL_STOPPED)
 		{
 			return true; // must return true here - don't shortcut playing the remaining buffers!
 		}
-		else
-		{
-			// no more buffers to read, and the existing audio has stopped
-			return false;
-		}
-	}
-	if (res < 0)
-	{
-		debug(LOG_ERROR, "bailing out");
-		freeUnusedALBuffers(0);
-		free(alBuffersIds);
-		return false;
+		// The source ran dry: keep waiting for the decode thread unless the stream has ended
+		return !stream->decode->ring.drained();
 	}
-	// Reattach the filled buffers to the source
-	alSourceQueueBuffers(stream->source, res, alBuffersIds);
-	// Delete any unused unqueued buffers
-	freeUnusedALBuffers(res);
-	sound_GetError();
-	free(alBuffersIds);
 
 	if (state == AL_STOPPED && !stream->queuedStop)
 	{
@@ -1281,12 +1305,21 @@ static void sound_DestroyStream(AUDIO_STREAM *stream)
 		debug(LOG_SOUND, "alGetSourcei(AL_BUFFERS_PROCESSED) returned count: %d", buffers_processed_count);
 	}
 
+	// Destroy the buffers that were never queued (or were unqueued by sound_UpdateStream)
+	if (!stream->freeBuffers.empty())
+	{
+		alDeleteBuffers(static_cast<ALsizei>(stream->freeBuffers.size()), stream->freeBuffers.data());
+		sound_GetError();
+	}
+
 	// Destroy the OpenAL source
 	alDeleteSources(1, &stream->source);
 	sound_GetError();
 
-	// Destroy the sound decoder
-	delete stream->decoder;
+	// Stop decoding; the decode thread drops its reference to the decoder on its next pass
+	stream->decode->cancel();
+	audioDecode_Wake();
+	stream->decode.reset();
 
 	// Now call the finished callback
 	if (stream->onFinished)
@@ -0,0 +1,122 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+	This file is part of Warzone 2100.
+	Copyright (C) 2026  Warzone 2100 Project (https://github.com/Warzone2100)
+
+	Warzone 2100 is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	Warzone 2100 is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Warzone 2100; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+/** @file pcm_ring.h
+ * Lock-free queue of decoded PCM chunks between the audio decode thread and the main loop.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// A fixed number of fixed-size PCM chunks, passed from exactly one producer thread (which decodes
+/// into them) to exactly one consumer thread (which copies them into OpenAL buffers). Neither side
+/// ever blocks or takes a lock: each only advances its own index, and a chunk belongs to the side
+/// whose index range it is in.
+class PcmChunkRing
+{
+public:
+	PcmChunkRing(size_t chunkCount, size_t chunkSize)
+		: chunks(chunkCount, std::vector<uint8_t>(chunkSize))
+		, sizes(chunkCount, 0)
+	{ }
+
+	PcmChunkRing(const PcmChunkRing&) = delete;
+	PcmChunkRing &operator=(const PcmChunkRing&) = delete;
+
+	size_t chunkSize() const { return chunks.empty() ? 0 : chunks.front().size(); }
+	size_t capacity() const { return chunks.size(); }
+
+	// MARK: - Producer
+
+	/// The chunk to decode into next (`chunkSize()` bytes), or nullptr if the ring is full.
+	uint8_t *writeChunk()
+	{
+		const size_t tail = writeIndex.load(std::memory_order_relaxed);
+		if (tail - readIndex.load(std::memory_order_acquire) >= chunks.size())
+		{
+			return nullptr;
+		}
+		return chunks[tail % chunks.size()].data();
+	}
+
+	/// Hands the chunk returned by `writeChunk()`, holding `size` bytes, to the consumer.
+	void commitWrite(size_t size)
+	{
+		const size_t tail = writeIndex.load(std::memory_order_relaxed);
+		sizes[tail % chunks.size()] = size;
+		writeIndex.store(tail + 1, std::memory_order_release);
+	}
+
+	/// No more chunks will be written: the stream ended, or decoding it failed.
+	void finish(bool failed)
+	{
+		decodeFailed.store(failed, std::memory_order_relaxed);
+		finished.store(true, std::memory_order_release);
+	}
+
+	bool isFinished() const { return finished.load(std::memory_order_acquire); }
+
+	// MARK: - Consumer
+
+	/// The oldest chunk not read yet, or nullptr if the producer has not written one.
+	const uint8_t *readChunk(size_t &size) const
+	{
+		const size_t head = readIndex.load(std::memory_order_relaxed);
+		if (head == writeIndex.load(std::memory_order_acquire))
+		{
+			return nullptr;
+		}
+		size = sizes[head % chunks.size()];
+		return chunks[head % chunks.size()].data();
+	}
+
+	/// Returns the chunk from `readChunk()` to the producer.
+	void commitRead()
+	{
+		readIndex.store(readIndex.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+	}
+
+	/// Number of chunks the consumer can read right now.
+	size_t available() const
+	{
+		return writeIndex.load(std::memory_order_acquire) - readIndex.load(std::memory_order_relaxed);
+	}
+
+	/// True once the producer has finished and every chunk it wrote has been read.
+	bool drained() const
+	{
+		// Check `finished` first: once it is set, no further writes can happen
+		return finished.load(std::memory_order_acquire) && available() == 0;
+	}
+
+	bool failed() const { return finished.load(std::memory_order_acquire) && decodeFailed.load(std::memory_order_relaxed); }
+
+private:
+	std::vector<std::vector<uint8_t>> chunks;
+	std::vector<size_t> sizes;
+	std::atomic<size_t> readIndex{0};  ///< only written by the consumer
+	std::atomic<size_t> writeIndex{0}; ///< only written by the producer
+	std::atomic<bool> finished{false};
+	std::atomic<bool> decodeFailed{false};
+};
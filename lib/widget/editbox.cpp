@@ -168,7 +168,7 @@ bool W_EDITBOX::overwriteChar(WzUniCodepoint ch)
 	}
 
 	ASSERT(insPos <= aText.length(), "overwriteChar: Invalid insertion point");
-	dirty = true;
+	markDirty();
 
 	if (insPos == aText.length())
 	{
@@ -320,7 +320,7 @@ void W_EDITBOX::run(W_CONTEXT *psContext)
 	{
 		return;
 	}
-	dirty = true;
+	markDirty();
 	StartTextInput(this, {screenPosX(), screenPosY(), width(), height()});
 	/* If there is a mouse click outside of the edit box - stop editing */
 	int mx = psContext->mx;
@@ -581,13 +581,13 @@ void W_EDITBOX::setString(WzString string)
 {
 	aText = string;
 	initialise();
-	dirty = true;
+	markDirty();
 }
 
 void W_EDITBOX::setPlaceholder(WzString value)
 {
 	placeholderText = value;
-	dirty = true;
+	markDirty();
 }
 
 void W_EDITBOX::setPlaceholderTextColor(optional<PIELIGHT> _fixedPlaceholderTextColor)
@@ -653,7 +653,7 @@ void W_EDITBOX::clicked(W_CONTEXT *psContext, WIDGET_KEY)
 			ASSERT(false, "W_EDITBOX is not attached to any screen?");
 		}
 	}
-	dirty = true;
+	markDirty();
 }
 
 
@@ -678,7 +678,7 @@ void W_EDITBOX::stopEditing()
 	printStart = 0;
 	fitStringStart();
 	StopTextInput(this);
-	dirty = true;
+	markDirty();
 	if (onEditingStoppedHandler)
 	{
 		onEditingStoppedHandler(*this);
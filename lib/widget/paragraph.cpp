@@ -579,7 +579,7 @@ void Paragraph::addOnClickHandler(const W_PARAGRAPH_ONCLICK_FUNC& onClickFunc)
 
 void Paragraph::clicked(W_CONTEXT *, WIDGET_KEY key)
 {
-	dirty = true;
+	markDirty();
 	isMouseDown = true;
 }
 
@@ -602,14 +602,14 @@ void Paragraph::released(W_CONTEXT *, WIDGET_KEY key)
 			onClickHandler(*this, key);
 		}
 	}
-	dirty = true;
+	markDirty();
 }
 
 /* Respond to the mouse moving off the widget */
 void Paragraph::highlightLost()
 {
 	isMouseDown = false;
-	dirty = true;
+	markDirty();
 }
 
 nonstd::optional<std::vector<uint32_t>> Paragraph::getScrollSnapOffsets()
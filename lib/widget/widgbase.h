@@ -263,7 +263,12 @@ public:
 
 	void show(bool doShow = true)
 	{
-		style = (style & ~WIDG_HIDDEN) | (!doShow * WIDG_HIDDEN);
+		const UDWORD newStyle = (style & ~WIDG_HIDDEN) | (!doShow * WIDG_HIDDEN);
+		if (newStyle != style)
+		{
+			style = newStyle;
+			markDirty();
+		}
 	}
 	void hide()
 	{
@@ -464,7 +469,10 @@ private:
 	WIDGET &operator =(WIDGET const &) = delete;
 
 public:
-	bool dirty; ///< Whether widget is changed and needs to be redrawn
+	/// Note that the widget changed since it was last displayed; only read by the redraw debug overlay
+	/// (see widgSetDebugRedrawRegions), every widget is still redrawn every frame.
+	void markDirty();
+	bool dirty; ///< Whether widget changed since it was last displayed
 public:
 	friend bool isMouseOverScreenOverlayChild(int mx, int my);
 };
@@ -92,6 +92,23 @@ static std::vector<std::function<void()>> widgetScheduledTasks;
 
 static bool debugBoundingBoxesOnly = false;
 
+// Redraw debug overlay: screen regions of widgets that changed recently, and per-frame display counts
+#define REDRAW_REGION_FADE_TIME 1000
+#define MAX_REDRAW_REGIONS 512
+struct RedrawRegion
+{
+	WzRect rect;
+	uint32_t time;
+};
+static bool debugRedrawRegions = false;
+static std::deque<RedrawRegion> debugRecentRedrawRegions;
+// Counted over all widgDisplayScreen() calls of a frame; the overlay shows the last complete frame
+static UDWORD debugCountedFrame = 0;
+static size_t debugWidgetsDisplayed = 0;
+static size_t debugChangedWidgetsDisplayed = 0;
+static size_t debugLastFrameWidgetsDisplayed = 0;
+static size_t debugLastFrameChangedWidgetsDisplayed = 0;
+
 #ifdef DEBUG
 #include "lib/framework/demangle.hpp"
 static std::unordered_set<const WIDGET*> debugLiveWidgets;
@@ -661,9 +678,26 @@ void WIDGET::setGeometry(WzRect const &r)
 	{
 		return;  // Nothing to do.
 	}
+	if (debugRedrawRegions && !screenPointer.expired())
+	{
+		markDirty(); // also record the old region, which is uncovered
+	}
 	dim = r;
 	geometryChanged();
+	markDirty();
+}
+
+void WIDGET::markDirty()
+{
 	dirty = true;
+	if (debugRedrawRegions && !screenPointer.expired())
+	{
+		if (debugRecentRedrawRegions.size() >= MAX_REDRAW_REGIONS)
+		{
+			debugRecentRedrawRegions.pop_front();
+		}
+		debugRecentRedrawRegions.push_back({screenGeometry(), realTime});
+	}
 }
 
 void WIDGET::setGeometryFromScreenRect(WzRect const &r)
@@ -738,12 +772,14 @@ void WIDGET::attach(const std::shared_ptr<WIDGET> &widget, ChildZPos zPos /*= Ch
 		childWidgets.insert(childWidgets.begin(), widget);
 		break;
 	}
+	widget->markDirty();
 }
 
 void WIDGET::detach(const std::shared_ptr<WIDGET> &widget)
 {
 	ASSERT_OR_RETURN(, widget != nullptr && !widget->parentWidget.expired(), "Bad detach.");
 
+	widget->markDirty();
 	widget->parentWidget.reset();
 	widget->setScreenPointer(nullptr);
 
@@ -1745,6 +1781,12 @@ void WIDGET::displayRecursive(WidgetGraphicsContext const &context)
 			// Display widget.
 			display(context.getXOffset(), context.getYOffset());
 		}
+		++debugWidgetsDisplayed;
+		if (dirty)
+		{
+			++debugChangedWidgetsDisplayed;
+			dirty = false;
+		}
 	}
 
 	if (widgetIsClipped && !context.allowChildDisplayRecursiveIfSelfClipped())
@@ -1782,6 +1824,36 @@ void WIDGET::displayRecursive(WidgetGraphicsContext const &context)
 	}
 }
 
+void widgSetDebugRedrawRegions(bool enabled)
+{
+	debugRedrawRegions = enabled;
+	debugRecentRedrawRegions.clear();
+}
+
+bool widgGetDebugRedrawRegions()
+{
+	return debugRedrawRegions;
+}
+
+static void displayDebugRedrawRegions()
+{
+	while (!debugRecentRedrawRegions.empty() && realTime - debugRecentRedrawRegions.front().time > REDRAW_REGION_FADE_TIME)
+	{
+		debugRecentRedrawRegions.pop_front();
+	}
+	for (auto const &region : debugRecentRedrawRegions)
+	{
+		const uint32_t age = realTime - region.time;
+		PIELIGHT col = WZCOL_RED;
+		col.byte.a = static_cast<uint8_t>(255 - (age * 255) / REDRAW_REGION_FADE_TIME);
+		const WzRect &r = region.rect;
+		iV_Box(r.x(), r.y(), r.x() + r.width() - 1, r.y() + r.height() - 1, col);
+	}
+
+	iV_SetTextColour(WZCOL_YELLOW);
+	iV_DrawText(astringf("Widgets displayed: %zu, changed: %zu", debugLastFrameWidgetsDisplayed, debugLastFrameChangedWidgetsDisplayed).c_str(), 4, screenHeight - 4 + iV_GetTextBelowBase(font_small), font_small);
+}
+
 /* Display the screen's widgets in their current state
  * (Call after calling widgRunScreen, this allows the input
  *  processing to be separated from the display of the widgets).
@@ -1808,6 +1880,15 @@ void widgDisplayScreen(const std::shared_ptr<W_SCREEN> &psScreen)
 	sContext.my = mouseY();
 	psScreen->psForm->processCallbacksRecursive(&sContext);
 
+	if (debugCountedFrame != frameGetFrameNumber())
+	{
+		debugCountedFrame = frameGetFrameNumber();
+		debugLastFrameWidgetsDisplayed = debugWidgetsDisplayed;
+		debugLastFrameChangedWidgetsDisplayed = debugChangedWidgetsDisplayed;
+		debugWidgetsDisplayed = 0;
+		debugChangedWidgetsDisplayed = 0;
+	}
+
 	if (!skipDrawing)
 	{
 		// Display the widgets.
@@ -1839,6 +1920,11 @@ void widgDisplayScreen(const std::shared_ptr<W_SCREEN> &psScreen)
 		psScreen->psForm->displayRecursive();
 		debugBoundingBoxesOnly = false;
 	}
+
+	if (debugRedrawRegions && !skipDrawing)
+	{
+		displayDebugRedrawRegions();
+	}
 }
 
 void W_SCREEN::setFocus(const std::shared_ptr<WIDGET> &widget)
@@ -393,6 +393,10 @@ WidgetTriggers const &widgRunScreen(const std::shared_ptr<W_SCREEN> &psScreen);
  */
 void widgDisplayScreen(const std::shared_ptr<W_SCREEN> &psScreen);
 
+/** Toggle the debug overlay that outlines recently changed widgets and counts displayed / changed widgets per frame. */
+void widgSetDebugRedrawRegions(bool enabled);
+bool widgGetDebugRedrawRegions();
+
 
 /** Set the current audio callback function and audio id's. */
 void WidgSetAudio(WIDGET_AUDIOCALLBACK Callback, SWORD HilightID, SWORD ClickedID, SWORD ErrorID);
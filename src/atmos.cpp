@@ -37,6 +37,7 @@
 #include "lib/gamelib/gtime.h"
 #include "game_world.h"
 #include <cmath>
+#include <vector>
 
 #ifndef GLM_ENABLE_EXPERIMENTAL
 	#define GLM_ENABLE_EXPERIMENTAL
@@ -60,31 +61,20 @@ enum AP_TYPE
 	AP_SNOW
 };
 
-enum AP_STATUS
-{
-	APS_INACTIVE,
-	APS_ACTIVE
-};
-
-static ATPART	*asAtmosParts = nullptr;
-static UDWORD	freeParticle = 0;
+/* The live particles, densely packed so that updating and drawing only touches the active ones */
+static std::vector<ATPART> activeParticles;
+static bool	atmosSystemActive = false;
 static WT_CLASS	weather = WT_NONE;
 static bool	weatherEnabled = true;
 
 /* Setup all the particles */
 void atmosInitSystem()
 {
-	if (!asAtmosParts && weather != WT_NONE)
+	if (!atmosSystemActive && weather != WT_NONE)
 	{
-		// calloc sets all to APS_INACTIVE initially
-		asAtmosParts = (ATPART *)calloc(MAX_ATMOS_PARTICLES, sizeof(*asAtmosParts));
-		if (!asAtmosParts)
-		{
-			debug(LOG_ERROR, "Failed to initialize atmos system - memory allocation failed");
-		}
+		activeParticles.clear();
+		atmosSystemActive = true;
 	}
-	/* Start at the beginning */
-	freeParticle = 0;
 }
 
 /*	Makes a particle wrap around - if it goes off the grid, then it returns
@@ -116,8 +106,8 @@ static void testParticleWrap(ATPART *psPart)
 	}
 }
 
-/* Moves one of the particles */
-static void processParticle(WorldMapState& mapState, ATPART *psPart)
+/* Moves one of the particles. Returns false if the particle died */
+static bool processParticle(WorldMapState& mapState, ATPART *psPart)
 {
 	SDWORD	groundHeight;
 	Vector3i pos;
@@ -141,8 +131,7 @@ static void processParticle(WorldMapState& mapState, ATPART *psPart)
 		    psPart->position.z > ((mapState.height - 1)*TILE_UNITS))
 		{
 			/* The kill it */
-			psPart->status = APS_INACTIVE;
-			return;
+			return false;
 		}
 
 		/* What height is the ground under it? Only do if low enough...*/
@@ -156,7 +145,6 @@ static void processParticle(WorldMapState& mapState, ATPART *psPart)
 			    || psPart->position.y < 0.f)
 			{
 				/* Kill it and return */
-				psPart->status = APS_INACTIVE;
 				if (psPart->type == AP_RAIN)
 				{
 					x = map_coord(static_cast<int32_t>(psPart->position.x));
@@ -171,7 +159,7 @@ static void processParticle(WorldMapState& mapState, ATPART *psPart)
 						addEffect(&pos, EFFECT_EXPLOSION, EXPLOSION_TYPE_SPECIFIED, true, getDisplayImdFromIndex(MI_SPLASH), 0);
 					}
 				}
-				return;
+				return false;
 			}
 		}
 		if (psPart->type == AP_SNOW)
@@ -186,69 +174,54 @@ static void processParticle(WorldMapState& mapState, ATPART *psPart)
 			}
 		}
 	}
+	return true;
 }
 
 /* Adds a particle to the system if it can */
 static void atmosAddParticle(const Vector3f &pos, AP_TYPE type)
 {
-	UDWORD	activeCount;
-	UDWORD	i;
-
-	for (i = freeParticle, activeCount = 0; asAtmosParts[i].status == APS_ACTIVE && activeCount < MAX_ATMOS_PARTICLES; i++)
-	{
-		activeCount++;
-		/* Check for wrap around */
-		if (i >= (MAX_ATMOS_PARTICLES - 1))
-		{
-			/* Go back to the first one */
-			i = 0;
-		}
-	}
-
-	/* Check the list isn't just full of essential effects */
-	if (activeCount >= MAX_ATMOS_PARTICLES - 1)
+	if (activeParticles.size() >= MAX_ATMOS_PARTICLES - 1)
 	{
 		/* All of the particles active!?!? */
 		return;
 	}
-	else
-	{
-		freeParticle = i;
-	}
 
-	/* Record it's type */
-	asAtmosParts[freeParticle].type = (UBYTE)type;
+	ATPART part;
 
-	/* Make it active */
-	asAtmosParts[freeParticle].status = APS_ACTIVE;
+	/* Record it's type */
+	part.type = (UBYTE)type;
 
 	/* Setup the imd */
 	switch (type)
 	{
 	case AP_SNOW:
-		asAtmosParts[freeParticle].imd = getImdFromIndex(MI_SNOW);
-		asAtmosParts[freeParticle].size = 80;
+		part.imd = getImdFromIndex(MI_SNOW);
+		part.size = 80;
 		break;
 	case AP_RAIN:
-		asAtmosParts[freeParticle].imd = getImdFromIndex(MI_RAIN);
-		asAtmosParts[freeParticle].size = 50;
+		part.imd = getImdFromIndex(MI_RAIN);
+		part.size = 50;
 		break;
 	default:
+		part.imd = nullptr;
+		part.size = 0;
 		break;
 	}
 
 	/* Setup position */
-	asAtmosParts[freeParticle].position = pos;
+	part.position = pos;
 
 	/* Setup its velocity */
 	if (type == AP_RAIN)
 	{
-		asAtmosParts[freeParticle].velocity = Vector3f(RAIN_SPEED_DRIFT, RAIN_SPEED_FALL, RAIN_SPEED_DRIFT);
+		part.velocity = Vector3f(RAIN_SPEED_DRIFT, RAIN_SPEED_FALL, RAIN_SPEED_DRIFT);
 	}
 	else
 	{
-		asAtmosParts[freeParticle].velocity = Vector3f(SNOW_SPEED_DRIFT, SNOW_SPEED_FALL, SNOW_SPEED_DRIFT);
+		part.velocity = Vector3f(SNOW_SPEED_DRIFT, SNOW_SPEED_FALL, SNOW_SPEED_DRIFT);
 	}
+
+	activeParticles.push_back(part);
 }
 
 /* Move the particles */
@@ -259,7 +232,7 @@ void atmosUpdateSystem(WorldMapState& mapState)
 	UDWORD	numberToAdd;
 	Vector3f pos;
 
-	if (!asAtmosParts || !weatherEnabled)
+	if (!atmosSystemActive || !weatherEnabled)
 	{
 		return;
 	}
@@ -267,12 +240,17 @@ void atmosUpdateSystem(WorldMapState& mapState)
 	// we don't want to do any of this while paused.
 	if (!gamePaused() && weather != WT_NONE)
 	{
-		for (i = 0; i < MAX_ATMOS_PARTICLES; i++)
+		for (i = 0; i < activeParticles.size();)
 		{
-			/* See if it's active */
-			if (asAtmosParts[i].status == APS_ACTIVE)
+			if (processParticle(mapState, &activeParticles[i]))
 			{
-				processParticle(mapState, &asAtmosParts[i]);
+				++i;
+			}
+			else
+			{
+				/* Dead - fill its slot with the last particle */
+				activeParticles[i] = activeParticles.back();
+				activeParticles.pop_back();
 			}
 		}
 
@@ -338,9 +316,8 @@ static inline void renderParticleInternal(ATPART *psPart, const glm::mat4 &viewM
 void atmosDrawParticles(const glm::mat4 &viewMatrix, const glm::mat4 &perspectiveViewMatrix)
 {
 	WZ_PROFILE_SCOPE(atmosDrawParticles);
-	UDWORD	i;
 
-	if (weather == WT_NONE || !asAtmosParts || !weatherEnabled)
+	if (weather == WT_NONE || !atmosSystemActive || !weatherEnabled)
 	{
 		return;
 	}
@@ -351,21 +328,17 @@ void atmosDrawParticles(const glm::mat4 &viewMatrix, const glm::mat4 &perspectiv
 	UDWORD last_particle_size = 0;
 
 	/* Traverse the list */
-	for (i = 0; i < MAX_ATMOS_PARTICLES; i++)
+	for (ATPART &part : activeParticles)
 	{
-		/* Don't bother unless it's active */
-		if (asAtmosParts[i].status == APS_ACTIVE)
+		/* Is it visible on the screen? */
+		if (clipXYZ(static_cast<int>(part.position.x), static_cast<int>(part.position.z), static_cast<int>(part.position.y), perspectiveViewMatrix))
 		{
-			/* Is it visible on the screen? */
-			if (clipXYZ(static_cast<int>(asAtmosParts[i].position.x), static_cast<int>(asAtmosParts[i].position.z), static_cast<int>(asAtmosParts[i].position.y), perspectiveViewMatrix))
+			if (last_particle_size != part.size)
 			{
-				if (last_particle_size != asAtmosParts[i].size)
-				{
-					rotateScaleMatrix = rotateMatrix * glm::scale(glm::vec3(asAtmosParts[i].size / 100.f));
-					last_particle_size = asAtmosParts[i].size;
-				}
-				renderParticleInternal(&asAtmosParts[i], viewMatrix, rotateScaleMatrix);
+				rotateScaleMatrix = rotateMatrix * glm::scale(glm::vec3(part.size / 100.f));
+				last_particle_size = part.size;
 			}
+			renderParticleInternal(&part, viewMatrix, rotateScaleMatrix);
 		}
 	}
 }
@@ -385,10 +358,11 @@ void atmosSetWeatherType(WT_CLASS type)
 		weather = type;
 		atmosInitSystem();
 	}
-	if (type == WT_NONE && asAtmosParts)
+	if (type == WT_NONE && atmosSystemActive)
 	{
-		free(asAtmosParts);
-		asAtmosParts = nullptr;
+		activeParticles.clear();
+		activeParticles.shrink_to_fit();
+		atmosSystemActive = false;
 	}
 }
 
@@ -404,11 +378,10 @@ void atmosSetWeatherEnabled(bool enabled)
 		return;
 	}
 	weatherEnabled = enabled;
-	if (!enabled && asAtmosParts)
+	if (!enabled)
 	{
 		// drop any live particles so re-enabling starts clean
-		memset(asAtmosParts, 0, MAX_ATMOS_PARTICLES * sizeof(*asAtmosParts));
-		freeParticle = 0;
+		activeParticles.clear();
 	}
 }
 
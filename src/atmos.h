@@ -26,7 +26,6 @@
 
 struct ATPART
 {
-	UBYTE		status;
 	UBYTE		type;
 	UDWORD		size;
 	Vector3f	position;
@@ -25,6 +25,7 @@
 #define __INCLUDED_BASEDEF_H__
 
 #include <bitset>
+#include <memory>
 
 #include "lib/framework/vector.h"
 #include "displaydef.h"
@@ -119,6 +120,8 @@ struct BASE_OBJECT : public SIMPLE_OBJECT
 
 	bool                hasExtraFunction = false;   ///< Does this object include some extra functionality?
 
+	mutable std::shared_ptr<bool> liveness;         ///< Created on demand and cleared on destruction, see objectLivenessToken()
+
 public:
 	// Query visibility for display purposes (i.e. for `selectedPlayer`)
 	// *DO NOT USE TO QUERY VISIBILITY FOR CALCULATIONS INVOLVING GAME / SIMULATION STATE*
@@ -31,7 +31,6 @@
 #include "map.h"
 #include "game_world.h"
 
-
 static inline uint16_t interpolateAngle(uint16_t v1, uint16_t v2, uint32_t t1, uint32_t t2, uint32_t t)
 {
 	const int numer = t - t1, denom = t2 - t1;
@@ -131,8 +130,22 @@ BASE_OBJECT::BASE_OBJECT(OBJECT_TYPE type, uint32_t id, unsigned player)
 	sDisplay.screenR = 0;
 }
 
+std::shared_ptr<const bool> objectLivenessToken(const BASE_OBJECT *psObj)
+{
+	if (!psObj->liveness)
+	{
+		psObj->liveness = std::make_shared<bool>(true);
+	}
+	return psObj->liveness;
+}
+
 BASE_OBJECT::~BASE_OBJECT()
 {
+	if (liveness)
+	{
+		*liveness = false;
+	}
+
 	// Tile visibility must already have been removed (against the object's own world map) by
 	// the time we get here.
 	//
@@ -27,6 +27,8 @@
 #include "lib/framework/types.h"
 #include "lib/framework/vector.h"
 
+#include <memory>
+
 struct BASE_OBJECT;
 struct BASE_STATS;
 struct SIMPLE_OBJECT;
@@ -70,4 +72,9 @@ StructureBounds getStructureBounds(BASE_STATS const *stats, Vector2i pos, uint16
 
 void resetObjectAnimationState(BASE_OBJECT *psObj);
 
+/// A flag that is true while `psObj` exists and is cleared when it is freed, wherever the object is
+/// kept (game, mission or transporter lists). Lets holders of a pointer check it without keeping a
+/// reference that has to be cleaned up, or looking the object up by id.
+std::shared_ptr<const bool> objectLivenessToken(const BASE_OBJECT *psObj);
+
 #endif // __INCLUDED_BASEOBJECT_H__
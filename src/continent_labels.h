@@ -0,0 +1,177 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+	This file is part of Warzone 2100.
+	Copyright (C) 2026  Warzone 2100 Project (https://github.com/Warzone2100)
+
+	Warzone 2100 is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	Warzone 2100 is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Warzone 2100; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+/** \file
+ * Connected-component ("continent") labelling of the tile grid.
+ *
+ * This header is deliberately self-contained (no game / framework includes)
+ * so it can be unit-tested standalone (tests/continent_labels_test.cpp).
+ *
+ * A layer classifies every tile with a small class value: 0 means the tile is
+ * impassable for the layer, any other value is a terrain class (e.g. land or
+ * sea for the limited-propulsion layer). Two tiles are on the same continent
+ * if they are joined by a chain of 8-neighbours of the same class.
+ *
+ * - labelAll() labels the whole grid in two linear passes over a disjoint-set
+ *   forest (no per-continent flood fill), and numbers continents in row-major
+ *   order of their first seed tile, exactly like the old flood fill did.
+ *
+ * Labels are read and written through accessors, so they can live directly in
+ * the tile structure and reachability checks stay a plain label comparison.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace continentLabels
+{
+
+/// Disjoint-set forest over tile indices (union by lower index, path halving).
+class DisjointSet
+{
+public:
+	explicit DisjointSet(size_t n) : parent(n)
+	{
+		for (size_t i = 0; i < n; ++i)
+		{
+			parent[i] = static_cast<uint32_t>(i);
+		}
+	}
+
+	uint32_t find(uint32_t i)
+	{
+		while (parent[i] != i)
+		{
+			parent[i] = parent[parent[i]];
+			i = parent[i];
+		}
+		return i;
+	}
+
+	void unite(uint32_t a, uint32_t b)
+	{
+		a = find(a);
+		b = find(b);
+		if (a < b)
+		{
+			parent[b] = a;
+		}
+		else if (b < a)
+		{
+			parent[a] = b;
+		}
+	}
+
+private:
+	std::vector<uint32_t> parent;
+};
+
+/// Label the interior [1, width - 2] x [1, height - 2] of the grid (the map border is never passable).
+///
+/// classOf(x, y) returns the tile class (0 = impassable), isSeed(x, y) whether a tile may start a new
+/// continent, and setLabel(x, y, label) stores the result. Continents are only started from tiles in
+/// [1, width - 3] x [1, height - 3]; a continent without any seed tile is left with label 0.
+/// Returns the number of continents found.
+template <typename ClassFn, typename SeedFn, typename SetFn>
+uint32_t labelAll(int width, int height, ClassFn classOf, SeedFn isSeed, SetFn setLabel)
+{
+	if (width < 3 || height < 3)
+	{
+		return 0;
+	}
+
+	const size_t numTiles = static_cast<size_t>(width) * static_cast<size_t>(height);
+	std::vector<uint8_t> classes(numTiles, 0);
+	DisjointSet sets(numTiles);
+
+	// Pass 1: union every tile with its already visited same-class neighbours (W, NW, N, NE).
+	for (int y = 1; y < height - 1; ++y)
+	{
+		for (int x = 1; x < width - 1; ++x)
+		{
+			const size_t i = static_cast<size_t>(x) + static_cast<size_t>(y) * width;
+			const uint8_t c = classOf(x, y);
+			classes[i] = c;
+			if (c == 0)
+			{
+				continue;
+			}
+			if (x > 1 && classes[i - 1] == c)
+			{
+				sets.unite(i, i - 1);
+			}
+			if (y > 1)
+			{
+				const size_t up = i - width;
+				if (x > 1 && classes[up - 1] == c)
+				{
+					sets.unite(i, up - 1);
+				}
+				if (classes[up] == c)
+				{
+					sets.unite(i, up);
+				}
+				if (x < width - 2 && classes[up + 1] == c)
+				{
+					sets.unite(i, up + 1);
+				}
+			}
+		}
+	}
+
+	// Pass 2: number the continents in order of their first seed tile.
+	std::vector<uint16_t> rootLabel(numTiles, 0);
+	uint32_t count = 0;
+	for (int y = 1; y < height - 2; ++y)
+	{
+		for (int x = 1; x < width - 2; ++x)
+		{
+			const size_t i = static_cast<size_t>(x) + static_cast<size_t>(y) * width;
+			if (classes[i] == 0)
+			{
+				continue;
+			}
+			const uint32_t root = sets.find(i);
+			// Out of labels: the remaining continents are left unlabelled
+			if (rootLabel[root] == 0 && count < UINT16_MAX && isSeed(x, y))
+			{
+				rootLabel[root] = static_cast<uint16_t>(++count);
+			}
+		}
+	}
+
+	// Pass 3: write the labels.
+	for (int y = 0; y < height; ++y)
+	{
+		for (int x = 0; x < width; ++x)
+		{
+			const size_t i = static_cast<size_t>(x) + static_cast<size_t>(y) * width;
+			const uint16_t label = classes[i] != 0 ? rootLabel[sets.find(i)] : 0;
+			setLabel(x, y, label);
+		}
+	}
+	return count;
+}
+
+} // namespace continentLabels
@@ -133,7 +133,7 @@ void dataClearSaveFlag()
 /* Load the body stats */
 static bool bufferSBODYLoad(const char *fileName, void **ppData)
 {
-	WzConfig ini(fileName, WzConfig::ReadOnlyAndRequired);
+	WzConfig ini(fileName, WzConfig::ReadOnlyAndRequired, WzConfig::UseBinaryCache);
 	calcDataHash(ini, DATA_SBODY);
 
 	if (!loadBodyStats(ini) || !allocComponentList(COMP_BODY, asBodyStats.size()))
@@ -155,7 +155,7 @@ static void dataReleaseStats(WZ_DECL_UNUSED void *pData)
 /* Load the weapon stats */
 static bool bufferSWEAPONLoad(const char *fileName, void **ppData)
 {
-	WzConfig ini(fileName, WzConfig::ReadOnlyAndRequired);
+	WzConfig ini(fileName, WzConfig::ReadOnlyAndRequired, WzConfig::UseBinaryCache);
 	calcDataHash(ini, DATA_SWEAPON);
 
 	if (!loadWeaponStats(ini)
@@ -172,7 +172,7 @@ static bool bufferSWEAPONLoad(const char *fileName, void **ppData)
 /* Load the constructor stats */
 static bool bufferSCONSTRLoad(const char *fileName, void **ppData)
 {
-	WzConfig ini(fileName, WzConfig::ReadOnlyAndRequired);
+	WzConfig ini(fileName, WzConfig::ReadOnlyAndRequired, WzConfig::UseBinaryCache);
 	calcDataHash(ini, DATA_SCONSTR);
 
 	if (!loadConstructStats(ini)
@@ -189,7 +189,7 @@ static bool bufferSCONSTRLoad(const char *fileName, void **ppData)
 /* Load the ECM stats */
 static bool bufferSECMLoad(const char *fileName, void **ppData)
 {
-	WzConfig ini(fileName, WzConfig::ReadOnlyAndRequired);
+	WzConfig ini(fileName, WzConfig::ReadOnlyAndRequired, WzConfig::UseBinaryCache);
 	calcDataHash(ini, DATA_SECM);
 
 	if (!loadECMStats(ini)
@@ -206,7 +206,7 @@ static bool bufferSECMLoad(const char *fileName, void **ppData)
 /* Load the Propulsion stats */
 static bool bufferSPROPLoad(const char *fileName, void **ppData)
 {
-	WzConfig ini(fileName, WzConfig::ReadOnlyAndRequired);
+	WzConfig ini(fileName, WzConfig::ReadOnlyAndRequired, WzConfig::UseBinaryCache);
 	calcDataHash(ini, DATA_SPROP);
 
 	if (!loadPropulsionStats(ini) || !allocComponentList(COMP_PROPULSION, asPropulsionStats.size()))
@@ -221,7 +221,7 @@ static bool bufferSPROPLoad(const char *fileName, void **ppData)
 
 static bool bufferSSENSORLoad(const char *fileName, void **ppData)
 {
-	WzConfig ini(fileName, WzConfig::ReadOnlyAndRequired);
+	WzConfig ini(fileName, WzConfig::ReadOnlyAndRequired, WzConfig::UseBinaryCache);
 	calcDataHash(ini, DATA_SSENSOR);
 
 	if (!loadSensorStats(ini)
@@ -238,7 +238,7 @@ static bool bufferSSENSORLoad(const char *fileName, void **ppData)
 /* Load the Repair stats */
 static bool bufferSREPAIRLoad(const char *fileName, void **ppData)
 {
-	WzConfig ini(fileName, WzConfig::ReadOnlyAndRequired);
+	WzConfig ini(fileName, WzConfig::ReadOnlyAndRequired, WzConfig::UseBinaryCache);
 	calcDataHash(ini, DATA_SREPAIR);
 
 	if (!loadRepairStats(ini) || !allocComponentList(COMP_REPAIRUNIT, asRepairStats.size()))
@@ -254,7 +254,7 @@ static bool bufferSREPAIRLoad(const char *fileName, void **ppData)
 /* Load the Brain stats */
 static bool bufferSBRAINLoad(const char *fileName, void **ppData)
 {
-	WzConfig ini(fileName, WzConfig::ReadOnlyAndRequired);
+	WzConfig ini(fileName, WzConfig::ReadOnlyAndRequired, WzConfig::UseBinaryCache);
 	calcDataHash(ini, DATA_SBRAIN);
 
 	if (!loadBrainStats(ini) || !allocComponentList(COMP_BRAIN, asBrainStats.size()))
@@ -269,7 +269,7 @@ static bool bufferSBRAINLoad(const char *fileName, void **ppData)
 /* Load the PropulsionType stats */
 static bool bufferSPROPTYPESLoad(const char *fileName, void **ppData)
 {
-	WzConfig ini(fileName, WzConfig::ReadOnlyAndRequired);
+	WzConfig ini(fileName, WzConfig::ReadOnlyAndRequired, WzConfig::UseBinaryCache);
 	calcDataHash(ini, DATA_SPROPTY);
 
 	if (!loadPropulsionTypes(ini))
@@ -298,7 +298,7 @@ static bool bufferSPROPSNDLoad(const char *fileName, void **ppData)
 /* Load the STERRTABLE stats */
 static bool bufferSTERRTABLELoad(const char *fileName, void **ppData)
 {
-	WzConfig ini(fileName, WzConfig::ReadOnlyAndRequired);
+	WzConfig ini(fileName, WzConfig::ReadOnlyAndRequired, WzConfig::UseBinaryCache);
 	calcDataHash(ini, DATA_STERRT);
 
 	if (!loadTerrainTable(ini))
@@ -322,7 +322,7 @@ static bool bufferSBPIMDLoad(const char *fileName, void **ppData)
 /* Load the Weapon Effect modifier stats */
 static bool bufferSWEAPMODLoad(const char *fileName, void **ppData)
 {
-	WzConfig ini(fileName, WzConfig::ReadOnlyAndRequired);
+	WzConfig ini(fileName, WzConfig::ReadOnlyAndRequired, WzConfig::UseBinaryCache);
 	calcDataHash(ini, DATA_SWEAPMOD);
 
 	if (!loadWeaponModifiers(ini))
@@ -359,7 +359,7 @@ static void dataSTEMPLRelease(WZ_DECL_UNUSED void *pData)
 /* Load the Structure stats */
 static bool bufferSSTRUCTLoad(const char *fileName, void **ppData)
 {
-	WzConfig ini(fileName, WzConfig::ReadOnlyAndRequired);
+	WzConfig ini(fileName, WzConfig::ReadOnlyAndRequired, WzConfig::UseBinaryCache);
 	calcDataHash(ini, DATA_SSTRUCT);
 
 	if (!loadStructureStats(ini))
@@ -387,7 +387,7 @@ static void dataSSTRUCTRelease(WZ_DECL_UNUSED void *pData)
 /* Load the Structure strength modifier stats */
 static bool bufferSSTRMODLoad(const char *fileName, void **ppData)
 {
-	WzConfig ini(fileName, WzConfig::ReadOnlyAndRequired);
+	WzConfig ini(fileName, WzConfig::ReadOnlyAndRequired, WzConfig::UseBinaryCache);
 	calcDataHash(ini, DATA_SSTRMOD);
 
 	if (!loadStructureStrengthModifiers(ini))
@@ -403,7 +403,7 @@ static bool bufferSSTRMODLoad(const char *fileName, void **ppData)
 /* Load the Feature stats */
 static bool bufferSFEATLoad(const char *fileName, void **ppData)
 {
-	WzConfig ini(fileName, WzConfig::ReadOnlyAndRequired);
+	WzConfig ini(fileName, WzConfig::ReadOnlyAndRequired, WzConfig::UseBinaryCache);
 	calcDataHash(ini, DATA_SFEAT);
 
 	if (!loadFeatureStats(ini))
@@ -438,7 +438,7 @@ static bool bufferRESCHLoad(const char *fileName, void **ppData)
 		dataRESCHRelease(nullptr);
 	}
 
-	WzConfig ini(fileName, WzConfig::ReadOnlyAndRequired);
+	WzConfig ini(fileName, WzConfig::ReadOnlyAndRequired, WzConfig::UseBinaryCache);
 	calcDataHash(ini, DATA_RESCH);
 
 	if (!loadResearch(ini))
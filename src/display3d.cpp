@@ -26,6 +26,7 @@
 #include "lib/framework/frame.h"
 #include "lib/framework/math_ext.h"
 #include "lib/framework/stdio_ext.h"
+#include "lib/framework/wzparallel.h"
 
 /* Includes direct access to render library */
 #include "lib/ivis_opengl/pieblitfunc.h"
@@ -95,6 +96,7 @@
 #include "shadowcascades.h"
 #include "profiling.h"
 #include "game_world.h"
+#include "staticcull.h"
 
 
 /********************  Prototypes  ********************/
@@ -105,7 +107,7 @@ static void displayDynamicObjects(const glm::mat4 &viewMatrix, const glm::mat4 &
 static void displayStaticObjects(const glm::mat4 &viewMatrix, const glm::mat4 &perspectiveViewMatrix);
 static void displayFeatures(const glm::mat4 &viewMatrix, const glm::mat4 &perspectiveViewMatrix);
 static UDWORD	getTargettingGfx();
-static void	drawGroupNumber(BASE_OBJECT *psObject);
+static void	queueGroupNumberImage(BASE_OBJECT *psObject, BatchedMultiImageRenderer& batchedMultiImageRenderer, size_t imageGroup);
 static void	trackHeight(int desiredHeight);
 static void	renderSurroundings(const glm::mat4& projectionMatrix, const glm::mat4 &skyboxViewMatrix);
 static void	locateMouse();
@@ -127,10 +129,10 @@ static void	showSensorRange2(BASE_OBJECT *psObj);
 static void	drawRangeAtPos(SDWORD centerX, SDWORD centerY, SDWORD radius);
 static void	addConstructionLine(DROID *psDroid, STRUCTURE *psStructure, const glm::mat4 &viewMatrix);
 static void	doConstructionLines(const glm::mat4 &viewMatrix);
-static void	drawDroidCmndNo(DROID *psDroid);
+static void	queueDroidCmndNoImages(DROID *psDroid, BatchedMultiImageRenderer& batchedMultiImageRenderer, size_t imageGroup);
 static void	drawDroidOrder(const DROID *psDroid);
-static void	drawDroidRank(DROID *psDroid);
-static void	drawDroidSensorLock(DROID *psDroid);
+static void	queueDroidRankImage(DROID *psDroid, BatchedMultiImageRenderer& batchedMultiImageRenderer, size_t imageGroup);
+static void	queueDroidSensorLockImage(DROID *psDroid, BatchedMultiImageRenderer& batchedMultiImageRenderer, size_t imageGroup);
 static	int	calcAverageTerrainHeight(WorldMapState& mapState, int tileX, int tileZ);
 static	int	calculateCameraHeight(int height);
 static void	updatePlayerAverageCentreTerrainHeight();
@@ -197,6 +199,8 @@ static bool bIsCloseDistance = false;
 /// Stores the screen coordinates of the transformed terrain tiles
 static Vector3i tileScreenInfo[VISIBLE_YTILES + 1][VISIBLE_XTILES + 1];
 static bool tileScreenVisible[VISIBLE_YTILES + 1][VISIBLE_XTILES + 1] = {false};
+/// Map tiles (with a tile of margin for rounding) spanned by the set entries of tileScreenVisible
+static CullRect screenVisibleTiles;
 
 /// Records the present X and Y values for the current mouse tile (in tiles)
 SDWORD mouseTileX, mouseTileY;
@@ -408,7 +412,7 @@ static void queueDroidEnemyHealthBarsRects(DROID *psDroid, BatchedMultiRectRende
 static void queueWeaponReloadBarRects(BASE_OBJECT *psObj, WEAPON *psWeap, int weapon_slot, BatchedMultiRectRenderer& batchedMultiRectRenderer, size_t rectGroup);
 static void queueStructureHealth(STRUCTURE *psStruct, BatchedMultiRectRenderer& batchedMultiRectRenderer, size_t rectGroup);
 static void queueStructureBuildProgress(STRUCTURE *psStruct, BatchedMultiRectRenderer& batchedMultiRectRenderer, size_t rectGroup);
-static void drawStructureTargetOriginIcon(STRUCTURE *psStruct, int weapon_slot);
+static void queueStructureTargetOriginImage(STRUCTURE *psStruct, int weapon_slot, BatchedMultiImageRenderer& batchedMultiImageRenderer, size_t imageGroup);
 
 class BatchedObjectStatusRenderer
 {
@@ -436,7 +440,17 @@ public:
 						queueWeaponReloadBarRects((BASE_OBJECT *)psDroid, &psDroid->asWeaps[i], i, batchedMultiRectRenderer, 1);
 					}
 
-					droidsToDraw.push_back(psDroid);
+					/* Write the droid rank out */
+					if ((psDroid->sDisplay.screenX + psDroid->sDisplay.screenR) > 0
+						&&	(psDroid->sDisplay.screenX - psDroid->sDisplay.screenR) < pie_GetVideoBufferWidth()
+						&&	(psDroid->sDisplay.screenY + psDroid->sDisplay.screenR) > 0
+						&&	(psDroid->sDisplay.screenY - psDroid->sDisplay.screenR) < pie_GetVideoBufferHeight())
+					{
+						queueDroidRankImage(psDroid, batchedMultiImageRenderer, 1);
+						queueDroidSensorLockImage(psDroid, batchedMultiImageRenderer, 1);
+						queueDroidCmndNoImages(psDroid, batchedMultiImageRenderer, 1);
+						queueGroupNumberImage(psDroid, batchedMultiImageRenderer, 1);
+					}
 				}
 			}
 		}
@@ -474,10 +488,12 @@ public:
 					for (unsigned i = 0; i < psStruct->numWeaps; i++)
 					{
 						queueWeaponReloadBarRects((BASE_OBJECT *)psStruct, &psStruct->asWeaps[i], i, batchedMultiRectRenderer, 3);
-						// drawStructureTargetOriginIcon(psStruct, i); // in the future, use instanced rendering here? (for now, add to structsToDraw below and handle later)
+						queueStructureTargetOriginImage(psStruct, i, batchedMultiImageRenderer, 2);
+					}
+					if (psStruct->isFactory())
+					{
+						queueGroupNumberImage(psStruct, batchedMultiImageRenderer, 2);
 					}
-
-					structsToDraw.push_back(psStruct);
 				}
 
 				if (psStruct->status == SS_BEING_BUILT)
@@ -490,69 +506,83 @@ public:
 
 	void addStructureTargetingGfxToRender()
 	{
-		// Future todo: make this instanced as well?
-		renderStructureTargetingGfx = true;
+		const UWORD targettingGfx = static_cast<UWORD>(getTargettingGfx());
+		for (uint32_t i = 0; i < MAX_PLAYERS; i++)
+		{
+			for (const STRUCTURE* psStruct : gameWorld.objects.structures[i])
+			{
+				/* If it's targetted and on-screen */
+				if (psStruct->flags.test(OBJECT_FLAG_TARGETED)
+					&& psStruct->sDisplay.frameNumber == currentGameFrame)
+				{
+					batchedMultiImageRenderer.addImage(IntImages, targettingGfx, psStruct->sDisplay.screenX, psStruct->sDisplay.screenY, pal_RGBA(255, 255, 255, 255), 3);
+				}
+			}
+		}
+	}
+
+	/// With `drawOrders`, each droid's order letter is drawn first and its marker straight after it, as the
+	/// letters are not batched; otherwise the droid markers are queued along with the feature markers
+	void addTargetedDroidAndFeatureGfxToRender(bool drawOrders)
+	{
+		for (int i = 0; i < MAX_PLAYERS; i++)
+		{
+			for (const DROID *psDroid : gameWorld.objects.droids[i])
+			{
+				if (drawOrders)
+				{
+					drawDroidOrder(psDroid);
+				}
+				if (!psDroid->died && psDroid->sDisplay.frameNumber == currentGameFrame
+					&& psDroid->flags.test(OBJECT_FLAG_TARGETED) && psDroid->visibleForLocalDisplay() == UBYTE_MAX)
+				{
+					const UWORD index = static_cast<UWORD>(IMAGE_BLUE1 + getModularScaledRealTime(1020, 5));
+					if (drawOrders)
+					{
+						iV_DrawImage(IntImages, index, psDroid->sDisplay.screenX, psDroid->sDisplay.screenY);
+					}
+					else
+					{
+						batchedMultiImageRenderer.addImage(IntImages, index, psDroid->sDisplay.screenX, psDroid->sDisplay.screenY, pal_RGBA(255, 255, 255, 255), 0);
+					}
+				}
+			}
+		}
+
+		const UWORD targettingGfx = static_cast<UWORD>(getTargettingGfx());
+		for (const FEATURE *psFeature : gameWorld.objects.features[0])
+		{
+			if (!psFeature->died && psFeature->sDisplay.frameNumber == currentGameFrame
+				&& psFeature->flags.test(OBJECT_FLAG_TARGETED))
+			{
+				batchedMultiImageRenderer.addImage(IntImages, targettingGfx, psFeature->sDisplay.screenX, psFeature->sDisplay.screenY, pal_RGBA(255, 255, 255, 255), 0);
+			}
+		}
 	}
 
 	void drawAllSelections()
 	{
+		// targeted droid / feature markers
+		batchedMultiImageRenderer.drawImages(0);
+
 		// droid selection / health draw
 		// 1. box + power bars rects
 		batchedMultiRectRenderer.drawRects(0);
-		// 2. droid rank images
-		for (DROID *psDroid : droidsToDraw)
-		{
-			/* Write the droid rank out */
-			if ((psDroid->sDisplay.screenX + psDroid->sDisplay.screenR) > 0
-				&&	(psDroid->sDisplay.screenX - psDroid->sDisplay.screenR) < pie_GetVideoBufferWidth()
-				&&	(psDroid->sDisplay.screenY + psDroid->sDisplay.screenR) > 0
-				&&	(psDroid->sDisplay.screenY - psDroid->sDisplay.screenR) < pie_GetVideoBufferHeight())
-			{
-				drawDroidRank(psDroid);
-				drawDroidSensorLock(psDroid);
-				drawDroidCmndNo(psDroid);
-				drawGroupNumber(psDroid);
-			}
-		}
+		// 2. droid rank / sensor lock / commander / group number images
+		batchedMultiImageRenderer.drawImages(1);
 		// 3. weapon reload bar
 		batchedMultiRectRenderer.drawRects(1);
 
 		// structure selection / health draw
 		// 1. structure health / build progress rects
 		batchedMultiRectRenderer.drawRects(2);
-		// 2. structure target origin icons
-		for (STRUCTURE *psStruct : structsToDraw)
-		{
-			for (unsigned i = 0; i < psStruct->numWeaps; i++)
-			{
-				drawStructureTargetOriginIcon(psStruct, i);
-			}
-			if (psStruct->isFactory())
-			{
-				drawGroupNumber(psStruct);
-			}
-		}
+		// 2. structure target origin icons and factory group numbers
+		batchedMultiImageRenderer.drawImages(2);
 		// 3. structure weapon reload bars
 		batchedMultiRectRenderer.drawRects(3);
 
-		if (renderStructureTargetingGfx)
-		{
-			SDWORD scrX, scrY;
-			for (uint32_t i = 0; i < MAX_PLAYERS; i++)
-			{
-				for (const STRUCTURE* psStruct : gameWorld.objects.structures[i])
-				{
-					/* If it's targetted and on-screen */
-					if (psStruct->flags.test(OBJECT_FLAG_TARGETED)
-						&& psStruct->sDisplay.frameNumber == currentGameFrame)
-					{
-						scrX = psStruct->sDisplay.screenX;
-						scrY = psStruct->sDisplay.screenY;
-						iV_DrawImage(IntImages, getTargettingGfx(), scrX, scrY);
-					}
-				}
-			}
-		}
+		// targeted structure markers
+		batchedMultiImageRenderer.drawImages(3);
 
 		// draw last rects
 		batchedMultiRectRenderer.drawRects(4);
@@ -563,26 +593,26 @@ public:
 		batchedMultiRectRenderer.initialize();
 		// 2 for droid selection rect groups, + 2 for structure selection rect groups, + 1 for "mouse over" rect groups (drawn last)
 		batchedMultiRectRenderer.resizeRectGroups(5);
+		batchedMultiImageRenderer.initialize();
+		// targeted droid / feature markers, droid icons, structure icons, targeted structure markers
+		batchedMultiImageRenderer.resizeImageGroups(4);
 	}
 
 	void clear()
 	{
-		droidsToDraw.clear();
-		structsToDraw.clear();
-		renderStructureTargetingGfx = false;
 		batchedMultiRectRenderer.clear();
+		batchedMultiImageRenderer.clear();
 	}
 
 	void reset()
 	{
 		clear();
 		batchedMultiRectRenderer.reset();
+		batchedMultiImageRenderer.reset();
 	}
 private:
-	std::vector<DROID *> droidsToDraw;
-	std::vector<STRUCTURE *> structsToDraw;
-	bool renderStructureTargetingGfx = false;
 	BatchedMultiRectRenderer batchedMultiRectRenderer;
+	BatchedMultiImageRenderer batchedMultiImageRenderer;
 };
 
 static BatchedObjectStatusRenderer batchedObjectStatusRenderer;
@@ -1284,6 +1314,7 @@ static void drawTiles(iView *player, LightingData& lightData, LightMap& lightmap
 	// (used for more accurate clipping elsewhere)
 	{
 		WZ_PROFILE_SCOPE(tile_Culling);
+		screenVisibleTiles = CullRect();
 		for (int idx = 0; idx < visibleTiles.y; ++idx)
 		{
 			for (int jdx = 0; jdx < visibleTiles.x; ++jdx)
@@ -1303,6 +1334,12 @@ static void drawTiles(iView *player, LightingData& lightData, LightMap& lightmap
 				quad.coords[3].y = tileScreenInfo[idx + 1][jdx + 0].y;
 
 				tileScreenVisible[idx][jdx] = quadIntersectsWithScreen(quad);
+				if (tileScreenVisible[idx][jdx])
+				{
+					const int tileX = playerXTile + jdx - visibleTiles.x / 2;
+					const int tileY = playerZTile + idx - visibleTiles.y / 2;
+					screenVisibleTiles.unite(CullRect{tileX - 1, tileY - 1, tileX + 2, tileY + 2});
+				}
 			}
 		}
 	}
@@ -1835,6 +1872,25 @@ void	renderProjectile(PROJECTILE *psCurr, const glm::mat4 &viewMatrix, const glm
 	}
 }
 
+// Objects near the visible part of the map this frame, and whether each one is on screen
+static std::vector<BASE_OBJECT *> clipCandidates;
+static std::vector<uint8_t> clipCandidateVisible;
+
+/// Run `clip` on every object in clipCandidates, spread over the shared worker pool.
+/// The clip functions only read the object and this frame's tile visibility, so they can run concurrently;
+/// rendering (which has plenty of side effects) stays on the main thread, in the original order.
+template <typename ClipFunc>
+static void clipCandidatesOnScreen(ClipFunc clip)
+{
+	clipCandidateVisible.assign(clipCandidates.size(), 0);
+	wzParallelFor(clipCandidates.size(), 64, [&clip](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i)
+		{
+			clipCandidateVisible[i] = clip(clipCandidates[i]) ? 1 : 0;
+		}
+	});
+}
+
 /// Draw the buildings
 static void displayStaticObjects(const glm::mat4 &viewMatrix, const glm::mat4 &perspectiveViewMatrix)
 {
@@ -1842,48 +1898,28 @@ static void displayStaticObjects(const glm::mat4 &viewMatrix, const glm::mat4 &p
 	// to solve the flickering edges of baseplates
 //	pie_SetDepthOffset(-1.0f);
 
-	/* Go through all the players */
-	for (unsigned aPlayer = 0; aPlayer < MAX_PLAYERS; ++aPlayer)
-	{
-		/* Now go all buildings for that player */
-		for (BASE_OBJECT* obj : gameWorld.objects.structures[aPlayer])
-		{
-			/* Worth rendering the structure? */
-			if (obj->type != OBJ_STRUCTURE || (obj->died != 0 && obj->died < graphicsTime)
-				|| !quickClipXYToMaximumTilesFromCurrentPosition(obj->pos.x, obj->pos.y))
-			{
-				continue;
-			}
-			STRUCTURE *psStructure = castStructure(obj);
-
-			if (!clipStructureOnScreen(psStructure))
-			{
-				continue;
-			}
-
-			renderStructure(psStructure, viewMatrix, perspectiveViewMatrix);
-		}
-	}
+	clipCandidates.clear();
+	staticCullQuery(OBJ_STRUCTURE, screenVisibleTiles, clipCandidates);
 
 	// Walk through destroyed objects.
-
-	/* Now go all buildings for that player */
 	for (BASE_OBJECT* obj : psDestroyedObj)
 	{
 		/* Worth rendering the structure? */
-		if (obj->type != OBJ_STRUCTURE || (obj->died != 0 && obj->died < graphicsTime)
-			|| !quickClipXYToMaximumTilesFromCurrentPosition(obj->pos.x, obj->pos.y))
+		if (obj->type == OBJ_STRUCTURE && (obj->died == 0 || obj->died >= graphicsTime)
+			&& quickClipXYToMaximumTilesFromCurrentPosition(obj->pos.x, obj->pos.y))
 		{
-			continue;
+			clipCandidates.push_back(obj);
 		}
-		STRUCTURE* psStructure = castStructure(obj);
+	}
+
+	clipCandidatesOnScreen([](BASE_OBJECT *obj) { return clipStructureOnScreen(castStructure(obj)); });
 
-		if (!clipStructureOnScreen(psStructure))
+	for (size_t i = 0; i < clipCandidates.size(); ++i)
+	{
+		if (clipCandidateVisible[i])
 		{
-			continue;
+			renderStructure(castStructure(clipCandidates[i]), viewMatrix, perspectiveViewMatrix);
 		}
-
-		renderStructure(psStructure, viewMatrix, perspectiveViewMatrix);
 	}
 
 //	pie_SetDepthOffset(0.0f);
@@ -2151,18 +2187,17 @@ static void displayFeatures(const glm::mat4 &viewMatrix, const glm::mat4 &perspe
 	WZ_PROFILE_SCOPE(displayFeatures);
 	// player can only be 0 for the features.
 
-	/* Go through all the features */
-	for (BASE_OBJECT* obj : gameWorld.objects.features[0])
+	/* Go through the features near the visible part of the map */
+	clipCandidates.clear();
+	staticCullQuery(OBJ_FEATURE, screenVisibleTiles, clipCandidates);
+
+	clipCandidatesOnScreen([](BASE_OBJECT *obj) { return clipFeatureOnScreen(castFeature(obj)); });
+
+	for (size_t i = 0; i < clipCandidates.size(); ++i)
 	{
-		if (obj->type == OBJ_FEATURE
-			&& (obj->died == 0 || obj->died > graphicsTime)
-			&& quickClipXYToMaximumTilesFromCurrentPosition(obj->pos.x, obj->pos.y))
+		if (clipCandidateVisible[i])
 		{
-			FEATURE* psFeature = castFeature(obj);
-			if (clipFeatureOnScreen(psFeature))
-			{
-				renderFeature(psFeature, viewMatrix, perspectiveViewMatrix);
-			}
+			renderFeature(castFeature(clipCandidates[i]), viewMatrix, perspectiveViewMatrix);
 		}
 	}
 
@@ -3098,7 +3133,7 @@ static void queueWeaponReloadBarRects(BASE_OBJECT *psObj, WEAPON *psWeap, int we
 }
 
 /// draw target origin icon for the specified structure
-static void drawStructureTargetOriginIcon(STRUCTURE *psStruct, int weapon_slot)
+static void queueStructureTargetOriginImage(STRUCTURE *psStruct, int weapon_slot, BatchedMultiImageRenderer& batchedMultiImageRenderer, size_t imageGroup)
 {
 	SDWORD		scrX, scrY, scrR;
 	UDWORD		scale;
@@ -3118,22 +3153,22 @@ static void drawStructureTargetOriginIcon(STRUCTURE *psStruct, int weapon_slot)
 	switch (psStruct->asWeaps[weapon_slot].origin)
 	{
 	case ORIGIN_VISUAL:
-		iV_DrawImage(IntImages, IMAGE_ORIGIN_VISUAL, scrX + scrR + 5, scrY - 1);
+		batchedMultiImageRenderer.addImage(IntImages, IMAGE_ORIGIN_VISUAL, scrX + scrR + 5, scrY - 1, pal_RGBA(255, 255, 255, 255), imageGroup);
 		break;
 	case ORIGIN_COMMANDER:
-		iV_DrawImage(IntImages, IMAGE_ORIGIN_COMMANDER, scrX + scrR + 5, scrY - 1);
+		batchedMultiImageRenderer.addImage(IntImages, IMAGE_ORIGIN_COMMANDER, scrX + scrR + 5, scrY - 1, pal_RGBA(255, 255, 255, 255), imageGroup);
 		break;
 	case ORIGIN_SENSOR:
-		iV_DrawImage(IntImages, IMAGE_ORIGIN_SENSOR_STANDARD, scrX + scrR + 5, scrY - 1);
+		batchedMultiImageRenderer.addImage(IntImages, IMAGE_ORIGIN_SENSOR_STANDARD, scrX + scrR + 5, scrY - 1, pal_RGBA(255, 255, 255, 255), imageGroup);
 		break;
 	case ORIGIN_CB_SENSOR:
-		iV_DrawImage(IntImages, IMAGE_ORIGIN_SENSOR_CB, scrX + scrR + 5, scrY - 1);
+		batchedMultiImageRenderer.addImage(IntImages, IMAGE_ORIGIN_SENSOR_CB, scrX + scrR + 5, scrY - 1, pal_RGBA(255, 255, 255, 255), imageGroup);
 		break;
 	case ORIGIN_AIRDEF_SENSOR:
-		iV_DrawImage(IntImages, IMAGE_ORIGIN_SENSOR_AIRDEF, scrX + scrR + 5, scrY - 1);
+		batchedMultiImageRenderer.addImage(IntImages, IMAGE_ORIGIN_SENSOR_AIRDEF, scrX + scrR + 5, scrY - 1, pal_RGBA(255, 255, 255, 255), imageGroup);
 		break;
 	case ORIGIN_RADAR_DETECTOR:
-		iV_DrawImage(IntImages, IMAGE_ORIGIN_RADAR_DETECTOR, scrX + scrR + 5, scrY - 1);
+		batchedMultiImageRenderer.addImage(IntImages, IMAGE_ORIGIN_RADAR_DETECTOR, scrX + scrR + 5, scrY - 1, pal_RGBA(255, 255, 255, 255), imageGroup);
 		break;
 	case ORIGIN_UNKNOWN:
 		// Do nothing
@@ -3470,7 +3505,6 @@ static void	drawDroidSelections()
 	BASE_OBJECT		*psClickedOn;
 	bool			bMouseOverDroid = false;
 	bool			bMouseOverOwnDroid = false;
-	UDWORD			index;
 
 	psClickedOn = mouseTarget();
 	if (psClickedOn != nullptr && psClickedOn->type == OBJ_DROID)
@@ -3514,37 +3548,7 @@ static void	drawDroidSelections()
 		}
 	}
 
-	for (int i = 0; i < MAX_PLAYERS; i++)
-	{
-		/* Go thru' all the droids */
-		for (const DROID *psDroid : gameWorld.objects.droids[i])
-		{
-			if (showORDERS)
-			{
-				drawDroidOrder(psDroid);
-			}
-			if (!psDroid->died && psDroid->sDisplay.frameNumber == currentGameFrame)
-			{
-				/* If it's selected */
-				if (psDroid->flags.test(OBJECT_FLAG_TARGETED) && psDroid->visibleForLocalDisplay() == UBYTE_MAX)
-				{
-					index = IMAGE_BLUE1 + getModularScaledRealTime(1020, 5);
-					iV_DrawImage(IntImages, index, psDroid->sDisplay.screenX, psDroid->sDisplay.screenY);
-				}
-			}
-		}
-	}
-
-	for (const FEATURE *psFeature : gameWorld.objects.features[0])
-	{
-		if (!psFeature->died && psFeature->sDisplay.frameNumber == currentGameFrame)
-		{
-			if (psFeature->flags.test(OBJECT_FLAG_TARGETED))
-			{
-				iV_DrawImage(IntImages, getTargettingGfx(), psFeature->sDisplay.screenX, psFeature->sDisplay.screenY);
-			}
-		}
-	}
+	batchedObjectStatusRenderer.addTargetedDroidAndFeatureGfxToRender(showORDERS);
 }
 
 static void drawDroidAndStructureSelections()
@@ -3568,7 +3572,7 @@ enum GROUPNUMBER_TYPE
 };
 /// rendering of the object's group next to the object itself,
 /// or the group that will be assigned to the object after production in the factory
-static void	drawGroupNumber(BASE_OBJECT *psObject)
+static void	queueGroupNumberImage(BASE_OBJECT *psObject, BatchedMultiImageRenderer& batchedMultiImageRenderer, size_t imageGroup)
 {
 	UWORD id = UWORD_MAX;
 	UBYTE groupNumber = UBYTE_MAX;
@@ -3650,13 +3654,13 @@ static void	drawGroupNumber(BASE_OBJECT *psObject)
 		switch (groupNumberType)
 		{
 		case GN_NORMAL:
-			iV_DrawImage(IntImages, id, x, y);
+			batchedMultiImageRenderer.addImage(IntImages, id, x, y, pal_RGBA(255, 255, 255, 255), imageGroup);
 			break;
 		case GN_DAMAGED:
-			iV_DrawImageTint(IntImages, id, x, y, pal_RGBA(255, 0, 0, 255) /* red */);
+			batchedMultiImageRenderer.addImage(IntImages, id, x, y, pal_RGBA(255, 0, 0, 255) /* red */, imageGroup);
 			break;
 		case GN_FACTORY:
-			iV_DrawImageTint(IntImages, id, x, y, pal_RGBA(255, 220, 115, 255) /* gold */);
+			batchedMultiImageRenderer.addImage(IntImages, id, x, y, pal_RGBA(255, 220, 115, 255) /* gold */, imageGroup);
 			break;
 		default:
 			break;
@@ -3677,8 +3681,8 @@ static void drawDroidOrder(const DROID *psDroid)
 	iV_DrawText(letter, psDroid->sDisplay.screenX - xShift - CMND_STAR_X_OFFSET,  psDroid->sDisplay.screenY + yShift, font_regular);
 }
 
-/// Draw the number of the commander the droid is assigned to
-static void	drawDroidCmndNo(DROID *psDroid)
+/// Queue the number of the commander the droid is assigned to
+static void	queueDroidCmndNoImages(DROID *psDroid, BatchedMultiImageRenderer& batchedMultiImageRenderer, size_t imageGroup)
 {
 	SDWORD	xShift, yShift, index;
 	UDWORD	id2;
@@ -3735,8 +3739,8 @@ static void	drawDroidCmndNo(DROID *psDroid)
 	{
 		xShift = psDroid->sDisplay.screenR + GN_X_OFFSET;
 		yShift = psDroid->sDisplay.screenR - CMND_GN_Y_OFFSET;
-		iV_DrawImage(IntImages, id2, psDroid->sDisplay.screenX - xShift - CMND_STAR_X_OFFSET, psDroid->sDisplay.screenY + yShift);
-		iV_DrawImage(IntImages, id, psDroid->sDisplay.screenX - xShift, psDroid->sDisplay.screenY + yShift);
+		batchedMultiImageRenderer.addImage(IntImages, id2, psDroid->sDisplay.screenX - xShift - CMND_STAR_X_OFFSET, psDroid->sDisplay.screenY + yShift, pal_RGBA(255, 255, 255, 255), imageGroup);
+		batchedMultiImageRenderer.addImage(IntImages, id, psDroid->sDisplay.screenX - xShift, psDroid->sDisplay.screenY + yShift, pal_RGBA(255, 255, 255, 255), imageGroup);
 	}
 }
 /* ---------------------------------------------------------------------------- */
@@ -4313,10 +4317,9 @@ UDWORD  getDroidRankGraphic(const DROID *psDroid)
 	return getDroidRankGraphicFromLevel(getDroidLevel(psDroid));
 }
 
-/**	Will render a graphic depiction of the droid's present rank.
- * \note Assumes matrix context set and that z-buffer write is force enabled (Always).
+/**	Will queue a graphic depiction of the droid's present rank.
  */
-static void	drawDroidRank(DROID *psDroid)
+static void	queueDroidRankImage(DROID *psDroid, BatchedMultiImageRenderer& batchedMultiImageRenderer, size_t imageGroup)
 {
 	UDWORD	gfxId = getDroidRankGraphic(psDroid);
 
@@ -4324,22 +4327,22 @@ static void	drawDroidRank(DROID *psDroid)
 	if (gfxId != UDWORD_MAX)
 	{
 		/* Render the rank graphic at the correct location */ // remove hardcoded numbers?!
-		iV_DrawImage(IntImages, (UWORD)gfxId,
+		batchedMultiImageRenderer.addImage(IntImages, (UWORD)gfxId,
 		             psDroid->sDisplay.screenX + psDroid->sDisplay.screenR + 8,
-		             psDroid->sDisplay.screenY + psDroid->sDisplay.screenR);
+		             psDroid->sDisplay.screenY + psDroid->sDisplay.screenR,
+		             pal_RGBA(255, 255, 255, 255), imageGroup);
 	}
 }
 
-/**	Will render a sensor graphic for a droid locked to a sensor droid/structure
- * \note Assumes matrix context set and that z-buffer write is force enabled (Always).
+/**	Will queue a sensor graphic for a droid locked to a sensor droid/structure
  */
-static void	drawDroidSensorLock(DROID *psDroid)
+static void	queueDroidSensorLockImage(DROID *psDroid, BatchedMultiImageRenderer& batchedMultiImageRenderer, size_t imageGroup)
 {
 	//if on fire support duty - must be locked to a Sensor Droid/Structure
 	if (orderState(psDroid, DORDER_FIRESUPPORT))
 	{
 		/* Render the sensor graphic at the correct location - which is what?!*/
-		iV_DrawImage(IntImages, IMAGE_GN_STAR, psDroid->sDisplay.screenX, psDroid->sDisplay.screenY);
+		batchedMultiImageRenderer.addImage(IntImages, IMAGE_GN_STAR, psDroid->sDisplay.screenX, psDroid->sDisplay.screenY, pal_RGBA(255, 255, 255, 255), imageGroup);
 	}
 }
 
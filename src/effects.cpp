@@ -90,6 +90,8 @@
 #endif
 #include <glm/gtx/transform.hpp>
 
+#include <array>
+
 #define	GRAVITON_GRAVITY	((float)-800)
 #define	EFFECT_X_FLIP		0x1
 #define	EFFECT_Y_FLIP		0x2
@@ -170,7 +172,9 @@
 #define SHOCKWAVE_SPEED	(GAME_TICKS_PER_SEC)
 #define	MAX_SHOCKWAVE_SIZE				500
 
-static PagedEntityContainer<EFFECT> gActiveEffects;
+/* The active effects, kept in one container per EFFECT_GROUP: each group is updated in one run, */
+/* so the per-type update code and its data stay hot instead of being interleaved with every other group */
+static std::array<PagedEntityContainer<EFFECT>, EFFECT_FREED> gActiveEffects;
 
 /* Tick counts for updates on a particular interval */
 static	UDWORD	lastUpdateStructures[EFFECT_STRUCTURE_DIVISION];
@@ -198,7 +202,7 @@ static bool updateDestruction(EFFECT *psEffect, LightingData& lightData);
 static bool updateFire(EFFECT *psEffect, LightingData& lightData);
 static bool updateSatLaser(EFFECT *psEffect, LightingData& lightData);
 static bool updateFirework(EFFECT *psEffect);
-static bool updateEffect(EFFECT *psEffect, LightingData& lightData);	// MASTER function
+static bool updateEffect(EFFECT *psEffect, LightingData& lightData, bool paused);	// MASTER function
 
 // ----------------------------------------------------------------------------------------
 // ---- The render functions - every group type of effect has a distinct one
@@ -233,7 +237,27 @@ static UDWORD effectGetNumFrames(EFFECT *psEffect);
 
 void shutdownEffectsSystem()
 {
-	gActiveEffects.clear();
+	for (auto &groupEffects : gActiveEffects)
+	{
+		groupEffects.clear();
+	}
+}
+
+/* Adds an effect to the container of its group */
+static void storeEffect(EFFECT &&effect)
+{
+	ASSERT_OR_RETURN(, effect.group >= 0 && effect.group < EFFECT_FREED, "Invalid effect group: %d", static_cast<int>(effect.group));
+	gActiveEffects[effect.group].emplace(std::move(effect));
+}
+
+static size_t numActiveEffects()
+{
+	size_t count = 0;
+	for (const auto &groupEffects : gActiveEffects)
+	{
+		count += groupEffects.size();
+	}
+	return count;
 }
 
 /*!
@@ -482,7 +506,7 @@ void addEffect(const Vector3i *pos, EFFECT_GROUP group, EFFECT_TYPE type, bool s
 
 	ASSERT(effect.imd != nullptr || group == EFFECT_DESTRUCTION || group == EFFECT_FIRE || group == EFFECT_SAT_LASER, "null effect imd");
 
-	gActiveEffects.emplace(std::move(effect));
+	storeEffect(std::move(effect));
 }
 
 
@@ -490,20 +514,24 @@ void addEffect(const Vector3i *pos, EFFECT_GROUP group, EFFECT_TYPE type, bool s
 void processEffects(const glm::mat4 &perspectiveViewMatrix, LightingData& lightData)
 {
 	WZ_PROFILE_SCOPE(processEffects);
-	for (auto it = gActiveEffects.begin(); it != gActiveEffects.end(); ++it)
+	const bool paused = gamePaused();
+	for (auto &groupEffects : gActiveEffects)
 	{
-		EFFECT& e = *it;
-
-		if (e.birthTime <= graphicsTime)  // Don't process, if it doesn't exist yet
+		for (auto it = groupEffects.begin(); it != groupEffects.end(); ++it)
 		{
-			if (!updateEffect(&e, lightData))
-			{
-				gActiveEffects.erase(it);
-				continue;
-			}
-			if (e.group != EFFECT_FREED && clipXY(static_cast<SDWORD>(e.position.x), static_cast<SDWORD>(e.position.z)))
+			EFFECT& e = *it;
+
+			if (e.birthTime <= graphicsTime)  // Don't process, if it doesn't exist yet
 			{
-				bucketAddTypeToList(RENDER_EFFECT, &e, perspectiveViewMatrix);
+				if (!updateEffect(&e, lightData, paused))
+				{
+					groupEffects.erase(it);
+					continue;
+				}
+				if (clipXY(static_cast<SDWORD>(e.position.x), static_cast<SDWORD>(e.position.z)))
+				{
+					bucketAddTypeToList(RENDER_EFFECT, &e, perspectiveViewMatrix);
+				}
 			}
 		}
 	}
@@ -513,7 +541,7 @@ void processEffects(const glm::mat4 &perspectiveViewMatrix, LightingData& lightD
 }
 
 /* The general update function for all effects - calls a specific one for each. Returns false if effect should be deleted. */
-static bool updateEffect(EFFECT *psEffect, LightingData& lightData)
+static bool updateEffect(EFFECT *psEffect, LightingData& lightData, bool paused)
 {
 	/* What type of effect are we dealing with? */
 	switch (psEffect->group)
@@ -521,55 +549,55 @@ static bool updateEffect(EFFECT *psEffect, LightingData& lightData)
 	case EFFECT_EXPLOSION:
 		return updateExplosion(psEffect, lightData);
 	case EFFECT_WAYPOINT:
-		if (!gamePaused())
+		if (!paused)
 		{
 			return updateWaypoint(psEffect);
 		}
 		return true;
 	case EFFECT_CONSTRUCTION:
-		if (!gamePaused())
+		if (!paused)
 		{
 			return updateConstruction(psEffect);
 		}
 		return true;
 	case EFFECT_SMOKE:
-		if (!gamePaused())
+		if (!paused)
 		{
 			return updatePolySmoke(psEffect);
 		}
 		return true;
 	case EFFECT_GRAVITON:
-		if (!gamePaused())
+		if (!paused)
 		{
 			return updateGraviton(psEffect, lightData);
 		}
 		return true;
 	case EFFECT_BLOOD:
-		if (!gamePaused())
+		if (!paused)
 		{
 			return updateBlood(psEffect);
 		}
 		return true;
 	case EFFECT_DESTRUCTION:
-		if (!gamePaused())
+		if (!paused)
 		{
 			return updateDestruction(psEffect, lightData);
 		}
 		return true;
 	case EFFECT_FIRE:
-		if (!gamePaused())
+		if (!paused)
 		{
 			return updateFire(psEffect, lightData);
 		}
 		return true;
 	case EFFECT_SAT_LASER:
-		if (!gamePaused())
+		if (!paused)
 		{
 			return updateSatLaser(psEffect, lightData);
 		}
 		return true;
 	case EFFECT_FIREWORK:
-		if (!gamePaused())
+		if (!paused)
 		{
 			return updateFirework(psEffect);
 		}
@@ -2393,42 +2421,41 @@ static bool readEffectVector3i(const nlohmann::ordered_json &j, const char *key,
 std::vector<nlohmann::ordered_json> serializeActiveEffects()
 {
 	std::vector<nlohmann::ordered_json> out;
-	out.reserve(gActiveEffects.size());
-
-	for (auto iter = gActiveEffects.begin(); iter != gActiveEffects.end(); ++iter)
-	{
-		const EFFECT &e = *iter;
-		if (e.group == EFFECT_FREED)
-		{
-			continue;
-		}
+	out.reserve(numActiveEffects());
+
+	for (auto &groupEffects : gActiveEffects)
+	{
+		for (auto iter = groupEffects.begin(); iter != groupEffects.end(); ++iter)
+		{
+			const EFFECT &e = *iter;
+
+			nlohmann::ordered_json j = nlohmann::ordered_json::object();
+			j["group"] = static_cast<int>(e.group);
+			j["type"] = static_cast<int>(e.type);
+			j["control"] = e.control;
+			j["frameNumber"] = e.frameNumber;
+			j["size"] = e.size;
+			j["baseScale"] = e.baseScale;
+			j["specific"] = e.specific;
+			// The player colour the effect was created with. Gravitons, giblets and the droid death
+			// animation are drawn in it, so it must survive the round-trip.
+			j["player"] = e.player;
+			j["position"] = writeEffectVector3f(e.position);
+			j["velocity"] = writeEffectVector3f(e.velocity);
+			j["rotation"] = writeEffectVector3i(e.rotation);
+			j["spin"] = writeEffectVector3i(e.spin);
+			j["birthTime"] = e.birthTime;
+			j["lastFrame"] = e.lastFrame;
+			j["frameDelay"] = e.frameDelay;
+			j["lifeSpan"] = e.lifeSpan;
+			j["radius"] = e.radius;
+			if (e.imd)
+			{
+				j["imd"] = modelName(e.imd).toUtf8();
+			}
 
-		nlohmann::ordered_json j = nlohmann::ordered_json::object();
-		j["group"] = static_cast<int>(e.group);
-		j["type"] = static_cast<int>(e.type);
-		j["control"] = e.control;
-		j["frameNumber"] = e.frameNumber;
-		j["size"] = e.size;
-		j["baseScale"] = e.baseScale;
-		j["specific"] = e.specific;
-		// The player colour the effect was created with. Gravitons, giblets and the droid death
-		// animation are drawn in it, so it must survive the round-trip.
-		j["player"] = e.player;
-		j["position"] = writeEffectVector3f(e.position);
-		j["velocity"] = writeEffectVector3f(e.velocity);
-		j["rotation"] = writeEffectVector3i(e.rotation);
-		j["spin"] = writeEffectVector3i(e.spin);
-		j["birthTime"] = e.birthTime;
-		j["lastFrame"] = e.lastFrame;
-		j["frameDelay"] = e.frameDelay;
-		j["lifeSpan"] = e.lifeSpan;
-		j["radius"] = e.radius;
-		if (e.imd)
-		{
-			j["imd"] = modelName(e.imd).toUtf8();
+			out.push_back(std::move(j));
 		}
-
-		out.push_back(std::move(j));
 	}
 
 	return out;
@@ -2499,46 +2526,49 @@ void restoreActiveEffects(const std::vector<nlohmann::ordered_json> &effects)
 			e.radius = 1;
 		}
 
-		gActiveEffects.emplace(std::move(e));
+		storeEffect(std::move(e));
 	}
 }
 
-/** This will save out the effects data */
+/** This will save out the effects data, group by group like serializeActiveEffects() */
 bool writeFXData(const char *fileName)
 {
 	int i = 0;
 	nlohmann::json mRoot = nlohmann::json::object();
-	for (auto iter = gActiveEffects.begin(); iter != gActiveEffects.end(); ++iter, i++)
-	{
-		const EFFECT& e = *iter;
+	for (auto &groupEffects : gActiveEffects)
+	{
+		for (auto iter = groupEffects.begin(); iter != groupEffects.end(); ++iter, i++)
+		{
+			const EFFECT& e = *iter;
+
+			nlohmann::json effectObj = nlohmann::json::object();
+			effectObj["control"] = e.control;
+			effectObj["group"] = e.group;
+			effectObj["type"] = e.type;
+			effectObj["frameNumber"] = e.frameNumber;
+			effectObj["size"] = e.size;
+			effectObj["baseScale"] = e.baseScale;
+			effectObj["specific"] = e.specific;
+			effectObj["position"] = e.position;
+			effectObj["velocity"] = e.velocity;
+			effectObj["rotation"] = e.rotation;
+			effectObj["spin"] = e.spin;
+			effectObj["birthTime"] = e.birthTime;
+			effectObj["lastFrame"] = e.lastFrame;
+			effectObj["frameDelay"] = e.frameDelay;
+			effectObj["lifeSpan"] = e.lifeSpan;
+			effectObj["radius"] = e.radius;
+
+			if (e.imd)
+			{
+				effectObj["imd_name"] = modelName(e.imd).toUtf8();
+			}
 
-		nlohmann::json effectObj = nlohmann::json::object();
-		effectObj["control"] = e.control;
-		effectObj["group"] = e.group;
-		effectObj["type"] = e.type;
-		effectObj["frameNumber"] = e.frameNumber;
-		effectObj["size"] = e.size;
-		effectObj["baseScale"] = e.baseScale;
-		effectObj["specific"] = e.specific;
-		effectObj["position"] = e.position;
-		effectObj["velocity"] = e.velocity;
-		effectObj["rotation"] = e.rotation;
-		effectObj["spin"] = e.spin;
-		effectObj["birthTime"] = e.birthTime;
-		effectObj["lastFrame"] = e.lastFrame;
-		effectObj["frameDelay"] = e.frameDelay;
-		effectObj["lifeSpan"] = e.lifeSpan;
-		effectObj["radius"] = e.radius;
+			auto effectKey = "effect_" + WzString::number(i);
+			mRoot[effectKey.toUtf8()] = std::move(effectObj);
 
-		if (e.imd)
-		{
-			effectObj["imd_name"] = modelName(e.imd).toUtf8();
+			// Move on to reading the next effect
 		}
-
-		auto effectKey = "effect_" + WzString::number(i);
-		mRoot[effectKey.toUtf8()] = std::move(effectObj);
-
-		// Move on to reading the next effect
 	}
 
 	std::string jsonString;
@@ -2617,7 +2647,12 @@ bool readFXData(const char *fileName, WorldMapState& mapState)
 		// Move on to reading the next effect
 		ini.endGroup();
 
-		gActiveEffects.emplace(std::move(curEffect));
+		if (curEffect.group < 0 || curEffect.group >= EFFECT_FREED)
+		{
+			debug(LOG_ERROR, "Skipping effect with invalid group %d", static_cast<int>(curEffect.group));
+			continue;
+		}
+		storeEffect(std::move(curEffect));
 	}
 
 	/* Hopefully everything's just fine by now */
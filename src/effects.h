@@ -174,6 +174,7 @@ bool	writeFXData(const char *fileName);
 /// Serializes the live effect list, one JSON object per effect.
 /// Effects are display-only, so this belongs to the savegame's local (per-client) section and is
 /// never part of the networked game state. Returns an empty list in headless mode.
+/// The effects are listed group by group (EFFECT_GROUP order), not in the order they were created.
 std::vector<nlohmann::ordered_json> serializeActiveEffects();
 
 /// Replaces the live effect list with a previously serialized one. Clears whatever is already there,
@@ -52,6 +52,7 @@
 #include "display3d.h"
 #include "random.h"
 #include "game_world.h"
+#include "staticcull.h"
 
 /* The statistics for the features */
 std::vector<FEATURE_STATS> asFeatureStats;
@@ -347,6 +348,9 @@ FEATURE *buildFeature(GameWorld& world, FEATURE_STATS *psStats, UDWORD x, UDWORD
 	psFeature->pos.z = map_TileHeight(world.map, psFeature->pos.x, psFeature->pos.y);//jps 18july97
 	updateFeatureOrientation(psFeature, world.map);
 
+	// only now that it has its place on the map
+	staticCullAdd(psFeature, world.objects);
+
 	return psFeature;
 }
 
@@ -2744,6 +2744,8 @@ LoadingTask<> loadGame(ResourceLoadingController& controller, const GameLoadDeta
 			//clear all the messages?
 			apsProxDisp[player].clear();
 			gameWorld.objects.extractors[player].clear();
+			gameWorld.objects.repairStructures[player].clear();
+			gameWorld.objects.repairDroids[player].clear();
 		}
 		gameWorld.objects.features[0].clear();
 		gameWorld.objects.oils[0].clear();
@@ -2761,6 +2763,8 @@ LoadingTask<> loadGame(ResourceLoadingController& controller, const GameLoadDeta
 			mission.gameWorld.objects.structures[player].clear();
 			mission.gameWorld.objects.flags[player].clear();
 			mission.gameWorld.objects.extractors[player].clear();
+			mission.gameWorld.objects.repairStructures[player].clear();
+			mission.gameWorld.objects.repairDroids[player].clear();
 		}
 		mission.gameWorld.objects.features[0].clear();
 		mission.gameWorld.objects.oils[0].clear();
@@ -3542,6 +3546,7 @@ LoadingTask<> loadGame(ResourceLoadingController& controller, const GameLoadDeta
 			//the first transporter group sent off at Beta-end by reversing this very list.
 			ASSERT(selectedPlayer < MAX_PLAYERS, "selectedPlayer is out of bounds: %" PRIu32 "", selectedPlayer);
 			mission.gameWorld.objects.droids[selectedPlayer].reverse();
+			mission.gameWorld.objects.repairDroids[selectedPlayer].reverse();
 		}
 	}
 
@@ -7753,6 +7758,7 @@ void loadFixupResearchPendingStates()
 			}
 		}
 	}
+	researchAvailabilityInvalidate();
 }
 
 // -----------------------------------------------------------------------------------------
@@ -7823,6 +7829,7 @@ bool loadSaveResearch(const char *pFileName)
 		}
 		ini.endGroup();
 	}
+	researchAvailabilityInvalidate();
 	return true;
 }
 
@@ -554,6 +554,7 @@ static void readResearch(const nlohmann::ordered_json &j, uint32_t version)
 			}
 		}
 	}
+	researchAvailabilityInvalidate();
 
 	const nlohmann::ordered_json &jdef = j.at("defaults");
 	const auto readDefaults = [&jdef](const char *key, UDWORD (&dst)[MAX_PLAYERS], size_t statCount)
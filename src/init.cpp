@@ -77,6 +77,7 @@
 #include "lighting.h"
 #include "loadsave.h"
 #include "loop.h"
+#include "mapcatalog.h"
 #include "mapgrid.h"
 #include "mechanics.h"
 #include "miscimd.h"
@@ -92,6 +93,7 @@
 #include "radar.h"
 #include "research.h"
 #include "lib/framework/resource_loading_controller.h"
+#include "lib/framework/wzparallel.h"
 #include "lib/framework/loading_task.h"
 #include "wrappers.h"
 #include "lib/framework/cursors.h"
@@ -991,6 +993,51 @@ private:
 	bool m_logErrors = false;
 };
 
+// Open one map archive and fill in `entry` (whose path is set already). Safe to call from any thread.
+static bool scanMapArchive(MapCatalogEntry &entry, const std::string &realFilePathAndName)
+{
+	auto zipReadSource = WzZipIOPHYSFSSourceReadProvider::make(entry.path);
+	if (!zipReadSource)
+	{
+		debug(LOG_ERROR, "Failed to open: %s", entry.path.c_str());
+		return false;
+	}
+
+	auto debugLoggerInstance = std::make_shared<WzMapLoadDebugLogger>();
+	debugLoggerInstance->setLogErrors(true);
+	auto mapZipIO = WzMapZipIO::openZipArchiveReadIOProvider(zipReadSource, debugLoggerInstance.get());
+	if (!mapZipIO)
+	{
+		debug(LOG_INFO, "Failed to open archive: %s.\nPlease delete or move the file specified.", realFilePathAndName.c_str());
+		return false;
+	}
+	debugLoggerInstance->setLogErrors(false);
+	auto mapPackage = WzMap::MapPackage::loadPackage("", debugLoggerInstance, mapZipIO);
+	if (!mapPackage)
+	{
+		debug(LOG_INFO, "Failed to load %s.\nPlease delete or move the file specified.", realFilePathAndName.c_str());
+		return false;
+	}
+
+	entry.details = mapPackage->levelDetails();
+	auto WZmapInfoResult = CheckInMap(*mapPackage);
+	entry.isMapMod = WZmapInfoResult.isMapMod;
+	entry.isRandom = WZmapInfoResult.isRandom;
+	return true;
+}
+
+// Scan `entries[i]` for every i in `toScan` on the worker pool; `loaded[i]` is set on success.
+static void scanMapArchives(const std::vector<size_t> &toScan, std::vector<MapCatalogEntry> &entries, const std::vector<std::string> &realFilePaths, std::vector<uint8_t> &loaded)
+{
+	wzParallelFor(toScan.size(), 1, [&](size_t begin, size_t end) {
+		for (size_t job = begin; job < end; ++job)
+		{
+			const size_t i = toScan[job];
+			loaded[i] = scanMapArchive(entries[i], realFilePaths[i]) ? 1 : 0;
+		}
+	});
+}
+
 bool buildMapList(bool campaignOnly)
 {
 	if (!loadLevFile("gamedesc.lev", mod_campaign, false, nullptr))
@@ -1012,47 +1059,79 @@ bool buildMapList(bool campaignOnly)
 		return true;
 	}
 	MapFileList realFileNames = listMapFiles();
-	auto debugLoggerInstance = std::make_shared<WzMapLoadDebugLogger>();
-	for (auto &realFileName : realFileNames)
+	MapCatalog catalog;
+	const bool haveCatalog = catalog.load();
+
+	// Use the catalog for unchanged archives, and only open the rest
+	std::vector<MapCatalogEntry> entries(realFileNames.size());
+	std::vector<std::string> realFilePaths(realFileNames.size());
+	std::vector<uint8_t> loaded(realFileNames.size(), 0);
+	std::vector<size_t> toScan;
+	for (size_t i = 0; i < realFileNames.size(); ++i)
 	{
+		const auto &realFileName = realFileNames[i];
 		const char * pRealDirStr = PHYSFS_getRealDir(realFileName.platformIndependent.c_str());
 		if (!pRealDirStr)
 		{
 			debug(LOG_ERROR, "Failed to find realdir for: %s", realFileName.platformIndependent.c_str());
 			continue; // skip
 		}
-		std::string realFilePathAndName = pRealDirStr + realFileName.platformDependent;
+		realFilePaths[i] = pRealDirStr + realFileName.platformDependent;
 
-		auto zipReadSource = WzZipIOPHYSFSSourceReadProvider::make(realFileName.platformIndependent);
-		if (!zipReadSource)
+		MapCatalogEntry &entry = entries[i];
+		entry.path = realFileName.platformIndependent;
+		entry.realDir = pRealDirStr;
+		PHYSFS_Stat metaData;
+		if (PHYSFS_stat(entry.path.c_str(), &metaData) != 0 && metaData.modtime >= 0)
 		{
-			debug(LOG_ERROR, "Failed to open: %s", realFileName.platformIndependent.c_str());
-			continue;
+			entry.fileSize = metaData.filesize;
+			entry.modTime = metaData.modtime;
+			if (const MapCatalogEntry *cached = catalog.find(entry.path, entry.realDir, entry.fileSize, entry.modTime))
+			{
+				entry = *cached;
+				loaded[i] = 1;
+				continue;
+			}
+		}
+		else
+		{
+			entry.modTime = -1; // unknown modification time: always rescan, never catalogue
 		}
+		toScan.push_back(i);
+	}
+	if (!toScan.empty())
+	{
+		debug(LOG_WZ, "Scanning %zu of %zu map archives", toScan.size(), realFileNames.size());
+		scanMapArchives(toScan, entries, realFilePaths, loaded);
+	}
 
-		debugLoggerInstance->setLogErrors(true);
-		auto mapZipIO = WzMapZipIO::openZipArchiveReadIOProvider(zipReadSource, debugLoggerInstance.get());
-		if (!mapZipIO)
+	// Register the maps in listing order, on this thread
+	std::vector<MapCatalogEntry> catalogEntries;
+	catalogEntries.reserve(entries.size());
+	for (size_t i = 0; i < entries.size(); ++i)
+	{
+		if (!loaded[i])
 		{
-			debug(LOG_INFO, "Failed to open archive: %s.\nPlease delete or move the file specified.", realFilePathAndName.c_str());
 			continue;
 		}
-		debugLoggerInstance->setLogErrors(false);
-		auto mapPackage = WzMap::MapPackage::loadPackage("", debugLoggerInstance, mapZipIO);
-		if (!mapPackage)
+		const MapCatalogEntry &entry = entries[i];
+		if (entry.modTime >= 0)
 		{
-			debug(LOG_INFO, "Failed to load %s.\nPlease delete or move the file specified.", realFilePathAndName.c_str());
-			continue;
+			catalogEntries.push_back(entry);
 		}
 
-		if (!levAddWzMap(mapPackage->levelDetails(), mod_multiplay, realFileName.platformIndependent.c_str()))
+		if (!levAddWzMap(entry.details, mod_multiplay, entry.path.c_str()))
 		{
-			debug(LOG_ERROR, "Corrupt / invalid map file: %s", realFilePathAndName.c_str());
+			debug(LOG_ERROR, "Corrupt / invalid map file: %s", realFilePaths[i].c_str());
 			continue;
 		}
 
-		auto WZmapInfoResult = CheckInMap(*mapPackage);
-		WZ_Maps.insert(WZMapInfo_Map::value_type(realFileName.platformIndependent, WZmapInfoResult));
+		WZ_Maps.insert(WZMapInfo_Map::value_type(entry.path, WZmapInfo(entry.isMapMod, entry.isRandom)));
+	}
+
+	if (!haveCatalog || !toScan.empty() || catalogEntries.size() != catalog.size())
+	{
+		catalog.save(catalogEntries);
 	}
 
 	return true;
@@ -1181,6 +1260,7 @@ void systemShutdown()
 	gamepadCursorShutdown();
 	widgShutDown();
 	fpathShutdown();
+	wzParallelShutdown();	// no more loads or AI timers
 	mapShutdown();
 	modelShutdown();
 	debug(LOG_MAIN, "shutting down everything else");
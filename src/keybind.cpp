@@ -25,6 +25,7 @@
 #include "lib/framework/rational.h"
 #include "lib/framework/object_list_iteration.h"
 #include "lib/framework/physfs_ext.h"
+#include "lib/framework/memory_pool.h"
 #include "objects.h"
 #include "levels.h"
 #include "basedef.h"
@@ -34,6 +35,7 @@
 #include "console.h"
 #include "display.h"
 #include "display3d.h"
+#include "terrain.h"
 #include "edit3d.h"
 #include "keybind.h"
 #include "mechanics.h"
@@ -708,16 +710,30 @@ void	kf_FrameRate()
 {
 	CONPRINTF("FPS %d; PIEs %zu; polys %zu",
 	                          frameRate(), loopPieCount, loopPolyCount);
+	const CullStats terrainCull = getTerrainCullStats();
+	CONPRINTF("Culling nodes tested/rejected: terrain %zu/%zu; objects %zu/%zu",
+	                          terrainCull.nodesTested, terrainCull.nodesRejected,
+	                          loopStaticCullStats.nodesTested, loopStaticCullStats.nodesRejected);
 	if (runningMultiplayer())
 	{
-		CONPRINTF("NETWORK:  Bytes: s-%zu r-%zu  Uncompressed Bytes: s-%zu r-%zu  Packets: s-%zu r-%zu",
+		CONPRINTF("NETWORK:  Bytes: s-%zu r-%zu  Uncompressed Bytes: s-%zu r-%zu  Packets: s-%zu r-%zu  Copied Bytes: r-%zu",
 		                          NETgetStatistic(NetStatisticRawBytes, true),
 		                          NETgetStatistic(NetStatisticRawBytes, false),
 		                          NETgetStatistic(NetStatisticUncompressedBytes, true),
 		                          NETgetStatistic(NetStatisticUncompressedBytes, false),
 		                          NETgetStatistic(NetStatisticPackets, true),
-		                          NETgetStatistic(NetStatisticPackets, false));
+		                          NETgetStatistic(NetStatisticPackets, false),
+		                          NETgetStatistic(NetStatisticCopiedBytes, false));
 	}
+	size_t poolUsed = 0, poolCapacity = 0, poolPeak = 0;
+	for (const auto& sizeClass : memoryPoolStats())
+	{
+		poolUsed += sizeClass.used * sizeClass.blockSize;
+		poolCapacity += sizeClass.capacity * sizeClass.blockSize;
+		poolPeak += sizeClass.peakUsed * sizeClass.blockSize;
+	}
+	CONPRINTF("Memory pools: %zu KiB used of %zu KiB, peak %zu KiB (size classes in the log)", poolUsed / 1024, poolCapacity / 1024, poolPeak / 1024);
+	memoryPoolLogStats(LOG_INFO);
 	gameStats = !gameStats;
 	CONPRINTF("Built: %s %s", getCompileDate(), __TIME__);
 }
@@ -58,6 +58,7 @@
 #include "message.h"
 #include "bucket3d.h"
 #include "display3d.h"
+#include "staticcull.h"
 #include "warzoneconfig.h"
 
 #include "multiplay.h" //ajl
@@ -106,6 +107,7 @@
  */
 size_t loopPieCount;
 size_t loopPolyCount;
+CullStats loopStaticCullStats;
 
 /*
  * local variables
@@ -349,6 +351,7 @@ static GAMECODE renderLoop()
 	}
 
 	pie_GetResetCounts(&loopPieCount, &loopPolyCount);
+	loopStaticCullStats = staticCullTakeStats();
 
 	// deal with the mission state
 	switch (loopMissionState)
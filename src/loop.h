@@ -26,6 +26,7 @@
 
 #include "lib/framework/frame.h"
 #include "levels.h"
+#include "lib/ivis_opengl/culling.h"
 
 #include <nonstd/optional.hpp>
 using nonstd::optional;
@@ -60,6 +61,7 @@ extern LEVEL_TYPE prevMissionType;
 
 extern size_t loopPieCount;
 extern size_t loopPolyCount;
+extern CullStats loopStaticCullStats; ///< structure / feature culling counters of the last frame
 
 GAMECODE gameLoop();
 void videoLoop();
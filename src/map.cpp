@@ -49,6 +49,7 @@
 #include "research.h"
 #include "mission.h"
 #include "gateway.h"
+#include "continent_labels.h"
 #include "wrappers.h"
 #include "mapgrid.h"
 #include "qtscript.h"
@@ -2031,80 +2032,42 @@ static const Vector2i aDirOffset[] =
 	Vector2i(1, 1),
 };
 
-// Flood fill a "continent".
-// TODO take into account scroll limits and update continents on scroll limit changes
-static void mapFloodFill(WorldMapState& mapState, int x, int y, int continent, uint8_t blockedBits, uint16_t MAPTILE::*varContinent)
+// Continent class of a tile for land or sea limited propulsion types: 1 = land, 2 = sea, 0 = neither.
+static uint8_t limitedContinentClass(const WorldMapState& mapState, int x, int y)
 {
-	std::vector<Vector2i> open;
-	open.push_back(Vector2i(x, y));
-	mapTile(mapState, x, y)->*varContinent = continent;  // Set continent value
-
-	while (!open.empty())
+	const uint8_t bits = blockTile(mapState, x, y, AUX_MAP);
+	if (!(bits & (WATER_BLOCKED | FEATURE_BLOCKED)))
 	{
-		// Pop the first open node off the list for this iteration
-		Vector2i pos = open.back();
-		open.pop_back();
-
-		// Add accessible neighbouring tiles to the open list
-		for (int i = 0; i < NUM_DIR; ++i)
-		{
-			// rely on the fact that all border tiles are inaccessible to avoid checking explicitly
-			Vector2i npos = pos + aDirOffset[i];
-
-			if (npos.x < 1 || npos.y < 1 || npos.x > mapState.width - 2 || npos.y > mapState.height - 2)
-			{
-				continue;
-			}
-			MAPTILE *psTile = mapTile(mapState, npos);
-
-			if (!(blockTile(mapState, npos.x, npos.y, AUX_MAP) & blockedBits) && psTile->*varContinent == 0)
-			{
-				open.push_back(npos);               // add to open list
-				psTile->*varContinent = continent;  // Set continent value
-			}
-		}
+		return 1;
 	}
-}
-
-void mapFloodFillContinents(WorldMapState& mapState)
-{
-	int x, y, limitedContinents = 0, hoverContinents = 0;
-
-	/* Clear continents */
-	for (y = 0; y < mapState.height; y++)
+	if (!(bits & (LAND_BLOCKED | FEATURE_BLOCKED)))
 	{
-		for (x = 0; x < mapState.width; x++)
-		{
-			MAPTILE *psTile = mapTile(mapState, x, y);
-
-			psTile->limitedContinent = 0;
-			psTile->hoverContinent = 0;
-		}
+		return 2;
 	}
+	return 0;
+}
 
-	/* Iterate over the whole map, looking for unset continents */
-	for (y = 1; y < mapState.height - 2; y++)
-	{
-		for (x = 1; x < mapState.width - 2; x++)
-		{
-			MAPTILE *psTile = mapTile(mapState, x, y);
-
-			if (psTile->limitedContinent == 0 && !fpathBlockingTile(mapState, x, y, PROPULSION_TYPE_WHEELED))
-			{
-				mapFloodFill(mapState, x, y, 1 + limitedContinents++, WATER_BLOCKED | FEATURE_BLOCKED, &MAPTILE::limitedContinent);
-			}
-			else if (psTile->limitedContinent == 0 && !fpathBlockingTile(mapState, x, y, PROPULSION_TYPE_PROPELLOR))
-			{
-				mapFloodFill(mapState, x, y, 1 + limitedContinents++, LAND_BLOCKED | FEATURE_BLOCKED, &MAPTILE::limitedContinent);
-			}
+// Continent class of a tile for hover propulsion.
+static uint8_t hoverContinentClass(const WorldMapState& mapState, int x, int y)
+{
+	return !(blockTile(mapState, x, y, AUX_MAP) & FEATURE_BLOCKED) ? 1 : 0;
+}
 
-			if (psTile->hoverContinent == 0 && !fpathBlockingTile(mapState, x, y, PROPULSION_TYPE_HOVER))
-			{
-				mapFloodFill(mapState, x, y, 1 + hoverContinents++, FEATURE_BLOCKED, &MAPTILE::hoverContinent);
-			}
-		}
-	}
-	debug(LOG_MAP, "Found %d limited and %d hover continents", limitedContinents, hoverContinents);
+// Label the "continents" (8-connected areas a propulsion class can traverse) of the whole map.
+// TODO take into account scroll limits and update continents on scroll limit changes
+void mapFloodFillContinents(WorldMapState& mapState)
+{
+	const uint32_t limitedContinents = continentLabels::labelAll(mapState.width, mapState.height,
+		[&](int x, int y) { return limitedContinentClass(mapState, x, y); },
+		[&](int x, int y) {
+			return !fpathBlockingTile(mapState, x, y, limitedContinentClass(mapState, x, y) == 1 ? PROPULSION_TYPE_WHEELED : PROPULSION_TYPE_PROPELLOR);
+		},
+		[&](int x, int y, uint16_t continent) { mapTile(mapState, x, y)->limitedContinent = continent; });
+	const uint32_t hoverContinents = continentLabels::labelAll(mapState.width, mapState.height,
+		[&](int x, int y) { return hoverContinentClass(mapState, x, y); },
+		[&](int x, int y) { return !fpathBlockingTile(mapState, x, y, PROPULSION_TYPE_HOVER); },
+		[&](int x, int y, uint16_t continent) { mapTile(mapState, x, y)->hoverContinent = continent; });
+	debug(LOG_MAP, "Found %u limited and %u hover continents", limitedContinents, hoverContinents);
 }
 
 void tileSetFire(WorldMapState& mapState, int32_t x, int32_t y, uint32_t duration)
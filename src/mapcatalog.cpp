@@ -0,0 +1,194 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+	This file is part of Warzone 2100.
+	Copyright (C) 2026  Warzone 2100 Project (https://github.com/Warzone2100)
+
+	Warzone 2100 is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	Warzone 2100 is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Warzone 2100; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+/** @file mapcatalog.cpp
+ * Persistent map archive catalog (see mapcatalog.h).
+ */
+
+#include "mapcatalog.h"
+
+#include "lib/framework/frame.h"
+#include "lib/framework/file.h"
+#include "lib/framework/physfs_ext.h"
+
+#include <nlohmann/json.hpp>
+
+#define MAP_CATALOG_DIR "cache"
+#define MAP_CATALOG_FILE MAP_CATALOG_DIR "/mapcatalog.json"
+
+// Bump whenever what buildMapList() derives from an archive changes.
+static constexpr int MAP_CATALOG_VERSION = 1;
+
+static nlohmann::json entryToJson(const MapCatalogEntry &entry)
+{
+	const WzMap::LevelDetails &d = entry.details;
+	nlohmann::json obj = nlohmann::json::object();
+	obj["path"] = entry.path;
+	obj["realDir"] = entry.realDir;
+	obj["size"] = entry.fileSize;
+	obj["mtime"] = entry.modTime;
+	obj["mapMod"] = entry.isMapMod;
+	obj["random"] = entry.isRandom;
+	obj["name"] = d.name;
+	obj["type"] = static_cast<int>(d.type);
+	obj["players"] = d.players;
+	obj["tileset"] = static_cast<int>(d.tileset);
+	obj["folder"] = d.mapFolderPath;
+	obj["created"] = d.createdDate;
+	obj["uploaded"] = d.uploadedDate;
+	obj["author"] = d.author;
+	obj["additionalAuthors"] = d.additionalAuthors;
+	obj["license"] = d.license;
+	if (d.generator.has_value())
+	{
+		obj["generator"] = d.generator.value();
+	}
+	return obj;
+}
+
+// Throws (nlohmann::json exceptions) on missing or mistyped fields.
+static MapCatalogEntry entryFromJson(const nlohmann::json &obj)
+{
+	MapCatalogEntry entry;
+	WzMap::LevelDetails &d = entry.details;
+	entry.path = obj.at("path").get<std::string>();
+	entry.realDir = obj.at("realDir").get<std::string>();
+	entry.fileSize = obj.at("size").get<int64_t>();
+	entry.modTime = obj.at("mtime").get<int64_t>();
+	entry.isMapMod = obj.at("mapMod").get<bool>();
+	entry.isRandom = obj.at("random").get<bool>();
+	d.name = obj.at("name").get<std::string>();
+	d.type = static_cast<WzMap::MapType>(obj.at("type").get<int>());
+	d.players = obj.at("players").get<uint8_t>();
+	d.tileset = static_cast<MAP_TILESET>(obj.at("tileset").get<int>());
+	d.mapFolderPath = obj.at("folder").get<std::string>();
+	d.createdDate = obj.at("created").get<std::string>();
+	d.uploadedDate = obj.at("uploaded").get<std::string>();
+	d.author = obj.at("author").get<std::string>();
+	d.additionalAuthors = obj.at("additionalAuthors").get<std::vector<std::string>>();
+	d.license = obj.at("license").get<std::string>();
+	auto it = obj.find("generator");
+	if (it != obj.end())
+	{
+		d.generator = it->get<std::string>();
+	}
+	return entry;
+}
+
+bool MapCatalog::load()
+{
+	entries.clear();
+	if (!PHYSFS_exists(MAP_CATALOG_FILE))
+	{
+		return false;
+	}
+	std::vector<char> data;
+	if (!loadFileToBufferVector(MAP_CATALOG_FILE, data, false, false))
+	{
+		return false;
+	}
+	try
+	{
+		const nlohmann::json root = nlohmann::json::parse(data.begin(), data.end());
+		if (root.at("version").get<int>() != MAP_CATALOG_VERSION)
+		{
+			debug(LOG_WZ, "Ignoring map catalog from a different version");
+			return false;
+		}
+		for (const auto &obj : root.at("maps"))
+		{
+			MapCatalogEntry entry = entryFromJson(obj);
+			std::string key = entry.path;
+			entries.emplace(std::move(key), std::move(entry));
+		}
+	}
+	catch (const std::exception &e)
+	{
+		debug(LOG_WARNING, "Ignoring invalid map catalog %s: %s", MAP_CATALOG_FILE, e.what());
+		entries.clear();
+		return false;
+	}
+	debug(LOG_WZ, "Loaded map catalog with %zu maps", entries.size());
+	return true;
+}
+
+bool MapCatalog::save(const std::vector<MapCatalogEntry> &newEntries) const
+{
+	nlohmann::json maps = nlohmann::json::array();
+	size_t skipped = 0;
+	for (const auto &entry : newEntries)
+	{
+		nlohmann::json obj = entryToJson(entry);
+		try
+		{
+			// Map names are not guaranteed to be valid UTF-8, which dump() throws on
+			obj.dump();
+		}
+		catch (const std::exception &e)
+		{
+			// Left out, the map is just read from its archive again on the next start
+			debug(LOG_WZ, "Not adding %s to the map catalog: %s", entry.path.c_str(), e.what());
+			++skipped;
+			continue;
+		}
+		maps.push_back(std::move(obj));
+	}
+	if (skipped > 0)
+	{
+		debug(LOG_WARNING, "Left %zu maps out of the map catalog", skipped);
+	}
+	nlohmann::json root = nlohmann::json::object();
+	root["version"] = MAP_CATALOG_VERSION;
+	root["maps"] = std::move(maps);
+	const std::string jsonString = root.dump();
+
+	// The catalog is an optimisation only: failing to write it is not an error
+	PHYSFS_mkdir(MAP_CATALOG_DIR);
+	PHYSFS_file *fileHandle = PHYSFS_openWrite(MAP_CATALOG_FILE);
+	if (!fileHandle)
+	{
+		debug(LOG_WZ, "Unable to write map catalog: %s", WZ_PHYSFS_getLastError());
+		return false;
+	}
+	const bool written = WZ_PHYSFS_writeBytes(fileHandle, jsonString.data(), static_cast<PHYSFS_uint32>(jsonString.size())) == static_cast<PHYSFS_sint64>(jsonString.size());
+	PHYSFS_close(fileHandle);
+	if (!written)
+	{
+		debug(LOG_WARNING, "Failed to write map catalog: %s", WZ_PHYSFS_getLastError());
+		PHYSFS_delete(MAP_CATALOG_FILE);
+		return false;
+	}
+	return true;
+}
+
+const MapCatalogEntry *MapCatalog::find(const std::string &path, const std::string &realDir, int64_t fileSize, int64_t modTime) const
+{
+	auto it = entries.find(path);
+	if (it == entries.end())
+	{
+		return nullptr;
+	}
+	const MapCatalogEntry &entry = it->second;
+	if (entry.realDir != realDir || entry.fileSize != fileSize || entry.modTime != modTime)
+	{
+		return nullptr;
+	}
+	return &entry;
+}
@@ -0,0 +1,65 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+	This file is part of Warzone 2100.
+	Copyright (C) 2026  Warzone 2100 Project (https://github.com/Warzone2100)
+
+	Warzone 2100 is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	Warzone 2100 is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Warzone 2100; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+/** @file mapcatalog.h
+ * Persistent catalog of the map archives found by buildMapList().
+ *
+ * Opening every `maps/*.wz` archive on startup is slow once a user has collected a few hundred
+ * maps. The catalog remembers, per archive, the level details and map-mod / script-generated
+ * flags, keyed by the archive's real directory, size and modification time, so only new or
+ * changed archives have to be opened again. It is stored as `cache/mapcatalog.json` in the
+ * write directory; a missing or unreadable catalog just means every archive is scanned.
+ */
+
+#pragma once
+
+#include <wzmaplib/map_package.h>
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct MapCatalogEntry
+{
+	std::string path;       ///< platform-independent path, e.g. "maps/2c-Startup.wz"
+	std::string realDir;    ///< search path entry the archive was found in
+	int64_t fileSize = 0;
+	int64_t modTime = 0;
+	WzMap::LevelDetails details;
+	bool isMapMod = false;
+	bool isRandom = false;
+};
+
+class MapCatalog
+{
+public:
+	/// Read the catalog from the write directory. Returns false (and leaves the catalog empty) if there is none or it is stale / corrupt.
+	bool load();
+	/// Replace the catalog on disk with `entries`, which should be every map found by the current scan.
+	bool save(const std::vector<MapCatalogEntry> &entries) const;
+
+	/// The cached entry for `path`, if the archive has not changed since it was catalogued.
+	const MapCatalogEntry *find(const std::string &path, const std::string &realDir, int64_t fileSize, int64_t modTime) const;
+	size_t size() const { return entries.size(); }
+
+private:
+	std::unordered_map<std::string, MapCatalogEntry> entries;
+};
@@ -37,6 +37,7 @@ static PointTree *gridPointTree = nullptr;  // A quad-tree-like object.
 static PointTree::Filter *gridFiltersUnseen;
 static PointTree::Filter *gridFiltersDroidsByPlayer;
 static PointTree::Filter *gridFiltersDroidsRepairCandidates;
+static PointTree::Filter *gridFiltersFriendlyStructures;
 
 // initialise the grid system
 bool gridInitialise()
@@ -46,6 +47,7 @@ bool gridInitialise()
 	gridFiltersUnseen = new PointTree::Filter[MAX_PLAYERS];
 	gridFiltersDroidsByPlayer = new PointTree::Filter[MAX_PLAYERS];
 	gridFiltersDroidsRepairCandidates = new PointTree::Filter[MAX_PLAYERS];
+	gridFiltersFriendlyStructures = new PointTree::Filter[MAX_PLAYERS];
 
 	return true;  // Yay, nothing failed!
 }
@@ -100,6 +102,7 @@ void gridReset(GameWorld& world)
 		gridFiltersUnseen[player].reset(*gridPointTree);
 		gridFiltersDroidsByPlayer[player].reset(*gridPointTree);
 		gridFiltersDroidsRepairCandidates[player].reset(*gridPointTree);
+		gridFiltersFriendlyStructures[player].reset(*gridPointTree);
 	}
 }
 
@@ -112,6 +115,10 @@ void gridShutDown()
 	gridFiltersUnseen = nullptr;
 	delete[] gridFiltersDroidsByPlayer;
 	gridFiltersDroidsByPlayer = nullptr;
+	delete[] gridFiltersDroidsRepairCandidates;
+	gridFiltersDroidsRepairCandidates = nullptr;
+	delete[] gridFiltersFriendlyStructures;
+	gridFiltersFriendlyStructures = nullptr;
 }
 
 static bool isInRadius(int32_t x, int32_t y, uint32_t radius)
@@ -230,6 +237,22 @@ GridList const &gridStartIterateRepairCandidates(int32_t x, int32_t y, uint32_t
 	return gridStartIterateFiltered(x, y, radius, &gridFiltersDroidsRepairCandidates[player], ConditionDroidCandidateForRepair(player));
 }
 
+struct ConditionFriendlyStructures
+{
+	ConditionFriendlyStructures(int32_t player_) : player(player_) {}
+	bool test(BASE_OBJECT *obj) const
+	{
+		// Note: no check for damage or build status, those change during the tick
+		return obj->type == OBJ_STRUCTURE && aiCheckAlliances(player, obj->player);
+	}
+	int player;
+};
+
+GridList const &gridStartIterateFriendlyStructures(int32_t x, int32_t y, uint32_t radius, int player)
+{
+	return gridStartIterateFiltered(x, y, radius, &gridFiltersFriendlyStructures[player], ConditionFriendlyStructures(player));
+}
+
 struct ConditionUnseen
 {
 	ConditionUnseen(int32_t player_) : player(player_) {}
@@ -51,6 +51,9 @@ GridList const &gridStartIterateDroidsByPlayer(int32_t x, int32_t y, uint32_t ra
 /// Find all objects within radius where (object->type == OBJ_DROID && !object->died)
 GridList const &gridStartIterateRepairCandidates(int32_t x, int32_t y, uint32_t radius, int player);
 
+/// Find all objects within radius where object->type == OBJ_STRUCTURE && aiCheckAlliances(player, object->player)
+GridList const &gridStartIterateFriendlyStructures(int32_t x, int32_t y, uint32_t radius, int player);
+
 // Used for visibility.
 /// Find all objects within radius where object->seenThisTick[player] != 255.
 GridList const &gridStartIterateUnseen(int32_t x, int32_t y, uint32_t radius, int player);
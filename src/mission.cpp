@@ -91,6 +91,7 @@
 #include "keybind.h"
 #include "campaigninfo.h"
 #include "game_world.h"
+#include "staticcull.h"
 #include "wzapi.h"
 #include "screens/guidescreen.h"
 #include "lib/framework/loading_task.h"
@@ -290,6 +291,8 @@ void initMission()
 		mission.gameWorld.objects.droids[inc].clear();
 		mission.gameWorld.objects.flags[inc].clear();
 		mission.gameWorld.objects.extractors[inc].clear();
+		mission.gameWorld.objects.repairStructures[inc].clear();
+		mission.gameWorld.objects.repairDroids[inc].clear();
 		apsLimboDroids[inc].clear();
 	}
 	mission.gameWorld.objects.features[0].clear();
@@ -354,6 +357,7 @@ bool missionShutDown()
 		ASSERT(gameWorld.objects.pendingVisRemoval.empty(), "pending visibility removals lost on world swap");
 		gameWorld = std::move(mission.gameWorld);
 		mission.gameWorld = {};
+		staticCullInvalidate();
 	}
 	keybindShutdown();
 	// sorry if this breaks something - but it looks like it's what should happen - John
@@ -780,6 +784,7 @@ static void saveMissionData()
 	flushPendingVisRemoval(mission.gameWorld);
 	mission.gameWorld = std::move(gameWorld);
 	gameWorld = {};
+	staticCullInvalidate();
 
 	// save the selectedPlayer's LZ
 	mission.homeLZ_X = getLandingX(selectedPlayer);
@@ -833,6 +838,7 @@ void restoreMissionData()
 	ASSERT(gameWorld.objects.pendingVisRemoval.empty(), "pending visibility removals lost on world swap");
 	gameWorld = std::move(mission.gameWorld);
 	mission.gameWorld = {};
+	staticCullInvalidate();
 	for (inc = 0; inc < MAX_PLAYERS; inc++)
 	{
 		for (DROID* psObj : gameWorld.objects.droids[inc])
@@ -876,6 +882,7 @@ void saveMissionLimboData()
 		return IterationResult::CONTINUE_ITERATION;
 	});
 	gameWorld.objects.droids[selectedPlayer].clear();
+	gameWorld.objects.repairDroids[selectedPlayer].clear();
 
 	// any selectedPlayer's factories/research need to be put on holdProduction/holdresearch
 	for (STRUCTURE* psStruct : gameWorld.objects.structures[selectedPlayer])
@@ -1028,6 +1035,8 @@ void saveCampaignData()
 		// Reserve the droids for selected player for start of next campaign
 		mission.gameWorld.objects.droids[selectedPlayer] = std::move(gameWorld.objects.droids[selectedPlayer]);
 		gameWorld.objects.droids[selectedPlayer].clear();
+		mission.gameWorld.objects.repairDroids[selectedPlayer] = std::move(gameWorld.objects.repairDroids[selectedPlayer]);
+		gameWorld.objects.repairDroids[selectedPlayer].clear();
 		for (DROID* psDroid : mission.gameWorld.objects.droids[selectedPlayer])
 		{
 			//cam change add droid
@@ -1042,6 +1051,7 @@ void saveCampaignData()
 		/*now that every unit for the selected player has been moved into the
 		mission list - reverse it and fill the transporter with the first ten units*/
 		mission.gameWorld.objects.droids[selectedPlayer].reverse();
+		mission.gameWorld.objects.repairDroids[selectedPlayer].reverse();
 
 		//find the *first* transporter
 		mutating_list_iterate(mission.gameWorld.objects.droids[selectedPlayer], [](DROID* psDroid)
@@ -2986,6 +2996,7 @@ void missionDestroyObjects()
 
 			//clear out the mission lists as well to make sure no Transporters exist
 			gameWorld.objects.droids[Player] = std::move(mission.gameWorld.objects.droids[Player]);
+			gameWorld.objects.repairDroids[Player] = std::move(mission.gameWorld.objects.repairDroids[Player]);
 
 			mutating_list_iterate(gameWorld.objects.droids[Player], [](DROID* psDroid)
 			{
@@ -2995,6 +3006,7 @@ void missionDestroyObjects()
 				return IterationResult::CONTINUE_ITERATION;
 			});
 			mission.gameWorld.objects.droids[Player].clear();
+			mission.gameWorld.objects.repairDroids[Player].clear();
 
 			mutating_list_iterate(gameWorld.objects.structures[Player], [](STRUCTURE* s)
 			{
@@ -66,8 +66,8 @@ struct QueuedDroidInfo
 		}
 		return droidId < z.droidId;
 	}
-	/// Returns 0 if order is the same, non-zero otherwise.
-	int orderCompare(QueuedDroidInfo const &z) const
+	/// Returns 0 if order is the same, non-zero otherwise. With ignoreLocation, location orders to different positions compare equal.
+	int orderCompare(QueuedDroidInfo const &z, bool ignoreLocation = false) const
 	{
 		if (player != z.player)
 		{
@@ -96,7 +96,7 @@ struct QueuedDroidInfo
 					return destType < z.destType ? -1 : 1;
 				}
 			}
-			else
+			else if (!ignoreLocation)
 			{
 				if (pos.x != z.pos.x)
 				{
@@ -514,6 +514,34 @@ static void NETQueuedDroidInfo(SerdeContext& c, typename SerdeFnArgT<SerdeContex
 	}
 }
 
+// Worst-case encoded sizes, used to split order batches well before they get near MaxMsgSize.
+static constexpr size_t MaxOrderRunHeaderSize = 48;
+static constexpr size_t MaxOrderDroidSize = 15;
+static constexpr size_t OrderBatchBudget = MaxMsgSize / 2;
+
+/// Writes `num` orders which only differ by the droid ID and, for location orders, the position.
+static void NETQueuedDroidRun(MessageWriter &w, QueuedDroidInfo const *infos, uint32_t num)
+{
+	NETQueuedDroidInfo(w, infos[0]);  // Carries the position of the first droid.
+	NETuint32_t(w, num);
+
+	uint32_t prevDroidId = 0;
+	Vector2i prevPos = infos[0].pos;
+	for (unsigned n = 0; n < num; ++n)
+	{
+		// Encode signed deltas between droid IDs and positions. Droids ordered together (a selection, a formation)
+		// have close IDs and positions, in either direction, so the deltas encode to one or two bytes each.
+		NETint32_t(w, static_cast<int32_t>(infos[n].droidId - prevDroidId));
+		prevDroidId = infos[n].droidId;
+		if (infos[0].subType == LocOrder)
+		{
+			NETint32_t(w, infos[n].pos.x - prevPos.x);
+			NETint32_t(w, infos[n].pos.y - prevPos.y);
+			prevPos = infos[n].pos;
+		}
+	}
+}
+
 // Actually send the droid info.
 void sendQueuedDroidInfo()
 {
@@ -528,36 +556,57 @@ void sendQueuedDroidInfo()
 	{
 		orderedMap[info.order].push_back(info);
 	}
+
+	// All orders of this tick go out in as few GAME_DROIDINFO_BATCH messages as fit, as runs of orders
+	// which only differ by the droid ID and position, instead of one message per distinct order.
+	static std::vector<std::pair<QueuedDroidInfo const *, uint32_t>> batch; // static to avoid allocations
+	size_t batchSize = 0;
+	const auto flushBatch = [&batchSize]() {
+		if (batch.empty())
+		{
+			return;
+		}
+		auto w = NETbeginEncode(NETgameQueue(realSelectedPlayer), GAME_DROIDINFO_BATCH);
+		uint32_t numRuns = static_cast<uint32_t>(batch.size());
+		NETuint32_t(w, numRuns);
+		for (auto const &run : batch)
+		{
+			NETQueuedDroidRun(w, run.first, run.second);
+		}
+		NETend(w);
+		batch.clear();
+		batchSize = 0;
+	};
+
 	std::vector<QueuedDroidInfo>::const_iterator eqBegin, eqEnd;
 	for (auto &pair: orderedMap)
 	{
 		const auto& qOrders = pair.second;
 		for (eqBegin = qOrders.begin(); eqBegin != qOrders.end(); eqBegin = eqEnd)
 		{
-			// Find end of range of orders which differ only by the droid ID.
-			for (eqEnd = eqBegin + 1; eqEnd != qOrders.end() && eqEnd->orderCompare(*eqBegin) == 0; ++eqEnd)
+			// Find end of range of orders which differ only by the droid ID and position.
+			for (eqEnd = eqBegin + 1; eqEnd != qOrders.end() && eqEnd->orderCompare(*eqBegin, true) == 0; ++eqEnd)
 			{}
 
-			auto w = NETbeginEncode(NETgameQueue(realSelectedPlayer), GAME_DROIDINFO);
-			NETQueuedDroidInfo(w, *eqBegin);
-
-			uint32_t num = eqEnd - eqBegin;
-			NETuint32_t(w, num);
-
-			uint32_t prevDroidId = 0;
-			for (unsigned n = 0; n < num; ++n)
+			// Split the range if it does not fit in the current message.
+			QueuedDroidInfo const *first = &*eqBegin;
+			size_t remaining = eqEnd - eqBegin;
+			while (remaining > 0)
 			{
-				uint32_t droidId = (eqBegin + n)->droidId;
-
-				// Encode deltas between droid IDs, since the deltas are smaller than the actual droid IDs, and will encode to less bytes on average.
-				uint32_t deltaDroidId = droidId - prevDroidId;
-				NETuint32_t(w, deltaDroidId);
-
-				prevDroidId = droidId;
+				if (batchSize + MaxOrderRunHeaderSize + MaxOrderDroidSize > OrderBatchBudget)
+				{
+					flushBatch();
+				}
+				size_t num = std::min(remaining, (OrderBatchBudget - batchSize - MaxOrderRunHeaderSize) / MaxOrderDroidSize);
+				batch.emplace_back(first, static_cast<uint32_t>(num));
+				batchSize += MaxOrderRunHeaderSize + num * MaxOrderDroidSize;
+				first += num;
+				remaining -= num;
 			}
-			NETend(w);
 		}
 	}
+	flushBatch();
+
 	// Sent the orders. Don't send them again.
 	queuedOrders.clear();
 }
@@ -638,105 +687,159 @@ void sendDroidInfo(DROID *psDroid, DroidOrder const &order, bool add)
 
 // ////////////////////////////////////////////////////////////////////////////
 // receive droid information form other players.
-bool recvDroidInfo(NETQUEUE queue)
+
+/// Reads one order and the droids given it, and gives it to them. In a batch, droid IDs and positions are signed
+/// deltas (see NETQueuedDroidRun), in a GAME_DROIDINFO message all droids share the position and IDs only grow.
+static void recvDroidInfoRun(NETQUEUE queue, MessageReader &r, bool batch)
 {
-	auto r = NETbeginDecode(queue, GAME_DROIDINFO);
+	QueuedDroidInfo info;
+	NETQueuedDroidInfo(r, info);
+
+	STRUCTURE_STATS *psStats = nullptr;
+	if (info.subType == LocOrder && (info.order == DORDER_BUILD || info.order == DORDER_LINEBUILD))
+	{
+		// Find structure target
+		for (unsigned typeIndex = 0; typeIndex < numStructureStats; typeIndex++)
+		{
+			if (asStructureStats[typeIndex].ref == info.structRef)
+			{
+				psStats = asStructureStats + typeIndex;
+				break;
+			}
+		}
+	}
+
+	switch (info.subType)
 	{
-		QueuedDroidInfo info;
-		NETQueuedDroidInfo(r, info);
+	case ObjOrder:       syncDebug("Order=%s,%d(%d)", getDroidOrderName(info.order), info.destId, info.destType); break;
+	case LocOrder:       syncDebug("Order=%s,(%d,%d)", getDroidOrderName(info.order), info.pos.x, info.pos.y); break;
+	case SecondaryOrder: syncDebug("SecondaryOrder=%d,%08X", (int)info.secOrder, (int)info.secState); break;
+	}
+
+	DROID_ORDER_DATA sOrder = infoToOrderData(info, psStats);
 
-		STRUCTURE_STATS *psStats = nullptr;
-		if (info.subType == LocOrder && (info.order == DORDER_BUILD || info.order == DORDER_LINEBUILD))
+	uint32_t num = 0;
+	NETuint32_t(r, num);
+
+	// The positions of a run are summed up from peer-supplied deltas, so they are summed up in 64 bits and the
+	// rest of the run is dropped once one no longer fits in the 32 bits a single order carries
+	int64_t runPosX = info.pos.x;
+	int64_t runPosY = info.pos.y;
+	bool runPosValid = true;
+	for (unsigned n = 0; n < num && r.valid(); ++n)
+	{
+		// Get the next droid ID which is being given this order.
+		if (batch)
 		{
-			// Find structure target
-			for (unsigned typeIndex = 0; typeIndex < numStructureStats; typeIndex++)
+			int32_t deltaDroidId = 0;
+			NETint32_t(r, deltaDroidId);
+			info.droidId += static_cast<uint32_t>(deltaDroidId);
+			if (info.subType == LocOrder)
 			{
-				if (asStructureStats[typeIndex].ref == info.structRef)
+				Vector2i deltaPos(0, 0);
+				NETint32_t(r, deltaPos.x);
+				NETint32_t(r, deltaPos.y);
+				runPosX += deltaPos.x;
+				runPosY += deltaPos.y;
+				if (runPosX < INT32_MIN || runPosX > INT32_MAX || runPosY < INT32_MIN || runPosY > INT32_MAX)
 				{
-					psStats = asStructureStats + typeIndex;
-					break;
+					runPosValid = false;
 				}
+				if (!runPosValid)
+				{
+					debug(LOG_WARNING, "Droid order run (by %d) has a position out of range, dropping droid %u", queue.index, info.droidId);
+					syncDebug("Position out of range.");
+					continue;
+				}
+				info.pos = Vector2i(static_cast<int32_t>(runPosX), static_cast<int32_t>(runPosY));
+				sOrder.pos = info.pos;
 			}
 		}
+		else
+		{
+			uint32_t deltaDroidId = 0;
+			NETuint32_t(r, deltaDroidId);
+			info.droidId += deltaDroidId;
+		}
 
-		switch (info.subType)
+		DROID *psDroid = IdToDroid(gameWorld.objects, info.droidId, info.player);
+		if (!psDroid)
+		{
+			debug(LOG_NEVER, "Packet from %d refers to non-existent droid %u, [%s : p%d]",
+			      queue.index, info.droidId, isHumanPlayer(info.player) ? "Human" : "AI", info.player);
+			syncDebug("Droid %d missing", info.droidId);
+			continue;  // Can't find the droid, so skip this droid.
+		}
+		if (!canGiveOrdersFor(queue.index, psDroid->player))
 		{
-		case ObjOrder:       syncDebug("Order=%s,%d(%d)", getDroidOrderName(info.order), info.destId, info.destType); break;
-		case LocOrder:       syncDebug("Order=%s,(%d,%d)", getDroidOrderName(info.order), info.pos.x, info.pos.y); break;
-		case SecondaryOrder: syncDebug("SecondaryOrder=%d,%08X", (int)info.secOrder, (int)info.secState); break;
+			debug(LOG_WARNING, "Droid order (by %d) for wrong player (%d).", queue.index, psDroid->player);
+			syncDebug("Wrong player.");
+			continue;
 		}
 
-		DROID_ORDER_DATA sOrder = infoToOrderData(info, psStats);
+		CHECK_DROID(psDroid);
 
-		uint32_t num = 0;
-		NETuint32_t(r, num);
+		syncDebugDroid(psDroid, '<');
 
-		for (unsigned n = 0; n < num; ++n)
+		switch (info.subType)
 		{
-			// Get the next droid ID which is being given this order.
-			uint32_t deltaDroidId = 0;
-			NETuint32_t(r, deltaDroidId);
-			info.droidId += deltaDroidId;
-
-			DROID *psDroid = IdToDroid(gameWorld.objects, info.droidId, info.player);
-			if (!psDroid)
-			{
-				debug(LOG_NEVER, "Packet from %d refers to non-existent droid %u, [%s : p%d]",
-				      queue.index, info.droidId, isHumanPlayer(info.player) ? "Human" : "AI", info.player);
-				syncDebug("Droid %d missing", info.droidId);
-				continue;  // Can't find the droid, so skip this droid.
-			}
-			if (!canGiveOrdersFor(queue.index, psDroid->player))
+		case ObjOrder:
+		case LocOrder:
+			/*
+			* If the current order not is a command order and we are not a
+			* commander yet are in the commander group remove us from it.
+			*/
+			if (hasCommander(psDroid)
+				&& info.order != DORDER_RTR
+				&& info.order != DORDER_RTR_SPECIFIED)
 			{
-				debug(LOG_WARNING, "Droid order (by %d) for wrong player (%d).", queue.index, psDroid->player);
-				syncDebug("Wrong player.");
-				continue;
+				psDroid->psGroup->remove(psDroid);
 			}
 
-			CHECK_DROID(psDroid);
-
-			syncDebugDroid(psDroid, '<');
-
-			switch (info.subType)
+			if (sOrder.psObj != TargetMissing)  // Only do order if the target didn't die.
 			{
-			case ObjOrder:
-			case LocOrder:
-				/*
-				* If the current order not is a command order and we are not a
-				* commander yet are in the commander group remove us from it.
-				*/
-				if (hasCommander(psDroid)
-					&& info.order != DORDER_RTR
-					&& info.order != DORDER_RTR_SPECIFIED)
+				if (!info.add)
 				{
-					psDroid->psGroup->remove(psDroid);
+					orderDroidListEraseRange(psDroid, 0, psDroid->listSize + 1);  // Clear all non-pending orders, plus the first pending order (which is probably the order we just received).
+					orderDroidBase(psDroid, &sOrder);  // Execute the order immediately (even if in the middle of another order.
 				}
-
-				if (sOrder.psObj != TargetMissing)  // Only do order if the target didn't die.
+				else
 				{
-					if (!info.add)
-					{
-						orderDroidListEraseRange(psDroid, 0, psDroid->listSize + 1);  // Clear all non-pending orders, plus the first pending order (which is probably the order we just received).
-						orderDroidBase(psDroid, &sOrder);  // Execute the order immediately (even if in the middle of another order.
-					}
-					else
-					{
-						orderDroidAdd(psDroid, &sOrder);   // Add the order to the (non-pending) list. Will probably overwrite the corresponding pending order, assuming all pending orders were written to the list.
-					}
+					orderDroidAdd(psDroid, &sOrder);   // Add the order to the (non-pending) list. Will probably overwrite the corresponding pending order, assuming all pending orders were written to the list.
 				}
-				break;
-			case SecondaryOrder:
-				// Set the droids secondary order
-				turnOffMultiMsg(true);
-				secondarySetState(psDroid, gameWorld.objects, info.secOrder, info.secState);
-				turnOffMultiMsg(false);
-				break;
 			}
+			break;
+		case SecondaryOrder:
+			// Set the droids secondary order
+			turnOffMultiMsg(true);
+			secondarySetState(psDroid, gameWorld.objects, info.secOrder, info.secState);
+			turnOffMultiMsg(false);
+			break;
+		}
 
-			syncDebugDroid(psDroid, '>');
+		syncDebugDroid(psDroid, '>');
 
-			CHECK_DROID(psDroid);
-		}
+		CHECK_DROID(psDroid);
+	}
+}
+
+bool recvDroidInfo(NETQUEUE queue)
+{
+	auto r = NETbeginDecode(queue, GAME_DROIDINFO);
+	recvDroidInfoRun(queue, r, false);
+	NETend(r);
+
+	return true;
+}
+
+bool recvDroidInfoBatch(NETQUEUE queue)
+{
+	auto r = NETbeginDecode(queue, GAME_DROIDINFO_BATCH);
+	uint32_t numRuns = 0;
+	NETuint32_t(r, numRuns);
+	for (uint32_t run = 0; run < numRuns && r.valid(); ++run)
+	{
+		recvDroidInfoRun(queue, r, true);
 	}
 	NETend(r);
 
@@ -828,6 +828,7 @@ bool pickupArtefact(int toPlayer, int fromPlayer)
 				if (asResearch[topic].researchPower && asResearch[topic].researchPoints)
 				{
 					MakeResearchPossible(&asPlayerResList[toPlayer][topic]);
+					researchAvailabilityChanged(toPlayer, topic);
 					if (toPlayer == selectedPlayer)
 					{
 						CONPRINTF(_("You Discover Blueprints For %s"), getLocalizedStatsName(&asResearch[topic]));
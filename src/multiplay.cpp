@@ -1463,6 +1463,9 @@ bool recvMessage()
 			case GAME_DROIDINFO:					//droid update info
 				recvDroidInfo(queue);
 				break;
+			case GAME_DROIDINFO_BATCH:				//droid update info, all orders of a tick
+				recvDroidInfoBatch(queue);
+				break;
 			case NET_TEXTMSG:					// simple text message
 				receiveInGameTextMessage(queue);
 				break;
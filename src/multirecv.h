@@ -29,6 +29,7 @@
 
 bool recvDroid(NETQUEUE queue);
 bool recvDroidInfo(NETQUEUE queue);
+bool recvDroidInfoBatch(NETQUEUE queue);
 bool recvDestroyDroid(NETQUEUE queue);
 bool recvDestroyStructure(NETQUEUE queue);
 bool recvBuildFinished(NETQUEUE queue);
@@ -46,6 +46,7 @@
 #include "wzcrashhandlingproviders.h"
 #include "world_object_state.h"
 #include "game_world.h"
+#include "staticcull.h"
 
 #include <algorithm>
 
@@ -501,6 +502,12 @@ static inline void releaseAllObjectsInList(PerPlayerObjectLists<OBJECT, MAX_PLAY
 /***************************  DROID  *********************************/
 
 /* add the droid to the Droid Lists */
+/* Whether the droid belongs in WorldObjectState::repairDroids */
+static bool isRepairDroid(const DROID *psDroid)
+{
+	return psDroid->droidType == DROID_REPAIR || psDroid->droidType == DROID_CYBORG_REPAIR;
+}
+
 void addDroid(DROID *psDroidToAdd, PerPlayerDroidLists& pList)
 {
 	DROID_GROUP	*psGroup;
@@ -517,6 +524,10 @@ void addDroid(DROID *psDroidToAdd, PerPlayerDroidLists& pList)
 		{
 			addObjectToFuncList(gameWorld.objects.sensors, (BASE_OBJECT *)psDroidToAdd, 0);
 		}
+		if (isRepairDroid(psDroidToAdd))
+		{
+			addObjectToList(gameWorld.objects.repairDroids, psDroidToAdd, psDroidToAdd->player);
+		}
 
 		// commanders have to get their group back if not already loaded
 		if (psDroidToAdd->droidType == DROID_COMMAND && !psDroidToAdd->psGroup)
@@ -531,6 +542,10 @@ void addDroid(DROID *psDroidToAdd, PerPlayerDroidLists& pList)
 		{
 			addObjectToFuncList(mission.gameWorld.objects.sensors, (BASE_OBJECT *)psDroidToAdd, 0);
 		}
+		if (isRepairDroid(psDroidToAdd))
+		{
+			addObjectToList(mission.gameWorld.objects.repairDroids, psDroidToAdd, psDroidToAdd->player);
+		}
 	}
 }
 
@@ -554,6 +569,10 @@ void killDroid(DROID *psDel, WorldObjectState& objState)
 	{
 		removeObjectFromFuncList(objState.sensors, (BASE_OBJECT *)psDel, 0);
 	}
+	if (isRepairDroid(psDel))
+	{
+		removeObjectFromList(objState.repairDroids, psDel, psDel->player);
+	}
 
 	destroyObject(objState, objState.droids, psDel);
 }
@@ -654,6 +673,10 @@ void freeAllDroids(GameWorld& world)
 	// objects killed but not yet vis-removed would be stranded by the world teardown - flush first
 	flushPendingVisRemoval(world);
 	freeAllEntitiesImpl<DROID, MAX_PLAYERS>(world.objects.droids, &world.map);
+	for (auto &list : world.objects.repairDroids)
+	{
+		list.clear();
+	}
 }
 
 /*Remove a single Droid from a list*/
@@ -672,6 +695,10 @@ void removeDroid(DROID* psDroidToRemove, PerPlayerDroidLists& pList)
 		{
 			removeObjectFromFuncList(gameWorld.objects.sensors, (BASE_OBJECT*)psDroidToRemove, 0);
 		}
+		if (isRepairDroid(psDroidToRemove))
+		{
+			removeObjectFromList(gameWorld.objects.repairDroids, psDroidToRemove, psDroidToRemove->player);
+		}
 		psDroidToRemove->died = NOT_CURRENT_LIST;
 	}
 	else if (&pList[psDroidToRemove->player] == &mission.gameWorld.objects.droids[psDroidToRemove->player])
@@ -680,6 +707,10 @@ void removeDroid(DROID* psDroidToRemove, PerPlayerDroidLists& pList)
 		{
 			removeObjectFromFuncList(mission.gameWorld.objects.sensors, (BASE_OBJECT*)psDroidToRemove, 0);
 		}
+		if (isRepairDroid(psDroidToRemove))
+		{
+			removeObjectFromList(mission.gameWorld.objects.repairDroids, psDroidToRemove, psDroidToRemove->player);
+		}
 	}
 }
 
@@ -692,10 +723,22 @@ void freeAllLimboDroids()
 
 /**************************  STRUCTURE  *******************************/
 
+/* Whether the structure belongs in WorldObjectState::repairStructures */
+static bool isRepairStructure(const STRUCTURE *psStruct)
+{
+	return psStruct->pStructureType->type == REF_REPAIR_FACILITY || psStruct->pStructureType->type == REF_HQ;
+}
+
 /* add the structure to the Structure Lists */
 void addStructure(STRUCTURE *psStructToAdd, WorldObjectState& objState)
 {
 	addObjectToList(objState.structures, psStructToAdd, psStructToAdd->player);
+	staticCullAdd(psStructToAdd, objState);
+	if (isRepairStructure(psStructToAdd))
+	{
+		// Not a function list: HQs may also be in the sensor list
+		addObjectToList(objState.repairStructures, psStructToAdd, psStructToAdd->player);
+	}
 	if (psStructToAdd->pStructureType->pSensor
 	    && psStructToAdd->pStructureType->pSensor->location == LOC_TURRET)
 	{
@@ -726,6 +769,10 @@ void killStruct(STRUCTURE *psBuilding, WorldObjectState& objState)
 	{
 		removeObjectFromFuncList(objState.extractors, psBuilding, psBuilding->player);
 	}
+	if (isRepairStructure(psBuilding))
+	{
+		removeObjectFromList(objState.repairStructures, psBuilding, psBuilding->player);
+	}
 
 	for (i = 0; i < MAX_WEAPONS; i++)
 	{
@@ -764,6 +811,7 @@ void killStruct(STRUCTURE *psBuilding, WorldObjectState& objState)
 		}
 	}
 
+	staticCullRemove(psBuilding);
 	destroyObject(objState, objState.structures, psBuilding);
 }
 
@@ -773,6 +821,14 @@ void freeAllStructs(GameWorld& world)
 	// objects killed but not yet vis-removed would be stranded by the world teardown - flush first
 	flushPendingVisRemoval(world);
 	freeAllEntitiesImpl<STRUCTURE, MAX_PLAYERS>(world.objects.structures, &world.map);
+	for (auto &list : world.objects.repairStructures)
+	{
+		list.clear();
+	}
+	if (&world == &gameWorld)
+	{
+		staticCullInvalidate();
+	}
 }
 
 /*Remove a single Structure from a list*/
@@ -783,6 +839,7 @@ void removeStructureFromList(STRUCTURE *psStructToRemove, WorldObjectState& objS
 	ASSERT(psStructToRemove->player < MAX_PLAYERS,
 	       "removeStructureFromList: invalid player for structure");
 	removeObjectFromList(objState.structures, psStructToRemove, psStructToRemove->player);
+	staticCullRemove(psStructToRemove);
 	if (psStructToRemove->pStructureType->pSensor
 	    && psStructToRemove->pStructureType->pSensor->location == LOC_TURRET)
 	{
@@ -792,6 +849,10 @@ void removeStructureFromList(STRUCTURE *psStructToRemove, WorldObjectState& objS
 	{
 		removeObjectFromFuncList(objState.extractors, psStructToRemove, psStructToRemove->player);
 	}
+	if (isRepairStructure(psStructToRemove))
+	{
+		removeObjectFromList(objState.repairStructures, psStructToRemove, psStructToRemove->player);
+	}
 }
 
 /**************************  FEATURE  *********************************/
@@ -814,6 +875,7 @@ void killFeature(FEATURE *psDel, WorldObjectState& objState)
 	ASSERT(psDel->type == OBJ_FEATURE,
 	       "killFeature: pointer is not a feature");
 	psDel->player = 0;
+	staticCullRemove(psDel);
 	destroyObject(objState, objState.features, psDel);
 
 	if (psDel->psStats->subType == FEAT_OIL_RESOURCE)
@@ -828,6 +890,10 @@ void freeAllFeatures(GameWorld& world)
 	// objects killed but not yet vis-removed would be stranded by the world teardown - flush first
 	flushPendingVisRemoval(world);
 	freeAllEntitiesImpl<FEATURE, 1>(world.objects.features, &world.map);
+	if (&world == &gameWorld)
+	{
+		staticCullInvalidate();
+	}
 }
 
 /**************************  FLAG_POSITION ********************************/
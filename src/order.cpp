@@ -307,7 +307,8 @@ static std::pair<STRUCTURE *, DROID_ACTION> checkForDamagedStruct(DROID *psDroid
 	unsigned bestDistanceSq = radius * radius;
 	std::pair<STRUCTURE *, DROID_ACTION> best = {nullptr, DACTION_NONE};
 
-	for (BASE_OBJECT *object : gridStartIterate(psDroid->pos.x, psDroid->pos.y, radius))
+	// Only friendly structures, so the droids, features and enemy bases around are skipped once per tick, not once per constructor
+	for (BASE_OBJECT *object : gridStartIterateFriendlyStructures(psDroid->pos.x, psDroid->pos.y, radius, psDroid->player))
 	{
 		unsigned distanceSq = droidSqDist(psDroid, object);  // droidSqDist returns -1 if unreachable, (unsigned)-1 is a big number.
 
@@ -3369,6 +3370,7 @@ void secondaryCheckDamageLevel(DROID *psDroid)
 		}
 	}
 }
+
 // balance the load at random
 // always prefer faster repairs
 static inline RtrBestResult decideWhereToRepairAndBalance(DROID *psDroid)
@@ -3392,7 +3394,7 @@ static inline RtrBestResult decideWhereToRepairAndBalance(DROID *psDroid)
 	vDroidPos.clear();
 	vDroid.clear();
 
-	for (STRUCTURE *psStruct : gameWorld.objects.structures[psDroid->player])
+	for (STRUCTURE *psStruct : gameWorld.objects.repairStructures[psDroid->player])
 	{
 		if (psStruct->pStructureType->type == REF_HQ)
 		{
@@ -3431,14 +3433,14 @@ static inline RtrBestResult decideWhereToRepairAndBalance(DROID *psDroid)
 		&& secondaryGetState(psDroid, DSO_ACCEPT_RETREP)))
 	{
 		// one of these lists is empty when on mission
-		DroidList* psdroidList = !gameWorld.objects.droids[psDroid->player].empty() ? &gameWorld.objects.droids[psDroid->player] : &mission.gameWorld.objects.droids[psDroid->player];
-		if (!psdroidList->empty())
+		const WorldObjectState &objects = !gameWorld.objects.droids[psDroid->player].empty() ? gameWorld.objects : mission.gameWorld.objects;
+		const DroidList &repairDroids = objects.repairDroids[psDroid->player];
+		if (!repairDroids.empty())
 		{
-			for (DROID* psCurr : *psdroidList)
+			for (DROID* psCurr : repairDroids)
 			{
 				// Accept any repair droids that accept retreating units
-				if ((psCurr->droidType == DROID_REPAIR || psCurr->droidType == DROID_CYBORG_REPAIR)
-					&& secondaryGetState(psCurr, DSO_ACCEPT_RETREP))
+				if (secondaryGetState(psCurr, DSO_ACCEPT_RETREP))
 				{
 					if (!CheckInScrollLimits(gameWorld.map, psCurr->pos.x, psCurr->pos.y))
 					{
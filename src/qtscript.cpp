@@ -42,6 +42,7 @@
 #include "lib/framework/wzapp.h"
 #include "lib/framework/wzconfig.h"
 #include "lib/framework/wzpaths.h"
+#include "lib/framework/wzparallel.h"
 
 #include "qtscript.h"
 
@@ -77,6 +78,7 @@
 
 #include "wzscriptdebug.h"
 #include "quickjs_backend.h"
+#include "quickjs_bytecode_cache.h"
 
 #define ATTACK_THROTTLE 1000
 
@@ -397,6 +399,10 @@ void scriptRemoveObject(const BASE_OBJECT *psObj)
 		return (node.baseobj == psObj->id);
 	});
 	scripting_engine::instance().groupRemoveObject(psObj);
+	for (auto *instance : scripts)
+	{
+		instance->objectRemoved(psObj);
+	}
 }
 
 // do not want to call this 'init', since scripts are often loaded before we get here
@@ -466,6 +472,7 @@ bool scripting_engine::shutdownScripts()
 		delete script;
 	}
 	scripts.clear();
+	scriptBytecodeCacheClear();
 	return true;
 }
 
@@ -513,6 +520,11 @@ bool scripting_engine::updateScripts()
 		}
 	}
 
+	if (war_getConcurrentAIScripts())
+	{
+		runConcurrentTimers(runlist);
+	}
+
 	for (auto &node : runlist)
 	{
 		// IMPORTANT: A queued function can delete a timer that is in the runlist!
@@ -527,18 +539,126 @@ bool scripting_engine::updateScripts()
 	return true;
 }
 
+// MARK: Concurrent AI timers
+//
+// With concurrent AI scripts on, the due timers of every skirmish AI instance run on the parallel workers,
+// one instance per worker, while the game stands still. Each instance has its own JS runtime, so the
+// scripts themselves never share anything; the API functions they call are sorted by what they do to
+// the game (see `js_concurrentApiCall`): reads run at once under `batchWorldMutex`, calls whose outcome
+// depends on their order (game random numbers, timers) wait for the instance's turn, and calls that change
+// the game are recorded in the instance's command buffer and replayed here afterwards. Nothing changes the
+// game during the batch, so reads see the same game however the workers were scheduled, and no event is
+// raised off the main thread. Turns and replays go in instance order.
+
+static thread_local int concurrentBatchSlotOfThread = -1;
+
+int scripting_engine::concurrentBatchSlot()
+{
+	return concurrentBatchSlotOfThread;
+}
+
+void scripting_engine::waitForConcurrentBatchTurn()
+{
+	const int slot = concurrentBatchSlotOfThread;
+	ASSERT_OR_RETURN(, slot >= 0, "Not running concurrent AI timers");
+	std::unique_lock<std::mutex> lock(batchTurnMutex);
+	batchTurnCondition.wait(lock, [this, slot] {
+		return std::all_of(batchSlotDone.begin(), batchSlotDone.begin() + slot, [](bool done) { return done; });
+	});
+}
+
+void scripting_engine::runConcurrentTimers(std::vector<std::shared_ptr<timerNode>> &runlist)
+{
+	std::vector<wzapi::scripting_instance *> batchInstances; // in load order, which is player order
+	for (auto *instance : scripts)
+	{
+		if (instance->runsConcurrently())
+		{
+			batchInstances.push_back(instance);
+		}
+	}
+	if (batchInstances.empty())
+	{
+		return;
+	}
+
+	struct BatchTimer
+	{
+		std::shared_ptr<timerNode> node;
+		BASE_OBJECT *psObj;
+	};
+	std::vector<std::vector<BatchTimer>> batchTimers(batchInstances.size());
+	std::vector<std::shared_ptr<timerNode>> serialTimers;
+	bool anyDue = false;
+	for (auto &node : runlist)
+	{
+		auto it = std::find(batchInstances.begin(), batchInstances.end(), node->instance);
+		if (it == batchInstances.end())
+		{
+			serialTimers.push_back(node);
+			continue;
+		}
+		// Look the object up now, while nothing else can change the game. It stays allocated for the batch
+		// even if an instance's call destroys it, and is converted under batchWorldMutex when the timer runs
+		BASE_OBJECT *psObj = IdToObject(node->baseobjtype, node->baseobj, node->player);
+		batchTimers[it - batchInstances.begin()].push_back(BatchTimer{node, psObj});
+		anyDue = true;
+	}
+	runlist = std::move(serialTimers);
+	if (!anyDue)
+	{
+		return;
+	}
+
+	// wzParallelFor hands out slots in increasing order, so the lowest unfinished slot is always being
+	// run and never waits: waitForConcurrentBatchTurn() cannot deadlock
+	batchSlotDone.assign(batchInstances.size(), false);
+	wzParallelFor(batchInstances.size(), 1, [&](size_t begin, size_t end) {
+		for (size_t slot = begin; slot < end; ++slot)
+		{
+			concurrentBatchSlotOfThread = static_cast<int>(slot);
+			batchInstances[slot]->enterThread();
+			for (const auto &timer : batchTimers[slot])
+			{
+				// A timer can remove one of its instance's timers that is further down the list
+				if (timer.node->type == TIMER_REMOVED)
+				{
+					continue;
+				}
+				timer.node->function(timer.node->timerID, timer.psObj, timer.node->additionalTimerFuncParam.get());
+			}
+			concurrentBatchSlotOfThread = -1;
+			{
+				std::lock_guard<std::mutex> guard(batchTurnMutex);
+				batchSlotDone[slot] = true;
+			}
+			batchTurnCondition.notify_all();
+		}
+	});
+
+	// Back on the main thread; replaying can fire events into any of the instances
+	for (auto *instance : batchInstances)
+	{
+		instance->enterThread();
+	}
+	for (auto *instance : batchInstances)
+	{
+		instance->applyDeferredCalls();
+	}
+}
+
 wzapi::scripting_instance* loadPlayerScript(const WzString& path, int player, AIDifficulty difficulty)
 {
 	return scripting_engine::instance().loadPlayerScript(path, player, difficulty);
 }
 
-static wzapi::scripting_instance* loadPlayerScriptByBackend(const WzString& path, int player, int realDifficulty)
+static wzapi::scripting_instance* loadPlayerScriptByBackend(const WzString& path, int player, int realDifficulty, bool concurrent)
 {
 	// JS scripts:
 	switch (war_getJSBackend())
 	{
 		case JS_BACKEND::quickjs:
-			return createQuickJSScriptInstance(path, player, realDifficulty);
+			return createQuickJSScriptInstance(path, player, realDifficulty, concurrent);
 		case JS_BACKEND::num_backends:
 			debug(LOG_ERROR, "Invalid js backend value"); // should not happen
 	}
@@ -561,7 +681,9 @@ wzapi::scripting_instance* scripting_engine::loadPlayerScript(const WzString& pa
 		realDifficulty = (int)getDifficultyLevel();
 	}
 
-	wzapi::scripting_instance* pNewInstance = loadPlayerScriptByBackend(path, player, realDifficulty);
+	// Only skirmish AIs (the global rules scripts load with DISABLED) keep to the concurrent API
+	const bool concurrent = war_getConcurrentAIScripts() && game.type == LEVEL_TYPE::SKIRMISH && difficulty != AIDifficulty::DISABLED;
+	wzapi::scripting_instance* pNewInstance = loadPlayerScriptByBackend(path, player, realDifficulty, concurrent);
 	if (!pNewInstance)
 	{
 		// failed to create new scripting instance
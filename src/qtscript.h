@@ -25,8 +25,10 @@
 #include "random.h"
 #include "wzapi.h"
 #include <chrono>
+#include <condition_variable>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <unordered_set>
 #include <unordered_map>
 #include <array>
@@ -398,6 +400,26 @@ public:
 	}
 
 	bool removeTimer(uniqueTimerID timerID);
+
+// MARK: Concurrent AI timers
+public:
+	/// Place of the calling thread's instance in the batch of concurrently running AI timers, or -1 when
+	/// the thread is not running one (the main thread, or concurrent AI scripts are off)
+	static int concurrentBatchSlot();
+	/// Blocks until every instance before the caller's in the batch has finished its timers, for API calls
+	/// whose outcome depends on the order they are made in (game random numbers, new timers)
+	void waitForConcurrentBatchTurn();
+	/// Held by every API call that touches the game while a batch runs
+	std::mutex& concurrentBatchMutex() { return batchWorldMutex; }
+private:
+	/// Runs the due timers of the concurrently running instances, one instance per worker, then applies
+	/// the calls they deferred in instance order. Removes those timers from `runlist`.
+	void runConcurrentTimers(std::vector<std::shared_ptr<timerNode>> &runlist);
+
+	std::mutex batchWorldMutex;
+	std::mutex batchTurnMutex;
+	std::condition_variable batchTurnCondition;
+	std::vector<bool> batchSlotDone; ///< guarded by batchTurnMutex
 public:
 	// Monitoring performance of function calls
 	template<typename Func>
@@ -74,6 +74,8 @@
 #include "qtscript.h"
 #include "featuredef.h"
 #include "data.h"
+#include "baseobject.h"
+#include "quickjs_bytecode_cache.h"
 
 
 #include <unordered_set>
@@ -111,6 +113,16 @@ MSVC_PRAGMA(warning( pop ))
 #else
 # define WZ_QJS_IsArray(ctx, arr) JS_IsArray(ctx, arr)
 #endif
+#if defined(QUICKJS_NG)
+# define WZ_QJS_NewClassID(rt, pclass_id) JS_NewClassID(rt, pclass_id)
+#else
+# define WZ_QJS_NewClassID(rt, pclass_id) JS_NewClassID(pclass_id)
+#endif
+#if defined(QUICKJS_NG)
+# define WZ_QJS_ENGINE_NAME "quickjs-ng"
+#else
+# define WZ_QJS_ENGINE_NAME "quickjs-wz"
+#endif
 
 // Alternatives for C++ - can't use the JS_CFUNC_DEF / JS_CGETSET_DEF / etc defines
 // #define JS_CFUNC_DEF(name, length, func1) { name, JS_PROP_WRITABLE | JS_PROP_CONFIGURABLE, JS_DEF_CFUNC, 0, .u = { .func = { length, JS_CFUNC_generic, { .generic = func1 } } } }
@@ -140,6 +152,19 @@ static inline JSCFunctionListEntry QJS_CGETSET_DEF(const char *name, JSCFunction
 	entry.u.getset.set.setter = fsetter;
 	return entry;
 }
+// #define JS_CGETSET_MAGIC_DEF(name, fgetter, fsetter, magic) { name, JS_PROP_CONFIGURABLE, JS_DEF_CGETSET_MAGIC, magic, .u = { .getset = { .get = { .getter_magic = fgetter }, .set = { .setter_magic = fsetter } } } }
+typedef JSValue JSCFunctionGetterMagic(JSContext *ctx, JSValueConst this_val, int magic);
+static inline JSCFunctionListEntry QJS_CGETSET_MAGIC_DEF(const char *name, JSCFunctionGetterMagic *fgetter, int16_t magic, uint8_t prop_flags = JS_PROP_CONFIGURABLE)
+{
+	JSCFunctionListEntry entry;
+	entry.name = name;
+	entry.prop_flags = prop_flags;
+	entry.def_type = JS_DEF_CGETSET_MAGIC;
+	entry.magic = magic;
+	entry.u.getset.get.getter_magic = fgetter;
+	entry.u.getset.set.setter_magic = nullptr;
+	return entry;
+}
 
 struct JSToJsonContext
 {
@@ -433,6 +458,7 @@ public:
 		ASSERT(ctx != nullptr, "JS_NewContext failed?");
 
 		global_obj = JS_GetGlobalObject(ctx);
+		createObjectPrototypes();
 
 		engineToInstanceMap.insert(std::pair<JSContext*, quickjs_scripting_instance*>(ctx, this));
 	}
@@ -448,7 +474,17 @@ public:
 			compiledScriptObj = JS_UNINITIALIZED;
 		}
 
+		for (auto &call : deferredCalls)
+		{
+			for (JSValue arg : call.args)
+			{
+				JS_FreeValue(ctx, arg);
+			}
+		}
+		deferredCalls.clear();
+
 		JS_FreeValue(ctx, global_obj);
+		freeObjectPrototypes();
 		ASSERT(ctx != nullptr, "context is null??");
 		if (ctx)
 		{
@@ -492,6 +528,7 @@ public:
 
 	void updateGameTime(uint32_t gameTime) override;
 	void updateGroupSizes(int group, int size) override;
+	void objectRemoved(const BASE_OBJECT *psObj) override;
 
 	void setSpecifiedGlobalVariables(const nlohmann::json& variables, wzapi::GlobalVariableFlags flags = wzapi::GlobalVariableFlags::ReadOnly | wzapi::GlobalVariableFlags::DoNotSave) override;
 
@@ -532,6 +569,43 @@ public:
 
 	void doNotSaveGlobal(const std::string &global);
 
+public:
+	// Game objects and research items handed to the script (see convGameObject)
+	JSValue objectPrototype(OBJECT_TYPE type) const { return gameObjectPrototypes[type]; }
+	JSValue researchPrototype() const { return researchProto; }
+	void addGameObjectProxy(uint32_t id, JSValue obj) { gameObjectProxies.emplace(id, obj); }
+	void forgetGameObjectProxy(uint32_t id, JSValue obj);
+
+	/// Whether the script gets plain snapshots of game objects instead of proxies reading the current values
+	bool objectSnapshots = false;
+
+private:
+	void createObjectPrototypes();
+	void freeObjectPrototypes();
+
+	JSValue gameObjectPrototypes[OBJ_NUM_TYPES]; ///< set up by createObjectPrototypes()
+	JSValue researchProto = JS_UNDEFINED;
+	/// Proxies of live game objects by object id. Weak: a proxy removes itself when it is finalized.
+	std::unordered_multimap<uint32_t, JSValue> gameObjectProxies;
+
+public:
+	// Concurrent AI timers (see js_concurrentApiCall)
+	void enterThread() override;
+	void applyDeferredCalls() override;
+	/// Records a call of API function `function` (an index into concurrentApiFunctions) for applyDeferredCalls()
+	void deferCall(int function, int argc, JSValueConst *argv);
+
+private:
+	/// Creates the script function for API function `func`, going through js_concurrentApiCall if the instance runs concurrently
+	JSValue newApiFunction(JSCFunction *func, const char *name, int length);
+
+	struct DeferredCall
+	{
+		int function;
+		std::vector<JSValue> args;
+	};
+	std::vector<DeferredCall> deferredCalls;
+
 private:
 	JSRuntime *rt;
     JSContext *ctx;
@@ -1261,6 +1335,282 @@ static int QuickJS_DefinePropertyValue(JSContext *ctx, JSValueConst this_obj, co
 	return ret;
 }
 
+// MARK: Game objects
+
+// Droids, structures, features and research items are handed to scripts either as plain snapshots, or as
+// proxies: a small object of class WzGameObject / WzResearch holding its identity (id, player, type) as own
+// properties, with every other property a getter on a prototype shared by all objects of its type that reads
+// the current value from the game. Both are built from the property lists below, so they always agree.
+
+enum ObjectProperty : int16_t
+{
+	// Base object
+	OBJPROP_ID, OBJPROP_X, OBJPROP_Y, OBJPROP_Z, OBJPROP_PLAYER, OBJPROP_ARMOUR, OBJPROP_THERMAL, OBJPROP_TYPE,
+	OBJPROP_SELECTED, OBJPROP_NAME, OBJPROP_BORN, OBJPROP_GROUP,
+	// Droid, structure and feature
+	OBJPROP_ACTION, OBJPROP_RANGE, OBJPROP_ORDER, OBJPROP_COST, OBJPROP_HAS_INDIRECT, OBJPROP_BODY_SIZE,
+	OBJPROP_CARGO_CAPACITY, OBJPROP_CARGO_LEFT, OBJPROP_CARGO_COUNT, OBJPROP_IS_RADAR_DETECTOR, OBJPROP_IS_CB,
+	OBJPROP_IS_SENSOR, OBJPROP_CAN_HIT_AIR, OBJPROP_CAN_HIT_GROUND, OBJPROP_IS_VTOL, OBJPROP_IS_FLYING,
+	OBJPROP_DROID_TYPE, OBJPROP_EXPERIENCE, OBJPROP_HEALTH, OBJPROP_BODY, OBJPROP_PROPULSION, OBJPROP_ARMED,
+	OBJPROP_WEAPONS, OBJPROP_CARGO_SIZE, OBJPROP_STATUS, OBJPROP_DIRECTION, OBJPROP_STATTYPE, OBJPROP_MODULES,
+	OBJPROP_DAMAGEABLE,
+	// Research
+	RESPROP_POWER, RESPROP_POINTS, RESPROP_STARTED, RESPROP_DONE, RESPROP_FULLNAME, RESPROP_NAME, RESPROP_ID,
+	RESPROP_TYPE, RESPROP_RESULTS,
+};
+
+struct ObjectPropertyDef
+{
+	const char *name;
+	ObjectProperty prop;
+};
+
+// Identity properties are own properties of a proxy, and never change
+static bool isIdentityProperty(ObjectProperty prop)
+{
+	return prop == OBJPROP_ID || prop == OBJPROP_PLAYER || prop == OBJPROP_TYPE || prop == RESPROP_ID || prop == RESPROP_TYPE;
+}
+
+static int objectPropertyFlags(ObjectProperty prop)
+{
+	return (prop == OBJPROP_ID) ? 0 : JS_PROP_ENUMERABLE; // the object id has always been hidden
+}
+
+/// What the weapons of a droid or structure can do
+struct ObjectWeaponInfo
+{
+	bool aa = false;
+	bool ga = false;
+	bool indirect = false;
+	int range = -1;
+};
+
+static ObjectWeaponInfo objectWeaponInfo(const BASE_OBJECT *psObj)
+{
+	ObjectWeaponInfo info;
+	if (psObj->type != OBJ_DROID && psObj->type != OBJ_STRUCTURE)
+	{
+		return info;
+	}
+	for (int i = 0; i < psObj->numWeaps; i++)
+	{
+		if (psObj->asWeaps[i].nStat)
+		{
+			ASSERT(psObj->asWeaps[i].nStat < asWeaponStats.size(), "Invalid nStat (%d) referenced for asWeaps[%d]; numWeaponStats (%zu); object: %s (numWeaps: %u)", psObj->asWeaps[i].nStat, i, asWeaponStats.size(), objInfo(psObj), psObj->numWeaps);
+			WEAPON_STATS *psWeap = psObj->getWeaponStats(i);
+			info.aa = info.aa || psWeap->surfaceToAir & SHOOT_IN_AIR;
+			info.ga = info.ga || psWeap->surfaceToAir & SHOOT_ON_GROUND;
+			info.indirect = info.indirect || psWeap->movementModel == MM_INDIRECT || psWeap->movementModel == MM_HOMINGINDIRECT;
+			info.range = MAX(proj_GetLongRange(*psWeap, psObj->player), info.range);
+		}
+	}
+	return info;
+}
+
+static JSValue baseObjectPropertyValue(JSContext *ctx, const BASE_OBJECT *psObj, ObjectProperty prop)
+{
+	switch (prop)
+	{
+	case OBJPROP_ID: return JS_NewUint32(ctx, psObj->id);
+	case OBJPROP_X: return JS_NewInt32(ctx, map_coord(psObj->pos.x));
+	case OBJPROP_Y: return JS_NewInt32(ctx, map_coord(psObj->pos.y));
+	case OBJPROP_Z: return JS_NewInt32(ctx, map_coord(psObj->pos.z));
+	case OBJPROP_PLAYER: return JS_NewUint32(ctx, psObj->player);
+	case OBJPROP_ARMOUR: return JS_NewInt32(ctx, objArmour(psObj, WC_KINETIC));
+	case OBJPROP_THERMAL: return JS_NewInt32(ctx, objArmour(psObj, WC_HEAT));
+	case OBJPROP_TYPE: return JS_NewInt32(ctx, psObj->type);
+	case OBJPROP_SELECTED: return JS_NewUint32(ctx, psObj->selected);
+	case OBJPROP_NAME: return JS_NewString(ctx, objInfo(psObj));
+	case OBJPROP_BORN: return JS_NewUint32(ctx, psObj->born);
+	case OBJPROP_GROUP:
+	{
+		scripting_engine::GROUPMAP *psMap = scripting_engine::instance().getGroupMap(engineToInstanceMap.at(ctx));
+		if (psMap != nullptr && psMap->map().count(psObj) > 0) // FIXME:
+		{
+			int group = psMap->map().at(psObj); // FIXME:
+			return JS_NewInt32(ctx, group);
+		}
+		return JS_NULL;
+	}
+	default: return JS_UNINITIALIZED;
+	}
+}
+
+static JSValue weaponListValue(JSContext *ctx, const BASE_OBJECT *psObj)
+{
+	JSValue weaponlist = JS_NewArray(ctx);
+	for (int j = 0; j < psObj->numWeaps; j++)
+	{
+		JSValue weapon = JS_NewObject(ctx);
+		const WEAPON_STATS *psStats = psObj->getWeaponStats(j);
+		QuickJS_DefinePropertyValue(ctx, weapon, "fullname", JS_NewString(ctx, psStats->name.toUtf8().c_str()), JS_PROP_ENUMERABLE);
+		QuickJS_DefinePropertyValue(ctx, weapon, "name", JS_NewString(ctx, psStats->id.toUtf8().c_str()), JS_PROP_ENUMERABLE); // will be changed to contain full name
+		QuickJS_DefinePropertyValue(ctx, weapon, "id", JS_NewString(ctx, psStats->id.toUtf8().c_str()), JS_PROP_ENUMERABLE);
+		QuickJS_DefinePropertyValue(ctx, weapon, "lastFired", JS_NewUint32(ctx, psObj->asWeaps[j].lastFired), JS_PROP_ENUMERABLE);
+		if (psObj->type == OBJ_DROID)
+		{
+			const DROID *psDroid = static_cast<const DROID *>(psObj);
+			QuickJS_DefinePropertyValue(ctx, weapon, "armed", JS_NewInt32(ctx, droidReloadBar(psDroid, &psDroid->asWeaps[j], j)), JS_PROP_ENUMERABLE);
+		}
+		JS_DefinePropertyValueUint32(ctx, weaponlist, j, weapon, JS_PROP_ENUMERABLE);
+	}
+	return weaponlist;
+}
+
+static JSValue droidPropertyValue(JSContext *ctx, const DROID *psDroid, ObjectProperty prop, const ObjectWeaponInfo &weapons)
+{
+	switch (prop)
+	{
+	case OBJPROP_ACTION: return JS_NewInt32(ctx, (int)psDroid->action);
+	case OBJPROP_RANGE: return (weapons.range >= 0) ? JS_NewInt32(ctx, weapons.range) : JS_NULL;
+	case OBJPROP_ORDER: return JS_NewInt32(ctx, (int)psDroid->order.type);
+	case OBJPROP_COST: return JS_NewUint32(ctx, calcDroidPower(psDroid));
+	case OBJPROP_HAS_INDIRECT: return JS_NewBool(ctx, weapons.indirect);
+	case OBJPROP_BODY_SIZE: return JS_NewInt32(ctx, psDroid->getBodyStats()->size);
+	case OBJPROP_CARGO_CAPACITY: return psDroid->isTransporter() ? JS_NewInt32(ctx, TRANSPORTER_CAPACITY) : JS_UNINITIALIZED;
+	case OBJPROP_CARGO_LEFT: return psDroid->isTransporter() ? JS_NewInt32(ctx, calcRemainingCapacity(psDroid)) : JS_UNINITIALIZED;
+	case OBJPROP_CARGO_COUNT: return psDroid->isTransporter() ? JS_NewUint32(ctx, psDroid->psGroup != nullptr? psDroid->psGroup->getNumMembers() : 0) : JS_UNINITIALIZED;
+	case OBJPROP_IS_RADAR_DETECTOR: return JS_NewBool(ctx, objRadarDetector(psDroid));
+	case OBJPROP_IS_CB: return JS_NewBool(ctx, cbSensorDroid(psDroid));
+	case OBJPROP_IS_SENSOR: return JS_NewBool(ctx, standardSensorDroid(psDroid));
+	case OBJPROP_CAN_HIT_AIR: return JS_NewBool(ctx, weapons.aa);
+	case OBJPROP_CAN_HIT_GROUND: return JS_NewBool(ctx, weapons.ga);
+	case OBJPROP_IS_VTOL: return JS_NewBool(ctx, psDroid->isVtol());
+	case OBJPROP_IS_FLYING: return JS_NewBool(ctx, psDroid->isFlying());
+	case OBJPROP_DROID_TYPE:
+	{
+		DROID_TYPE type = psDroid->droidType;
+		switch (psDroid->droidType) // hide some engine craziness
+		{
+		case DROID_CYBORG_CONSTRUCT:
+			type = DROID_CONSTRUCT; break;
+		case DROID_CYBORG_SUPER:
+			type = DROID_CYBORG; break;
+		case DROID_DEFAULT:
+			type = DROID_WEAPON; break;
+		case DROID_CYBORG_REPAIR:
+			type = DROID_REPAIR; break;
+		default:
+			break;
+		}
+		return JS_NewInt32(ctx, (int)type);
+	}
+	case OBJPROP_EXPERIENCE: return JS_NewFloat64(ctx, (double)psDroid->experience / 65536.0);
+	case OBJPROP_HEALTH: return JS_NewFloat64(ctx, 100.0 / (double)psDroid->originalBody * (double)psDroid->body);
+	case OBJPROP_BODY: return JS_NewString(ctx, psDroid->getBodyStats()->id.toUtf8().c_str());
+	case OBJPROP_PROPULSION: return JS_NewString(ctx, psDroid->getPropulsionStats()->id.toUtf8().c_str());
+	case OBJPROP_ARMED: return JS_NewFloat64(ctx, 0.0); // deprecated!
+	case OBJPROP_WEAPONS: return weaponListValue(ctx, psDroid);
+	case OBJPROP_CARGO_SIZE: return JS_NewInt32(ctx, transporterSpaceRequired(psDroid));
+	default: return baseObjectPropertyValue(ctx, psDroid, prop);
+	}
+}
+
+static JSValue structurePropertyValue(JSContext *ctx, const STRUCTURE *psStruct, ObjectProperty prop, const ObjectWeaponInfo &weapons)
+{
+	switch (prop)
+	{
+	case OBJPROP_IS_CB: return JS_NewBool(ctx, structCBSensor(psStruct));
+	case OBJPROP_IS_SENSOR: return JS_NewBool(ctx, structStandardSensor(psStruct));
+	case OBJPROP_CAN_HIT_AIR: return JS_NewBool(ctx, weapons.aa);
+	case OBJPROP_CAN_HIT_GROUND: return JS_NewBool(ctx, weapons.ga);
+	case OBJPROP_HAS_INDIRECT: return JS_NewBool(ctx, weapons.indirect);
+	case OBJPROP_IS_RADAR_DETECTOR: return JS_NewBool(ctx, objRadarDetector(psStruct));
+	case OBJPROP_RANGE: return JS_NewInt32(ctx, weapons.range);
+	case OBJPROP_STATUS: return JS_NewInt32(ctx, (int)psStruct->status);
+	case OBJPROP_HEALTH: return JS_NewInt32(ctx, 100 * psStruct->body / MAX(1, psStruct->structureBody()));
+	case OBJPROP_COST: return JS_NewInt32(ctx, psStruct->pStructureType->powerToBuild);
+	case OBJPROP_DIRECTION: return JS_NewInt32(ctx, static_cast<int32_t>(UNDEG(psStruct->rot.direction)));
+	case OBJPROP_STATTYPE:
+		switch (psStruct->pStructureType->type) // don't bleed our source insanities into the scripting world
+		{
+		case REF_WALL:
+		case REF_WALLCORNER:
+		case REF_GATE:
+			return JS_NewInt32(ctx, (int)REF_WALL);
+		case REF_FORTRESS:
+		case REF_DEFENSE:
+			return JS_NewInt32(ctx, (int)REF_DEFENSE);
+		default:
+			return JS_NewInt32(ctx, (int)psStruct->pStructureType->type);
+		}
+	case OBJPROP_MODULES:
+		if (psStruct->pStructureType->type == REF_FACTORY || psStruct->pStructureType->type == REF_CYBORG_FACTORY
+		    || psStruct->pStructureType->type == REF_VTOL_FACTORY
+		    || psStruct->pStructureType->type == REF_RESEARCH
+		    || psStruct->pStructureType->type == REF_POWER_GEN)
+		{
+			return JS_NewUint32(ctx, psStruct->capacity);
+		}
+		return JS_NULL;
+	case OBJPROP_WEAPONS: return weaponListValue(ctx, psStruct);
+	default: return baseObjectPropertyValue(ctx, psStruct, prop);
+	}
+}
+
+static JSValue featurePropertyValue(JSContext *ctx, const FEATURE *psFeature, ObjectProperty prop)
+{
+	const FEATURE_STATS *psStats = psFeature->psStats;
+	switch (prop)
+	{
+	case OBJPROP_HEALTH: return JS_NewUint32(ctx, 100 * psStats->body / MAX(1, psFeature->body));
+	case OBJPROP_DAMAGEABLE: return JS_NewBool(ctx, psStats->damageable);
+	case OBJPROP_STATTYPE: return JS_NewInt32(ctx, psStats->subType);
+	default: return baseObjectPropertyValue(ctx, psFeature, prop);
+	}
+}
+
+/// Current value of `prop` of `psObj`, or JS_UNINITIALIZED if the object does not have it.
+/// Pass `weapons` when reading several properties at once, so it is only computed once.
+static JSValue gameObjectPropertyValue(JSContext *ctx, const BASE_OBJECT *psObj, ObjectProperty prop, const ObjectWeaponInfo *weapons = nullptr)
+{
+	ObjectWeaponInfo ownWeapons;
+	if (weapons == nullptr && (prop == OBJPROP_RANGE || prop == OBJPROP_HAS_INDIRECT || prop == OBJPROP_CAN_HIT_AIR || prop == OBJPROP_CAN_HIT_GROUND))
+	{
+		ownWeapons = objectWeaponInfo(psObj);
+	}
+	const ObjectWeaponInfo &info = weapons ? *weapons : ownWeapons;
+	switch (psObj->type)
+	{
+	case OBJ_DROID: return droidPropertyValue(ctx, static_cast<const DROID *>(psObj), prop, info);
+	case OBJ_STRUCTURE: return structurePropertyValue(ctx, static_cast<const STRUCTURE *>(psObj), prop, info);
+	case OBJ_FEATURE: return featurePropertyValue(ctx, static_cast<const FEATURE *>(psObj), prop);
+	default: return baseObjectPropertyValue(ctx, psObj, prop);
+	}
+}
+
+static JSValue researchPropertyValue(JSContext *ctx, const RESEARCH *psResearch, int player, ObjectProperty prop)
+{
+	switch (prop)
+	{
+	case RESPROP_POWER: return JS_NewInt32(ctx, (int)psResearch->researchPower);
+	case RESPROP_POINTS: return JS_NewInt32(ctx, (int)psResearch->researchPoints);
+	case RESPROP_STARTED:
+	{
+		bool started = false;
+		for (int i = 0; i < game.maxPlayers; i++)
+		{
+			if (aiCheckAlliances(player, i) || player == i)
+			{
+				int bits = asPlayerResList[i][psResearch->index].ResearchStatus;
+				started = started || (bits & STARTED_RESEARCH) || (bits & STARTED_RESEARCH_PENDING) || (bits & RESBITS_PENDING_ONLY);
+			}
+		}
+		return JS_NewBool(ctx, started); // including whether an ally has started it
+	}
+	case RESPROP_DONE: return JS_NewBool(ctx, IsResearchCompleted(&asPlayerResList[player][psResearch->index]));
+	case RESPROP_FULLNAME: return JS_NewString(ctx, psResearch->name.toUtf8().c_str()); // temporary
+	case RESPROP_NAME: return JS_NewString(ctx, psResearch->id.toUtf8().c_str()); // will be changed to contain fullname
+	case RESPROP_ID: return JS_NewString(ctx, psResearch->id.toUtf8().c_str());
+	case RESPROP_TYPE: return JS_NewInt32(ctx, SCRIPT_RESEARCH);
+	case RESPROP_RESULTS: return mapJsonToQuickJSValue(ctx, psResearch->results, JS_PROP_ENUMERABLE);
+	default: return JS_UNINITIALIZED;
+	}
+}
+
+static JSValue convGameObject(const BASE_OBJECT *psObj, JSContext *ctx); // forward-declare
+static JSValue convResearchItem(const RESEARCH *psResearch, JSContext *ctx, int player); // forward-declare
+
 //;; ## Research
 //;;
 //;; Describes a research item. The following properties are defined:
@@ -1274,32 +1624,19 @@ static int QuickJS_DefinePropertyValue(JSContext *ctx, JSValueConst this_obj, co
 //;; * ```type``` The type will always be ```RESEARCH_DATA```.
 //;; * ```results``` An array of objects of research upgrades (defined in "research.json").
 //;;
+static const std::vector<ObjectPropertyDef> researchProperties = {
+	{"power", RESPROP_POWER}, {"points", RESPROP_POINTS}, {"started", RESPROP_STARTED}, {"done", RESPROP_DONE},
+	{"fullname", RESPROP_FULLNAME}, {"name", RESPROP_NAME}, {"id", RESPROP_ID}, {"type", RESPROP_TYPE},
+	{"results", RESPROP_RESULTS},
+};
+
 JSValue convResearch(const RESEARCH *psResearch, JSContext *ctx, int player)
 {
 	if (psResearch == nullptr)
 	{
 		return JS_NULL;
 	}
-	JSValue value = JS_NewObject(ctx);
-	QuickJS_DefinePropertyValue(ctx, value, "power", JS_NewInt32(ctx, (int)psResearch->researchPower), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "points", JS_NewInt32(ctx, (int)psResearch->researchPoints), JS_PROP_ENUMERABLE);
-	bool started = false;
-	for (int i = 0; i < game.maxPlayers; i++)
-	{
-		if (aiCheckAlliances(player, i) || player == i)
-		{
-			int bits = asPlayerResList[i][psResearch->index].ResearchStatus;
-			started = started || (bits & STARTED_RESEARCH) || (bits & STARTED_RESEARCH_PENDING) || (bits & RESBITS_PENDING_ONLY);
-		}
-	}
-	QuickJS_DefinePropertyValue(ctx, value, "started", JS_NewBool(ctx, started), JS_PROP_ENUMERABLE); // including whether an ally has started it
-	QuickJS_DefinePropertyValue(ctx, value, "done", JS_NewBool(ctx, IsResearchCompleted(&asPlayerResList[player][psResearch->index])), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "fullname", JS_NewString(ctx, psResearch->name.toUtf8().c_str()), JS_PROP_ENUMERABLE); // temporary
-	QuickJS_DefinePropertyValue(ctx, value, "name", JS_NewString(ctx, psResearch->id.toUtf8().c_str()), JS_PROP_ENUMERABLE); // will be changed to contain fullname
-	QuickJS_DefinePropertyValue(ctx, value, "id", JS_NewString(ctx, psResearch->id.toUtf8().c_str()), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "type", JS_NewInt32(ctx, SCRIPT_RESEARCH), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "results", mapJsonToQuickJSValue(ctx, psResearch->results, JS_PROP_ENUMERABLE), JS_PROP_ENUMERABLE);
-	return value;
+	return convResearchItem(psResearch, ctx, player);
 }
 
 //;; ## Structure
@@ -1325,76 +1662,17 @@ JSValue convResearch(const RESEARCH *psResearch, JSContext *ctx, int player)
 //;; * ```hasIndirect``` One or more of the structure's weapons are indirect. (3.2+ only)
 //;; * ```health``` Percentage that this structure is damaged (where 100 means not damaged at all).
 //;;
+static const std::vector<ObjectPropertyDef> structureProperties = {
+	{"isCB", OBJPROP_IS_CB}, {"isSensor", OBJPROP_IS_SENSOR}, {"canHitAir", OBJPROP_CAN_HIT_AIR},
+	{"canHitGround", OBJPROP_CAN_HIT_GROUND}, {"hasIndirect", OBJPROP_HAS_INDIRECT},
+	{"isRadarDetector", OBJPROP_IS_RADAR_DETECTOR}, {"range", OBJPROP_RANGE}, {"status", OBJPROP_STATUS},
+	{"health", OBJPROP_HEALTH}, {"cost", OBJPROP_COST}, {"direction", OBJPROP_DIRECTION},
+	{"stattype", OBJPROP_STATTYPE}, {"modules", OBJPROP_MODULES}, {"weapons", OBJPROP_WEAPONS},
+};
+
 JSValue convStructure(const STRUCTURE *psStruct, JSContext *ctx)
 {
-	bool aa = false;
-	bool ga = false;
-	bool indirect = false;
-	int range = -1;
-	for (int i = 0; i < psStruct->numWeaps; i++)
-	{
-		if (psStruct->asWeaps[i].nStat)
-		{
-			WEAPON_STATS *psWeap = psStruct->getWeaponStats(i);
-			aa = aa || psWeap->surfaceToAir & SHOOT_IN_AIR;
-			ga = ga || psWeap->surfaceToAir & SHOOT_ON_GROUND;
-			indirect = indirect || psWeap->movementModel == MM_INDIRECT || psWeap->movementModel == MM_HOMINGINDIRECT;
-			range = MAX(proj_GetLongRange(*psWeap, psStruct->player), range);
-		}
-	}
-	JSValue value = convObj(psStruct, ctx);
-	QuickJS_DefinePropertyValue(ctx, value, "isCB", JS_NewBool(ctx, structCBSensor(psStruct)), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "isSensor", JS_NewBool(ctx, structStandardSensor(psStruct)), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "canHitAir", JS_NewBool(ctx, aa), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "canHitGround", JS_NewBool(ctx, ga), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "hasIndirect", JS_NewBool(ctx, indirect), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "isRadarDetector", JS_NewBool(ctx, objRadarDetector(psStruct)), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "range", JS_NewInt32(ctx, range), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "status", JS_NewInt32(ctx, (int)psStruct->status), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "health", JS_NewInt32(ctx, 100 * psStruct->body / MAX(1, psStruct->structureBody())), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "cost", JS_NewInt32(ctx, psStruct->pStructureType->powerToBuild), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "direction", JS_NewInt32(ctx, static_cast<int32_t>(UNDEG(psStruct->rot.direction))), JS_PROP_ENUMERABLE);
-	int stattype = 0;
-	switch (psStruct->pStructureType->type) // don't bleed our source insanities into the scripting world
-	{
-	case REF_WALL:
-	case REF_WALLCORNER:
-	case REF_GATE:
-		stattype = (int)REF_WALL;
-		break;
-	case REF_FORTRESS:
-	case REF_DEFENSE:
-		stattype = (int)REF_DEFENSE;
-		break;
-	default:
-		stattype = (int)psStruct->pStructureType->type;
-		break;
-	}
-	QuickJS_DefinePropertyValue(ctx, value, "stattype", JS_NewInt32(ctx, stattype), JS_PROP_ENUMERABLE);
-	if (psStruct->pStructureType->type == REF_FACTORY || psStruct->pStructureType->type == REF_CYBORG_FACTORY
-	    || psStruct->pStructureType->type == REF_VTOL_FACTORY
-	    || psStruct->pStructureType->type == REF_RESEARCH
-	    || psStruct->pStructureType->type == REF_POWER_GEN)
-	{
-		QuickJS_DefinePropertyValue(ctx, value, "modules", JS_NewUint32(ctx, psStruct->capacity), JS_PROP_ENUMERABLE);
-	}
-	else
-	{
-		QuickJS_DefinePropertyValue(ctx, value, "modules", JS_NULL, JS_PROP_ENUMERABLE);
-	}
-	JSValue weaponlist = JS_NewArray(ctx);
-	for (int j = 0; j < psStruct->numWeaps; j++)
-	{
-		JSValue weapon = JS_NewObject(ctx);
-		const WEAPON_STATS *psStats = psStruct->getWeaponStats(j);
-		QuickJS_DefinePropertyValue(ctx, weapon, "fullname", JS_NewString(ctx, psStats->name.toUtf8().c_str()), JS_PROP_ENUMERABLE);
-		QuickJS_DefinePropertyValue(ctx, weapon, "name", JS_NewString(ctx, psStats->id.toUtf8().c_str()), JS_PROP_ENUMERABLE); // will be changed to contain full name
-		QuickJS_DefinePropertyValue(ctx, weapon, "id", JS_NewString(ctx, psStats->id.toUtf8().c_str()), JS_PROP_ENUMERABLE);
-		QuickJS_DefinePropertyValue(ctx, weapon, "lastFired", JS_NewUint32(ctx, psStruct->asWeaps[j].lastFired), JS_PROP_ENUMERABLE);
-		JS_DefinePropertyValueUint32(ctx, weaponlist, j, weapon, JS_PROP_ENUMERABLE);
-	}
-	QuickJS_DefinePropertyValue(ctx, value, "weapons", weaponlist, JS_PROP_ENUMERABLE);
-	return value;
+	return convGameObject(psStruct, ctx);
 }
 
 //;; ## Feature
@@ -1406,14 +1684,13 @@ JSValue convStructure(const STRUCTURE *psStruct, JSContext *ctx)
 //;; * ```damageable``` Can this feature be damaged?
 //;; * ```health``` Percentage that this feature is damaged (where 100 means not damaged at all).
 //;;
+static const std::vector<ObjectPropertyDef> featureProperties = {
+	{"health", OBJPROP_HEALTH}, {"damageable", OBJPROP_DAMAGEABLE}, {"stattype", OBJPROP_STATTYPE},
+};
+
 JSValue convFeature(const FEATURE *psFeature, JSContext *ctx)
 {
-	JSValue value = convObj(psFeature, ctx);
-	const FEATURE_STATS *psStats = psFeature->psStats;
-	QuickJS_DefinePropertyValue(ctx, value, "health", JS_NewUint32(ctx, 100 * psStats->body / MAX(1, psFeature->body)), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "damageable", JS_NewBool(ctx, psStats->damageable), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "stattype", JS_NewInt32(ctx, psStats->subType), JS_PROP_ENUMERABLE);
-	return value;
+	return convGameObject(psFeature, ctx);
 }
 
 //;; ## Droid
@@ -1479,91 +1756,20 @@ JSValue convFeature(const FEATURE *psFeature, JSContext *ctx)
 //;; * ```cargoSize``` The amount of cargo space the droid will take inside a transport. (3.2+ only)
 //;; * ```health``` Percentage that this droid is damaged (where 100 means not damaged at all).
 //;;
+static const std::vector<ObjectPropertyDef> droidProperties = {
+	{"action", OBJPROP_ACTION}, {"range", OBJPROP_RANGE}, {"order", OBJPROP_ORDER}, {"cost", OBJPROP_COST},
+	{"hasIndirect", OBJPROP_HAS_INDIRECT}, {"bodySize", OBJPROP_BODY_SIZE}, {"cargoCapacity", OBJPROP_CARGO_CAPACITY},
+	{"cargoLeft", OBJPROP_CARGO_LEFT}, {"cargoCount", OBJPROP_CARGO_COUNT}, {"isRadarDetector", OBJPROP_IS_RADAR_DETECTOR},
+	{"isCB", OBJPROP_IS_CB}, {"isSensor", OBJPROP_IS_SENSOR}, {"canHitAir", OBJPROP_CAN_HIT_AIR},
+	{"canHitGround", OBJPROP_CAN_HIT_GROUND}, {"isVTOL", OBJPROP_IS_VTOL}, {"isFlying", OBJPROP_IS_FLYING},
+	{"droidType", OBJPROP_DROID_TYPE}, {"experience", OBJPROP_EXPERIENCE}, {"health", OBJPROP_HEALTH},
+	{"body", OBJPROP_BODY}, {"propulsion", OBJPROP_PROPULSION}, {"armed", OBJPROP_ARMED},
+	{"weapons", OBJPROP_WEAPONS}, {"cargoSize", OBJPROP_CARGO_SIZE},
+};
+
 JSValue convDroid(const DROID *psDroid, JSContext *ctx)
 {
-	bool aa = false;
-	bool ga = false;
-	bool indirect = false;
-	int range = -1;
-	const BODY_STATS *psBodyStats = psDroid->getBodyStats();
-
-	for (int i = 0; i < psDroid->numWeaps; i++)
-	{
-		if (psDroid->asWeaps[i].nStat)
-		{
-			ASSERT(psDroid->asWeaps[i].nStat < asWeaponStats.size(), "Invalid nStat (%d) referenced for asWeaps[%d]; numWeaponStats (%zu); droid: \"%s\" (numWeaps: %u)", psDroid->asWeaps[i].nStat, i, asWeaponStats.size(), psDroid->aName, psDroid->numWeaps);
-			WEAPON_STATS *psWeap = psDroid->getWeaponStats(i);
-			aa = aa || psWeap->surfaceToAir & SHOOT_IN_AIR;
-			ga = ga || psWeap->surfaceToAir & SHOOT_ON_GROUND;
-			indirect = indirect || psWeap->movementModel == MM_INDIRECT || psWeap->movementModel == MM_HOMINGINDIRECT;
-			range = MAX(proj_GetLongRange(*psWeap, psDroid->player), range);
-		}
-	}
-	DROID_TYPE type = psDroid->droidType;
-	JSValue value = convObj(psDroid, ctx);
-	QuickJS_DefinePropertyValue(ctx, value, "action", JS_NewInt32(ctx, (int)psDroid->action), JS_PROP_ENUMERABLE);
-	if (range >= 0)
-	{
-		QuickJS_DefinePropertyValue(ctx, value, "range", JS_NewInt32(ctx, range), JS_PROP_ENUMERABLE);
-	}
-	else
-	{
-		QuickJS_DefinePropertyValue(ctx, value, "range", JS_NULL, JS_PROP_ENUMERABLE);
-	}
-	QuickJS_DefinePropertyValue(ctx, value, "order", JS_NewInt32(ctx, (int)psDroid->order.type), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "cost", JS_NewUint32(ctx, calcDroidPower(psDroid)), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "hasIndirect", JS_NewBool(ctx, indirect), JS_PROP_ENUMERABLE);
-	switch (psDroid->droidType) // hide some engine craziness
-	{
-	case DROID_CYBORG_CONSTRUCT:
-		type = DROID_CONSTRUCT; break;
-	case DROID_CYBORG_SUPER:
-		type = DROID_CYBORG; break;
-	case DROID_DEFAULT:
-		type = DROID_WEAPON; break;
-	case DROID_CYBORG_REPAIR:
-		type = DROID_REPAIR; break;
-	default:
-		break;
-	}
-	QuickJS_DefinePropertyValue(ctx, value, "bodySize", JS_NewInt32(ctx, psBodyStats->size), JS_PROP_ENUMERABLE);
-	if (psDroid->isTransporter())
-	{
-		QuickJS_DefinePropertyValue(ctx, value, "cargoCapacity", JS_NewInt32(ctx, TRANSPORTER_CAPACITY), JS_PROP_ENUMERABLE);
-		QuickJS_DefinePropertyValue(ctx, value, "cargoLeft", JS_NewInt32(ctx, calcRemainingCapacity(psDroid)), JS_PROP_ENUMERABLE);
-		QuickJS_DefinePropertyValue(ctx, value, "cargoCount", JS_NewUint32(ctx, psDroid->psGroup != nullptr? psDroid->psGroup->getNumMembers() : 0), JS_PROP_ENUMERABLE);
-	}
-	QuickJS_DefinePropertyValue(ctx, value, "isRadarDetector", JS_NewBool(ctx, objRadarDetector(psDroid)), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "isCB", JS_NewBool(ctx, cbSensorDroid(psDroid)), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "isSensor", JS_NewBool(ctx, standardSensorDroid(psDroid)), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "canHitAir", JS_NewBool(ctx, aa), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "canHitGround", JS_NewBool(ctx, ga), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "isVTOL", JS_NewBool(ctx, psDroid->isVtol()), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "isFlying", JS_NewBool(ctx, psDroid->isFlying()), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "droidType", JS_NewInt32(ctx, (int)type), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "experience", JS_NewFloat64(ctx, (double)psDroid->experience / 65536.0), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "health", JS_NewFloat64(ctx, 100.0 / (double)psDroid->originalBody * (double)psDroid->body), JS_PROP_ENUMERABLE);
-
-	QuickJS_DefinePropertyValue(ctx, value, "body", JS_NewString(ctx, psDroid->getBodyStats()->id.toUtf8().c_str()), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "propulsion", JS_NewString(ctx, psDroid->getPropulsionStats()->id.toUtf8().c_str()), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "armed", JS_NewFloat64(ctx, 0.0), JS_PROP_ENUMERABLE); // deprecated!
-
-	JSValue weaponlist = JS_NewArray(ctx);
-	for (int j = 0; j < psDroid->numWeaps; j++)
-	{
-		int armed = droidReloadBar(psDroid, &psDroid->asWeaps[j], j);
-		JSValue weapon = JS_NewObject(ctx);
-		const WEAPON_STATS *psStats = psDroid->getWeaponStats(j);
-		QuickJS_DefinePropertyValue(ctx, weapon, "fullname", JS_NewString(ctx, psStats->name.toUtf8().c_str()), JS_PROP_ENUMERABLE);
-		QuickJS_DefinePropertyValue(ctx, weapon, "name", JS_NewString(ctx, psStats->id.toUtf8().c_str()), JS_PROP_ENUMERABLE); // will be changed to contain full name
-		QuickJS_DefinePropertyValue(ctx, weapon, "id", JS_NewString(ctx, psStats->id.toUtf8().c_str()), JS_PROP_ENUMERABLE);
-		QuickJS_DefinePropertyValue(ctx, weapon, "lastFired", JS_NewUint32(ctx, psDroid->asWeaps[j].lastFired), JS_PROP_ENUMERABLE);
-		QuickJS_DefinePropertyValue(ctx, weapon, "armed", JS_NewInt32(ctx, armed), JS_PROP_ENUMERABLE);
-		JS_DefinePropertyValueUint32(ctx, weaponlist, j, weapon, JS_PROP_ENUMERABLE);
-	}
-	QuickJS_DefinePropertyValue(ctx, value, "weapons", weaponlist, JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "cargoSize", JS_NewInt32(ctx, transporterSpaceRequired(psDroid)), JS_PROP_ENUMERABLE);
-	return value;
+	return convGameObject(psDroid, ctx);
 }
 
 //;; ## Base Object
@@ -1586,34 +1792,358 @@ JSValue convDroid(const DROID *psDroid, JSContext *ctx)
 //;; * ```born``` The game time at which this object was produced or came into the world. (3.2+ only)
 //;; * ```group``` The group this object is member of. This is a numerical ID. If not a member of any group, will be set to \emph{null}.
 //;;
+//;; Apart from ```id```, ```player``` and ```type```, these properties (and those of droids, structures, features and
+//;; research) are read from the game each time the script reads them, so a kept object stays up to date. Once the
+//;; object is destroyed, it keeps the values it had at that point. ```Object.keys()``` only lists ```player``` and
+//;; ```type```; use ```for...in``` to walk all properties. See ```setObjectSnapshots()``` to get plain copies instead.
+//;;
+static const std::vector<ObjectPropertyDef> baseObjectProperties = {
+	{"id", OBJPROP_ID}, {"x", OBJPROP_X}, {"y", OBJPROP_Y}, {"z", OBJPROP_Z}, {"player", OBJPROP_PLAYER},
+	{"armour", OBJPROP_ARMOUR}, {"thermal", OBJPROP_THERMAL}, {"type", OBJPROP_TYPE}, {"selected", OBJPROP_SELECTED},
+	{"name", OBJPROP_NAME}, {"born", OBJPROP_BORN}, {"group", OBJPROP_GROUP},
+};
+
 JSValue convObj(const BASE_OBJECT *psObj, JSContext *ctx)
+{
+	ASSERT_OR_RETURN(JS_NewObject(ctx), psObj, "No object for conversion");
+	return convGameObject(psObj, ctx);
+}
+
+static const std::vector<ObjectPropertyDef> &objectTypeProperties(OBJECT_TYPE type)
+{
+	static const std::vector<ObjectPropertyDef> none;
+	switch (type)
+	{
+	case OBJ_DROID: return droidProperties;
+	case OBJ_STRUCTURE: return structureProperties;
+	case OBJ_FEATURE: return featureProperties;
+	default: return none;
+	}
+}
+
+static void defineGameObjectProperties(JSContext *ctx, JSValue value, const BASE_OBJECT *psObj, const std::vector<ObjectPropertyDef> &properties, const ObjectWeaponInfo &weapons, bool identity)
+{
+	for (const auto &property : properties)
+	{
+		if (!identity && isIdentityProperty(property.prop))
+		{
+			continue;
+		}
+		JSValue propValue = gameObjectPropertyValue(ctx, psObj, property.prop, &weapons);
+		if (!JS_IsUninitialized(propValue))
+		{
+			QuickJS_DefinePropertyValue(ctx, value, property.name, propValue, objectPropertyFlags(property.prop));
+		}
+	}
+}
+
+/// Plain object holding every property of `psObj`, the way scripts always got them
+static JSValue gameObjectSnapshot(JSContext *ctx, const BASE_OBJECT *psObj)
+{
+	JSValue value = JS_NewObject(ctx);
+	const ObjectWeaponInfo weapons = objectWeaponInfo(psObj);
+	defineGameObjectProperties(ctx, value, psObj, baseObjectProperties, weapons, true);
+	defineGameObjectProperties(ctx, value, psObj, objectTypeProperties(psObj->type), weapons, true);
+	return value;
+}
+
+static JSValue researchSnapshot(JSContext *ctx, const RESEARCH *psResearch, int player)
 {
 	JSValue value = JS_NewObject(ctx);
-	ASSERT_OR_RETURN(value, psObj, "No object for conversion");
-	QuickJS_DefinePropertyValue(ctx, value, "id", JS_NewUint32(ctx, psObj->id), 0);
-	QuickJS_DefinePropertyValue(ctx, value, "x", JS_NewInt32(ctx, map_coord(psObj->pos.x)), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "y", JS_NewInt32(ctx, map_coord(psObj->pos.y)), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "z", JS_NewInt32(ctx, map_coord(psObj->pos.z)), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "player", JS_NewUint32(ctx, psObj->player), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "armour", JS_NewInt32(ctx, objArmour(psObj, WC_KINETIC)), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "thermal", JS_NewInt32(ctx, objArmour(psObj, WC_HEAT)), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "type", JS_NewInt32(ctx, psObj->type), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "selected", JS_NewUint32(ctx, psObj->selected), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "name", JS_NewString(ctx, objInfo(psObj)), JS_PROP_ENUMERABLE);
-	QuickJS_DefinePropertyValue(ctx, value, "born", JS_NewUint32(ctx, psObj->born), JS_PROP_ENUMERABLE);
-	scripting_engine::GROUPMAP *psMap = scripting_engine::instance().getGroupMap(engineToInstanceMap.at(ctx));
-	if (psMap != nullptr && psMap->map().count(psObj) > 0) // FIXME:
-	{
-		int group = psMap->map().at(psObj); // FIXME:
-		QuickJS_DefinePropertyValue(ctx, value, "group", JS_NewInt32(ctx, group), JS_PROP_ENUMERABLE);
+	for (const auto &property : researchProperties)
+	{
+		QuickJS_DefinePropertyValue(ctx, value, property.name, researchPropertyValue(ctx, psResearch, player, property.prop), objectPropertyFlags(property.prop));
+	}
+	return value;
+}
+
+static JSClassID js_gameobject_class_id = 0;
+static JSClassID js_research_class_id = 0;
+
+/// Opaque data of a WzGameObject
+struct GameObjectProxy
+{
+	quickjs_scripting_instance *instance = nullptr;
+	const BASE_OBJECT *psObj = nullptr; ///< nullptr once the object is gone
+	std::shared_ptr<const bool> alive;  ///< objectLivenessToken() of psObj
+	uint32_t id = 0;
+	unsigned player = 0;
+	OBJECT_TYPE type = OBJ_NUM_TYPES;
+	bool registered = false;            ///< listed in the instance's gameObjectProxies
+
+	const BASE_OBJECT *object()
+	{
+		if (psObj != nullptr && !*alive)
+		{
+			psObj = nullptr;
+			alive.reset();
+		}
+		return psObj;
+	}
+};
+
+/// Opaque data of a WzResearch
+struct ResearchProxy
+{
+	size_t index = 0;
+	int player = 0;
+
+	const RESEARCH *research() const
+	{
+		return (index < asResearch.size()) ? &asResearch[index] : nullptr;
+	}
+};
+
+static void js_gameobject_finalizer(JSRuntime *rt, JSValue val)
+{
+	auto *proxy = static_cast<GameObjectProxy *>(JS_GetOpaque(val, js_gameobject_class_id));
+	if (proxy == nullptr)
+	{
+		return;
+	}
+	if (proxy->registered)
+	{
+		proxy->instance->forgetGameObjectProxy(proxy->id, val);
+	}
+	delete proxy;
+}
+
+static void js_research_finalizer(JSRuntime *rt, JSValue val)
+{
+	delete static_cast<ResearchProxy *>(JS_GetOpaque(val, js_research_class_id));
+}
+
+static JSValue js_gameobject_get(JSContext *ctx, JSValueConst this_val, int magic)
+{
+	auto *proxy = static_cast<GameObjectProxy *>(JS_GetOpaque(this_val, js_gameobject_class_id));
+	const BASE_OBJECT *psObj = (proxy != nullptr) ? proxy->object() : nullptr;
+	if (psObj == nullptr)
+	{
+		return JS_UNDEFINED;
+	}
+	JSValue value = gameObjectPropertyValue(ctx, psObj, static_cast<ObjectProperty>(magic));
+	return JS_IsUninitialized(value) ? JS_UNDEFINED : value;
+}
+
+static JSValue js_research_get(JSContext *ctx, JSValueConst this_val, int magic)
+{
+	auto *proxy = static_cast<ResearchProxy *>(JS_GetOpaque(this_val, js_research_class_id));
+	const RESEARCH *psResearch = (proxy != nullptr) ? proxy->research() : nullptr;
+	if (psResearch == nullptr)
+	{
+		return JS_UNDEFINED;
+	}
+	return researchPropertyValue(ctx, psResearch, proxy->player, static_cast<ObjectProperty>(magic));
+}
+
+/// Plain object with the current values of a WzGameObject or WzResearch (or, for a game object that is gone,
+/// its last values), including any property the script added to it. JS_UNINITIALIZED if `obj` is neither.
+static JSValue QuickJS_ObjectProxySnapshot(JSContext *ctx, JSValueConst obj)
+{
+	JSValue snapshot = JS_UNINITIALIZED;
+	if (auto *proxy = static_cast<GameObjectProxy *>(JS_GetOpaque(obj, js_gameobject_class_id)))
+	{
+		const BASE_OBJECT *psObj = proxy->object();
+		snapshot = (psObj != nullptr) ? gameObjectSnapshot(ctx, psObj) : JS_NewObject(ctx);
+	}
+	else if (auto *research = static_cast<ResearchProxy *>(JS_GetOpaque(obj, js_research_class_id)))
+	{
+		const RESEARCH *psResearch = research->research();
+		snapshot = (psResearch != nullptr) ? researchSnapshot(ctx, psResearch, research->player) : JS_NewObject(ctx);
 	}
 	else
 	{
-		QuickJS_DefinePropertyValue(ctx, value, "group", JS_NULL, JS_PROP_ENUMERABLE);
+		return JS_UNINITIALIZED;
+	}
+	// Own properties: the identity, the values a removed object had, and whatever the script added
+	QuickJS_EnumerateObjectProperties(ctx, obj, [ctx, obj, snapshot](const char *key, JSAtom &atom) {
+		JSPropertyDescriptor desc;
+		int hasProperty = JS_GetOwnProperty(ctx, &desc, obj, atom);
+		if (hasProperty <= 0)
+		{
+			return;
+		}
+		if (JS_GetOwnProperty(ctx, nullptr, snapshot, atom) <= 0)
+		{
+			JS_DefinePropertyValue(ctx, snapshot, atom, JS_DupValue(ctx, desc.value), desc.flags & JS_PROP_ENUMERABLE);
+		}
+		JS_FreeValue(ctx, desc.value);
+		JS_FreeValue(ctx, desc.getter);
+		JS_FreeValue(ctx, desc.setter);
+	}, false);
+	return snapshot;
+}
+
+static JSValue js_objectproxy_toJSON(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv)
+{
+	JSValue snapshot = QuickJS_ObjectProxySnapshot(ctx, this_val);
+	return JS_IsUninitialized(snapshot) ? JS_DupValue(ctx, this_val) : snapshot;
+}
+
+static JSValue convGameObject(const BASE_OBJECT *psObj, JSContext *ctx)
+{
+	quickjs_scripting_instance *instance = engineToInstanceMap.at(ctx);
+	if (instance->objectSnapshots || psObj->type >= OBJ_PROJECTILE)
+	{
+		return gameObjectSnapshot(ctx, psObj);
+	}
+	JSValue value = JS_NewObjectProtoClass(ctx, instance->objectPrototype(psObj->type), js_gameobject_class_id);
+	if (JS_IsException(value))
+	{
+		return value;
+	}
+	auto *proxy = new GameObjectProxy();
+	proxy->instance = instance;
+	proxy->psObj = psObj;
+	proxy->alive = objectLivenessToken(psObj);
+	proxy->id = psObj->id;
+	proxy->player = psObj->player;
+	proxy->type = psObj->type;
+	proxy->registered = true;
+	JS_SetOpaque(value, proxy);
+	instance->addGameObjectProxy(psObj->id, value);
+	const ObjectWeaponInfo noWeapons;
+	for (const auto &property : baseObjectProperties)
+	{
+		if (isIdentityProperty(property.prop))
+		{
+			QuickJS_DefinePropertyValue(ctx, value, property.name, gameObjectPropertyValue(ctx, psObj, property.prop, &noWeapons), objectPropertyFlags(property.prop));
+		}
 	}
 	return value;
 }
 
+static JSValue convResearchItem(const RESEARCH *psResearch, JSContext *ctx, int player)
+{
+	quickjs_scripting_instance *instance = engineToInstanceMap.at(ctx);
+	if (instance->objectSnapshots)
+	{
+		return researchSnapshot(ctx, psResearch, player);
+	}
+	JSValue value = JS_NewObjectProtoClass(ctx, instance->researchPrototype(), js_research_class_id);
+	if (JS_IsException(value))
+	{
+		return value;
+	}
+	auto *proxy = new ResearchProxy();
+	proxy->index = psResearch->index;
+	proxy->player = player;
+	JS_SetOpaque(value, proxy);
+	for (const auto &property : researchProperties)
+	{
+		if (isIdentityProperty(property.prop))
+		{
+			QuickJS_DefinePropertyValue(ctx, value, property.name, researchPropertyValue(ctx, psResearch, player, property.prop), objectPropertyFlags(property.prop));
+		}
+	}
+	return value;
+}
+
+static JSValue newObjectPrototype(JSContext *ctx, const std::vector<const std::vector<ObjectPropertyDef> *> &propertyLists, JSCFunctionGetterMagic *getter)
+{
+	std::vector<JSCFunctionListEntry> entries;
+	for (const auto *properties : propertyLists)
+	{
+		for (const auto &property : *properties)
+		{
+			if (!isIdentityProperty(property.prop))
+			{
+				entries.push_back(QJS_CGETSET_MAGIC_DEF(property.name, getter, property.prop, JS_PROP_CONFIGURABLE | JS_PROP_ENUMERABLE));
+			}
+		}
+	}
+	entries.push_back(QJS_CFUNC_DEF("toJSON", 1, js_objectproxy_toJSON));
+	JSValue proto = JS_NewObject(ctx);
+	JS_SetPropertyFunctionList(ctx, proto, entries.data(), static_cast<int>(entries.size()));
+	return proto;
+}
+
+void quickjs_scripting_instance::createObjectPrototypes()
+{
+	if (js_gameobject_class_id == 0)
+	{
+		WZ_QJS_NewClassID(rt, &js_gameobject_class_id);
+		WZ_QJS_NewClassID(rt, &js_research_class_id);
+	}
+	JSClassDef gameObjectClass = {};
+	gameObjectClass.class_name = "WzGameObject";
+	gameObjectClass.finalizer = js_gameobject_finalizer;
+	JS_NewClass(rt, js_gameobject_class_id, &gameObjectClass);
+	JSClassDef researchClass = {};
+	researchClass.class_name = "WzResearch";
+	researchClass.finalizer = js_research_finalizer;
+	JS_NewClass(rt, js_research_class_id, &researchClass);
+
+	for (int type = 0; type < OBJ_NUM_TYPES; ++type)
+	{
+		gameObjectPrototypes[type] = JS_UNDEFINED;
+	}
+	gameObjectPrototypes[OBJ_DROID] = newObjectPrototype(ctx, {&baseObjectProperties, &droidProperties}, js_gameobject_get);
+	gameObjectPrototypes[OBJ_STRUCTURE] = newObjectPrototype(ctx, {&baseObjectProperties, &structureProperties}, js_gameobject_get);
+	gameObjectPrototypes[OBJ_FEATURE] = newObjectPrototype(ctx, {&baseObjectProperties, &featureProperties}, js_gameobject_get);
+	researchProto = newObjectPrototype(ctx, {&researchProperties}, js_research_get);
+
+	objectSnapshots = getenv("WZ_JS_OBJECT_SNAPSHOTS") != nullptr;
+}
+
+void quickjs_scripting_instance::freeObjectPrototypes()
+{
+	for (int type = 0; type < OBJ_NUM_TYPES; ++type)
+	{
+		JS_FreeValue(ctx, gameObjectPrototypes[type]);
+		gameObjectPrototypes[type] = JS_UNDEFINED;
+	}
+	JS_FreeValue(ctx, researchProto);
+	researchProto = JS_UNDEFINED;
+}
+
+void quickjs_scripting_instance::forgetGameObjectProxy(uint32_t id, JSValue obj)
+{
+	auto range = gameObjectProxies.equal_range(id);
+	for (auto it = range.first; it != range.second; ++it)
+	{
+		if (JS_VALUE_GET_PTR(it->second) == JS_VALUE_GET_PTR(obj))
+		{
+			gameObjectProxies.erase(it);
+			return;
+		}
+	}
+}
+
+void quickjs_scripting_instance::objectRemoved(const BASE_OBJECT *psObj)
+{
+	auto range = gameObjectProxies.equal_range(psObj->id);
+	if (range.first == range.second)
+	{
+		return;
+	}
+	// Hold on to the proxies first: defining properties may run the garbage collector, which finalizes proxies
+	std::vector<JSValue> proxies;
+	for (auto it = range.first; it != range.second;)
+	{
+		auto *proxy = static_cast<GameObjectProxy *>(JS_GetOpaque(it->second, js_gameobject_class_id));
+		if (proxy != nullptr && proxy->type == psObj->type)
+		{
+			proxy->registered = false;
+			proxy->psObj = nullptr;
+			proxies.push_back(JS_DupValue(ctx, it->second));
+			it = gameObjectProxies.erase(it);
+		}
+		else
+		{
+			++it;
+		}
+	}
+	// Scripts holding on to the object keep its last values, as they would have with a snapshot
+	const ObjectWeaponInfo weapons = objectWeaponInfo(psObj);
+	for (JSValue proxy : proxies)
+	{
+		defineGameObjectProperties(ctx, proxy, psObj, baseObjectProperties, weapons, false);
+		defineGameObjectProperties(ctx, proxy, psObj, objectTypeProperties(psObj->type), weapons, false);
+		JS_FreeValue(ctx, proxy);
+	}
+}
+
 //;; ## Template
 //;;
 //;; Describes a template type. Templates are droid designs that a player has created.
@@ -1673,6 +2203,13 @@ JSValue convMax(const BASE_OBJECT *psObj, JSContext *ctx)
 }
 
 // Call a function by name
+/// Events run the code of any instance, which may only happen on the main thread (see js_concurrentApiCall)
+static bool mayRaiseEvent(const std::string &event)
+{
+	ASSERT_OR_RETURN(false, scripting_engine::concurrentBatchSlot() < 0, "Event %s raised from a concurrently running AI timer", event.c_str());
+	return true;
+}
+
 static JSValue callFunction(JSContext *ctx, const std::string &function, std::vector<JSValue> &args, bool event = true)
 {
 	const auto instance = engineToInstanceMap.at(ctx);
@@ -2739,6 +3276,10 @@ static JSValue callFunction(JSContext *ctx, const std::string &function, std::ve
 		template <typename... Args>
 		bool wrap_event_handler__(const std::string &functionName, JSContext *context, Args&&... args)
 		{
+			if (!mayRaiseEvent(functionName))
+			{
+				return false;
+			}
 			std::vector<JSValue> args_list;
 			using expander = int[];
 //			WZ_DECL_UNUSED int dummy[] = { 0, ((void) append_value_list(args_list, std::forward<Args>(args), engine),0)... };
@@ -2854,6 +3395,42 @@ static std::string QuickJS_DumpError(JSContext *ctx)
 	return result;
 }
 
+// Compiles `source` as a global script, or reads the bytecode compiled from it earlier from the script bytecode cache
+static JSValue QuickJS_CompileScript(JSContext *ctx, const char *source, size_t sourceSize, const std::string &filename)
+{
+	const Sha256 key = scriptBytecodeKey(WZ_QJS_ENGINE_NAME, filename, source, sourceSize);
+	if (ScriptBytecode bytecode = scriptBytecodeFind(key))
+	{
+		JSValue compiled = JS_ReadObject(ctx, bytecode->data(), bytecode->size(), JS_READ_OBJ_BYTECODE);
+		if (!JS_IsException(compiled))
+		{
+			return compiled;
+		}
+		std::string errorAsString = QuickJS_DumpError(ctx);
+		debug(LOG_SCRIPT, "Could not read cached bytecode of %s, compiling it: %s", filename.c_str(), errorAsString.c_str());
+		scriptBytecodeForget(key);
+	}
+
+	JSValue compiled = JS_Eval_BypassLimitedContext(ctx, source, sourceSize, filename.c_str(), JS_EVAL_TYPE_GLOBAL | JS_EVAL_FLAG_COMPILE_ONLY);
+	if (JS_IsException(compiled))
+	{
+		return compiled;
+	}
+	size_t size = 0;
+	uint8_t *written = JS_WriteObject(ctx, &size, compiled, JS_WRITE_OBJ_BYTECODE);
+	if (written)
+	{
+		scriptBytecodeStore(key, std::vector<uint8_t>(written, written + size));
+		js_free(ctx, written);
+	}
+	else
+	{
+		std::string errorAsString = QuickJS_DumpError(ctx);
+		debug(LOG_SCRIPT, "Could not write bytecode of %s: %s", filename.c_str(), errorAsString.c_str());
+	}
+	return compiled;
+}
+
 //-- ## include(filePath)
 //--
 //-- Includes another source code file at this point. You should generally only specify the filename,
@@ -2875,7 +3452,7 @@ static JSValue js_include(JSContext *ctx, JSValueConst this_val, int argc, JSVal
 		JS_ThrowReferenceError(ctx, "Failed to read include file \"%s\"", filePath.c_str());
 		return JS_FALSE;
 	}
-	JSValue compiledFuncObj = JS_Eval_BypassLimitedContext(ctx, bytes, size, loadedFilePath.c_str(), JS_EVAL_TYPE_GLOBAL | JS_EVAL_FLAG_COMPILE_ONLY);
+	JSValue compiledFuncObj = QuickJS_CompileScript(ctx, bytes, size, loadedFilePath);
 	free(bytes);
 	if (JS_IsException(compiledFuncObj))
 	{
@@ -2950,6 +3527,18 @@ public:
 	{ }
 };
 
+/// The object of a timer as an argument of its function. The timers of an instance that runs concurrently
+/// are called on a worker, where the object is read under the batch mutex like any other read of the game.
+static JSValue timerObjectArgument(BASE_OBJECT *psObj, JSContext *ctx)
+{
+	if (scripting_engine::concurrentBatchSlot() < 0)
+	{
+		return convMax(psObj, ctx);
+	}
+	std::lock_guard<std::mutex> guard(scripting_engine::instance().concurrentBatchMutex());
+	return convMax(psObj, ctx);
+}
+
 static uniqueTimerID SetQuickJSTimer(JSContext *ctx, int player, const std::string& funcName, int32_t ms, const std::string& stringArg, BASE_OBJECT *psObj, timerType type)
 {
 	return scripting_engine::instance().setTimer(engineToInstanceMap.at(ctx)
@@ -2959,7 +3548,7 @@ static uniqueTimerID SetQuickJSTimer(JSContext *ctx, int player, const std::stri
 		std::vector<JSValue> args;
 		if (baseObject != nullptr)
 		{
-			args.push_back(convMax(baseObject, ctx));
+			args.push_back(timerObjectArgument(baseObject, ctx));
 		}
 		else if (pData && !(pData->stringArg.empty()))
 		{
@@ -3140,6 +3729,23 @@ static JSValue js_namespace(JSContext *ctx, JSValueConst this_val, int argc, JSV
 	return JS_TRUE;
 }
 
+//-- ## setObjectSnapshots(enabled)
+//--
+//-- Droids, structures, features and research items returned after this call are plain objects holding
+//-- their values at the time they were returned, instead of reading them from the game when the script
+//-- reads them. This is slower, but gives scripts that compare an old copy of an object with a new one
+//-- what they expect. Setting the ```WZ_JS_OBJECT_SNAPSHOTS``` environment variable enables it for all scripts.
+//-- AIs whose timers run concurrently always get snapshots.
+//--
+static JSValue js_setObjectSnapshots(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv)
+{
+	SCRIPT_ASSERT(ctx, argc == 1, "Must have one parameter");
+	auto instance = engineToInstanceMap.at(ctx);
+	// A proxy reads the game whenever the script looks at it, which a concurrent instance may not do
+	instance->objectSnapshots = instance->runsConcurrently() || JS_ToBool(ctx, argv[0]);
+	return JS_TRUE;
+}
+
 static JSValue debugGetCallerFuncObject(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv)
 {
 	return js_debugger_get_caller_funcObject(ctx);
@@ -3172,10 +3778,15 @@ static JSValue debugGetBacktrace(JSContext *ctx, JSValueConst this_val, int argc
 	return js_debugger_build_backtrace(ctx, nullptr);
 }
 
-wzapi::scripting_instance* createQuickJSScriptInstance(const WzString& path, int player, int difficulty)
+wzapi::scripting_instance* createQuickJSScriptInstance(const WzString& path, int player, int difficulty, bool concurrent)
 {
 	WzPathInfo basename = WzPathInfo::fromPlatformIndependentPath(path.toUtf8());
 	quickjs_scripting_instance* pNewInstance = new quickjs_scripting_instance(player, basename.baseName(), basename.path());
+	pNewInstance->setRunsConcurrently(concurrent);
+	if (concurrent)
+	{
+		pNewInstance->objectSnapshots = true;
+	}
 	if (!pNewInstance->loadScript(path, player, difficulty))
 	{
 		delete pNewInstance;
@@ -3233,6 +3844,7 @@ static const JSCFunctionListEntry js_builtin_funcs[] = {
 	QJS_CFUNC_DEF("include", 1, js_include ), // backend-specific (a scripting_instance can't directly include a different type of script)
 	QJS_CFUNC_DEF("includeJSON", 1, js_includeJSON ), // JS-specific JSON loading
 	QJS_CFUNC_DEF("namespace", 1, js_namespace ), // JS-specific implementation
+	QJS_CFUNC_DEF("setObjectSnapshots", 1, js_setObjectSnapshots ), // backend-specific
 	QJS_CFUNC_DEF("debugGetCallerFuncObject", 0, debugGetCallerFuncObject ), // backend-specific
 	QJS_CFUNC_DEF("debugGetCallerFuncName", 0, debugGetCallerFuncName ), // backend-specific
 	QJS_CFUNC_DEF("debugGetBacktrace", 0, debugGetBacktrace ) // backend-specific
@@ -3252,7 +3864,7 @@ bool quickjs_scripting_instance::loadScript(const WzString& path, int player, in
 		calcDataHash(reinterpret_cast<const uint8_t *>(bytes), size, DATA_SCRIPT);
 	}
 	m_path = path.toUtf8();
-	compiledScriptObj = JS_Eval_BypassLimitedContext(ctx, bytes, size, path.toUtf8().c_str(), JS_EVAL_TYPE_GLOBAL | JS_EVAL_FLAG_COMPILE_ONLY);
+	compiledScriptObj = QuickJS_CompileScript(ctx, bytes, size, m_path);
 	free(bytes);
 	if (JS_IsException(compiledScriptObj))
 	{
@@ -3266,7 +3878,18 @@ bool quickjs_scripting_instance::loadScript(const WzString& path, int player, in
 	}
 
 	// Special functions
-	JS_SetPropertyFunctionList(ctx, global_obj, js_builtin_funcs, sizeof(js_builtin_funcs) / sizeof(js_builtin_funcs[0]));
+	if (runsConcurrently())
+	{
+		for (const auto &entry : js_builtin_funcs)
+		{
+			JSValue newFunc = newApiFunction(entry.u.func.cfunc.generic, entry.name, entry.u.func.length);
+			JS_DefinePropertyValueStr(ctx, global_obj, entry.name, newFunc, JS_PROP_WRITABLE | JS_PROP_CONFIGURABLE);
+		}
+	}
+	else
+	{
+		JS_SetPropertyFunctionList(ctx, global_obj, js_builtin_funcs, sizeof(js_builtin_funcs) / sizeof(js_builtin_funcs[0]));
+	}
 
 	// Regular functions
 	WzPathInfo basename = WzPathInfo::fromPlatformIndependentPath(path.toUtf8());
@@ -3445,7 +4068,7 @@ std::tuple<TimerFunc, std::unique_ptr<timerAdditionalData>> quickjs_scripting_in
 			std::vector<JSValue> args;
 			if (baseObject != nullptr)
 			{
-				args.push_back(convMax(baseObject, pContext));
+				args.push_back(timerObjectArgument(baseObject, pContext));
 			}
 			else if (pData && !(pData->stringArg.empty()))
 			{
@@ -3637,9 +4260,13 @@ IMPL_EVENT_HANDLER(eventBeaconRemoved, int, int)
 IMPL_EVENT_HANDLER(eventGroupLoss, const BASE_OBJECT *, int, int)
 bool quickjs_scripting_instance::handle_eventArea(const std::string& label, const DROID *psDroid)
 {
+	std::string funcname = std::string("eventArea") + label;
+	if (!mayRaiseEvent(funcname))
+	{
+		return false;
+	}
 	std::vector<JSValue> args;
 	args.push_back(convDroid(psDroid, ctx));
-	std::string funcname = std::string("eventArea") + label;
 	debug(LOG_SCRIPT, "Triggering %s for %s", funcname.c_str(), scriptName().c_str());
 	callFunction(ctx, funcname, args);
 	std::for_each(args.begin(), args.end(), [this](JSValue& val) { JS_FreeValue(ctx, val); });
@@ -3986,9 +4613,173 @@ JSValue constructUpgradesQuickJSValue(JSContext *ctx)
 	return upgrades;
 }
 
+// MARK: Concurrent AI timers
+//
+// The API functions of an instance that runs concurrently (see scripting_engine::runConcurrentTimers) all
+// go through js_concurrentApiCall, which looks at what a function does to decide how to make the call
+// while the instance's timers run on a worker. Outside of that (events, and everything on the main thread)
+// the call is made directly, as for any other instance.
+//
+// Nothing changes the game while a batch runs, so every read sees the game as it was when the batch
+// started, however the workers are scheduled. Calls that change the game (and may fire events into other
+// instances) are recorded in the instance's command buffer instead, and made on the main thread in player
+// order once every instance is done.
+
+enum class ConcurrentCall
+{
+	Local,    ///< only touches the instance's own JS state: called directly
+	Read,     ///< reads the game, or changes only the instance's own engine state: called at once, under the batch mutex
+	Ordered,  ///< changes nothing other instances can read, but its outcome depends on the order of the calls of all instances: called in the instance's turn
+	Deferred, ///< changes the game: recorded, and called on the main thread once every instance is done; returns true
+	Refused,  ///< returns a new game object, which cannot exist before the call is made: throws
+};
+
+struct ConcurrentApiFunction
+{
+	std::string name;
+	JSCFunction *func;
+	ConcurrentCall kind;
+};
+
+/// Indexed by the magic of the script functions. Only added to when loading an instance, never during a batch.
+static std::vector<ConcurrentApiFunction> concurrentApiFunctions;
+static std::unordered_map<std::string, int> concurrentApiFunctionIndex;
+
+static ConcurrentCall concurrentCallKind(const std::string &name)
+{
+	static const std::unordered_set<std::string> localFunctions = {
+		"profile", "include", "includeJSON", "namespace", "setObjectSnapshots",
+		"debugGetCallerFuncObject", "debugGetCallerFuncName", "debugGetBacktrace",
+	};
+	static const std::unordered_set<std::string> readFunctions = {
+		"_", "allianceExistsBetween", "componentAvailable", "countDroid", "countStruct", "debug",
+		"distBetweenTwoPoints", "droidCanReach", "dump", "enumArea", "enumBlips", "enumCargo", "enumDroid",
+		"enumFeature", "enumGateways", "enumGroup", "enumLabels", "enumRange", "enumResearch", "enumSelected",
+		"enumStruct", "enumStructOffWorld", "enumTemplates", "findResearch", "getDroidLimit", "getDroidPath",
+		"getDroidProduction", "getExperienceModifier", "getLabel", "getMissionTime", "getMissionType",
+		"getMultiTechLevel", "getObject", "getResearch", "getRevealStatus", "getScrollLimits",
+		"getStructureLimit", "getWeaponInfo", "groupAdd", "groupAddArea", "groupAddDroid", "groupSize",
+		"hackAssert", "hackDoNotSave", "hackGetObj", "isSpectator", "isStructureAvailable", "isVTOL", "label",
+		"makeTemplate", "newGroup", "pickStructLocation", "playerPower", "propulsionCanReach", "queuedPower",
+		"receiveAllEvents", "safeDest", "structureCanFit", "structureIdle", "terrainType", "tileIsBurning",
+	};
+	static const std::unordered_set<std::string> orderedFunctions = {
+		"syncRandom", "setTimer", "queue", "removeTimer",
+	};
+	// Cheats and campaign functions; the skirmish AIs that run concurrently do not use them
+	static const std::unordered_set<std::string> refusedFunctions = {
+		"addDroid", "addFeature", "addSpotter", "addStructure",
+	};
+	if (localFunctions.count(name))
+	{
+		return ConcurrentCall::Local;
+	}
+	if (readFunctions.count(name))
+	{
+		return ConcurrentCall::Read;
+	}
+	if (orderedFunctions.count(name))
+	{
+		return ConcurrentCall::Ordered;
+	}
+	if (refusedFunctions.count(name))
+	{
+		return ConcurrentCall::Refused;
+	}
+	return ConcurrentCall::Deferred;
+}
+
+static JSValue js_concurrentApiCall(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv, int magic)
+{
+	const ConcurrentApiFunction &function = concurrentApiFunctions[magic];
+	if (scripting_engine::concurrentBatchSlot() < 0)
+	{
+		return function.func(ctx, this_val, argc, argv);
+	}
+	switch (function.kind)
+	{
+		case ConcurrentCall::Local:
+			return function.func(ctx, this_val, argc, argv);
+		case ConcurrentCall::Ordered:
+			scripting_engine::instance().waitForConcurrentBatchTurn();
+			// fall through
+		case ConcurrentCall::Read:
+		{
+			std::lock_guard<std::mutex> guard(scripting_engine::instance().concurrentBatchMutex());
+			return function.func(ctx, this_val, argc, argv);
+		}
+		case ConcurrentCall::Deferred:
+			engineToInstanceMap.at(ctx)->deferCall(magic, argc, argv);
+			return JS_TRUE;
+		case ConcurrentCall::Refused:
+			return JS_ThrowTypeError(ctx, "%s() cannot be called from a concurrently running timer", function.name.c_str());
+	}
+	return JS_UNDEFINED; // silence compiler warning
+}
+
+JSValue quickjs_scripting_instance::newApiFunction(JSCFunction *func, const char *name, int length)
+{
+	if (!runsConcurrently())
+	{
+		return JS_NewCFunction(ctx, func, name, length);
+	}
+	auto it = concurrentApiFunctionIndex.find(name);
+	if (it == concurrentApiFunctionIndex.end())
+	{
+		ASSERT_OR_RETURN(JS_EXCEPTION, concurrentApiFunctions.size() < INT16_MAX, "Too many API functions");
+		concurrentApiFunctions.push_back(ConcurrentApiFunction{name, func, concurrentCallKind(name)});
+		it = concurrentApiFunctionIndex.emplace(name, static_cast<int>(concurrentApiFunctions.size() - 1)).first;
+	}
+	ASSERT(concurrentApiFunctions[it->second].func == func, "API function %s registered with different implementations", name);
+	return JS_NewCFunctionMagic(ctx, js_concurrentApiCall, name, length, JS_CFUNC_generic_magic, it->second);
+}
+
+void quickjs_scripting_instance::enterThread()
+{
+	// The stack limit check measures against the stack of the thread that last set it
+	JS_UpdateStackTop(rt);
+}
+
+void quickjs_scripting_instance::deferCall(int function, int argc, JSValueConst *argv)
+{
+	DeferredCall call;
+	call.function = function;
+	for (int i = 0; i < argc; ++i)
+	{
+		call.args.push_back(JS_DupValue(ctx, argv[i]));
+	}
+	deferredCalls.push_back(std::move(call));
+}
+
+void quickjs_scripting_instance::applyDeferredCalls()
+{
+	std::vector<DeferredCall> calls = std::move(deferredCalls);
+	deferredCalls.clear();
+	for (auto &call : calls)
+	{
+		const ConcurrentApiFunction &function = concurrentApiFunctions[call.function];
+		JSValue result = function.func(ctx, JS_UNDEFINED, static_cast<int>(call.args.size()), call.args.data());
+		if (JS_IsException(result))
+		{
+			std::string errorAsString = QuickJS_DumpError(ctx);
+			debug(LOG_ERROR, "[%d]:%s: deferred call of %s failed: %s", player(), scriptName().c_str(), function.name.c_str(), errorAsString.c_str());
+		}
+		else if (JS_IsBool(result) && !JS_ToBool(ctx, result))
+		{
+			// The script was told the call succeeded when it was recorded
+			debug(LOG_SCRIPT, "[%d]:%s: deferred call of %s returned false", player(), scriptName().c_str(), function.name.c_str());
+		}
+		JS_FreeValue(ctx, result);
+		for (JSValue arg : call.args)
+		{
+			JS_FreeValue(ctx, arg);
+		}
+	}
+}
+
 #define JS_REGISTER_FUNC(js_func_name, num_parameters) \
 { \
-	JSValue newFunc = JS_NewCFunction(ctx, JS_FUNC_IMPL_NAME(js_func_name), #js_func_name, num_parameters); \
+	JSValue newFunc = newApiFunction(JS_FUNC_IMPL_NAME(js_func_name), #js_func_name, num_parameters); \
 	ASSERT_OR_RETURN(false, !JS_IsException(newFunc), "Failure to create function: %s", #js_func_name); \
 	int setRes = JS_SetPropertyStr(ctx, global_obj, #js_func_name, newFunc); \
 	ASSERT_OR_RETURN(false, setRes == 1, "Failure to register function property: %s", #js_func_name); \
@@ -3996,7 +4787,7 @@ JSValue constructUpgradesQuickJSValue(JSContext *ctx)
 
 #define JS_REGISTER_FUNC2(js_func_name, min_num_parameters, max_num_parameters) \
 { \
-	JSValue newFunc = JS_NewCFunction(ctx, JS_FUNC_IMPL_NAME(js_func_name), #js_func_name, min_num_parameters); \
+	JSValue newFunc = newApiFunction(JS_FUNC_IMPL_NAME(js_func_name), #js_func_name, min_num_parameters); \
 	ASSERT_OR_RETURN(false, !JS_IsException(newFunc), "Failure to create function: %s", #js_func_name); \
 	int setRes = JS_SetPropertyStr(ctx, global_obj, #js_func_name, newFunc); \
 	ASSERT_OR_RETURN(false, setRes == 1, "Failure to register function property: %s", #js_func_name); \
@@ -4004,7 +4795,7 @@ JSValue constructUpgradesQuickJSValue(JSContext *ctx)
 
 #define JS_REGISTER_FUNC_NAME(js_func_name, num_parameters, full_impl_handler_func_name) \
 { \
-	JSValue newFunc = JS_NewCFunction(ctx, full_impl_handler_func_name, #js_func_name, num_parameters); \
+	JSValue newFunc = newApiFunction(full_impl_handler_func_name, #js_func_name, num_parameters); \
 	ASSERT_OR_RETURN(false, !JS_IsException(newFunc), "Failure to create function: %s", #js_func_name); \
 	int setRes = JS_SetPropertyStr(ctx, global_obj, #js_func_name, newFunc); \
 	ASSERT_OR_RETURN(false, setRes == 1, "Failure to register function property: %s", #js_func_name); \
@@ -4012,7 +4803,7 @@ JSValue constructUpgradesQuickJSValue(JSContext *ctx)
 
 #define JS_REGISTER_FUNC_NAME2(js_func_name, min_num_parameters, max_num_parameters, full_impl_handler_func_name) \
 { \
-	JSValue newFunc = JS_NewCFunction(ctx, full_impl_handler_func_name, #js_func_name, min_num_parameters); \
+	JSValue newFunc = newApiFunction(full_impl_handler_func_name, #js_func_name, min_num_parameters); \
 	ASSERT_OR_RETURN(false, !JS_IsException(newFunc), "Failure to create function: %s", #js_func_name); \
 	int setRes = JS_SetPropertyStr(ctx, global_obj, #js_func_name, newFunc); \
 	ASSERT_OR_RETURN(false, setRes == 1, "Failure to register function property: %s", #js_func_name); \
@@ -4267,6 +5058,12 @@ nlohmann::ordered_json wz_qjs_to_json(JSToJsonContext &c, JSValue value)
 		nlohmann::ordered_json j;
 		c.stack.push_back(value);
 
+		// Game object and research proxies read most properties through their prototype: serialize a plain snapshot
+		// of them instead (references still point at the proxy itself)
+		JSValue snapshot = QuickJS_ObjectProxySnapshot(c.ctx, value);
+		auto free_snapshot = gsl::finally([&c, snapshot] { JS_FreeValue(c.ctx, snapshot); });
+		JSValue source = JS_IsUninitialized(snapshot) ? value : snapshot;
+
 		if (c.tag_class_instances)
 		{
 			// Assign a reference id *before* recursing into children, so that cyclic or
@@ -4326,16 +5123,16 @@ nlohmann::ordered_json wz_qjs_to_json(JSToJsonContext &c, JSValue value)
 			}
 			else
 			{
-				std::string className = getSerializableClassName(c, value);
+				std::string className = getSerializableClassName(c, source);
 				nlohmann::ordered_json data = nlohmann::ordered_json::object();
-				QuickJS_EnumerateObjectProperties(c.ctx, value, [&c, value, &data](const char *key, JSAtom &atom) {
-					if (isOwnAccessorProperty(c.ctx, value, atom))
+				QuickJS_EnumerateObjectProperties(c.ctx, source, [&c, source, &data](const char *key, JSAtom &atom) {
+					if (isOwnAccessorProperty(c.ctx, source, atom))
 					{
 						// can't serialize getter/setter closures
 						debug(LOG_SCRIPT, "Skipping own accessor property \"%s\" when saving script global: getter/setter closures cannot be serialized", key);
 						return;
 					}
-					JSValue jsVal = JS_GetProperty(c.ctx, value, atom);
+					JSValue jsVal = JS_GetProperty(c.ctx, source, atom);
 					std::string nameStr = key;
 					if (!JS_IsException(jsVal))
 					{
@@ -4365,7 +5162,7 @@ nlohmann::ordered_json wz_qjs_to_json(JSToJsonContext &c, JSValue value)
 					// Warn script authors when a built-in exotic object (Map/Set/Date/...) is
 					// being saved: its internal state lives in internal slots, not own
 					// properties, so it degrades to an (essentially empty) plain object.
-					std::string builtinName = getBuiltinExoticClassName(c, value);
+					std::string builtinName = getBuiltinExoticClassName(c, source);
 					if (!builtinName.empty())
 					{
 						debug(LOG_SCRIPT, "Cannot fully save script global of built-in type \"%s\": its internal state is not serializable; it will be restored as a plain object (%zu own propert%s preserved)", builtinName.c_str(), static_cast<size_t>(data.size()), (data.size() == 1) ? "y" : "ies");
@@ -4394,8 +5191,8 @@ nlohmann::ordered_json wz_qjs_to_json(JSToJsonContext &c, JSValue value)
 		{
 			// Legacy bare object
 			j = nlohmann::ordered_json::object();
-			QuickJS_EnumerateObjectProperties(c.ctx, value, [&c, value, &j](const char *key, JSAtom &atom) {
-				JSValue jsVal = JS_GetProperty(c.ctx, value, atom);
+			QuickJS_EnumerateObjectProperties(c.ctx, source, [&c, source, &j](const char *key, JSAtom &atom) {
+				JSValue jsVal = JS_GetProperty(c.ctx, source, atom);
 				std::string nameStr = key;
 				if (!JS_IsException(jsVal))
 				{
@@ -23,7 +23,7 @@
 #include "lib/framework/frame.h"
 #include "qtscript.h"
 
-wzapi::scripting_instance* createQuickJSScriptInstance(const WzString& path, int player, int difficulty);
+wzapi::scripting_instance* createQuickJSScriptInstance(const WzString& path, int player, int difficulty, bool concurrent);
 ScriptMapData runMapScript_QuickJS(WzString const &path, uint64_t seed, bool preview);
 
 #endif
@@ -0,0 +1,72 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+	This file is part of Warzone 2100.
+	Copyright (C) 2026  Warzone 2100 Project (https://github.com/Warzone2100)
+
+	Warzone 2100 is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	Warzone 2100 is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Warzone 2100; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+/** \file
+ *  Script bytecode cache (see quickjs_bytecode_cache.h).
+ */
+
+#include "quickjs_bytecode_cache.h"
+
+#include <mutex>
+#include <unordered_map>
+
+namespace
+{
+
+std::mutex cacheMutex;
+std::unordered_map<Sha256, ScriptBytecode> memoryCache; ///< guarded by cacheMutex
+
+} // namespace
+
+Sha256 scriptBytecodeKey(const std::string &engine, const std::string &filename, const void *source, size_t sourceSize)
+{
+	std::string key = engine;
+	key += '\0';
+	key += filename;
+	key += '\0';
+	const Sha256 sourceHash = sha256Sum(source, sourceSize);
+	key.append(reinterpret_cast<const char *>(sourceHash.bytes), Sha256::Bytes);
+	return sha256Sum(key.data(), key.size());
+}
+
+ScriptBytecode scriptBytecodeFind(const Sha256 &key)
+{
+	std::lock_guard<std::mutex> guard(cacheMutex);
+	auto it = memoryCache.find(key);
+	return it != memoryCache.end() ? it->second : nullptr;
+}
+
+void scriptBytecodeStore(const Sha256 &key, std::vector<uint8_t> &&bytecode)
+{
+	std::lock_guard<std::mutex> guard(cacheMutex);
+	memoryCache[key] = std::make_shared<const std::vector<uint8_t>>(std::move(bytecode));
+}
+
+void scriptBytecodeForget(const Sha256 &key)
+{
+	std::lock_guard<std::mutex> guard(cacheMutex);
+	memoryCache.erase(key);
+}
+
+void scriptBytecodeCacheClear()
+{
+	std::lock_guard<std::mutex> guard(cacheMutex);
+	memoryCache.clear();
+}
@@ -0,0 +1,57 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+	This file is part of Warzone 2100.
+	Copyright (C) 2026  Warzone 2100 Project (https://github.com/Warzone2100)
+
+	Warzone 2100 is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	Warzone 2100 is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Warzone 2100; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+/** \file
+ *  Cache of compiled script bytecode.
+ *
+ *  Every script instance compiles its main file and everything it includes, so ten copies of one AI
+ *  compile the same sources ten times. The cache keeps the bytecode the JS backend wrote for a file,
+ *  keyed by the file name, a hash of its source and the engine that compiled it, in memory until the
+ *  scripts are shut down. It is never written to disk: the engine runs bytecode it reads back without
+ *  checking it, so bytecode must only ever come from this process.
+ *  The cache only stores bytes; reading and writing bytecode is up to the backend.
+ */
+#pragma once
+
+#include "lib/framework/crc.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+typedef std::shared_ptr<const std::vector<uint8_t>> ScriptBytecode;
+
+/// Key of the bytecode of `source`, compiled from the file `filename` by `engine` (which must name the
+/// bytecode format, e.g. the JS engine and its version). Thread-safe.
+Sha256 scriptBytecodeKey(const std::string &engine, const std::string &filename, const void *source, size_t sourceSize);
+
+/// The cached bytecode for `key`, or nullptr. Thread-safe.
+ScriptBytecode scriptBytecodeFind(const Sha256 &key);
+
+/// Stores the bytecode for `key`. Thread-safe.
+void scriptBytecodeStore(const Sha256 &key, std::vector<uint8_t> &&bytecode);
+
+/// Drops `key`, for bytecode the backend could not read back. Thread-safe.
+void scriptBytecodeForget(const Sha256 &key);
+
+/// Drops everything. Called when the scripts are shut down.
+void scriptBytecodeCacheClear();
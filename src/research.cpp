@@ -25,6 +25,7 @@
  */
 #include <string.h>
 #include <map>
+#include <bit>
 
 #include "lib/framework/frame.h"
 #include "lib/netplay/sync_debug.h"
@@ -50,6 +51,7 @@
 
 // The stores for the research stats
 std::vector<RESEARCH> asResearch;
+static std::vector<int> researchIndexByAtom; ///< index into asResearch for each research atom, or -1
 optional<ResearchUpgradeCalculationMode> researchUpgradeCalcMode;
 std::unordered_map<WzString, std::vector<size_t>> resCategories;
 nlohmann::json cachedStatsObject = nlohmann::json(nullptr);
@@ -89,7 +91,6 @@ std::vector<PlayerUpgradeCounts> playerUpgradeCounts;
 static UWORD setIconID(const char *pIconName, const char *pName);
 static void replaceComponent(COMPONENT_STATS *pNewComponent, COMPONENT_STATS *pOldComponent,
                              UBYTE player);
-static bool checkResearchName(RESEARCH *psRes, UDWORD numStats);
 
 //flag that indicates whether the player can self repair
 static UBYTE bSelfRepair[MAX_PLAYERS];
@@ -103,6 +104,129 @@ static void switchComponent(DROID *psDroid, UDWORD oldType, UDWORD oldCompInc,
 static void replaceTransDroidComponents(DROID *psTransporter, UDWORD oldType,
                                         UDWORD oldCompInc, UDWORD newCompInc);
 
+/*
+Per-player index of the topics researchAvailable() may return true for, so listing the available
+research only checks those and not every topic with all its pre-requisites.
+
+A topic is "open" if it is cancelled, or if it is neither completed nor disabled and is either
+possible or has all its pre-requisites completed. That only changes when research completes, is
+cancelled or is made possible, which update the topics involved. Whether a topic is started, or its
+structures are built, changes far more often and is still checked by researchAvailable(). Loading a
+game or the research stats rewrites everything, so those just rebuild the index on its next use.
+*/
+struct ResearchAvailabilityIndex
+{
+	std::vector<uint16_t> missingPrereqs;  ///< number of pre-requisites of each topic that are not completed
+	std::vector<uint64_t> counted;         ///< bit per topic, set once its completion is in missingPrereqs
+	std::vector<uint64_t> open;            ///< bit per open topic
+	bool valid = false;
+};
+static ResearchAvailabilityIndex researchAvailability[MAX_PLAYERS];
+static std::vector<std::vector<uint16_t>> researchDependants;  ///< topics that have each topic as a pre-requisite
+
+static inline bool testTopicBit(const std::vector<uint64_t> &bits, size_t topic)
+{
+	return (bits[topic / 64] >> (topic % 64)) & 1;
+}
+
+static inline void setTopicBit(std::vector<uint64_t> &bits, size_t topic, bool value)
+{
+	const uint64_t mask = uint64_t(1) << (topic % 64);
+	bits[topic / 64] = value ? (bits[topic / 64] | mask) : (bits[topic / 64] & ~mask);
+}
+
+static bool researchTopicOpen(const PLAYER_RESEARCH &playerRes, const RESEARCH &research, uint16_t missingPrereqs)
+{
+	if (playerRes.ResearchStatus & (CANCELLED_RESEARCH | CANCELLED_RESEARCH_PENDING))
+	{
+		return true;
+	}
+	if (IsResearchDisabled(&playerRes) || IsResearchCompleted(&playerRes))
+	{
+		return false;
+	}
+	return IsResearchPossible(&playerRes) || (!research.pPRList.empty() && missingPrereqs == 0);
+}
+
+static void rebuildResearchAvailability(unsigned player)
+{
+	ResearchAvailabilityIndex &index = researchAvailability[player];
+	const std::vector<PLAYER_RESEARCH> &playerResList = asPlayerResList[player];
+	const size_t numTopics = std::min(asResearch.size(), playerResList.size());
+
+	if (researchDependants.size() != asResearch.size())
+	{
+		researchDependants.assign(asResearch.size(), {});
+		for (size_t topic = 0; topic < asResearch.size(); ++topic)
+		{
+			for (UWORD prereq : asResearch[topic].pPRList)
+			{
+				researchDependants[prereq].push_back(static_cast<uint16_t>(topic));
+			}
+		}
+	}
+
+	index.missingPrereqs.assign(numTopics, 0);
+	index.counted.assign((numTopics + 63) / 64, 0);
+	index.open.assign((numTopics + 63) / 64, 0);
+	for (size_t topic = 0; topic < numTopics; ++topic)
+	{
+		for (UWORD prereq : asResearch[topic].pPRList)
+		{
+			if (prereq >= numTopics || !IsResearchCompleted(&playerResList[prereq]))
+			{
+				++index.missingPrereqs[topic];
+			}
+		}
+		if (IsResearchCompleted(&playerResList[topic]))
+		{
+			setTopicBit(index.counted, topic, true);
+		}
+	}
+	for (size_t topic = 0; topic < numTopics; ++topic)
+	{
+		setTopicBit(index.open, topic, researchTopicOpen(playerResList[topic], asResearch[topic], index.missingPrereqs[topic]));
+	}
+	index.valid = true;
+}
+
+void researchAvailabilityInvalidate()
+{
+	for (auto &index : researchAvailability)
+	{
+		index.valid = false;
+	}
+	researchDependants.clear();
+}
+
+void researchAvailabilityChanged(unsigned player, size_t topic)
+{
+	ASSERT_OR_RETURN(, player < MAX_PLAYERS, "Invalid player %u", player);
+	ResearchAvailabilityIndex &index = researchAvailability[player];
+	if (!index.valid || topic >= index.missingPrereqs.size())
+	{
+		return;
+	}
+	const PLAYER_RESEARCH &playerRes = asPlayerResList[player][topic];
+	if (IsResearchCompleted(&playerRes) && !testTopicBit(index.counted, topic))
+	{
+		setTopicBit(index.counted, topic, true);
+		for (uint16_t dependant : researchDependants[topic])
+		{
+			ASSERT_OR_RETURN(, index.missingPrereqs[dependant] > 0, "Research availability index out of sync");
+			--index.missingPrereqs[dependant];
+			setTopicBit(index.open, dependant, researchTopicOpen(asPlayerResList[player][dependant], asResearch[dependant], index.missingPrereqs[dependant]));
+		}
+	}
+	else if (!IsResearchCompleted(&playerRes) && testTopicBit(index.counted, topic))
+	{
+		// Only loading a game takes research back, rebuild rather than walking the dependants
+		index.valid = false;
+		return;
+	}
+	setTopicBit(index.open, topic, researchTopicOpen(playerRes, asResearch[topic], index.missingPrereqs[topic]));
+}
+
 
 bool researchInitVars()
 {
@@ -110,6 +234,8 @@ bool researchInitVars()
 	psCBLastResStructure = nullptr;
 	CBResFacilityOwner = -1;
 	asResearch.clear();
+	researchIndexByAtom.clear();
+	researchAvailabilityInvalidate();
 	researchUpgradeCalcMode = nullopt;
 	resCategories.clear();
 	cachedStatsObject = nlohmann::json(nullptr);
@@ -404,7 +530,8 @@ bool loadResearch(WzConfig &ini)
 		research.id = list[inc];
 
 		//check the name hasn't been used already
-		ASSERT_OR_RETURN(false, checkResearchName(&research, inc), "Research name '%s' used already", getStatsName(&research));
+		const StatAtom researchAtom = statAtomIntern(research.id.toUtf8());
+		ASSERT_OR_RETURN(false, getResearchFromAtom(researchAtom) == nullptr, "Research name '%s' used already", getStatsName(&research));
 
 		research.ref = STAT_RESEARCH + inc;
 
@@ -623,6 +750,11 @@ bool loadResearch(WzConfig &ini)
 			}
 		}
 
+		if (researchAtom >= researchIndexByAtom.size())
+		{
+			researchIndexByAtom.resize(researchAtom + 1, -1);
+		}
+		researchIndexByAtom[researchAtom] = static_cast<int>(asResearch.size());
 		asResearch.push_back(research);
 		ini.endGroup();
 	}
@@ -700,6 +832,7 @@ bool loadResearch(WzConfig &ini)
 		researchUpgradeCalcMode = ResearchUpgradeCalculationMode::Compat;
 	}
 
+	researchAvailabilityInvalidate();
 	return true;
 }
 
@@ -826,16 +959,33 @@ There can only be 'limit' number of entries
 std::vector<uint16_t> fillResearchList(UDWORD playerID, nonstd::optional<UWORD> topic, UWORD limit)
 {
 	std::vector<uint16_t> list;
+	ASSERT_OR_RETURN(list, playerID < MAX_PLAYERS, "Invalid player %u", playerID);
+
+	ResearchAvailabilityIndex &index = researchAvailability[playerID];
+	if (!index.valid)
+	{
+		rebuildResearchAvailability(playerID);
+	}
 
-	for (auto inc = 0; inc < asResearch.size(); inc++)
+	// Only open topics can be available, see ResearchAvailabilityIndex
+	for (size_t word = 0; word < index.open.size(); ++word)
 	{
+		uint64_t bits = index.open[word];
 		// if the inc matches the 'topic' - automatically add to the list
-		if ((topic.has_value() && inc == topic.value()) || researchAvailable(inc, playerID, ModeQueue))
+		if (topic.has_value() && topic.value() < index.missingPrereqs.size() && topic.value() / 64 == word)
+		{
+			bits |= uint64_t(1) << (topic.value() % 64);
+		}
+		for (; bits != 0; bits &= bits - 1)
 		{
-			list.push_back(inc);
-			if (list.size() == limit)
+			const size_t inc = word * 64 + std::countr_zero(bits);
+			if ((topic.has_value() && inc == topic.value()) || researchAvailable(inc, playerID, ModeQueue))
 			{
-				return list;
+				list.push_back(inc);
+				if (list.size() == limit)
+				{
+					return list;
+				}
 			}
 		}
 	}
@@ -1186,6 +1336,7 @@ void researchResult(UDWORD researchIndex, UBYTE player, bool bDisplay, STRUCTURE
 	syncDebug("researchResult(%u, %u, …)", researchIndex, player);
 
 	MakeResearchCompleted(&asPlayerResList[player][researchIndex]);
+	researchAvailabilityChanged(player, researchIndex);
 
 	//check for structures to be made available
 	for (unsigned short pStructureResult : pResearch->pStructureResults)
@@ -1296,6 +1447,8 @@ bool ResearchShutDown()
 void ResearchRelease()
 {
 	asResearch.clear();
+	researchIndexByAtom.clear();
+	researchAvailabilityInvalidate();
 	researchUpgradeCalcMode = nullopt;
 	resCategories.clear();
 	for (auto &i : asPlayerResList)
@@ -1412,6 +1565,7 @@ void cancelResearch(STRUCTURE *psBuilding, QUEUE_MODE mode)
 			sendResearchStatus(psBuilding, topicInc, psBuilding->player, false);
 			// Immediately tell the UI that we can research this now. (But don't change the game state.)
 			MakeResearchCancelledPending(pPlayerRes);
+			researchAvailabilityChanged(psBuilding->player, topicInc);
 			setStatusPendingCancel(*psResFac);
 			return;  // Wait for our message before doing anything. (Whatever this function does...)
 		}
@@ -1427,6 +1581,7 @@ void cancelResearch(STRUCTURE *psBuilding, QUEUE_MODE mode)
 			// Set the researched flag
 			MakeResearchCancelled(pPlayerRes);
 		}
+		researchAvailabilityChanged(psBuilding->player, topicInc);
 
 		// Initialise the research facility's subject
 		psResFac->psSubject = nullptr;
@@ -1626,14 +1781,20 @@ SDWORD	mapIconToRID(UDWORD iconID)
 //return a pointer to a research topic based on the name
 RESEARCH *getResearch(const char *pName)
 {
-	for (auto &inc : asResearch)
+	RESEARCH *psResearch = getResearchFromAtom(statAtomFind(pName));
+	if (!psResearch)
 	{
-		if (inc.id.compare(pName) == 0)
-		{
-			return &inc;
-		}
+		debug(LOG_WARNING, "Unknown research - %s", pName);
+	}
+	return psResearch;
+}
+
+RESEARCH *getResearchFromAtom(StatAtom atom)
+{
+	if (atom < researchIndexByAtom.size() && researchIndexByAtom[atom] >= 0)
+	{
+		return &asResearch[researchIndexByAtom[atom]];
 	}
-	debug(LOG_WARNING, "Unknown research - %s", pName);
 	return nullptr;
 }
 
@@ -1708,17 +1869,6 @@ static void replaceComponent(COMPONENT_STATS *pNewComponent, COMPONENT_STATS *pO
 
 /*Looks through all the currently allocated stats to check the name is not
 a duplicate*/
-static bool checkResearchName(RESEARCH *psResearch, UDWORD numStats)
-{
-	for (size_t inc = 0; inc < numStats; inc++)
-	{
-
-		ASSERT_OR_RETURN(false, asResearch[inc].id.compare(psResearch->id) != 0,
-		                 "Research name has already been used - %s", getStatsName(psResearch));
-	}
-	return true;
-}
-
 /* Sets the 'possible' flag for a player's research so the topic will appear in
 the research list next time the Research Facility is selected */
 bool enableResearch(RESEARCH *psResearch, UDWORD player)
@@ -1739,6 +1889,7 @@ bool enableResearch(RESEARCH *psResearch, UDWORD player)
 
 	//found, so set the flag
 	MakeResearchPossible(&asPlayerResList[player][inc]);
+	researchAvailabilityChanged(player, inc);
 
 	if (player == selectedPlayer)
 	{
@@ -2012,6 +2163,7 @@ static void RecursivelyDisableResearchByID(size_t index)
 	for (int player = 0; player < MAX_PLAYERS; ++player)
 	{
 		DisableResearch(&asPlayerResList[player][index]);
+		researchAvailabilityChanged(player, index);
 	}
 
 	for (size_t inc = 0; inc < asResearch.size(); inc++)
@@ -114,6 +114,8 @@ void ResearchRelease();
 
 /* For a given view data get the research this is related to */
 RESEARCH *getResearch(const char *pName);
+/// Like getResearch, without the warning for unknown names
+RESEARCH *getResearchFromAtom(StatAtom atom);
 
 /* sets the status of the topic to cancelled and stores the current research
    points accquired */
@@ -148,6 +150,11 @@ bool researchInitVars();
 
 bool researchAvailable(int inc, UDWORD playerID, QUEUE_MODE mode);
 
+/// Tells the research availability index that the completed, cancelled or possible state of a topic changed.
+void researchAvailabilityChanged(unsigned player, size_t topic);
+/// Rebuilds the research availability index on its next use, after the research state was rewritten (e.g. loaded).
+void researchAvailabilityInvalidate();
+
 struct AllyResearch
 {
 	unsigned player;
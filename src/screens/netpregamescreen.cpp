@@ -611,14 +611,14 @@ void WzCountdownLabel::setCountdown(const std::chrono::steady_clock::time_point
 	startTime = _startTime;
 	countdownSeconds = _countdownSeconds;
 	maxWidth = iV_GetTextWidth(WzString::number(countdownSeconds), font_large); // not accurate for all numbers, but hopefully in the ballpark...
-	dirty = true;
+	markDirty();
 }
 
 void WzCountdownLabel::setTextAlignment(WzTextAlignment align)
 {
 	style &= ~(WLAB_ALIGNLEFT | WLAB_ALIGNCENTRE | WLAB_ALIGNRIGHT);
 	style |= align;
-	dirty = true;
+	markDirty();
 }
 
 void WzCountdownLabel::display(int xOffset, int yOffset)
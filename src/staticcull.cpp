@@ -0,0 +1,178 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+	This file is part of Warzone 2100.
+	Copyright (C) 2026  Warzone 2100 Project (https://github.com/Warzone2100)
+
+	Warzone 2100 is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	Warzone 2100 is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Warzone 2100; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+/** \file
+ *  Culling quadtrees over the structures and features of the active world (see staticcull.h).
+ */
+
+#include "lib/framework/frame.h"
+
+#include "staticcull.h"
+#include "baseobject.h"
+#include "feature.h"
+#include "game_world.h"
+#include "structure.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+/// Leaf size of the trees, in tiles
+#define STATIC_CULL_LEAF_TILES 8
+/// Tiles around a footprint that the on-screen clip checks (room for shadows on the terrain)
+#define STATIC_CULL_OVERDRAW_TILES 2
+
+static CullQuadtree<BASE_OBJECT *> structureTree;
+static CullQuadtree<BASE_OBJECT *> featureTree;
+static bool treesValid = false;
+static CullStats queryStats;
+
+/// Where a tracked object sits in its object list: the list (player) index, and a counter that grows with every
+/// insertion, so that within a list newer objects (which addObjectToList() prepends) come first
+struct ListPosition
+{
+	unsigned list = 0;
+	uint64_t sequence = 0;
+};
+static std::unordered_map<const BASE_OBJECT *, ListPosition> listPositions;
+static uint64_t nextSequence = 0;
+static std::vector<std::pair<ListPosition, BASE_OBJECT *>> sortScratch;
+
+static void trackListPosition(const BASE_OBJECT *psObj, unsigned list)
+{
+	listPositions[psObj] = ListPosition{list, ++nextSequence};
+}
+
+static CullQuadtree<BASE_OBJECT *> *treeFor(OBJECT_TYPE type)
+{
+	switch (type)
+	{
+		case OBJ_STRUCTURE: return &structureTree;
+		case OBJ_FEATURE: return &featureTree;
+		default: return nullptr;
+	}
+}
+
+static CullRect cullBounds(const BASE_OBJECT *psObj)
+{
+	const StructureBounds b = getStructureBounds(psObj);
+	return CullRect{b.map.x - STATIC_CULL_OVERDRAW_TILES, b.map.y - STATIC_CULL_OVERDRAW_TILES,
+	                b.map.x + std::max(b.size.x, 1) + STATIC_CULL_OVERDRAW_TILES, b.map.y + std::max(b.size.y, 1) + STATIC_CULL_OVERDRAW_TILES};
+}
+
+static void rebuildTrees()
+{
+	const WorldMapState& map = gameWorld.map;
+	structureTree.reset(map.width, map.height, STATIC_CULL_LEAF_TILES);
+	featureTree.reset(map.width, map.height, STATIC_CULL_LEAF_TILES);
+	listPositions.clear();
+	// Back to front, so that the sequence numbers match the order of the lists
+	for (unsigned player = 0; player < gameWorld.objects.structures.size(); ++player)
+	{
+		const StructureList& list = gameWorld.objects.structures[player];
+		for (auto it = list.rbegin(); it != list.rend(); ++it)
+		{
+			structureTree.insert(*it, cullBounds(*it));
+			trackListPosition(*it, player);
+		}
+	}
+	const FeatureList& features = gameWorld.objects.features[0];
+	for (auto it = features.rbegin(); it != features.rend(); ++it)
+	{
+		featureTree.insert(*it, cullBounds(*it));
+		trackListPosition(*it, 0);
+	}
+	treesValid = true;
+	debug(LOG_3D, "Built culling trees: %zu structures, %zu features", structureTree.size(), featureTree.size());
+}
+
+void staticCullAdd(BASE_OBJECT *psObj, const WorldObjectState& objState)
+{
+	ASSERT_OR_RETURN(, psObj != nullptr, "Invalid pointer");
+	CullQuadtree<BASE_OBJECT *> *tree = treeFor(psObj->type);
+	if (!treesValid || tree == nullptr || &objState != &gameWorld.objects)
+	{
+		return;
+	}
+	tree->insert(psObj, cullBounds(psObj));
+	trackListPosition(psObj, psObj->type == OBJ_STRUCTURE ? psObj->player : 0);
+}
+
+void staticCullRemove(BASE_OBJECT *psObj)
+{
+	ASSERT_OR_RETURN(, psObj != nullptr, "Invalid pointer");
+	CullQuadtree<BASE_OBJECT *> *tree = treeFor(psObj->type);
+	if (!treesValid || tree == nullptr)
+	{
+		return;
+	}
+	// Objects of other worlds were never added, so not finding one is fine
+	tree->remove(psObj);
+	listPositions.erase(psObj);
+}
+
+void staticCullInvalidate()
+{
+	treesValid = false;
+	structureTree.clear();
+	featureTree.clear();
+	listPositions.clear();
+}
+
+void staticCullQuery(OBJECT_TYPE type, const CullRect& view, std::vector<BASE_OBJECT *>& out)
+{
+	CullQuadtree<BASE_OBJECT *> *tree = treeFor(type);
+	ASSERT_OR_RETURN(, tree != nullptr, "Not a static object type: %d", static_cast<int>(type));
+	if (!treesValid || tree->width() != gameWorld.map.width || tree->height() != gameWorld.map.height)
+	{
+		rebuildTrees();
+	}
+	tree->query([&view](const CullRect& bounds) {
+		if (!view.intersects(bounds))
+		{
+			return CullResult::Outside;
+		}
+		return view.contains(bounds) ? CullResult::Inside : CullResult::Intersecting;
+	}, [](BASE_OBJECT *psObj, bool) {
+		auto it = listPositions.find(psObj);
+		sortScratch.emplace_back(it != listPositions.end() ? it->second : ListPosition(), psObj);
+	}, queryStats);
+
+	// The tree hands the objects over in spatial order; draw them in object list order, as before the trees
+	// existed, since that decides the order of the translucent instance batches and of the instances in them
+	std::sort(sortScratch.begin(), sortScratch.end(), [](const std::pair<ListPosition, BASE_OBJECT *>& a, const std::pair<ListPosition, BASE_OBJECT *>& b) {
+		if (a.first.list != b.first.list)
+		{
+			return a.first.list < b.first.list;
+		}
+		return a.first.sequence > b.first.sequence;
+	});
+	for (const auto& entry : sortScratch)
+	{
+		out.push_back(entry.second);
+	}
+	sortScratch.clear();
+}
+
+CullStats staticCullTakeStats()
+{
+	CullStats stats = queryStats;
+	queryStats = CullStats();
+	return stats;
+}
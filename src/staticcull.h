@@ -0,0 +1,50 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+	This file is part of Warzone 2100.
+	Copyright (C) 2026  Warzone 2100 Project (https://github.com/Warzone2100)
+
+	Warzone 2100 is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	Warzone 2100 is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Warzone 2100; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+/** \file
+ *  Culling quadtrees over the structures and features of the active world.
+ *
+ *  objmem.cpp keeps them up to date as objects are added and destroyed (buildFeature() adds features
+ *  itself, once they are placed); anything that replaces the active world's object lists wholesale
+ *  (world swaps, freeing all objects) calls staticCullInvalidate(), and the trees are rebuilt from the
+ *  lists the next time they are queried.
+ */
+#pragma once
+
+#include "lib/ivis_opengl/culling.h"
+#include "basedef.h"
+
+#include <vector>
+
+struct WorldObjectState;
+
+/// Track a structure or feature of `objState` that has its place on the map (ignored unless that is the active world)
+void staticCullAdd(BASE_OBJECT *psObj, const WorldObjectState& objState);
+/// Stop tracking a structure or feature (destroyed, or moved to another list)
+void staticCullRemove(BASE_OBJECT *psObj);
+/// The active world's structure / feature lists were replaced: rebuild the trees before the next query
+void staticCullInvalidate();
+
+/// Append the live structures (OBJ_STRUCTURE) or features (OBJ_FEATURE) whose footprint, plus the overdraw
+/// clipStructureOnScreen() / clipFeatureOnScreen() allow for, intersects `view` (in map tiles), in object list order.
+void staticCullQuery(OBJECT_TYPE type, const CullRect& view, std::vector<BASE_OBJECT *>& out);
+
+/// Counters for the queries made since the last call (structures and features combined)
+CullStats staticCullTakeStats();
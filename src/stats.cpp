@@ -40,6 +40,7 @@
 #include "projectile.h"
 #include "text.h"
 #include "notifications.h"
+#include <deque>
 #include <unordered_map>
 
 #define WEAPON_TIME		100
@@ -68,8 +69,12 @@ UBYTE		*apCompLists[MAX_PLAYERS][COMP_NUMCOMPONENTS];
 //store for each players Structure states
 UBYTE		*apStructTypeLists[MAX_PLAYERS];
 
-static std::unordered_map<WzString, BASE_STATS *> lookupStatPtr;
-static std::unordered_map<WzString, COMPONENT_STATS *> lookupCompStatPtr;
+// Interned stat ids: atom -> id, and id -> atom (the keys point into statAtomNames, which never moves its strings)
+static std::deque<std::string> statAtomNames;
+static std::unordered_map<std::string_view, StatAtom> statAtomLookup;
+
+static StatAtomTable<BASE_STATS> lookupStatPtr;
+static StatAtomTable<COMPONENT_STATS> lookupCompStatPtr;
 static size_t statModelLoadingFailures = 0;
 
 static bool getMovementModel(const WzString &movementModel, MOVEMENT_MODEL *model);
@@ -276,8 +281,8 @@ static void loadStats(WzConfig &json, BASE_STATS *psStats, size_t index)
 	psStats->id = json.group();
 	psStats->name = json.string("name");
 	psStats->index = index;
-	ASSERT(lookupStatPtr.find(psStats->id) == lookupStatPtr.end(), "Duplicate ID found! (%s)", psStats->id.toUtf8().c_str());
-	lookupStatPtr.insert(std::make_pair(psStats->id, psStats));
+	bool inserted = lookupStatPtr.insert(statAtomIntern(psStats->id.toUtf8()), psStats);
+	ASSERT(inserted, "Duplicate ID found! (%s)", psStats->id.toUtf8().c_str());
 }
 
 void loadStructureStats_BaseStats(WzConfig &json, STRUCTURE_STATS *psStats, size_t index)
@@ -287,13 +292,13 @@ void loadStructureStats_BaseStats(WzConfig &json, STRUCTURE_STATS *psStats, size
 
 void unloadStructureStats_BaseStats(const STRUCTURE_STATS &psStats)
 {
-	lookupStatPtr.erase(psStats.id);
+	lookupStatPtr.erase(statAtomFind(psStats.id));
 }
 
 static void loadCompStats(WzConfig &json, COMPONENT_STATS *psStats, size_t index)
 {
 	loadStats(json, psStats, index);
-	lookupCompStatPtr.insert(std::make_pair(psStats->id, psStats));
+	lookupCompStatPtr.insert(statAtomFind(psStats->id), psStats);
 	psStats->buildPower = json.value("buildPower", 0).toUInt();
 	psStats->buildPoints = json.value("buildPoints", 0).toUInt();
 	psStats->designable = json.value("designable", false).toBool();
@@ -1348,50 +1353,71 @@ int getCompFromName(COMPONENT_TYPE compType, const WzString &name)
 	return getCompFromID(compType, name);
 }
 
-int getCompFromID(COMPONENT_TYPE compType, const WzString &name)
+static int getCompIndex(COMPONENT_TYPE compType, const COMPONENT_STATS *psComp, const char *name)
 {
-	COMPONENT_STATS *psComp = nullptr;
-	auto it = lookupCompStatPtr.find(WzString::fromUtf8(name.toUtf8().c_str()));
-	if (it != lookupCompStatPtr.end())
-	{
-		psComp = it->second;
-	}
-	ASSERT_OR_RETURN(-1, psComp, "No such component ID [%s] found", name.toUtf8().c_str());
-	ASSERT_OR_RETURN(-1, compType == psComp->compType, "Wrong component type for ID %s", name.toUtf8().c_str());
-	ASSERT_OR_RETURN(-1, psComp->index <= INT_MAX, "Component index is too large for ID %s", name.toUtf8().c_str());
+	ASSERT_OR_RETURN(-1, psComp, "No such component ID [%s] found", name);
+	ASSERT_OR_RETURN(-1, compType == psComp->compType, "Wrong component type for ID %s", name);
+	ASSERT_OR_RETURN(-1, psComp->index <= INT_MAX, "Component index is too large for ID %s", name);
 	return static_cast<int>(psComp->index);
 }
 
+int getCompFromID(COMPONENT_TYPE compType, const WzString &name)
+{
+	return getCompIndex(compType, lookupCompStatPtr.find(statAtomFind(name)), name.toUtf8().c_str());
+}
+
+int getCompFromAtom(COMPONENT_TYPE compType, StatAtom atom)
+{
+	return getCompIndex(compType, lookupCompStatPtr.find(atom), (atom != NULL_STAT_ATOM) ? statAtomName(atom).c_str() : "");
+}
+
 /// Get the component for a stat based on the name alone.
 /// Returns NULL if record not found
 COMPONENT_STATS *getCompStatsFromName(const WzString &name)
 {
-	COMPONENT_STATS *psComp = nullptr;
-	auto it = lookupCompStatPtr.find(name);
-	if (it != lookupCompStatPtr.end())
-	{
-		psComp = it->second;
-	}
-	/*if (!psComp)
-	{
-		debug(LOG_ERROR, "Not found: %s", name.toUtf8().c_str());
-		for (auto& it2 : lookupCompStatPtr)
-		{
-			debug(LOG_ERROR, "    %s", it2.second->id.toUtf8().c_str());
-		}
-	}*/
-	return psComp;
+	return lookupCompStatPtr.find(statAtomFind(name));
 }
 
 BASE_STATS *getBaseStatsFromName(const WzString &name)
 {
-	BASE_STATS *psStat = nullptr;
-	auto it = lookupStatPtr.find(name);
-	if (it != lookupStatPtr.end())
+	return lookupStatPtr.find(statAtomFind(name));
+}
+
+COMPONENT_STATS *getCompStatsFromAtom(StatAtom atom)
+{
+	return lookupCompStatPtr.find(atom);
+}
+
+BASE_STATS *getBaseStatsFromAtom(StatAtom atom)
+{
+	return lookupStatPtr.find(atom);
+}
+
+StatAtom statAtomIntern(std::string_view name)
+{
+	auto it = statAtomLookup.find(name);
+	if (it != statAtomLookup.end())
 	{
-		psStat = it->second;
+		return it->second;
 	}
-	return psStat;
+	ASSERT_OR_RETURN(NULL_STAT_ATOM, statAtomNames.size() < NULL_STAT_ATOM, "Too many stat ids");
+	const StatAtom atom = static_cast<StatAtom>(statAtomNames.size());
+	statAtomNames.emplace_back(name);
+	statAtomLookup.emplace(std::string_view(statAtomNames.back()), atom);
+	return atom;
+}
+
+StatAtom statAtomFind(std::string_view name)
+{
+	auto it = statAtomLookup.find(name);
+	return (it != statAtomLookup.end()) ? it->second : NULL_STAT_ATOM;
+}
+
+const std::string &statAtomName(StatAtom atom)
+{
+	static const std::string none;
+	ASSERT_OR_RETURN(none, atom < statAtomNames.size(), "Invalid stat atom %u", atom);
+	return statAtomNames[atom];
 }
 
 /*sets the store to the body size based on the name passed in - returns false
@@ -25,6 +25,7 @@
 
 #include "lib/framework/wzconfig.h"
 
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -164,6 +165,70 @@ STRUCTURE_STATS *getStructStatsFromName(const WzString &name);
 /// Get the base stat pointer for a stat based on the name
 BASE_STATS *getBaseStatsFromName(const WzString &name);
 
+/* Interned stat ids
+ *
+ * Every stat id that is loaded (components, structures, research) is interned once as a StatAtom, a
+ * small integer that names the same id for the rest of the run, even across reloading the stats. The
+ * tables looking stats up by id are indexed by atom, so a lookup hashes the name once, straight from
+ * the bytes the caller has, and not once per table or after a round trip through WzString.
+ * StatAtom itself is declared in statsdef.h.
+ */
+
+/// The atom for `name`, interning it if it is new. Only called when loading stats.
+StatAtom statAtomIntern(std::string_view name);
+/// The atom for `name`, or NULL_STAT_ATOM if no stat was ever loaded with that id.
+StatAtom statAtomFind(std::string_view name);
+inline StatAtom statAtomFind(const char *name) { return statAtomFind(std::string_view(name ? name : "")); }
+inline StatAtom statAtomFind(const WzString &name) { return statAtomFind(std::string_view(name.toUtf8())); }
+/// The id that `atom` stands for.
+const std::string &statAtomName(StatAtom atom);
+
+/// Stats of one kind, looked up by the atom of their id.
+template <typename T>
+class StatAtomTable
+{
+public:
+	T *find(StatAtom atom) const
+	{
+		return atom < entries.size() ? entries[atom] : nullptr;
+	}
+	/// Returns false, and changes nothing, if `atom` is already in the table
+	bool insert(StatAtom atom, T *psStats)
+	{
+		ASSERT_OR_RETURN(false, atom != NULL_STAT_ATOM, "Invalid stat atom");
+		if (atom >= entries.size())
+		{
+			entries.resize(atom + 1, nullptr);
+		}
+		if (entries[atom] != nullptr)
+		{
+			return false;
+		}
+		entries[atom] = psStats;
+		return true;
+	}
+	void erase(StatAtom atom)
+	{
+		if (atom < entries.size())
+		{
+			entries[atom] = nullptr;
+		}
+	}
+	void clear()
+	{
+		entries.clear();
+	}
+
+private:
+	std::vector<T *> entries;
+};
+
+/// Lookups by atom, for callers that look up the same ids over and over (scripts)
+int getCompFromAtom(COMPONENT_TYPE compType, StatAtom atom);
+COMPONENT_STATS *getCompStatsFromAtom(StatAtom atom);
+STRUCTURE_STATS *getStructStatsFromAtom(StatAtom atom);
+BASE_STATS *getBaseStatsFromAtom(StatAtom atom);
+
 /*returns the weapon sub class based on the string name passed in */
 bool getWeaponSubClass(const char *subClass, WEAPON_SUBCLASS *wclass);
 const char *getWeaponSubClass(WEAPON_SUBCLASS wclass);
@@ -31,6 +31,10 @@ struct iIMDBaseShape;
 #include <bitset>
 #include "lib/framework/wzstring.h"
 
+/// Interned stat id, see statAtomIntern() in stats.h
+typedef uint32_t StatAtom;
+#define NULL_STAT_ATOM UINT32_MAX
+
 /* The different types of droid */
 // NOTE, if you add to, or change this list then you'll need
 // to update the DroidSelectionWeights lookup table in Display.c
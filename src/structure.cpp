@@ -106,7 +106,7 @@ UDWORD			researchModuleStat;
 //holder for all StructureStats
 STRUCTURE_STATS		*asStructureStats = nullptr;
 UDWORD				numStructureStats = 0;
-static std::unordered_map<WzString, STRUCTURE_STATS *> lookupStructStatPtr;
+static StatAtomTable<STRUCTURE_STATS> lookupStructStatPtr;
 optional<int> structureDamageBaseExperienceLevel;
 
 //used to hold the modifiers cross refd by weapon effect and structureStrength
@@ -744,7 +744,7 @@ bool loadStructureStats(WzConfig &ini)
 
 		ini.endGroup();
 
-		lookupStructStatPtr.insert(std::make_pair(psStats->id, psStats));
+		lookupStructStatPtr.insert(statAtomFind(psStats->id), psStats);
 		++statWriteIdx;
 	}
 	numStructureStats = statWriteIdx;
@@ -4903,7 +4903,12 @@ bool destroyStruct(STRUCTURE *psDel, unsigned impactTime, GameWorld& world)
 return the first one it finds!! */
 int32_t getStructStatFromName(const WzString &name)
 {
-	STRUCTURE_STATS *psStat = getStructStatsFromName(name);
+	return getStructStatFromAtom(statAtomFind(name));
+}
+
+int32_t getStructStatFromAtom(StatAtom atom)
+{
+	STRUCTURE_STATS *psStat = lookupStructStatPtr.find(atom);
 	if (psStat)
 	{
 		return psStat->index;
@@ -4913,13 +4918,12 @@ int32_t getStructStatFromName(const WzString &name)
 
 STRUCTURE_STATS *getStructStatsFromName(const WzString &name)
 {
-	STRUCTURE_STATS *psStat = nullptr;
-	auto it = lookupStructStatPtr.find(name);
-	if (it != lookupStructStatPtr.end())
-	{
-		psStat = it->second;
-	}
-	return psStat;
+	return lookupStructStatPtr.find(statAtomFind(name));
+}
+
+STRUCTURE_STATS *getStructStatsFromAtom(StatAtom atom)
+{
+	return lookupStructStatPtr.find(atom);
 }
 
 /*check to see if the structure is 'doing' anything  - return true if idle*/
@@ -146,6 +146,7 @@ void alignStructure(STRUCTURE *psBuilding, WorldMapState& mapState);
 void setCurrentStructQuantity(const WorldObjectState& objState, bool displayError);
 /* get a stat inc based on the name */
 int32_t getStructStatFromName(const WzString &name);
+int32_t getStructStatFromAtom(StatAtom atom);
 /*sets the point new droids go to - x/y in world coords for a Factory*/
 void setAssemblyPoint(GameWorld& world, FLAG_POSITION *psAssemblyPoint, UDWORD x, UDWORD y, UDWORD player, bool bCheck);
 
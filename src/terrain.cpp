@@ -40,6 +40,7 @@
 #include "lib/framework/resource_loading_controller.h"
 #include "resource_loading_dispatch.h"
 #include "lib/framework/wzapp.h"
+#include "lib/framework/wzparallel.h"
 #include "lib/ivis_opengl/ivisdef.h"
 #include "lib/ivis_opengl/imd.h"
 #include "lib/ivis_opengl/piefunc.h"
@@ -52,6 +53,7 @@
 #include "lib/ivis_opengl/piematrix.h"
 #include "lib/ivis_opengl/piedraw.h"
 #include "lib/ivis_opengl/pielight_convert.h"
+#include "lib/ivis_opengl/culling.h"
 #include "world_map_state.h"
 #include <glm/mat4x4.hpp>
 #ifndef GLM_ENABLE_EXPERIMENTAL
@@ -138,6 +140,12 @@ static size_t lightmapWidth;
 static size_t lightmapHeight;
 /// Lightmap image
 static std::unique_ptr<iV_Image> lightmapPixmap;
+/// Scratch rows for updateLightMap(), kept around to avoid reallocating
+static std::vector<float> lightmapColumnFade;
+static std::vector<uint8_t> lightmapRowChannels[4];
+static std::vector<uint8_t> lightmapRowPixels;
+/// Sub-rect staging image for uploading the changed part of the lightmap
+static iV_Image lightmapUploadPixmap;
 /// Lightmap values
 struct LightmapCalculatedValues
 {
@@ -182,11 +190,29 @@ static gfx_api::buffer* terrainPatchIndexVBO = nullptr;
 static int terrainDistance;
 /// How many sectors have we actually got?
 static int xSectors, ySectors;
+/// Quadtree over the sectors (items are sector indices), so culling skips whole regions of the map at once
+static CullQuadtree<int> sectorTree;
+/// Indices of the sectors with draw set this frame, in index order
+static std::vector<int> visibleSectors;
+/// Counters for the last cullTerrain() call
+static CullStats terrainCullStats;
 
 /// Did we initialise the terrain renderer yet?
 static bool terrainInitialised = false;
 
-static std::vector<gfx_api::TerrainDecalVertex> terrainDecalVertexUpdateBuffer;
+/// CPU copy of one dirty sector's vertex data, built on a worker thread and uploaded by the main thread
+struct SectorGeometryBuild
+{
+	int sector = -1;
+	std::vector<TerrainVertex> geometry;
+	std::vector<WaterVertex> water;
+	std::vector<gfx_api::TerrainDecalVertex> terrainAndDecal;
+	int geometrySize = 0;
+	int waterSize = 0;
+	int terrainAndDecalSize = 0;
+};
+/// Staging buffers for the sectors rebuilt this frame (kept around to avoid repeated allocations)
+static std::vector<SectorGeometryBuild> sectorGeometryBuilds;
 
 /// Helper to specify the offset in a VBO
 #define BUFFER_OFFSET(i) (reinterpret_cast<char *>(i))
@@ -686,63 +712,158 @@ static void setSectorDecalVertex_SinglePass(WorldMapState& mapState, int x, int
 }
 
 /**
- * Update the sector for when the terrain is changed.
+ * Build the vertex data of a sector for when the terrain is changed.
+ * Only reads the map and the surface caches, so several sectors can be built at once on worker threads.
  */
-static void updateSectorGeometry(WorldMapState& mapState, int x, int y)
+static void buildSectorGeometry(WorldMapState& mapState, SectorGeometryBuild& build)
 {
-	TerrainVertex *geometry;
-	WaterVertex *water;
-	int geometrySize = 0;
-	int waterSize = 0;
+	const Sector& sector = sectors[build.sector];
+	const int x = build.sector / ySectors;
+	const int y = build.sector % ySectors;
 
-	if (terrainSubdivision > 1)
-	{
-		// refresh the per-corner surface caches before re-evaluating the surface:
-		// a corner's cached values depend on its +-1 neighbors, so expand the sector's corner
-		// rect by 1 (markTileDirty's widening guarantees every affected sector gets here)
-		terrainSurface::rebuildSurfaceCachesRegion(mapState, x * sectorSize - 1, y * sectorSize - 1,
-													(x + 1) * sectorSize + 1, (y + 1) * sectorSize + 1);
-	}
+	build.geometry.resize(sector.geometrySize);
+	build.water.resize(sector.waterSize);
+	build.terrainAndDecal.resize(sector.terrainAndDecalSize);
+	build.geometrySize = 0;
+	build.waterSize = 0;
+	build.terrainAndDecalSize = 0;
 
-	geometry = new TerrainVertex[sectors[x * ySectors + y].geometrySize];
-	water = (WaterVertex *)malloc(sizeof(WaterVertex) * sectors[x * ySectors + y].waterSize);
+	setSectorGeometry(mapState, x, y, build.geometry.data(), build.water.data(), &build.geometrySize, &build.waterSize);
+	setSectorDecalVertex_SinglePass(mapState, x, y, build.terrainAndDecal.data(), &build.terrainAndDecalSize);
+}
 
-	setSectorGeometry(mapState, x, y, geometry, water, &geometrySize, &waterSize);
-	ASSERT(geometrySize == sectors[x * ySectors + y].geometrySize, "something went seriously wrong updating the terrain");
-	ASSERT(waterSize    == sectors[x * ySectors + y].waterSize   , "something went seriously wrong updating the terrain");
+static void uploadSectorGeometry(const SectorGeometryBuild& build)
+{
+	const Sector& sector = sectors[build.sector];
+	ASSERT_OR_RETURN(, build.geometrySize == sector.geometrySize, "something went seriously wrong updating the terrain");
+	ASSERT_OR_RETURN(, build.waterSize == sector.waterSize, "something went seriously wrong updating the terrain");
+	ASSERT_OR_RETURN(, build.terrainAndDecalSize == sector.terrainAndDecalSize, "Sizes don't match!");
 
 	if (geometryVBO) // absent under HardwareTess (the shadow pass draws tessellated patches and the color pass writes depth)
 	{
-		geometryVBO->update(sizeof(TerrainVertex)*sectors[x * ySectors + y].geometryOffset,
-								sizeof(TerrainVertex)*sectors[x * ySectors + y].geometrySize, geometry,
+		geometryVBO->update(sizeof(TerrainVertex) * sector.geometryOffset,
+								sizeof(TerrainVertex) * sector.geometrySize, build.geometry.data(),
 								gfx_api::buffer::update_flag::non_overlapping_updates_promise);
 	}
-	waterVBO->update(sizeof(WaterVertex)*sectors[x * ySectors + y].waterOffset,
-					 sizeof(WaterVertex)*sectors[x * ySectors + y].waterSize, water,
+	waterVBO->update(sizeof(WaterVertex) * sector.waterOffset,
+					 sizeof(WaterVertex) * sector.waterSize, build.water.data(),
 					 gfx_api::buffer::update_flag::non_overlapping_updates_promise);
+	terrainDecalVBO->update(sizeof(gfx_api::TerrainDecalVertex) * sector.terrainAndDecalOffset,
+						 sizeof(gfx_api::TerrainDecalVertex) * sector.terrainAndDecalSize, build.terrainAndDecal.data(),
+						 gfx_api::buffer::update_flag::non_overlapping_updates_promise);
+}
 
-	delete[] geometry;
-	free(water);
+/// Re-bake the tessellation fields under the given sectors. Each re-bake is widened by the surface's
+/// influence radius and sub-uploads three textures, so neighbouring sectors are merged into one
+/// re-bake whenever that does not re-bake noticeably more texels than doing them one by one.
+static void rebakeSectors(WorldMapState& mapState, const std::vector<int>& sectorIndices)
+{
+	constexpr int influenceTiles = 3; // see terrainBake::rebakeTileRegion
+	auto bakedArea = [](const CullRect& r) {
+		return static_cast<int64_t>(r.x2 - r.x1 + 2 * influenceTiles) * (r.y2 - r.y1 + 2 * influenceTiles);
+	};
+
+	std::vector<CullRect> regions;
+	regions.reserve(sectorIndices.size());
+	for (int sector : sectorIndices)
+	{
+		const int x = sector / ySectors;
+		const int y = sector % ySectors;
+		regions.push_back(CullRect{x * sectorSize, y * sectorSize, (x + 1) * sectorSize, (y + 1) * sectorSize});
+	}
+	for (bool merged = true; merged;)
+	{
+		merged = false;
+		for (size_t a = 0; a < regions.size() && !merged; ++a)
+		{
+			for (size_t b = a + 1; b < regions.size(); ++b)
+			{
+				CullRect both = regions[a];
+				both.unite(regions[b]);
+				if (bakedArea(both) <= bakedArea(regions[a]) + bakedArea(regions[b]))
+				{
+					regions[a] = both;
+					regions.erase(regions.begin() + b);
+					merged = true;
+					break;
+				}
+			}
+		}
+	}
+
+	for (const CullRect& r : regions)
+	{
+		terrainBake::rebakeTileRegion(mapState, r.x1, r.y1, r.x2 - 1, r.y2 - 1);
+	}
+}
+
+/**
+ * Update the dirty sectors among `sectorIndices` for when the terrain is changed.
+ * The vertex data is generated on the parallel worker threads, into staging buffers that are
+ * then uploaded here, so rebuilding many sectors at once (dirtyAllSectors) does not stall on one core.
+ */
+static void updateDirtySectorGeometry(WorldMapState& mapState, const std::vector<int>& sectorIndices)
+{
+	std::vector<int> dirtySectors;
+	for (int sector : sectorIndices)
+	{
+		if (sectors[sector].dirty)
+		{
+			dirtySectors.push_back(sector);
+		}
+	}
+	if (dirtySectors.empty())
+	{
+		return;
+	}
+	WZ_PROFILE_SCOPE(updateDirtySectorGeometry);
+
+	if (terrainSubdivision > 1)
+	{
+		// refresh the per-corner surface caches before re-evaluating the surface:
+		// a corner's cached values depend on its +-1 neighbors, so expand the sector's corner
+		// rect by 1 (markTileDirty's widening guarantees every affected sector gets here).
+		// Done up front, since the builders below read the caches from several threads.
+		for (int sector : dirtySectors)
+		{
+			const int x = sector / ySectors;
+			const int y = sector % ySectors;
+			terrainSurface::rebuildSurfaceCachesRegion(mapState, x * sectorSize - 1, y * sectorSize - 1,
+														(x + 1) * sectorSize + 1, (y + 1) * sectorSize + 1);
+		}
+	}
+
+	if (sectorGeometryBuilds.size() < dirtySectors.size())
+	{
+		sectorGeometryBuilds.resize(dirtySectors.size());
+	}
+	for (size_t i = 0; i < dirtySectors.size(); ++i)
+	{
+		sectorGeometryBuilds[i].sector = dirtySectors[i];
+	}
+	wzParallelFor(dirtySectors.size(), 1, [&mapState](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i)
+		{
+			buildSectorGeometry(mapState, sectorGeometryBuilds[i]);
+		}
+	});
+
+	for (size_t i = 0; i < dirtySectors.size(); ++i)
+	{
+		uploadSectorGeometry(sectorGeometryBuilds[i]);
+		sectors[dirtySectors[i]].dirty = false;
+	}
 
 	if (terrainMeshStrategy == TerrainMeshStrategy::HardwareTess)
 	{
 		// the tessellated surface comes from the baked field textures
-		terrainBake::rebakeTileRegion(mapState, x * sectorSize, y * sectorSize,
-									  x * sectorSize + sectorSize - 1, y * sectorSize + sectorSize - 1);
+		rebakeSectors(mapState, dirtySectors);
 	}
-
-	terrainDecalVertexUpdateBuffer.resize(sectors[x * ySectors + y].terrainAndDecalSize); // reuse a buffer to avoid repeated allocations if possible
-	int terrainDecalSize = 0;
-	setSectorDecalVertex_SinglePass(mapState, x, y, terrainDecalVertexUpdateBuffer.data(), &terrainDecalSize);
-	ASSERT(terrainDecalSize == sectors[x * ySectors + y].terrainAndDecalSize, "Sizes don't match!");
-	terrainDecalVBO->update(sizeof(gfx_api::TerrainDecalVertex)*sectors[x * ySectors + y].terrainAndDecalOffset,
-						 sizeof(gfx_api::TerrainDecalVertex)*sectors[x * ySectors + y].terrainAndDecalSize, terrainDecalVertexUpdateBuffer.data(),
-						 gfx_api::buffer::update_flag::non_overlapping_updates_promise);
 }
 
 /**
  * Mark all tiles that are influenced by this grid point as dirty.
- * Dirty sectors will later get updated by updateSectorGeometry.
+ * Dirty sectors will later get updated by updateDirtySectorGeometry.
  */
 void markTileDirty(int i, int j)
 {
@@ -1331,6 +1452,15 @@ bool initTerrain(WorldMapState& mapState)
 	xSectors = (mapState.width + sectorSize - 1) / sectorSize;
 	ySectors = (mapState.height + sectorSize - 1) / sectorSize;
 	sectors = std::unique_ptr<Sector[]> (new Sector[xSectors * ySectors]());
+	sectorTree.reset(xSectors * sectorSize, ySectors * sectorSize, sectorSize);
+	for (int sx = 0; sx < xSectors; sx++)
+	{
+		for (int sy = 0; sy < ySectors; sy++)
+		{
+			sectorTree.insert(sx * ySectors + sy, CullRect{sx * sectorSize, sy * sectorSize, (sx + 1) * sectorSize, (sy + 1) * sectorSize});
+		}
+	}
+	visibleSectors.clear();
 
 	////////////////////
 	// fill the geometry part of the sectors
@@ -1672,10 +1802,14 @@ void shutdownTerrain()
 	terrainSurface::clearSurfaceCaches();
 
 	sectors.reset();
+	sectorTree.reset(0, 0, sectorSize);
+	visibleSectors.clear();
+	sectorGeometryBuilds.clear();
 
 	delete lightmap_texture;
 	lightmap_texture = nullptr;
 	lightmapPixmap = nullptr;
+	lightmapUploadPixmap.clear();
 
 	delete groundTexArr; groundTexArr = nullptr;
 	delete groundNormalArr; groundNormalArr = nullptr;
@@ -1694,16 +1828,82 @@ void shutdownTerrain()
 	terrainInitialised = false;
 }
 
-static void updateLightMap(WorldMapState& mapState, const LightMap& lightmap)
+/// Recompute the lightmap image, and return the rect of texels (as tiles) that changed since the last call.
+///
+/// A row is first gathered from the tiles and the LightMap into one array per channel, then faded in
+/// a branch-free loop the compiler can vectorise, and only written to the image where it differs, so
+/// the texture upload (by far the expensive part) only covers what changed. With the distance fade
+/// active, rows and columns outside the visible area are always black and are not gathered at all.
+static CullRect updateLightMap(WorldMapState& mapState, const LightMap& lightmap)
 {
-	size_t lightmapChannels = lightmapPixmap->channels(); // should always be 4 now...
+	const size_t lightmapChannels = lightmapPixmap->channels(); // should always be 4 now...
+	ASSERT_OR_RETURN(CullRect(), lightmapChannels == 4, "Unexpected lightmap channels: %zu", lightmapChannels);
+	ASSERT_OR_RETURN(CullRect(), lightmap.width() > 0 && lightmap.height() > 0, "Lightmap data not initialised");
 	unsigned char* lightMapWritePtr = lightmapPixmap->bmp_w();
+	const int width = mapState.width;
+	const int lightWidth = lightmap.width();
+	const int markedPulse = getModularScaledGraphicsTime(2048, 255);
+
+	// fade to black at the edges of the visible terrain area:
+	// darken = (distance to the closest edge of the visible map) / 2, which splits into a column and a row term
+	const bool fadeEdges = !pie_GetFogStatus();
+	const float playerX = map_coordf(playerPos.p.x);
+	const float playerY = map_coordf(playerPos.p.z);
+	lightmapColumnFade.assign(width, 1.f);
+	int firstColumn = 0;
+	int lastColumn = width;
+	if (fadeEdges)
+	{
+		firstColumn = width;
+		lastColumn = 0;
+		for (int i = 0; i < width; ++i)
+		{
+			const float distA = i - (playerX - visibleTiles.x / 2);
+			const float distB = (playerX + visibleTiles.x / 2) - i;
+			lightmapColumnFade[i] = std::min(distA, distB) / 2.0f;
+			if (lightmapColumnFade[i] > 0)
+			{
+				firstColumn = std::min(firstColumn, i);
+				lastColumn = i + 1;
+			}
+		}
+	}
+
+	for (auto& channel : lightmapRowChannels)
+	{
+		channel.resize(width);
+	}
+	lightmapRowPixels.resize(static_cast<size_t>(width) * 4);
+	uint8_t* const r = lightmapRowChannels[0].data();
+	uint8_t* const g = lightmapRowChannels[1].data();
+	uint8_t* const b = lightmapRowChannels[2].data();
+	uint8_t* const a = lightmapRowChannels[3].data();
+	const float* const columnFade = lightmapColumnFade.data();
+
+	CullRect changed;
 	for (int j = 0; j < mapState.height; ++j)
 	{
-		for (int i = 0; i < mapState.width; ++i)
+		float rowFade = 1.f;
+		if (fadeEdges)
+		{
+			const float distC = j - (playerY - visibleTiles.y / 2);
+			const float distD = (playerY + visibleTiles.y / 2) - j;
+			rowFade = std::min(distC, distD) / 2.0f;
+		}
+		const int rowBegin = (rowFade > 0) ? firstColumn : width;
+		const int rowEnd = (rowFade > 0) ? lastColumn : width;
+
+		// gather
+		std::fill(r, r + width, 0);
+		std::fill(g, g + width, 0);
+		std::fill(b, b + width, 0);
+		std::fill(a, a + width, 0);
+		const PIELIGHT* lightRow = lightmap.row(j);
+		const MAPTILE* tileRow = mapTile(mapState, 0, j);
+		for (int i = rowBegin; i < rowEnd; ++i)
 		{
-			MAPTILE *psTile = mapTile(mapState, i, j);
-			PIELIGHT colour = lightmap(i, j);
+			const MAPTILE* psTile = tileRow + i;
+			PIELIGHT colour = lightRow[std::min(i, lightWidth - 1)];
 			UBYTE level = static_cast<UBYTE>(psTile->level);
 
 			if (psTile->tileInfoBits & BITS_GATEWAY && showGateways)
@@ -1712,97 +1912,154 @@ static void updateLightMap(WorldMapState& mapState, const LightMap& lightmap)
 			}
 			if (psTile->tileInfoBits & BITS_MARKED)
 			{
-				int m = getModularScaledGraphicsTime(2048, 255);
-				colour.byte.r = MAX(m, 255 - m);
+				colour.byte.r = MAX(markedPulse, 255 - markedPulse);
 				level = std::max<UBYTE>(level, colour.byte.r / 2);
 			}
-
-			lightMapWritePtr[(i + j * lightmapWidth) * lightmapChannels + 0] = colour.byte.r;
-			lightMapWritePtr[(i + j * lightmapWidth) * lightmapChannels + 1] = colour.byte.g;
-			lightMapWritePtr[(i + j * lightmapWidth) * lightmapChannels + 2] = colour.byte.b;
+			r[i] = colour.byte.r;
+			g[i] = colour.byte.g;
+			b[i] = colour.byte.b;
 			// store the "brightness" level in byte.a
 			// NOTE: This differs depending on whether using the single-pass terrain shader or the fallback terrain shaders
 			// (For more, see avUpdateTiles() and getTileIllumination())
-			lightMapWritePtr[(i + j * lightmapWidth) * lightmapChannels + 3] = level;
+			a[i] = level;
+		}
 
-			if (!pie_GetFogStatus())
+		// fade: darken <= 0 is black, darken >= 1 leaves the texel alone, and in between every channel is scaled (truncating)
+		if (fadeEdges)
+		{
+			for (int i = rowBegin; i < rowEnd; ++i)
 			{
-				// fade to black at the edges of the visible terrain area
-				const float playerX = map_coordf(playerPos.p.x);
-				const float playerY = map_coordf(playerPos.p.z);
-
-				const float distA = i - (playerX - visibleTiles.x / 2);
-				const float distB = (playerX + visibleTiles.x / 2) - i;
-				const float distC = j - (playerY - visibleTiles.y / 2);
-				const float distD = (playerY + visibleTiles.y / 2) - j;
-				float darken, distToEdge;
-
-				// calculate the distance to the closest edge of the visible map
-				// determine the smallest distance
-				distToEdge = distA;
-				if (distB < distToEdge)
-				{
-					distToEdge = distB;
-				}
-				if (distC < distToEdge)
-				{
-					distToEdge = distC;
-				}
-				if (distD < distToEdge)
-				{
-					distToEdge = distD;
-				}
-
-				darken = (distToEdge) / 2.0f;
-				if (darken <= 0)
-				{
-					lightMapWritePtr[(i + j * lightmapWidth) * lightmapChannels + 0] = 0;
-					lightMapWritePtr[(i + j * lightmapWidth) * lightmapChannels + 1] = 0;
-					lightMapWritePtr[(i + j * lightmapWidth) * lightmapChannels + 2] = 0;
-					lightMapWritePtr[(i + j * lightmapWidth) * lightmapChannels + 3] = 0;
-				}
-				else if (darken < 1)
-				{
-					lightMapWritePtr[(i + j * lightmapWidth) * lightmapChannels + 0] *= darken;
-					lightMapWritePtr[(i + j * lightmapWidth) * lightmapChannels + 1] *= darken;
-					lightMapWritePtr[(i + j * lightmapWidth) * lightmapChannels + 2] *= darken;
-					lightMapWritePtr[(i + j * lightmapWidth) * lightmapChannels + 3] *= darken;
-				}
+				const float darken = std::clamp(std::min(columnFade[i], rowFade), 0.f, 1.f);
+				r[i] = static_cast<uint8_t>(r[i] * darken);
+				g[i] = static_cast<uint8_t>(g[i] * darken);
+				b[i] = static_cast<uint8_t>(b[i] * darken);
+				a[i] = static_cast<uint8_t>(a[i] * darken);
 			}
 		}
+
+		// interleave, and only touch the image where the row changed
+		uint8_t* const pixels = lightmapRowPixels.data();
+		for (int i = 0; i < width; ++i)
+		{
+			pixels[i * 4 + 0] = r[i];
+			pixels[i * 4 + 1] = g[i];
+			pixels[i * 4 + 2] = b[i];
+			pixels[i * 4 + 3] = a[i];
+		}
+		uint8_t* const imageRow = lightMapWritePtr + static_cast<size_t>(j) * lightmapWidth * lightmapChannels;
+		if (memcmp(imageRow, pixels, static_cast<size_t>(width) * 4) == 0)
+		{
+			continue;
+		}
+		int first = 0;
+		while (memcmp(imageRow + first * 4, pixels + first * 4, 4) == 0)
+		{
+			++first;
+		}
+		int last = width - 1;
+		while (memcmp(imageRow + last * 4, pixels + last * 4, 4) == 0)
+		{
+			--last;
+		}
+		memcpy(imageRow + first * 4, pixels + first * 4, static_cast<size_t>(last - first + 1) * 4);
+		changed.unite(CullRect{first, j, last + 1, j + 1});
+	}
+	return changed;
+}
+
+/// Upload the `changed` part of the lightmap image to the texture
+static void uploadLightMapRect(const CullRect& changed)
+{
+	if (changed.empty())
+	{
+		return;
+	}
+	const size_t changedArea = static_cast<size_t>(changed.x2 - changed.x1) * static_cast<size_t>(changed.y2 - changed.y1);
+	if (changedArea * 2 >= lightmapWidth * lightmapHeight)
+	{
+		lightmap_texture->upload(0, *(lightmapPixmap.get()));
+		return;
+	}
+
+	const size_t channels = lightmapPixmap->channels();
+	const size_t rowBytes = static_cast<size_t>(changed.x2 - changed.x1) * channels;
+	if (lightmapUploadPixmap.width() != static_cast<unsigned>(changed.x2 - changed.x1) || lightmapUploadPixmap.height() != static_cast<unsigned>(changed.y2 - changed.y1))
+	{
+		if (!lightmapUploadPixmap.allocate(changed.x2 - changed.x1, changed.y2 - changed.y1, static_cast<unsigned>(channels)))
+		{
+			debug(LOG_ERROR, "Failed to allocate lightmap upload buffer");
+			lightmap_texture->upload(0, *(lightmapPixmap.get()));
+			return;
+		}
+	}
+	const unsigned char* src = lightmapPixmap->bmp();
+	unsigned char* dst = lightmapUploadPixmap.bmp_w();
+	for (int y = changed.y1; y < changed.y2; ++y)
+	{
+		memcpy(dst + static_cast<size_t>(y - changed.y1) * rowBytes, src + (static_cast<size_t>(y) * lightmapWidth + changed.x1) * channels, rowBytes);
 	}
+	lightmap_texture->upload_sub(0, changed.x1, changed.y1, lightmapUploadPixmap);
 }
 
 static void cullTerrain(WorldMapState& mapState)
 {
 	const float maxDistance = static_cast<float>(world_coord(terrainDistance));
 	const float maxDistanceSquared = maxDistance * maxDistance;
+	const float playerX = static_cast<float>(playerPos.p.x);
+	const float playerY = static_cast<float>(playerPos.p.z);
 
-	for (int x = 0; x < xSectors; x++)
+	for (int sector : visibleSectors)
 	{
-		for (int y = 0; y < ySectors; y++)
+		sectors[sector].draw = false;
+	}
+	visibleSectors.clear();
+
+	// A sector is drawn if its centre is within range, and sector centres lie inside the node bounds,
+	// so a node is skipped if its closest point is out of range and accepted whole if its furthest corner is in range.
+	auto testNode = [&](const CullRect& bounds) {
+		const float x1 = world_coord(bounds.x1), x2 = world_coord(bounds.x2);
+		const float y1 = world_coord(bounds.y1), y2 = world_coord(bounds.y2);
+		const float nearX = std::clamp(playerX, x1, x2) - playerX;
+		const float nearY = std::clamp(playerY, y1, y2) - playerY;
+		if (nearX * nearX + nearY * nearY > maxDistanceSquared)
 		{
+			return CullResult::Outside;
+		}
+		const float farX = std::max(std::abs(playerX - x1), std::abs(playerX - x2));
+		const float farY = std::max(std::abs(playerY - y1), std::abs(playerY - y2));
+		return (farX * farX + farY * farY <= maxDistanceSquared) ? CullResult::Inside : CullResult::Intersecting;
+	};
+
+	terrainCullStats = CullStats();
+	sectorTree.query(testNode, [&](int sector, bool fullyInside) {
+		if (!fullyInside)
+		{
+			const int x = sector / ySectors;
+			const int y = sector % ySectors;
 			float xPos = world_coord(x * sectorSize + sectorSize / 2);
 			float yPos = world_coord(y * sectorSize + sectorSize / 2);
-			float xDelta = playerPos.p.x - xPos;
-			float yDelta = playerPos.p.z - yPos;
-			float distance = xDelta * xDelta + yDelta * yDelta;
-
-			if (distance > maxDistanceSquared)
+			float xDelta = playerX - xPos;
+			float yDelta = playerY - yPos;
+			if (xDelta * xDelta + yDelta * yDelta > maxDistanceSquared)
 			{
-				sectors[x * ySectors + y].draw = false;
-			}
-			else
-			{
-				sectors[x * ySectors + y].draw = true;
-				if (sectors[x * ySectors + y].dirty)
-				{
-					updateSectorGeometry(mapState, x, y);
-					sectors[x * ySectors + y].dirty = false;
-				}
+				return;
 			}
 		}
+		visibleSectors.push_back(sector);
+	}, terrainCullStats);
+
+	// Keep index order, so neighbouring sectors still merge into one draw call in batchDrawElements
+	std::sort(visibleSectors.begin(), visibleSectors.end());
+	for (int sector : visibleSectors)
+	{
+		sectors[sector].draw = true;
 	}
+	updateDirtySectorGeometry(mapState, visibleSectors);
+}
+
+CullStats getTerrainCullStats()
+{
+	return terrainCullStats;
 }
 
 /// Near-camera tessellation level for the Terrain Detail setting
@@ -1842,17 +2099,9 @@ static void drawDepthOnly(const glm::mat4 &ModelViewProjection, const glm::vec4
 		gfx_api::context::get().set_polygon_offset(0.1f, 1.f);
 	}
 
-	for (int x = 0; x < xSectors; x++)
+	for (int sector : visibleSectors)
 	{
-		for (int y = 0; y < ySectors; y++)
-		{
-			if (sectors[x * ySectors + y].draw)
-			{
-				batchDrawElements<gfx_api::TerrainDepth>(
-					sectors[x * ySectors + y].geometryIndexSize,
-					sectors[x * ySectors + y].geometryIndexOffset);
-			}
-		}
+		batchDrawElements<gfx_api::TerrainDepth>(sectors[sector].geometryIndexSize, sectors[sector].geometryIndexOffset);
 	}
 	flushDrawElementsBatch<gfx_api::TerrainDepth>();
 	if (withOffset)
@@ -1879,17 +2128,9 @@ static void drawDepthOnlyForDepthMapTess(const glm::mat4 &ModelViewProjection, c
 	terrainTessParams(), renderState.fogEnabled, renderState.fogBegin, renderState.fogEnd, 0.f });
 	gfx_api::context::get().bind_index_buffer(*terrainPatchIndexVBO, gfx_api::index_type::u32);
 
-	for (int x = 0; x < xSectors; x++)
+	for (int sector : visibleSectors)
 	{
-		for (int y = 0; y < ySectors; y++)
-		{
-			if (sectors[x * ySectors + y].draw)
-			{
-				batchDrawElements<gfx_api::TerrainDepthOnlyForDepthMapTess>(
-					sectors[x * ySectors + y].patchIndexSize,
-					sectors[x * ySectors + y].patchIndexOffset);
-			}
-		}
+		batchDrawElements<gfx_api::TerrainDepthOnlyForDepthMapTess>(sectors[sector].patchIndexSize, sectors[sector].patchIndexOffset);
 	}
 	flushDrawElementsBatch<gfx_api::TerrainDepthOnlyForDepthMapTess>();
 	gfx_api::TerrainDepthOnlyForDepthMapTess::get().unbind_vertex_buffers(terrainDecalVBO);
@@ -1920,17 +2161,9 @@ static void drawDepthOnlyForDepthMap(const glm::mat4 &ModelViewProjection, const
 //		gfx_api::context::get().set_polygon_offset(0.1f, 1.f);
 //	}
 
-	for (int x = 0; x < xSectors; x++)
+	for (int sector : visibleSectors)
 	{
-		for (int y = 0; y < ySectors; y++)
-		{
-			if (sectors[x * ySectors + y].draw)
-			{
-				batchDrawElements<gfx_api::TerrainDepthOnlyForDepthMap>(
-					sectors[x * ySectors + y].geometryIndexSize,
-					sectors[x * ySectors + y].geometryIndexOffset);
-			}
-		}
+		batchDrawElements<gfx_api::TerrainDepthOnlyForDepthMap>(sectors[sector].geometryIndexSize, sectors[sector].geometryIndexOffset);
 	}
 	flushDrawElementsBatch<gfx_api::TerrainDepthOnlyForDepthMap>();
 //	if (withOffset)
@@ -1979,17 +2212,9 @@ static void drawTerrainCombinedmpl(const glm::mat4 &ModelViewProjection, const g
 	};
 	PSO::get().set_uniforms(uniforms);
 
-	for (int x = 0; x < xSectors; x++)
+	for (int sector : visibleSectors)
 	{
-		for (int y = 0; y < ySectors; y++)
-		{
-			if (sectors[x * ySectors + y].draw)
-			{
-				batchDrawElements<PSO>(
-					sectors[x * ySectors + y].terrainAndDecalIndexSize,
-					sectors[x * ySectors + y].terrainAndDecalIndexOffset);
-			}
-		}
+		batchDrawElements<PSO>(sectors[sector].terrainAndDecalIndexSize, sectors[sector].terrainAndDecalIndexOffset);
 	}
 	flushDrawElementsBatch<PSO>();
 	PSO::get().unbind_vertex_buffers(terrainDecalVBO);
@@ -2036,17 +2261,9 @@ static void drawTerrainCombinedTessImpl(const glm::mat4 &ModelViewProjection, co
 	// the rasterized position, so the drawn terrain is unaffected.
 	gfx_api::context::get().set_polygon_offset(0.1f, 1.f);
 
-	for (int x = 0; x < xSectors; x++)
+	for (int sector : visibleSectors)
 	{
-		for (int y = 0; y < ySectors; y++)
-		{
-			if (sectors[x * ySectors + y].draw)
-			{
-				batchDrawElements<PSO>(
-					sectors[x * ySectors + y].patchIndexSize,
-					sectors[x * ySectors + y].patchIndexOffset);
-			}
-		}
+		batchDrawElements<PSO>(sectors[sector].patchIndexSize, sectors[sector].patchIndexOffset);
 	}
 	flushDrawElementsBatch<PSO>();
 	gfx_api::context::get().set_polygon_offset(0.f, 0.f);
@@ -2098,9 +2315,7 @@ void perFrameTerrainUpdates(WorldMapState& mapState, const LightMap& lightMap)
 	if (realTime - lightmapLastUpdate >= LIGHTMAP_REFRESH)
 	{
 		lightmapLastUpdate = realTime;
-		updateLightMap(mapState, lightMap);
-
-		lightmap_texture->upload(0, *(lightmapPixmap.get()));
+		uploadLightMapRect(updateLightMap(mapState, lightMap));
 	}
 
 	///////////////////////////////////
@@ -2192,17 +2407,9 @@ void drawWaterNormalImpl(const glm::mat4 &ModelViewProjection, const Vector3f &c
 
 	gfx_api::context::get().bind_index_buffer(*waterIndexVBO, gfx_api::index_type::u32);
 
-	for (int x = 0; x < xSectors; x++)
+	for (int sector : visibleSectors)
 	{
-		for (int y = 0; y < ySectors; y++)
-		{
-			if (sectors[x * ySectors + y].draw)
-			{
-				batchDrawElements<PSO>(
-				                     sectors[x * ySectors + y].waterIndexSize,
-				                     sectors[x * ySectors + y].waterIndexOffset);
-			}
-		}
+		batchDrawElements<PSO>(sectors[sector].waterIndexSize, sectors[sector].waterIndexOffset);
 	}
 	flushDrawElementsBatch<PSO>();
 	PSO::get().unbind_vertex_buffers(waterVBO);
@@ -2249,17 +2456,9 @@ void drawWaterHighImpl(const glm::mat4 &ModelViewProjection, const glm::mat4& vi
 
 	gfx_api::context::get().bind_index_buffer(*waterIndexVBO, gfx_api::index_type::u32);
 
-	for (int x = 0; x < xSectors; x++)
+	for (int sector : visibleSectors)
 	{
-		for (int y = 0; y < ySectors; y++)
-		{
-			if (sectors[x * ySectors + y].draw)
-			{
-				batchDrawElements<PSO>(
-									 sectors[x * ySectors + y].waterIndexSize,
-									 sectors[x * ySectors + y].waterIndexOffset);
-			}
-		}
+		batchDrawElements<PSO>(sectors[sector].waterIndexSize, sectors[sector].waterIndexOffset);
 	}
 	flushDrawElementsBatch<PSO>();
 	PSO::get().unbind_vertex_buffers(waterVBO);
@@ -2303,17 +2502,9 @@ void drawWaterClassic(const glm::mat4 &ModelViewProjection, const glm::mat4 &Mod
 
 	gfx_api::context::get().bind_index_buffer(*waterIndexVBO, gfx_api::index_type::u32);
 
-	for (int x = 0; x < xSectors; x++)
+	for (int sector : visibleSectors)
 	{
-		for (int y = 0; y < ySectors; y++)
-		{
-			if (sectors[x * ySectors + y].draw)
-			{
-				batchDrawElements<gfx_api::WaterClassicPSO>(
-									 sectors[x * ySectors + y].waterIndexSize,
-									 sectors[x * ySectors + y].waterIndexOffset);
-			}
-		}
+		batchDrawElements<gfx_api::WaterClassicPSO>(sectors[sector].waterIndexSize, sectors[sector].waterIndexOffset);
 	}
 	flushDrawElementsBatch<gfx_api::WaterClassicPSO>();
 	gfx_api::WaterClassicPSO::get().unbind_vertex_buffers(waterVBO);
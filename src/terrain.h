@@ -29,6 +29,7 @@
 #include "terrain_defs.h"
 #include "lib/framework/loading_task_fwd.h"
 
+struct CullStats;
 struct ShadowCascadesInfo;
 struct LightMap;
 struct WorldMapState;
@@ -62,6 +63,8 @@ const glm::mat4& getModelUVLightmapMatrix();
 
 void markTileDirty(int i, int j);
 void dirtyAllSectors();
+/// Counters for the sector culling of the last frame
+CullStats getTerrainCullStats();
 
 enum TerrainShaderType
 {
@@ -92,6 +92,7 @@ struct WARZONE_GLOBALS
 	int autoNotReadyKickSeconds = 0;
 	bool disableReplayRecording = false;
 	bool devForceOldSavegameLoad = false;
+	bool concurrentAIScripts = false;
 	int maxReplaysSaved = MAX_REPLAY_FILES;
 	int oldLogsLimit = MAX_OLD_LOGS;
 	uint32_t MPinactivityMinutes = 5;
@@ -675,6 +676,16 @@ void war_setDisableReplayRecording(bool disable)
 	warGlobs.disableReplayRecording = disable;
 }
 
+bool war_getConcurrentAIScripts()
+{
+	return warGlobs.concurrentAIScripts;
+}
+
+void war_setConcurrentAIScripts(bool enabled)
+{
+	warGlobs.concurrentAIScripts = enabled;
+}
+
 bool war_getDevForceOldSavegameLoad()
 {
 	return warGlobs.devForceOldSavegameLoad;
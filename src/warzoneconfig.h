@@ -192,6 +192,9 @@ int war_getAutoNotReadyKickSeconds();
 void war_setAutoNotReadyKickSeconds(int seconds);
 bool war_getDisableReplayRecording();
 void war_setDisableReplayRecording(bool disable);
+// Run the timers of skirmish AI scripts on worker threads (see scripting_engine::updateScripts)
+bool war_getConcurrentAIScripts();
+void war_setConcurrentAIScripts(bool enabled);
 // Dev-only: force preferring the legacy folder savegame over the new GameState blob when a save has both.
 bool war_getDevForceOldSavegameLoad();
 void war_setDevForceOldSavegameLoad(bool force);
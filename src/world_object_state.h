@@ -38,6 +38,8 @@ struct WorldObjectState
 	PerPlayerFeatureLists features;
 	PerPlayerFlagPositionLists flags; ///< The list of Flag Positions allocated
 	PerPlayerExtractorLists extractors;
+	PerPlayerStructureLists repairStructures; ///< Repair facilities and HQs, where droids return to for repairs
+	PerPlayerDroidLists repairDroids; ///< The repair droids of `droids`, in the same order
 	GlobalSensorList sensors; ///< List of sensors in the game.
 	GlobalOilList oils;
 
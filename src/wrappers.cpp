@@ -32,7 +32,9 @@
 #include "lib/ivis_opengl/piemode.h"
 #include "lib/ivis_opengl/piestate.h"
 #include "lib/ivis_opengl/gfx_api.h"
+#include "lib/ivis_opengl/gfx_api_texture_cache.h"
 #include "lib/ivis_opengl/screen.h"
+#include "lib/ivis_opengl/textdraw.h"
 #include "lib/netplay/connection_provider_registry.h"
 #include "lib/netplay/netplay.h"	// multiplayer
 #include "lib/sound/audio.h"
@@ -76,6 +78,11 @@ static bool loadingScreenSessionActive = false;
 static int barLeftX, barLeftY, barRightX, barRightY, boxWidth, boxHeight, starsNum, starHeight;
 static STAR *stars = nullptr;
 
+// Texture cache activity since the loading screen opened
+static gfx_api::TextureCacheStats loadingTextureStatsStart;
+static uint32_t loadingTextureStatsShown = 0;
+static WzText loadingTextureStatsText;
+
 static STAR newStar()
 {
 	STAR s;
@@ -108,6 +115,22 @@ static void renderLoadingScreenPass()
 			pie_UniTransBoxFill(topX, topY, botX, botY, stars[i].colour);
 		}
 	}
+
+	const gfx_api::TextureCacheStats stats = gfx_api::textureCacheStats();
+	const uint32_t hits = stats.hits - loadingTextureStatsStart.hits;
+	const uint32_t misses = stats.misses - loadingTextureStatsStart.misses;
+	if (hits + misses == 0)
+	{
+		return;
+	}
+	if (hits + misses != loadingTextureStatsShown)
+	{
+		const double hitSeconds = (stats.hitMicroseconds - loadingTextureStatsStart.hitMicroseconds) / 1000000.0;
+		const double missSeconds = (stats.missMicroseconds - loadingTextureStatsStart.missMicroseconds) / 1000000.0;
+		loadingTextureStatsText.setText(WzString::fromUtf8(astringf("Textures: %u cached (%.2fs), %u transcoded (%.2fs)", hits, hitSeconds, misses, missSeconds)), font_small);
+		loadingTextureStatsShown = hits + misses;
+	}
+	loadingTextureStatsText.render(barLeftX, barLeftY - 4 - loadingTextureStatsText.belowBase(), WZCOL_TEXT_MEDIUM);
 }
 
 static void setupLoadingScreen()
@@ -334,6 +357,8 @@ void wzemscripten_display_web_loading_indicator(int x)
 void initLoadingScreen(bool drawbdrop)
 {
 	setupLoadingScreen();
+	loadingTextureStatsStart = gfx_api::textureCacheStats();
+	loadingTextureStatsShown = 0;
 	wzShowMouse(false);
 	pie_SetFogStatus(false);
 	loadingScreenSessionActive = true;
@@ -361,6 +386,16 @@ void closeLoadingScreen()
 {
 	loadingScreenSessionActive = false;
 
+	const gfx_api::TextureCacheStats stats = gfx_api::textureCacheStats();
+	if (stats.hits + stats.misses != loadingTextureStatsStart.hits + loadingTextureStatsStart.misses)
+	{
+		debug(LOG_WZ, "Texture cache: %u hits (%" PRIu64 " ms), %u misses (%" PRIu64 " ms), %" PRIu64 " KiB read, %" PRIu64 " KiB written",
+		      stats.hits - loadingTextureStatsStart.hits, (stats.hitMicroseconds - loadingTextureStatsStart.hitMicroseconds) / 1000,
+		      stats.misses - loadingTextureStatsStart.misses, (stats.missMicroseconds - loadingTextureStatsStart.missMicroseconds) / 1000,
+		      (stats.bytesRead - loadingTextureStatsStart.bytesRead) / 1024, (stats.bytesWritten - loadingTextureStatsStart.bytesWritten) / 1024);
+	}
+	loadingTextureStatsText = WzText(); // frees the texture while the graphics context still exists
+
 	if (stars)
 	{
 		free(stars);
@@ -372,7 +372,7 @@ bool wzapi::orderDroidBuild(WZAPI_PARAMS(DROID* psDroid, int order, std::string
 {
 	SCRIPT_ASSERT(false, context, psDroid, "No valid droid provided");
 
-	int structureIndex = getStructStatFromName(WzString::fromUtf8(structureName));
+	int structureIndex = getStructStatFromAtom(statAtomFind(structureName));
 	SCRIPT_ASSERT(false, context, structureIndex >= 0 && structureIndex < numStructureStats, "Structure %s not found", structureName.c_str());
 	STRUCTURE_STATS	*psStats = &asStructureStats[structureIndex];
 
@@ -1237,12 +1237,11 @@ wzapi::researchResults wzapi::enumResearch(WZAPI_NO_PARAMS)
 	researchResults result;
 	int player = context.player();
 	SCRIPT_ASSERT_PLAYER({}, context, player);
-	for (int i = 0; i < asResearch.size(); i++)
+	for (uint16_t i : fillResearchList(player, nonstd::nullopt, UINT16_MAX))
 	{
-		RESEARCH *psResearch = &asResearch[i];
-		if (!IsResearchCompleted(&asPlayerResList[player][i]) && researchAvailable(i, player, ModeQueue))
+		if (!IsResearchCompleted(&asPlayerResList[player][i]))
 		{
-			result.resList.push_back(psResearch);
+			result.resList.push_back(&asResearch[i]);
 		}
 	}
 	result.player = player;
@@ -1308,7 +1307,7 @@ bool wzapi::pursueResearch(WZAPI_PARAMS(const STRUCTURE *psStruct, string_or_str
 	RESEARCH *psResearch = nullptr;  // Dummy initialisation.
 	for (const auto& researchName : research.strings)
 	{
-		RESEARCH *psCurrResearch = ::getResearch(researchName.c_str());
+		RESEARCH *psCurrResearch = getResearchFromAtom(statAtomFind(researchName));
 		SCRIPT_ASSERT(false, context, psCurrResearch, "No such research: %s", researchName.c_str());
 		PLAYER_RESEARCH *plrRes = &asPlayerResList[player][psCurrResearch->index];
 		if (!IsResearchStartedPending(plrRes) && !IsResearchCompleted(plrRes))
@@ -1400,7 +1399,7 @@ wzapi::researchResults wzapi::findResearch(WZAPI_PARAMS(std::string researchName
 	researchResults result;
 	result.player = player;
 
-	RESEARCH *psTarget = ::getResearch(researchName.c_str());
+	RESEARCH *psTarget = getResearchFromAtom(statAtomFind(researchName));
 	SCRIPT_ASSERT({}, context, psTarget, "No such research: %s", researchName.c_str());
 	PLAYER_RESEARCH *plrRes = &asPlayerResList[player][psTarget->index];
 	if (IsResearchStartedPending(plrRes) || IsResearchCompleted(plrRes))
@@ -1494,7 +1493,7 @@ int wzapi::queuedPower(WZAPI_PARAMS(int player))
 //--
 bool wzapi::isStructureAvailable(WZAPI_PARAMS(std::string structureName, optional<int> _player))
 {
-	int structureIndex = getStructStatFromName(WzString::fromUtf8(structureName));
+	int structureIndex = getStructStatFromAtom(statAtomFind(structureName));
 	SCRIPT_ASSERT(false, context, structureIndex >= 0 && structureIndex < numStructureStats, "Structure %s not found", structureName.c_str());
 	int player = _player.value_or(context.player());
 
@@ -1589,7 +1588,7 @@ optional<scr_position> wzapi::pickStructLocation(WZAPI_PARAMS(const DROID *psDro
 	SCRIPT_ASSERT({}, context, psDroid, "No valid droid provided");
 	const int player = psDroid->player;
 	SCRIPT_ASSERT_PLAYER({}, context, player);
-	int structureIndex = getStructStatFromName(WzString::fromUtf8(structureName));
+	int structureIndex = getStructStatFromAtom(statAtomFind(structureName));
 	SCRIPT_ASSERT({}, context, structureIndex >= 0 && structureIndex < numStructureStats, "Structure %s not found", structureName.c_str());
 	STRUCTURE_STATS	*psStat = &asStructureStats[structureIndex];
 	SCRIPT_ASSERT({}, context, psStat, "No such stat found: %s", structureName.c_str());
@@ -1680,7 +1679,7 @@ bool wzapi::structureCanFit(WZAPI_PARAMS(std::string structureName, int x, int y
 {
 	const int player = context.player();
 	SCRIPT_ASSERT_PLAYER(false, context, player);
-	int structureIndex = getStructStatFromName(WzString::fromUtf8(structureName));
+	int structureIndex = getStructStatFromAtom(statAtomFind(structureName));
 	SCRIPT_ASSERT(false, context, structureIndex >= 0 && structureIndex < numStructureStats, "Structure %s not found", structureName.c_str());
 	STRUCTURE_STATS	*psStat = &asStructureStats[structureIndex];
 	SCRIPT_ASSERT(false, context, psStat, "No such stat found: %s", structureName.c_str());
@@ -1714,7 +1713,7 @@ bool wzapi::droidCanReach(WZAPI_PARAMS(const DROID *psDroid, int x, int y))
 //--
 bool wzapi::propulsionCanReach(WZAPI_PARAMS(std::string propulsionName, int x1, int y1, int x2, int y2))
 {
-	int propulsionIndex = getCompFromName(COMP_PROPULSION, WzString::fromUtf8(propulsionName));
+	int propulsionIndex = getCompFromAtom(COMP_PROPULSION, statAtomFind(propulsionName));
 	SCRIPT_ASSERT(false, context, propulsionIndex > 0, "No such propulsion: %s", propulsionName.c_str());
 	const PROPULSION_STATS *psPropStats = &asPropulsionStats[propulsionIndex];
 	return fpathCheck(gameWorld.map, Vector3i(world_coord(x1), world_coord(y1), 0), Vector3i(world_coord(x2), world_coord(y2), 0), psPropStats->propulsionType);
@@ -1764,7 +1763,7 @@ static int get_first_available_component(int player, int capacity, const wzapi::
 {
 	for (const auto& componentName : list.strings)
 	{
-		int componentIndex = getCompFromName(componentType, WzString::fromUtf8(componentName));
+		int componentIndex = getCompFromAtom(componentType, statAtomFind(componentName));
 		if (componentIndex >= 0)
 		{
 			int status = apCompLists[player][componentType][componentIndex];
@@ -1820,7 +1819,7 @@ static std::unique_ptr<DROID_TEMPLATE> makeTemplate(int player, const std::strin
 		return nullptr;
 	}
 	std::string componentName = _turrets.va_list[0].strings[0];
-	COMPONENT_STATS *psComp = getCompStatsFromName(WzString::fromUtf8(componentName.c_str()));
+	COMPONENT_STATS *psComp = getCompStatsFromAtom(statAtomFind(componentName));
 	if (psComp == nullptr)
 	{
 		debug(LOG_ERROR, "Wanted to build %s but %s does not exist", templateName.c_str(), componentName.c_str());
@@ -2037,7 +2036,7 @@ bool wzapi::componentAvailable(WZAPI_PARAMS(std::string componentType, optional<
 	int player = context.player();
 	SCRIPT_ASSERT_PLAYER(false, context, player);
 	std::string &componentName = _componentName.has_value() ? _componentName.value() : componentType;
-	COMPONENT_STATS *psComp = getCompStatsFromName(WzString::fromUtf8(componentName.c_str()));
+	COMPONENT_STATS *psComp = getCompStatsFromAtom(statAtomFind(componentName));
 	SCRIPT_ASSERT(false, context, psComp, "No such component: %s", componentName.c_str());
 	int status = apCompLists[player][psComp->compType][psComp->index];
 	return status == AVAILABLE || status == REDUNDANT;
@@ -2399,7 +2398,7 @@ bool wzapi::isSpectator(WZAPI_PARAMS(int player))
 //--
 nlohmann::json wzapi::getWeaponInfo(WZAPI_PARAMS(std::string weaponName)) WZAPI_DEPRECATED
 {
-	int weaponIndex = getCompFromName(COMP_WEAPON, WzString::fromUtf8(weaponName));
+	int weaponIndex = getCompFromAtom(COMP_WEAPON, statAtomFind(weaponName));
 	SCRIPT_ASSERT(nlohmann::json(), context, weaponIndex >= 0 && weaponIndex < asWeaponStats.size(), "No such weapon: %s", weaponName.c_str());
 	WEAPON_STATS *psStats = &asWeaponStats[weaponIndex];
 	nlohmann::json result = nlohmann::json::object();
@@ -2595,7 +2594,7 @@ bool wzapi::gameOverMessage(WZAPI_PARAMS(bool gameWon, optional<bool> _showBackD
 //--
 bool wzapi::setStructureLimits(WZAPI_PARAMS(std::string structureName, int limit, optional<int> _player))
 {
-	int structureIndex = getStructStatFromName(WzString::fromUtf8(structureName));
+	int structureIndex = getStructStatFromAtom(statAtomFind(structureName));
 	int player = _player.value_or(context.player());
 	SCRIPT_ASSERT_PLAYER(false, context, player);
 	SCRIPT_ASSERT(false, context, limit < LOTS_OF && limit >= 0, "Invalid limit");
@@ -2701,7 +2700,7 @@ wzapi::no_return_value wzapi::completeResearch(WZAPI_PARAMS(std::string research
 	int player = _player.value_or(context.player());
 	SCRIPT_ASSERT_PLAYER({}, context, player);
 	bool forceIt = _forceResearch.value_or(false);
-	RESEARCH *psResearch = ::getResearch(researchName.c_str());
+	RESEARCH *psResearch = getResearchFromAtom(statAtomFind(researchName));
 	SCRIPT_ASSERT({}, context, psResearch, "No such research %s for player %d", researchName.c_str(), player);
 	SCRIPT_ASSERT({}, context, psResearch->index < asResearch.size(), "Research index out of bounds");
 	PLAYER_RESEARCH *plrRes = &asPlayerResList[player][psResearch->index];
@@ -2757,7 +2756,7 @@ bool wzapi::enableResearch(WZAPI_PARAMS(std::string researchName, optional<int>
 {
 	int player = _player.value_or(context.player());
 	SCRIPT_ASSERT_PLAYER(false, context, player);
-	RESEARCH *psResearch = ::getResearch(researchName.c_str());
+	RESEARCH *psResearch = getResearchFromAtom(statAtomFind(researchName));
 	SCRIPT_ASSERT(false, context, psResearch, "No such research %s for player %d", researchName.c_str(), player);
 	if (!::enableResearch(psResearch, player))
 	{
@@ -3006,7 +3005,7 @@ wzapi::no_return_value wzapi::hideInterface(WZAPI_NO_PARAMS)
 //--
 wzapi::no_return_value wzapi::enableStructure(WZAPI_PARAMS(std::string structureName, optional<int> _player))
 {
-	int structureIndex = getStructStatFromName(WzString::fromUtf8(structureName));
+	int structureIndex = getStructStatFromAtom(statAtomFind(structureName));
 	int player = _player.value_or(context.player());
 	SCRIPT_ASSERT_PLAYER({}, context, player);
 	SCRIPT_ASSERT({}, context, structureIndex >= 0 && structureIndex < numStructureStats, "Structure %s not found", structureName.c_str());
@@ -3017,7 +3016,7 @@ wzapi::no_return_value wzapi::enableStructure(WZAPI_PARAMS(std::string structure
 
 static void setComponent(const std::string& componentName, int player, int availability)
 {
-	COMPONENT_STATS *psComp = getCompStatsFromName(WzString::fromUtf8(componentName));
+	COMPONENT_STATS *psComp = getCompStatsFromAtom(statAtomFind(componentName));
 	ASSERT_OR_RETURN(, psComp, "Bad component %s", componentName.c_str());
 	apCompLists[player][psComp->compType][psComp->index] = availability;
 }
@@ -3147,7 +3146,7 @@ scr_area wzapi::getScrollLimits(WZAPI_NO_PARAMS)
 //--
 wzapi::returned_nullable_ptr<const STRUCTURE> wzapi::addStructure(WZAPI_PARAMS(std::string structureName, int player, int x, int y, optional<int> _direction))
 {
-	int structureIndex = getStructStatFromName(WzString::fromUtf8(structureName.c_str()));
+	int structureIndex = getStructStatFromAtom(statAtomFind(structureName));
 	SCRIPT_ASSERT(nullptr, context, structureIndex >= 0 && structureIndex < numStructureStats, "Structure %s not found", structureName.c_str());
 	SCRIPT_ASSERT_PLAYER(nullptr, context, player);
 
@@ -3170,7 +3169,7 @@ wzapi::returned_nullable_ptr<const STRUCTURE> wzapi::addStructure(WZAPI_PARAMS(s
 //--
 unsigned int wzapi::getStructureLimit(WZAPI_PARAMS(std::string structureName, optional<int> _player))
 {
-	int structureIndex = getStructStatFromName(WzString::fromUtf8(structureName.c_str()));
+	int structureIndex = getStructStatFromAtom(statAtomFind(structureName));
 	SCRIPT_ASSERT(0, context, structureIndex >= 0 && structureIndex < numStructureStats, "Structure %s not found", structureName.c_str());
 	int player = _player.value_or(context.player());
 	SCRIPT_ASSERT_PLAYER(0, context, player);
@@ -3184,7 +3183,7 @@ unsigned int wzapi::getStructureLimit(WZAPI_PARAMS(std::string structureName, op
 //--
 int wzapi::countStruct(WZAPI_PARAMS(std::string structureName, optional<int> _playerFilter))
 {
-	int structureIndex = getStructStatFromName(WzString::fromUtf8(structureName.c_str()));
+	int structureIndex = getStructStatFromAtom(statAtomFind(structureName));
 	SCRIPT_ASSERT(-1, context, structureIndex >= 0 && structureIndex < numStructureStats, "Structure %s not found", structureName.c_str());
 	int me = context.player();
 	int playerFilter = _playerFilter.value_or(me);
@@ -3412,7 +3411,7 @@ wzapi::no_return_value wzapi::setObjectFlag(WZAPI_PARAMS(BASE_OBJECT *psObj, int
 //--
 wzapi::no_return_value wzapi::fireWeaponAtLoc(WZAPI_PARAMS(std::string weaponName, int x, int y, optional<int> _player, optional<bool> center))
 {
-	int weaponIndex = getCompFromName(COMP_WEAPON, WzString::fromUtf8(weaponName));
+	int weaponIndex = getCompFromAtom(COMP_WEAPON, statAtomFind(weaponName));
 	SCRIPT_ASSERT({}, context, weaponIndex > 0, "No such weapon: %s", weaponName.c_str());
 
 	int player = _player.value_or(context.player());
@@ -3441,7 +3440,7 @@ wzapi::no_return_value wzapi::fireWeaponAtLoc(WZAPI_PARAMS(std::string weaponNam
 //--
 wzapi::no_return_value wzapi::fireWeaponAtObj(WZAPI_PARAMS(std::string weaponName, BASE_OBJECT *psObj, optional<int> _player))
 {
-	int weaponIndex = getCompFromName(COMP_WEAPON, WzString::fromUtf8(weaponName));
+	int weaponIndex = getCompFromAtom(COMP_WEAPON, statAtomFind(weaponName));
 	SCRIPT_ASSERT({}, context, weaponIndex > 0, "No such weapon: %s", weaponName.c_str());
 	SCRIPT_ASSERT({}, context, psObj, "No valid object provided");
 
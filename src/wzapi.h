@@ -601,6 +601,17 @@ namespace wzapi
 		inline void setReceiveAllEvents(bool value) { m_isReceivingAllEvents = value; }
 		inline bool isReceivingAllEvents() const { return m_isReceivingAllEvents; }
 
+	public:
+		// Concurrent AI timers (see `scripting_engine::updateScripts`)
+		// Whether this instance's timers may run on a worker thread, alongside those of other such instances.
+		// Set before the script is loaded; only skirmish AIs are run this way.
+		inline void setRunsConcurrently(bool value) { m_runsConcurrently = value; }
+		inline bool runsConcurrently() const { return m_runsConcurrently; }
+		// Called on the thread that is about to run this instance's code
+		virtual void enterThread() { }
+		// Runs the game-changing API calls the instance recorded while its timers ran concurrently. Main thread only.
+		virtual void applyDeferredCalls() { }
+
 	public:
 		// Helpers for loading a file from the "context" of a scripting_instance
 		class LoadFileSearchOptions
@@ -664,6 +675,8 @@ namespace wzapi
 	public:
 		virtual void updateGameTime(uint32_t gameTime) = 0;
 		virtual void updateGroupSizes(int group, int size) = 0;
+		// `psObj` is leaving the game (destroyed, or given to another player), and can no longer be looked up by id
+		virtual void objectRemoved(const BASE_OBJECT *psObj) { }
 
 		// set "global" variables
 		//
@@ -687,6 +700,7 @@ namespace wzapi
 		std::string m_scriptName;
 		std::string m_scriptPath;
 		bool m_isReceivingAllEvents = false;
+		bool m_runsConcurrently = false;
 	};
 
 	class execution_context_base
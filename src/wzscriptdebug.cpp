@@ -81,6 +81,7 @@
 #include "multistat.h"
 #include "lighting.h"
 #include "texture.h"
+#include "terrain.h"
 #include "warzoneconfig.h"
 #include "component.h"
 
@@ -287,6 +288,11 @@ static nlohmann::ordered_json fillMainModel()
 	result["difficultyLevel"] = difficulty_type.at(getDifficultyLevel());
 	result["loopPieCount"] = loopPieCount;
 	result["loopPolyCount"] = loopPolyCount;
+	const CullStats terrainCull = getTerrainCullStats();
+	result["terrainCull.nodesTested"] = terrainCull.nodesTested;
+	result["terrainCull.nodesRejected"] = terrainCull.nodesRejected;
+	result["objectCull.nodesTested"] = loopStaticCullStats.nodesTested;
+	result["objectCull.nodesRejected"] = loopStaticCullStats.nodesRejected;
 	result["allowDesign"] = allowDesign;
 	result["includeRedundantDesigns"] = includeRedundantDesigns;
 
@@ -585,6 +591,7 @@ public:
 		previousRowButton = panel->createButton(0, "Add droids", [](){ intOpenDebugMenu(OBJ_DROID); }, nullptr, true);
 		previousRowButton = panel->createButton(0, "Add structures", [](){ intOpenDebugMenu(OBJ_STRUCTURE); }, previousRowButton, true);
 		previousRowButton = panel->createButton(0, "Add features", [](){ intOpenDebugMenu(OBJ_FEATURE); }, previousRowButton, true);
+		previousRowButton = panel->createButton(0, "UI redraws", [](){ widgSetDebugRedrawRegions(!widgGetDebugRedrawRegions()); }, previousRowButton, false);
 
 		previousRowButton = panel->createButton(1, "Research all", kf_FinishAllResearch, nullptr, true);
 		previousRowButton = panel->createButton(1, "Show sensors", kf_ToggleSensorDisplay, previousRowButton, false);
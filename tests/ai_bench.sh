@@ -0,0 +1,46 @@
+#!/bin/bash
+
+# Runs the bundled AIs against each other headlessly, once with game objects handed to scripts as
+# proxies, once as snapshots (WZ_JS_OBJECT_SNAPSHOTS) and once with the AI timers running concurrently
+# (--concurrent-ai), and compares the time spent in scripts.
+#
+# usage: tests/ai_bench.sh [path to warzone2100] [skirmish setup] [game minutes]
+
+WZ=${1:-src/warzone2100}
+SETUP=${2:-miza}
+MINUTES=${3:-20}
+
+trap ctrl_c INT
+
+function ctrl_c() {
+	echo " * Caught ctrl+c - aborting!"
+	exit 1
+}
+
+# Sums calls * avg over the performance tables the scripts write to logs/ at shutdown
+function script_time
+{
+	cat "$1"/logs/*.log 2>/dev/null | awk -F'|' '
+		NF == 7 && $1 ~ /^ *[0-9]+ *$/ { total += $1 * $2; calls += $1 }
+		END { printf "%d calls, %.1f ms in scripts\n", calls, total / 1000 }'
+}
+
+function run
+{
+	local configdir="tmp/ai_bench_$1"
+	rm -rf "$configdir"
+	mkdir -p "$configdir"
+	echo
+	echo " -- $1 --"
+	local start=$(date +%s)
+	env $2 "$WZ" --headless --autogame --skirmish=$SETUP.json --gametimelimit=$MINUTES --configdir="$configdir" $3 > "$configdir/stdout.txt" 2>&1
+	local status=$?
+	local end=$(date +%s)
+	echo "exit status $status, $((end - start)) s wall time"
+	script_time "$configdir"
+}
+
+echo "Benchmarking AI scripts: $SETUP.json, $MINUTES game minutes"
+run proxies ""
+run snapshots "WZ_JS_OBJECT_SNAPSHOTS=1"
+run concurrent "" --concurrent-ai
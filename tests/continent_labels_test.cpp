@@ -0,0 +1,164 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+	This file is part of Warzone 2100.
+	Copyright (C) 2026  Warzone 2100 Project (https://github.com/Warzone2100)
+
+	Warzone 2100 is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	Warzone 2100 is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Warzone 2100; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+// Standalone unit tests for src/continent_labels.h (no framework, no
+// game dependencies). Build and run:
+//   c++ -std=c++20 -Isrc tests/continent_labels_test.cpp -o continent_labels_test && ./continent_labels_test
+// or via CMake with -DWZ_BUILD_CONTINENT_LABELS_TEST=ON (target: continent_labels_test).
+// Exits nonzero on failure.
+
+#include "continent_labels.h"
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace continentLabels;
+
+static const int ringDx[8] = {0, -1, -1, -1, 0, 1, 1, 1};
+static const int ringDy[8] = {1, 1, 0, -1, -1, -1, 0, 1};
+
+static int failures = 0;
+static int checks = 0;
+
+#define CHECK_TRUE(cond, ...) \
+	do { \
+		checks++; \
+		if (!(cond)) { \
+			failures++; \
+			std::printf("FAIL %s:%d: ", __FILE__, __LINE__); \
+			std::printf(__VA_ARGS__); \
+			std::printf("\n"); \
+		} \
+	} while (0)
+
+static std::mt19937 rng(7654321);
+
+struct Grid
+{
+	int width, height;
+	std::vector<uint8_t> cls;
+	std::vector<uint16_t> label;
+
+	Grid(int w, int h) : width(w), height(h), cls(w * h, 0), label(w * h, 0) {}
+
+	uint8_t classAt(int x, int y) const
+	{
+		return (x < 1 || y < 1 || x > width - 2 || y > height - 2) ? 0 : cls[x + y * width];
+	}
+};
+
+// The flood fill that mapFloodFillContinents() used before the disjoint-set labelling.
+static std::vector<uint16_t> referenceFlood(const Grid &g)
+{
+	std::vector<uint16_t> out(g.width * g.height, 0);
+	uint16_t next = 0;
+	for (int y = 1; y < g.height - 2; y++)
+	{
+		for (int x = 1; x < g.width - 2; x++)
+		{
+			if (out[x + y * g.width] != 0 || g.classAt(x, y) == 0)
+			{
+				continue;
+			}
+			const uint8_t c = g.classAt(x, y);
+			const uint16_t label = ++next;
+			std::vector<std::pair<int, int>> open{{x, y}};
+			out[x + y * g.width] = label;
+			while (!open.empty())
+			{
+				auto pos = open.back();
+				open.pop_back();
+				for (int d = 0; d < 8; d++)
+				{
+					const int nx = pos.first + ringDx[d], ny = pos.second + ringDy[d];
+					if (nx < 1 || ny < 1 || nx > g.width - 2 || ny > g.height - 2)
+					{
+						continue;
+					}
+					if (g.classAt(nx, ny) == c && out[nx + ny * g.width] == 0)
+					{
+						out[nx + ny * g.width] = label;
+						open.emplace_back(nx, ny);
+					}
+				}
+			}
+		}
+	}
+	return out;
+}
+
+static void randomize(Grid &g, int numClasses, int blockedPercent)
+{
+	std::uniform_int_distribution<int> pct(0, 99);
+	std::uniform_int_distribution<int> cl(1, numClasses);
+	for (int y = 1; y < g.height - 1; y++)
+	{
+		for (int x = 1; x < g.width - 1; x++)
+		{
+			g.cls[x + y * g.width] = pct(rng) < blockedPercent ? 0 : static_cast<uint8_t>(cl(rng));
+		}
+	}
+}
+
+static uint32_t labelGrid(Grid &g)
+{
+	return labelAll(g.width, g.height,
+	                [&](int x, int y) { return g.classAt(x, y); },
+	                [](int, int) { return true; },
+	                [&](int x, int y, uint16_t l) { g.label[x + y * g.width] = l; });
+}
+
+// MARK: - Full labelling
+
+static void testLabelAllMatchesFloodFill()
+{
+	for (int trial = 0; trial < 200; trial++)
+	{
+		Grid g(8 + trial % 37, 8 + (trial * 7) % 41);
+		randomize(g, 1 + trial % 2, 10 + trial % 60);
+		labelGrid(g);
+		const std::vector<uint16_t> expected = referenceFlood(g);
+		CHECK_TRUE(g.label == expected, "labels differ from flood fill (trial %d)", trial);
+	}
+}
+
+static void testUnseededContinentsStayUnlabelled()
+{
+	// A single tile in the last interior column is only reachable from the scan region via its neighbours.
+	Grid g(6, 6);
+	g.cls[4 + 2 * 6] = 1;
+	CHECK_TRUE(labelGrid(g) == 0, "unexpected continent");
+	CHECK_TRUE(g.label[4 + 2 * 6] == 0, "tile outside the scan region got a label");
+
+	g.cls[3 + 2 * 6] = 1;
+	CHECK_TRUE(labelGrid(g) == 1, "expected one continent");
+	CHECK_TRUE(g.label[4 + 2 * 6] == 1 && g.label[3 + 2 * 6] == 1, "connected tile not labelled");
+}
+
+int main()
+{
+	testLabelAllMatchesFloodFill();
+	testUnseededContinentsStayUnlabelled();
+
+	std::printf("%s: %d checks, %d failures\n", failures == 0 ? "PASS" : "FAIL", checks, failures);
+	return failures == 0 ? 0 : 1;
+}
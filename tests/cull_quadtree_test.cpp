@@ -0,0 +1,159 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+	This file is part of Warzone 2100.
+	Copyright (C) 2026  Warzone 2100 Project (https://github.com/Warzone2100)
+
+	Warzone 2100 is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	Warzone 2100 is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Warzone 2100; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+// Standalone unit tests for CullQuadtree in lib/ivis_opengl/culling.h (header-only, needs
+// only glm). Build and run:
+//   c++ -std=c++20 -I3rdparty/glm -Ilib/ivis_opengl tests/cull_quadtree_test.cpp -o cull_quadtree_test && ./cull_quadtree_test
+// or via CMake with -DWZ_BUILD_CULL_QUADTREE_TEST=ON (target: cull_quadtree_test).
+// Exits nonzero on failure.
+
+#include "culling.h"
+
+#include <cstdio>
+#include <map>
+#include <random>
+#include <set>
+
+static int failures = 0;
+static int checks = 0;
+
+#define CHECK_TRUE(cond, ...) \
+	do { \
+		checks++; \
+		if (!(cond)) { \
+			failures++; \
+			std::printf("FAIL %s:%d: ", __FILE__, __LINE__); \
+			std::printf(__VA_ARGS__); \
+			std::printf("\n"); \
+		} \
+	} while (0)
+
+static std::mt19937 rng(20260419);
+
+static CullResult testAgainst(const CullRect& view, const CullRect& bounds)
+{
+	if (!view.intersects(bounds))
+	{
+		return CullResult::Outside;
+	}
+	return view.contains(bounds) ? CullResult::Inside : CullResult::Intersecting;
+}
+
+static std::set<int> query(const CullQuadtree<int>& tree, const CullRect& view, CullStats& stats)
+{
+	std::set<int> result;
+	tree.query([&view](const CullRect& bounds) { return testAgainst(view, bounds); },
+	           [&result](int item, bool) { result.insert(item); }, stats);
+	return result;
+}
+
+// Random inserts / removes / re-inserts, checked against a brute-force list after every batch.
+static void testMatchesBruteForce()
+{
+	for (int round = 0; round < 40; ++round)
+	{
+		const int width = 1 + static_cast<int>(rng() % 256);
+		const int height = 1 + static_cast<int>(rng() % 256);
+		CullQuadtree<int> tree;
+		tree.reset(width, height, 8);
+		std::map<int, CullRect> reference;
+
+		for (int op = 0; op < 3000; ++op)
+		{
+			const int item = static_cast<int>(rng() % 400);
+			if (rng() % 3 != 0)
+			{
+				const int x = static_cast<int>(rng() % width);
+				const int y = static_cast<int>(rng() % height);
+				const CullRect bounds{x - 2, y - 2, x + 3 + static_cast<int>(rng() % 3), y + 3 + static_cast<int>(rng() % 3)};
+				tree.insert(item, bounds);
+				reference[item] = bounds;
+			}
+			else
+			{
+				const bool removed = tree.remove(item);
+				CHECK_TRUE(removed == (reference.erase(item) != 0), "remove(%d) returned %d", item, removed);
+			}
+		}
+		CHECK_TRUE(tree.size() == reference.size(), "size %zu, expected %zu", tree.size(), reference.size());
+
+		for (int q = 0; q < 50; ++q)
+		{
+			const int x = static_cast<int>(rng() % width);
+			const int y = static_cast<int>(rng() % height);
+			const CullRect view{x - 32, y - 32, x + 32, y + 24};
+			CullStats stats;
+			const std::set<int> found = query(tree, view, stats);
+			for (const auto& entry : reference)
+			{
+				CHECK_TRUE(!view.intersects(entry.second) || found.count(entry.first), "visible item %d not returned", entry.first);
+			}
+			CHECK_TRUE(stats.nodesRejected <= stats.nodesTested, "more nodes rejected than tested");
+		}
+	}
+}
+
+// Only the nodes near the view are looked at, however big the map.
+static void testCostFollowsView()
+{
+	CullQuadtree<int> tree;
+	tree.reset(256, 256, 8);
+	int next = 0;
+	for (int y = 0; y < 256; y += 2)
+	{
+		for (int x = 0; x < 256; x += 2)
+		{
+			tree.insert(next++, CullRect{x, y, x + 1, y + 1});
+		}
+	}
+	CullStats stats;
+	const std::set<int> found = query(tree, CullRect{100, 100, 116, 116}, stats);
+	CHECK_TRUE(found.size() >= 64 && found.size() < 200, "unexpected item count %zu", found.size());
+	CHECK_TRUE(stats.nodesTested < 100, "tested %zu nodes for a small view", stats.nodesTested);
+
+	CullStats empty;
+	CHECK_TRUE(query(tree, CullRect(), empty).empty() && empty.nodesTested == 1, "empty view was not rejected at the root");
+}
+
+// Removing everything from one corner shrinks the node bounds, so the corner is rejected early.
+static void testRemoveShrinksBounds()
+{
+	CullQuadtree<int> tree;
+	tree.reset(64, 64, 8);
+	tree.insert(1, CullRect{2, 2, 4, 4});
+	tree.insert(2, CullRect{60, 60, 62, 62});
+	tree.remove(2);
+	CullStats stats;
+	CHECK_TRUE(query(tree, CullRect{56, 56, 64, 64}, stats).empty(), "removed item still returned");
+	CHECK_TRUE(stats.nodesTested == 1 && stats.nodesRejected == 1, "stale bounds: tested %zu nodes", stats.nodesTested);
+	tree.clear();
+	CHECK_TRUE(tree.size() == 0 && !tree.contains(1), "clear() kept items");
+}
+
+int main()
+{
+	testMatchesBruteForce();
+	testCostFollowsView();
+	testRemoveShrinksBounds();
+
+	std::printf("%s: %d checks, %d failures\n", failures == 0 ? "PASS" : "FAIL", checks, failures);
+	return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,145 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+	This file is part of Warzone 2100.
+	Copyright (C) 2026  Warzone 2100 Project (https://github.com/Warzone2100)
+
+	Warzone 2100 is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	Warzone 2100 is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Warzone 2100; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+// Standalone unit tests for PcmChunkRing in lib/sound/pcm_ring.h (header-only, std only).
+// Build and run:
+//   c++ -std=c++20 -pthread -Ilib/sound tests/pcm_ring_test.cpp -o pcm_ring_test && ./pcm_ring_test
+// or via CMake with -DWZ_BUILD_PCM_RING_TEST=ON (target: pcm_ring_test).
+// Exits nonzero on failure.
+
+#include "pcm_ring.h"
+
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
+static int failures = 0;
+static int checks = 0;
+
+#define CHECK_TRUE(cond, ...) \
+	do { \
+		checks++; \
+		if (!(cond)) { \
+			failures++; \
+			std::printf("FAIL %s:%d: ", __FILE__, __LINE__); \
+			std::printf(__VA_ARGS__); \
+			std::printf("\n"); \
+		} \
+	} while (0)
+
+// Full / empty edges and the end-of-stream state, on one thread.
+static void testSingleThread()
+{
+	PcmChunkRing ring(3, 8);
+	size_t size = 0;
+	CHECK_TRUE(ring.readChunk(size) == nullptr && ring.available() == 0, "new ring is not empty");
+	for (int i = 0; i < 3; ++i)
+	{
+		uint8_t *chunk = ring.writeChunk();
+		CHECK_TRUE(chunk != nullptr, "ring full after %d chunks", i);
+		if (!chunk)
+		{
+			return;
+		}
+		std::memset(chunk, i + 1, ring.chunkSize());
+		ring.commitWrite(static_cast<size_t>(i + 1));
+	}
+	CHECK_TRUE(ring.writeChunk() == nullptr, "ring not full after %zu chunks", ring.capacity());
+	CHECK_TRUE(ring.available() == 3, "available() = %zu", ring.available());
+
+	const uint8_t *chunk = ring.readChunk(size);
+	CHECK_TRUE(chunk != nullptr && size == 1 && chunk[0] == 1, "first chunk out of order");
+	ring.commitRead();
+	CHECK_TRUE(ring.writeChunk() != nullptr, "reading did not free a chunk");
+
+	ring.finish(false);
+	CHECK_TRUE(ring.isFinished() && !ring.drained(), "drained while chunks are left");
+	ring.commitRead();
+	ring.commitRead();
+	CHECK_TRUE(ring.drained() && !ring.failed(), "not drained after reading every chunk");
+
+	PcmChunkRing failed(2, 4);
+	failed.finish(true);
+	CHECK_TRUE(failed.drained() && failed.failed(), "decode failure not reported");
+}
+
+// A producer and a consumer thread pass a counting sequence through a small ring: every byte
+// must arrive once and in order, with the sizes the producer committed.
+static void testProducerConsumer()
+{
+	const size_t chunkSize = 64;
+	const uint32_t totalChunks = 200000;
+	PcmChunkRing ring(4, chunkSize);
+
+	std::thread producer([&ring, chunkSize, totalChunks]() {
+		for (uint32_t i = 0; i < totalChunks;)
+		{
+			uint8_t *chunk = ring.writeChunk();
+			if (!chunk)
+			{
+				std::this_thread::yield();
+				continue;
+			}
+			const size_t size = 1 + i % chunkSize;
+			for (size_t b = 0; b < size; ++b)
+			{
+				chunk[b] = static_cast<uint8_t>(i + b);
+			}
+			ring.commitWrite(size);
+			++i;
+		}
+		ring.finish(false);
+	});
+
+	uint32_t received = 0;
+	uint32_t corrupt = 0;
+	while (!ring.drained())
+	{
+		size_t size = 0;
+		const uint8_t *chunk = ring.readChunk(size);
+		if (!chunk)
+		{
+			std::this_thread::yield();
+			continue;
+		}
+		bool ok = (size == 1 + received % chunkSize);
+		for (size_t b = 0; ok && b < size; ++b)
+		{
+			ok = (chunk[b] == static_cast<uint8_t>(received + b));
+		}
+		corrupt += ok ? 0 : 1;
+		ring.commitRead();
+		++received;
+	}
+	producer.join();
+
+	CHECK_TRUE(received == totalChunks, "received %u of %u chunks", received, totalChunks);
+	CHECK_TRUE(corrupt == 0, "%u chunks arrived corrupt or out of order", corrupt);
+}
+
+int main()
+{
+	testSingleThread();
+	testProducerConsumer();
+
+	std::printf("%s: %d checks, %d failures\n", failures == 0 ? "PASS" : "FAIL", checks, failures);
+	return failures == 0 ? 0 : 1;
+}